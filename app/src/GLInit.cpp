@@ -67,6 +67,8 @@ namespace TrenchBroom {
     static Func3<void, GLenum, GLenum, GLfloat>& _glTexParameterf = glTexParameterf;
     static Func3<void, GLenum, GLenum, GLint>& _glTexParameteri = glTexParameteri;
     static Func9<void, GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*>& _glTexImage2D = glTexImage2D;
+    static Func10<void, GLenum, GLint, GLint, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*>& _glTexImage3D = glTexImage3D;
+    static Func1<void, GLenum>& _glGenerateMipmap = glGenerateMipmap;
     static Func1<void, GLenum>& _glActiveTexture = glActiveTexture;
     
     static Func2<void, GLsizei, GLuint*>& _glGenBuffers = glGenBuffers;
@@ -77,6 +79,13 @@ namespace TrenchBroom {
     static Func2<GLvoid*, GLenum, GLenum>& _glMapBuffer = glMapBuffer;
     static Func1<GLboolean, GLenum>& _glUnmapBuffer = glUnmapBuffer;
     
+    static Func2<void, GLsizei, GLuint*>& _glGenQueries = glGenQueries;
+    static Func2<void, GLsizei, const GLuint*>& _glDeleteQueries = glDeleteQueries;
+    static Func2<void, GLenum, GLuint>& _glBeginQuery = glBeginQuery;
+    static Func1<void, GLenum>& _glEndQuery = glEndQuery;
+    static Func3<void, GLuint, GLenum, GLint*>& _glGetQueryObjectiv = glGetQueryObjectiv;
+    static Func3<void, GLuint, GLenum, GLuint*>& _glGetQueryObjectuiv = glGetQueryObjectuiv;
+    
     static Func1<void, GLuint>& _glEnableVertexAttribArray = glEnableVertexAttribArray;
     static Func1<void, GLuint>& _glDisableVertexAttribArray = glDisableVertexAttribArray;
     static Func1<void, GLenum>& _glEnableClientState = glEnableClientState;
@@ -199,6 +208,8 @@ namespace TrenchBroom {
         _glTexParameterf.bindFunc(&::glTexParameterf);
         _glTexParameteri.bindFunc(&::glTexParameteri);
         _glTexImage2D.bindFunc(&::glTexImage2D);
+        _glTexImage3D.bindFunc(glTexImage3D);
+        _glGenerateMipmap.bindFunc(glGenerateMipmap);
         _glActiveTexture.bindFunc(glActiveTexture);
         
         _glGenBuffers.bindFunc(glGenBuffers);
@@ -209,6 +220,13 @@ namespace TrenchBroom {
         _glMapBuffer.bindFunc(glMapBuffer);
         _glUnmapBuffer.bindFunc(glUnmapBuffer);
         
+        _glGenQueries.bindFunc(glGenQueries);
+        _glDeleteQueries.bindFunc(glDeleteQueries);
+        _glBeginQuery.bindFunc(glBeginQuery);
+        _glEndQuery.bindFunc(glEndQuery);
+        _glGetQueryObjectiv.bindFunc(glGetQueryObjectiv);
+        _glGetQueryObjectuiv.bindFunc(glGetQueryObjectuiv);
+        
         _glEnableVertexAttribArray.bindFunc(glEnableVertexAttribArray);
         _glDisableVertexAttribArray.bindFunc(glDisableVertexAttribArray);
         _glEnableClientState.bindFunc(&::glEnableClientState);
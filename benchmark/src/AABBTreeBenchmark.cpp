@@ -0,0 +1,109 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "AABBTree.h"
+#include "BenchmarkUtils.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/AssortNodesVisitor.h"
+#include "Model/Brush.h"
+#include "Model/MapFormat.h"
+#include "Model/Node.h"
+#include "Model/World.h"
+
+#include <memory>
+#include <random>
+
+namespace TrenchBroom {
+    using NodeTree = AABBTree<double, 3, Model::Node*>;
+
+    static const BBox3 WorldBounds(8192.0);
+
+    static Model::NodeList collectBrushes(Model::World* world) {
+        Model::CollectBrushesVisitor visitor;
+        world->acceptAndRecurse(visitor);
+        return Model::NodeList(std::begin(visitor.brushes()), std::end(visitor.brushes()));
+    }
+
+    static std::unique_ptr<Model::World> readWorld() {
+        const String source = Benchmark::syntheticMap(64, 128);
+        IO::SimpleParserStatus status(nullptr);
+        IO::WorldReader reader(source, nullptr);
+        return std::unique_ptr<Model::World>(reader.read(Model::MapFormat::Standard, WorldBounds, status));
+    }
+
+    TEST(AABBTreeBenchmark, insertAndRemove) {
+        const auto world = readWorld();
+        const Model::NodeList nodes = collectBrushes(world.get());
+
+        NodeTree tree;
+        Benchmark::measure("AABBTree/insert " + std::to_string(nodes.size()) + " nodes", 10,
+                           [&]() { tree.clear(); },
+                           [&]() {
+                               for (Model::Node* node : nodes)
+                                   tree.insert(node->bounds(), node);
+                           });
+
+        Benchmark::measure("AABBTree/remove " + std::to_string(nodes.size()) + " nodes", 10,
+                           [&]() {
+                               tree.clear();
+                               for (Model::Node* node : nodes)
+                                   tree.insert(node->bounds(), node);
+                           },
+                           [&]() {
+                               for (Model::Node* node : nodes)
+                                   tree.remove(node->bounds(), node);
+                           });
+        ASSERT_TRUE(tree.empty());
+    }
+
+    TEST(AABBTreeBenchmark, query) {
+        const auto world = readWorld();
+        const Model::NodeList nodes = collectBrushes(world.get());
+
+        NodeTree tree;
+        for (Model::Node* node : nodes)
+            tree.insert(node->bounds(), node);
+
+        std::mt19937 random(0);
+        std::uniform_real_distribution<double> coord(-2048.0, 2048.0);
+
+        std::vector<Ray3> rays;
+        std::vector<Vec3> points;
+        for (size_t i = 0; i < 10000; ++i) {
+            const Vec3 origin(coord(random), coord(random), coord(random));
+            const Vec3 target(coord(random), coord(random), coord(random));
+            rays.push_back(Ray3(origin, (target - origin).normalized()));
+            points.push_back(target);
+        }
+
+        size_t hits = 0;
+        Benchmark::measure("AABBTree/10000 ray queries", 10, [&]() {
+            for (const Ray3& ray : rays)
+                hits += tree.findIntersectors(ray).size();
+        });
+        Benchmark::measure("AABBTree/10000 point queries", 10, [&]() {
+            for (const Vec3& point : points)
+                hits += tree.findContainers(point).size();
+        });
+        ASSERT_LT(0u, hits);
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BatchMath.h"
+#include "BenchmarkUtils.h"
+#include "VecMath.h"
+
+#include <random>
+#include <vector>
+
+namespace TrenchBroom {
+    static const size_t PointCount = 1 << 20;
+
+    template <typename T>
+    static typename Vec<T,3>::List randomPoints() {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<T> distribution(static_cast<T>(-4096.0), static_cast<T>(4096.0));
+
+        typename Vec<T,3>::List result;
+        result.reserve(PointCount);
+        for (size_t i = 0; i < PointCount; ++i)
+            result.push_back(Vec<T,3>(distribution(random), distribution(random), distribution(random)));
+        return result;
+    }
+
+    template <typename T>
+    static Mat<T,4,4> transformation() {
+        return translationMatrix(Vec<T,3>(32.0, -16.0, 8.0)) * rotationMatrix(Vec<T,3>(1.0, 2.0, 3.0).normalized(), static_cast<T>(0.3));
+    }
+
+    template <typename T>
+    static void measureTransformations(const String& type) {
+        const typename Vec<T,3>::List points = randomPoints<T>();
+        const Mat<T,4,4> matrix = transformation<T>();
+        typename Vec<T,3>::List scalarResult(points.size()), batchResult(points.size());
+
+        Benchmark::measure("BatchMath/scalar transform " + type, 20, [&]() {
+            BatchMath::Scalar::transformPoints(matrix, points.data(), points.size(), scalarResult.data());
+        });
+        Benchmark::measure("BatchMath/batch transform " + type, 20, [&]() {
+            BatchMath::transformPoints(matrix, points.data(), points.size(), batchResult.data());
+        });
+        ASSERT_EQ(scalarResult, batchResult);
+
+        BBox<T,3> scalarBounds, batchBounds;
+        Benchmark::measure("BatchMath/scalar transformed bounds " + type, 20, [&]() {
+            scalarBounds = BatchMath::Scalar::transformedBounds(matrix, points.data(), points.size());
+        });
+        Benchmark::measure("BatchMath/batch transformed bounds " + type, 20, [&]() {
+            batchBounds = BatchMath::transformedBounds(matrix, points.data(), points.size());
+        });
+        ASSERT_EQ(scalarBounds, batchBounds);
+
+        Benchmark::measure("BatchMath/scalar bounds " + type, 20, [&]() {
+            scalarBounds = BatchMath::Scalar::boundsOfPoints(points.data(), points.size());
+        });
+        Benchmark::measure("BatchMath/batch bounds " + type, 20, [&]() {
+            batchBounds = BatchMath::boundsOfPoints(points.data(), points.size());
+        });
+        ASSERT_EQ(scalarBounds, batchBounds);
+
+        std::vector<BBox<T,3>> boxes;
+        boxes.reserve(points.size() / 2);
+        for (size_t i = 0; i < points.size(); i += 2)
+            boxes.push_back(BBox<T,3>(points[i], points[i]).mergeWith(points[i + 1]));
+
+        Benchmark::measure("BatchMath/scalar merge bounds " + type, 20, [&]() {
+            scalarBounds = BatchMath::Scalar::mergeBounds(boxes.data(), boxes.size());
+        });
+        Benchmark::measure("BatchMath/batch merge bounds " + type, 20, [&]() {
+            batchBounds = BatchMath::mergeBounds(boxes.data(), boxes.size());
+        });
+        ASSERT_EQ(scalarBounds, batchBounds);
+    }
+
+    TEST(BatchMathBenchmark, transformFloat) {
+        measureTransformations<float>("float");
+    }
+
+    TEST(BatchMathBenchmark, transformDouble) {
+        measureTransformations<double>("double");
+    }
+
+    TEST(BatchMathBenchmark, classifyPoints) {
+        const Vec3d::List points = randomPoints<double>();
+        const Plane3d plane(1024.0, Vec3d(1.0, 2.0, 3.0).normalized());
+
+        // classify brush sized batches as the brush containment and intersection tests do
+        static const size_t BatchSize = 8;
+        BatchMath::PointStatusMask::Type scalarStatus = 0, batchStatus = 0;
+        Benchmark::measure("BatchMath/scalar classify", 20, [&]() {
+            scalarStatus = 0;
+            for (size_t i = 0; i < points.size(); i += BatchSize)
+                scalarStatus |= BatchMath::Scalar::classifyPoints(plane, points.data() + i, BatchSize) << (i % 3);
+        });
+        Benchmark::measure("BatchMath/batch classify", 20, [&]() {
+            batchStatus = 0;
+            for (size_t i = 0; i < points.size(); i += BatchSize)
+                batchStatus |= BatchMath::classifyPoints(plane, points.data() + i, BatchSize) << (i % 3);
+        });
+        ASSERT_EQ(scalarStatus, batchStatus);
+    }
+}
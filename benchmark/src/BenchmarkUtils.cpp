@@ -0,0 +1,167 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+
+#include "IO/DiskIO.h"
+#include "IO/MappedFile.h"
+#include "IO/Path.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+
+namespace TrenchBroom {
+    namespace Benchmark {
+        struct Result {
+            String name;
+            double median;
+            double min;
+            size_t iterations;
+        };
+
+        static const char* OutputVariable = "TB_BENCHMARK_OUTPUT";
+        static const char* BaselineVariable = "TB_BENCHMARK_BASELINE";
+        static const char* ToleranceVariable = "TB_BENCHMARK_TOLERANCE";
+        static const double DefaultTolerance = 0.25;
+
+        static std::vector<Result>& results() {
+            static std::vector<Result> results;
+            return results;
+        }
+
+        static std::map<String, double> readBaseline(const char* path) {
+            std::map<String, double> result;
+
+            std::ifstream stream(path);
+            if (!stream.is_open()) {
+                std::fprintf(stderr, "Cannot open benchmark baseline '%s'\n", path);
+                return result;
+            }
+
+            String line;
+            while (std::getline(stream, line)) {
+                const StringList columns = StringUtils::split(line, '\t');
+                if (columns.size() >= 2) {
+                    result[columns[0]] = std::atof(columns[1].c_str());
+                }
+            }
+            return result;
+        }
+
+        static const std::map<String, double>& baseline() {
+            static const std::map<String, double> baseline = []() {
+                const char* path = std::getenv(BaselineVariable);
+                return path != nullptr ? readBaseline(path) : std::map<String, double>();
+            }();
+            return baseline;
+        }
+
+        static double tolerance() {
+            const char* value = std::getenv(ToleranceVariable);
+            return value != nullptr ? std::atof(value) : DefaultTolerance;
+        }
+
+        void recordResult(const String& name, std::vector<double> milliseconds) {
+            ASSERT_FALSE(milliseconds.empty());
+
+            std::sort(std::begin(milliseconds), std::end(milliseconds));
+            const Result result = { name, milliseconds[milliseconds.size() / 2], milliseconds.front(), milliseconds.size() };
+            results().push_back(result);
+
+            std::printf("BENCHMARK\t%s\t%f\t%f\t%zu\n", result.name.c_str(), result.median, result.min, result.iterations);
+
+            const auto it = baseline().find(name);
+            if (it != std::end(baseline())) {
+                const double limit = it->second * (1.0 + tolerance());
+                EXPECT_LE(result.median, limit) << "Benchmark '" << name << "' regressed: median " << result.median << " ms, baseline " << it->second << " ms";
+            }
+        }
+
+        String syntheticMap(const size_t entityCount, const size_t brushesPerEntity) {
+            StringStream str;
+            str << "{\n\"classname\" \"worldspawn\"\n";
+
+            size_t brushIndex = 0;
+            const auto writeCube = [&]() {
+                // lay the cubes out on a 64 x 64 grid, stacking layers upwards
+                const long x = static_cast<long>(brushIndex % 64) * 64 - 2048;
+                const long y = static_cast<long>((brushIndex / 64) % 64) * 64 - 2048;
+                const long z = static_cast<long>(brushIndex / 4096) * 64 - 2048;
+                const String texture = "texture" + std::to_string(brushIndex % 32);
+                ++brushIndex;
+
+                str << "{\n";
+                str << "( " << x      << " " << y      << " " << z      << " ) ( " << x      << " " << y + 1  << " " << z      << " ) ( " << x      << " " << y      << " " << z + 1  << " ) " << texture << " 0 0 0 1 1\n";
+                str << "( " << x      << " " << y      << " " << z      << " ) ( " << x      << " " << y      << " " << z + 1  << " ) ( " << x + 1  << " " << y      << " " << z      << " ) " << texture << " 0 0 0 1 1\n";
+                str << "( " << x      << " " << y      << " " << z      << " ) ( " << x + 1  << " " << y      << " " << z      << " ) ( " << x      << " " << y + 1  << " " << z      << " ) " << texture << " 0 0 0 1 1\n";
+                str << "( " << x + 56 << " " << y + 56 << " " << z + 56 << " ) ( " << x + 56 << " " << y + 57 << " " << z + 56 << " ) ( " << x + 57 << " " << y + 56 << " " << z + 56 << " ) " << texture << " 0 0 0 1 1\n";
+                str << "( " << x + 56 << " " << y + 56 << " " << z + 56 << " ) ( " << x + 57 << " " << y + 56 << " " << z + 56 << " ) ( " << x + 56 << " " << y + 56 << " " << z + 57 << " ) " << texture << " 0 0 0 1 1\n";
+                str << "( " << x + 56 << " " << y + 56 << " " << z + 56 << " ) ( " << x + 56 << " " << y + 56 << " " << z + 57 << " ) ( " << x + 56 << " " << y + 57 << " " << z + 56 << " ) " << texture << " 0 0 0 1 1\n";
+                str << "}\n";
+            };
+
+            for (size_t i = 0; i < brushesPerEntity; ++i) {
+                writeCube();
+            }
+            str << "}\n";
+
+            for (size_t i = 0; i < entityCount; ++i) {
+                str << "{\n\"classname\" \"func_wall\"\n";
+                for (size_t j = 0; j < brushesPerEntity; ++j) {
+                    writeCube();
+                }
+                str << "}\n";
+            }
+
+            return str.str();
+        }
+
+        String sampleMap(const String& name) {
+            const IO::Path path = IO::Disk::getCurrentWorkingDir() + IO::Path("data/IO/Map") + IO::Path(name);
+            const IO::MappedFile::Ptr file = IO::Disk::openFile(path);
+            return String(file->begin(), file->end());
+        }
+
+        class OutputEnvironment : public ::testing::Environment {
+        public:
+            void TearDown() override {
+                const char* path = std::getenv(OutputVariable);
+                if (path == nullptr)
+                    return;
+
+                std::ofstream stream(path);
+                if (!stream.is_open()) {
+                    std::fprintf(stderr, "Cannot write benchmark results to '%s'\n", path);
+                    return;
+                }
+
+                for (const Result& result : results()) {
+                    stream << result.name << '\t' << result.median << '\t' << result.min << '\t' << result.iterations << '\n';
+                }
+            }
+        };
+
+        [[maybe_unused]] static ::testing::Environment* const outputEnvironment = ::testing::AddGlobalTestEnvironment(new OutputEnvironment());
+    }
+}
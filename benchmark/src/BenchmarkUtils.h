@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BenchmarkUtils
+#define TrenchBroom_BenchmarkUtils
+
+#include "StringUtils.h"
+
+#include <chrono>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Benchmark {
+        /**
+         * Records the timings of a benchmark. Prints a tab separated line of the form
+         *
+         *     BENCHMARK <name> <median ms> <min ms> <iterations>
+         *
+         * to stdout. If the environment variable TB_BENCHMARK_OUTPUT is set, all results are also written to the
+         * file it names when the benchmark run ends, one result per line in the form <name> <median ms> <min ms>
+         * <iterations>, which is also the format expected for a baseline.
+         *
+         * If the environment variable TB_BENCHMARK_BASELINE names such a file, each result is compared to the
+         * result with the same name in the baseline, and the benchmark fails if its median exceeds the baseline
+         * median by more than the fraction given in TB_BENCHMARK_TOLERANCE (0.25 by default).
+         */
+        void recordResult(const String& name, std::vector<double> milliseconds);
+
+        /**
+         * Returns the source of a map in Standard format that contains a worldspawn entity and the given number of
+         * brush entities, each with the given number of axis aligned cubes.
+         */
+        String syntheticMap(size_t entityCount, size_t brushesPerEntity);
+
+        /**
+         * Returns the source of one of the sample maps in data/IO/Map.
+         */
+        String sampleMap(const String& name);
+
+#ifdef __GNUC__
+#define TB_NOINLINE __attribute__((noinline))
+#else
+#define TB_NOINLINE
+#endif
+
+        /**
+         * Calls `setup` and then times `run`, `iterations` times, and records the result under the given name.
+         * Only `run` is timed. The noinline is so you can see the measured function when profiling.
+         */
+        template <typename S, typename R>
+        TB_NOINLINE void measure(const String& name, const size_t iterations, S&& setup, R&& run) {
+            std::vector<double> milliseconds;
+            milliseconds.reserve(iterations);
+
+            for (size_t i = 0; i < iterations; ++i) {
+                setup();
+                const auto start = std::chrono::high_resolution_clock::now();
+                run();
+                const auto end = std::chrono::high_resolution_clock::now();
+                milliseconds.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            }
+
+            recordResult(name, milliseconds);
+        }
+
+        template <typename R>
+        void measure(const String& name, const size_t iterations, R&& run) {
+            measure(name, iterations, [](){}, run);
+        }
+    }
+}
+
+#endif /* defined(TrenchBroom_BenchmarkUtils) */
@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "CollectionUtils.h"
+#include "Color.h"
+#include "Assets/EntityDefinition.h"
+#include "IO/FgdParser.h"
+#include "IO/SimpleParserStatus.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Returns an FGD file with the given number of base classes, which form inheritance chains of ten classes
+         * each, and the given number of point classes, each of which inherits from three base classes.
+         */
+        static String syntheticFgd(const size_t baseClassCount, const size_t classCount) {
+            StringStream str;
+            for (size_t i = 0; i < baseClassCount; ++i) {
+                str << "@BaseClass ";
+                if (i % 10 > 0)
+                    str << "base(Base" << (i - 1) << ") ";
+                str << "= Base" << i << " [\n";
+                for (size_t j = 0; j < 5; ++j)
+                    str << "\tattribute" << i << "_" << j << "(string) : \"Attribute " << j << " of base " << i << "\" : \"default\"\n";
+                str << "\tspawnflags(flags) =\n"
+                    << "\t[\n"
+                    << "\t\t" << (1 << (i % 24)) << " : \"Flag " << i << "\" : 0\n"
+                    << "\t]\n"
+                    << "]\n\n";
+            }
+
+            for (size_t i = 0; i < classCount; ++i) {
+                str << "@PointClass base(Base" << (i % baseClassCount) << ", Base" << ((i * 7) % baseClassCount) << ", Base" << ((i * 13) % baseClassCount) << ") "
+                    << "size(-16 -16 -16, 16 16 16) color(255 128 0) model({ \"path\": \":progs/class" << i << ".mdl\" }) "
+                    << "= class" << i << " : \"Class " << i << "\"\n"
+                    << "[\n"
+                    << "\tcount(integer) : \"Count\" : 1\n"
+                    << "\tmode(choices) : \"Mode\" : 0 =\n"
+                    << "\t[\n"
+                    << "\t\t0 : \"Off\"\n"
+                    << "\t\t1 : \"On\"\n"
+                    << "\t]\n"
+                    << "]\n\n";
+            }
+            return str.str();
+        }
+
+        static void benchParse(const String& name, const String& source, const size_t iterations) {
+            // the definitions are deleted at the end because freeing so many objects between the runs makes the
+            // allocator's timing unpredictable
+            std::vector<Assets::EntityDefinitionList> definitions;
+            Benchmark::measure(name, iterations,
+                               []() {},
+                               [&]() {
+                                   SimpleParserStatus status(nullptr);
+                                   FgdParser parser(source, Color(1.0f, 1.0f, 1.0f, 1.0f));
+                                   definitions.push_back(parser.parseDefinitions(status));
+                               });
+            for (Assets::EntityDefinitionList& list : definitions) {
+                ASSERT_FALSE(list.empty());
+                VectorUtils::clearAndDelete(list);
+            }
+        }
+
+        TEST(FgdParserBenchmark, parseSyntheticFgd) {
+            benchParse("FgdParser synthetic 100 base classes, 5000 classes", syntheticFgd(100, 5000), 5);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "IO/MapCache.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <sstream>
+
+namespace TrenchBroom {
+    namespace IO {
+        static const BBox3 WorldBounds(8192.0);
+
+        static String writeCache(const String& source) {
+            SimpleParserStatus status(nullptr);
+            WorldReader reader(source, nullptr);
+            Model::World* world = reader.read(Model::MapFormat::Standard, WorldBounds, status);
+
+            std::stringstream str;
+            MapCacheWriter writer(world, source.data(), source.data() + source.size(), str);
+            writer.writeCache();
+            delete world;
+
+            return str.str();
+        }
+
+        static void benchReadCache(const String& name, const String& source, const size_t iterations) {
+            const String cache = writeCache(source);
+
+            Model::World* world = nullptr;
+            Benchmark::measure(name, iterations,
+                               [&]() { delete world; world = nullptr; },
+                               [&]() {
+                                   MapCacheReader reader(cache.data(), cache.data() + cache.size(), nullptr);
+                                   world = reader.read(Model::MapFormat::Standard, WorldBounds, source.data(), source.data() + source.size());
+                               });
+            ASSERT_NE(nullptr, world);
+            delete world;
+        }
+
+        // compare with the WorldReader benchmarks, which read the same maps from source
+        TEST(MapCacheBenchmark, readSyntheticMap) {
+            benchReadCache("MapCache/synthetic 100x100", Benchmark::syntheticMap(100, 100), 5);
+        }
+
+        TEST(MapCacheBenchmark, readSampleMap) {
+            benchReadCache("MapCache/rtz_q1", Benchmark::sampleMap("rtz_q1.map"), 10);
+        }
+    }
+}
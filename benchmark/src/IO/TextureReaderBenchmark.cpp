@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "CollectionUtils.h"
+#include "Assets/Palette.h"
+#include "Assets/Texture.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
+#include "IO/IdMipTextureReader.h"
+#include "IO/IdPakFileSystem.h"
+#include "IO/Path.h"
+#include "IO/TextureReader.h"
+#include "IO/WadFileSystem.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        TEST(TextureReaderBenchmark, readWadTextures) {
+            DiskFileSystem fs(Disk::getCurrentWorkingDir());
+            const Assets::Palette palette = Assets::Palette::loadFile(fs, Path("data/palette.lmp"));
+
+            TextureReader::TextureNameStrategy nameStrategy;
+            IdMipTextureReader textureReader(nameStrategy, palette);
+
+            const Path wadPath = Disk::getCurrentWorkingDir() + Path("data/IO/Wad/cr8_czg.wad");
+
+            std::vector<Assets::Texture*> textures;
+            Benchmark::measure("WadFileSystem/open cr8_czg.wad", 20, [&]() {
+                WadFileSystem wadFS(wadPath);
+                ASSERT_FALSE(wadFS.findItems(Path("")).empty());
+            });
+
+            WadFileSystem wadFS(wadPath);
+            const Path::List items = wadFS.findItems(Path(""));
+            Benchmark::measure("IdMipTextureReader/read cr8_czg.wad", 20,
+                               [&]() { VectorUtils::clearAndDelete(textures); },
+                               [&]() {
+                                   for (const Path& item : items)
+                                       textures.push_back(textureReader.readTexture(wadFS.openFile(item)));
+                               });
+            ASSERT_EQ(items.size(), textures.size());
+            VectorUtils::clearAndDelete(textures);
+        }
+
+        TEST(TextureReaderBenchmark, openPak) {
+            const Path pakPath = Disk::getCurrentWorkingDir() + Path("data/IO/Pak/pak1.pak");
+            Benchmark::measure("IdPakFileSystem/open and list pak1.pak", 20, [&]() {
+                IdPakFileSystem pakFS(pakPath, Disk::openFile(pakPath));
+                ASSERT_FALSE(pakFS.findItemsRecursively(Path("")).empty());
+            });
+        }
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "IO/NodeWriter.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <sstream>
+
+namespace TrenchBroom {
+    namespace IO {
+        static const BBox3 WorldBounds(8192.0);
+
+        static Model::World* readWorld(const String& source) {
+            SimpleParserStatus status(nullptr);
+            WorldReader reader(source, nullptr);
+            return reader.read(Model::MapFormat::Standard, WorldBounds, status);
+        }
+
+        static void benchReadWorld(const String& name, const String& source, const size_t iterations) {
+            Model::World* world = nullptr;
+            Benchmark::measure(name, iterations,
+                               [&]() { delete world; world = nullptr; },
+                               [&]() { world = readWorld(source); });
+            ASSERT_NE(nullptr, world);
+            delete world;
+        }
+
+        static void benchWriteWorld(const String& name, const String& source, const size_t iterations) {
+            Model::World* world = readWorld(source);
+            ASSERT_NE(nullptr, world);
+
+            Benchmark::measure(name, iterations, [&]() {
+                std::stringstream str;
+                NodeWriter writer(world, str);
+                writer.writeMap();
+            });
+            delete world;
+        }
+
+        TEST(WorldReaderBenchmark, readSyntheticMap) {
+            benchReadWorld("WorldReader/synthetic 100x100", Benchmark::syntheticMap(100, 100), 5);
+        }
+
+        TEST(WorldReaderBenchmark, readSampleMap) {
+            benchReadWorld("WorldReader/rtz_q1", Benchmark::sampleMap("rtz_q1.map"), 10);
+        }
+
+        TEST(NodeWriterBenchmark, writeSyntheticMap) {
+            benchWriteWorld("NodeWriter/synthetic 100x100", Benchmark::syntheticMap(100, 100), 5);
+        }
+
+        TEST(NodeWriterBenchmark, writeSampleMap) {
+            benchWriteWorld("NodeWriter/rtz_q1", Benchmark::sampleMap("rtz_q1.map"), 10);
+        }
+    }
+}
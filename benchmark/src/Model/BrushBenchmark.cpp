@@ -0,0 +1,202 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "CollectionUtils.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+#include "Polyhedron.h"
+
+#include <random>
+
+namespace TrenchBroom {
+    namespace Model {
+        static const BBox3 WorldBounds(8192.0);
+
+        TEST(BrushBenchmark, createCuboids) {
+            World world(MapFormat::Standard, nullptr, WorldBounds);
+            BrushBuilder builder(&world, WorldBounds);
+
+            BrushList brushes;
+            Benchmark::measure("Brush/create 1000 cuboids", 10,
+                               [&]() { VectorUtils::clearAndDelete(brushes); },
+                               [&]() {
+                                   for (size_t i = 0; i < 1000; ++i) {
+                                       const Vec3 origin(static_cast<FloatType>(i % 32) * 64.0, static_cast<FloatType>(i / 32) * 64.0, 0.0);
+                                       brushes.push_back(builder.createCuboid(BBox3(origin, origin + Vec3(56.0, 56.0, 56.0)), "texture"));
+                                   }
+                               });
+            VectorUtils::clearAndDelete(brushes);
+        }
+
+        TEST(BrushBenchmark, cloneCuboids) {
+            World world(MapFormat::Standard, nullptr, WorldBounds);
+            BrushBuilder builder(&world, WorldBounds);
+
+            BrushList brushes;
+            for (size_t i = 0; i < 10000; ++i) {
+                const Vec3 origin(static_cast<FloatType>(i % 100) * 64.0, static_cast<FloatType>(i / 100) * 64.0, 0.0);
+                brushes.push_back(builder.createCuboid(BBox3(origin, origin + Vec3(56.0, 56.0, 56.0)), "texture"));
+            }
+
+            BrushList clones;
+            Benchmark::measure("Brush/clone 10000 cuboids", 10,
+                               [&]() { VectorUtils::clearAndDelete(clones); },
+                               [&]() {
+                                   for (const Brush* brush : brushes)
+                                       clones.push_back(brush->clone(WorldBounds));
+                               });
+            VectorUtils::clearAndDelete(clones);
+            VectorUtils::clearAndDelete(brushes);
+        }
+
+        TEST(BrushBenchmark, subtract) {
+            World world(MapFormat::Standard, nullptr, WorldBounds);
+            BrushBuilder builder(&world, WorldBounds);
+
+            // a large slab with a grid of smaller cubes cut out of it, some of them overlapping its edges
+            Brush* minuend = builder.createCuboid(BBox3(Vec3(-512.0, -512.0, -64.0), Vec3(512.0, 512.0, 64.0)), "minuend");
+            BrushList subtrahends;
+            for (size_t i = 0; i < 64; ++i) {
+                const Vec3 origin(static_cast<FloatType>(i % 8) * 144.0 - 600.0, static_cast<FloatType>(i / 8) * 144.0 - 600.0, -32.0);
+                subtrahends.push_back(builder.createCuboid(BBox3(origin, origin + Vec3(96.0, 96.0, 96.0)), "subtrahend"));
+            }
+
+            BrushList result;
+            Benchmark::measure("Brush/subtract 64 cuboids", 10,
+                               [&]() { VectorUtils::clearAndDelete(result); },
+                               [&]() {
+                                   for (const Brush* subtrahend : subtrahends) {
+                                       VectorUtils::append(result, minuend->subtract(world, WorldBounds, "default", subtrahend));
+                                   }
+                               });
+
+            VectorUtils::clearAndDelete(result);
+            VectorUtils::clearAndDelete(subtrahends);
+            delete minuend;
+        }
+
+        TEST(BrushBenchmark, subtractFromManyMinuends) {
+            World world(MapFormat::Standard, nullptr, WorldBounds);
+            BrushBuilder builder(&world, WorldBounds);
+
+            // a large cuboid carved through a grid of small brushes
+            Brush* subtrahend = builder.createCuboid(BBox3(Vec3(-600.0, -40.0, -40.0), Vec3(600.0, 40.0, 40.0)), "subtrahend");
+            BrushList minuends;
+            for (size_t i = 0; i < 256; ++i) {
+                const Vec3 origin(static_cast<FloatType>(i % 32) * 36.0 - 576.0, static_cast<FloatType>(i / 32) * 16.0 - 64.0, -64.0);
+                minuends.push_back(builder.createCuboid(BBox3(origin, origin + Vec3(32.0, 12.0, 128.0)), "minuend"));
+            }
+
+            std::vector<BrushList> result;
+            const auto clearResult = [&]() {
+                for (BrushList& brushes : result)
+                    VectorUtils::clearAndDelete(brushes);
+                result.clear();
+            };
+
+            Benchmark::measure("Brush/subtract from 256 minuends, serial", 5, clearResult, [&]() {
+                for (const Brush* minuend : minuends)
+                    result.push_back(minuend->subtract(world, WorldBounds, "default", subtrahend));
+            });
+            Benchmark::measure("Brush/subtract from 256 minuends, parallel", 5, clearResult, [&]() {
+                result = Brush::subtract(world, WorldBounds, "default", minuends, subtrahend);
+            });
+
+            clearResult();
+            VectorUtils::clearAndDelete(minuends);
+            delete subtrahend;
+        }
+
+        TEST(BrushBenchmark, intersect) {
+            World world(MapFormat::Standard, nullptr, WorldBounds);
+            BrushBuilder builder(&world, WorldBounds);
+
+            Brush* other = builder.createCuboid(BBox3(Vec3(-32.0, -32.0, -32.0), Vec3(96.0, 96.0, 96.0)), "other");
+
+            BrushList brushes;
+            Benchmark::measure("Brush/intersect 1000 cuboids", 10,
+                               [&]() {
+                                   VectorUtils::clearAndDelete(brushes);
+                                   for (size_t i = 0; i < 1000; ++i) {
+                                       brushes.push_back(builder.createCube(128.0, "texture"));
+                                   }
+                               },
+                               [&]() {
+                                   for (Brush* brush : brushes) {
+                                       brush->intersect(WorldBounds, other);
+                                   }
+                               });
+
+            VectorUtils::clearAndDelete(brushes);
+            delete other;
+        }
+
+        TEST(BrushBenchmark, intersectsAndContains) {
+            World world(MapFormat::Standard, nullptr, WorldBounds);
+            BrushBuilder builder(&world, WorldBounds);
+
+            // random convex brushes in a small area so that many of them touch or overlap
+            std::mt19937 random(0);
+            std::uniform_int_distribution<int> coord(-16, 16);
+
+            BrushList brushes;
+            while (brushes.size() < 200) {
+                Vec3::List points;
+                for (size_t i = 0; i < 12; ++i)
+                    points.push_back(16.0 * Vec3(coord(random), coord(random), coord(random)) / 4.0);
+
+                const Polyhedron3 polyhedron(points);
+                if (polyhedron.polyhedron())
+                    brushes.push_back(builder.createBrush(polyhedron, "texture"));
+            }
+
+            std::vector<Polyhedron3> polyhedra;
+            for (const Brush* brush : brushes)
+                polyhedra.push_back(Polyhedron3(brush->vertexPositions()));
+
+            size_t count = 0;
+            Benchmark::measure("Brush/intersects 40000 pairs", 5, [&]() {
+                for (const Brush* lhs : brushes) {
+                    for (const Brush* rhs : brushes)
+                        count += lhs->intersects(rhs) ? 1 : 0;
+                }
+            });
+            Benchmark::measure("Brush/contains 40000 pairs", 5, [&]() {
+                for (const Brush* lhs : brushes) {
+                    for (const Brush* rhs : brushes)
+                        count += lhs->contains(rhs) ? 1 : 0;
+                }
+            });
+            Benchmark::measure("Polyhedron/intersects 40000 pairs", 5, [&]() {
+                for (const Polyhedron3& lhs : polyhedra) {
+                    for (const Polyhedron3& rhs : polyhedra)
+                        count += lhs.intersects(rhs) ? 1 : 0;
+                }
+            });
+            ASSERT_LT(0u, count);
+
+            VectorUtils::clearAndDelete(brushes);
+        }
+    }
+}
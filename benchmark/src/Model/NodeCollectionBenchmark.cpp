@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/NodeCollection.h"
+#include "Model/World.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Mimics how the document maintains its selected nodes when selecting all brushes of a large map and then
+         * deselecting most or all of them again.
+         */
+        TEST(NodeCollectionBenchmark, selectAndDeselect) {
+            static const size_t BrushCount = 60000;
+            static const size_t DeselectCount = 50000;
+
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            NodeList brushes;
+            brushes.reserve(BrushCount);
+            for (size_t i = 0; i < BrushCount; ++i) {
+                Brush* brush = builder.createCube(64.0, "");
+                world.defaultLayer()->addChild(brush);
+                brushes.push_back(brush);
+            }
+
+            // deselect every sixth brush last so that the removed nodes are spread over the collection
+            NodeList toDeselect;
+            toDeselect.reserve(DeselectCount);
+            for (size_t i = 0; i < BrushCount && toDeselect.size() < DeselectCount; ++i) {
+                if (i % 6 != 0) {
+                    toDeselect.push_back(brushes[i]);
+                }
+            }
+
+            NodeCollection selection;
+            Benchmark::measure("NodeCollection/select all " + std::to_string(BrushCount) + " brushes", 5, [&]() { selection.clear(); }, [&]() {
+                selection.addNodes(brushes);
+                ASSERT_EQ(BrushCount, selection.brushes().size());
+            });
+
+            Benchmark::measure("NodeCollection/deselect " + std::to_string(DeselectCount) + " of " + std::to_string(BrushCount) + " brushes", 5, [&]() {
+                selection.clear();
+                selection.addNodes(brushes);
+            }, [&]() {
+                selection.removeNodes(toDeselect);
+                ASSERT_EQ(BrushCount - DeselectCount, selection.brushes().size());
+            });
+
+            Benchmark::measure("NodeCollection/deselect all " + std::to_string(BrushCount) + " brushes one by one", 5, [&]() {
+                selection.clear();
+                selection.addNodes(brushes);
+            }, [&]() {
+                for (Node* brush : brushes) {
+                    selection.removeNode(brush);
+                }
+                ASSERT_TRUE(selection.nodes().empty());
+            });
+        }
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/PickResult.h"
+#include "Model/World.h"
+
+#include <memory>
+#include <random>
+
+namespace TrenchBroom {
+    namespace Model {
+        static const BBox3 WorldBounds(8192.0);
+
+        static void benchPick(const String& name, const String& source) {
+            IO::SimpleParserStatus status(nullptr);
+            IO::WorldReader reader(source, nullptr);
+            const std::unique_ptr<World> world(reader.read(MapFormat::Standard, WorldBounds, status));
+            ASSERT_NE(nullptr, world);
+
+            // cast rays from random points towards the center of the map, like a camera looking at it would
+            std::mt19937 random(0);
+            std::uniform_real_distribution<FloatType> coord(-2048.0, 2048.0);
+            const Vec3 center = world->defaultLayer()->bounds().center();
+
+            std::vector<Ray3> rays;
+            for (size_t i = 0; i < 1000; ++i) {
+                const Vec3 origin(coord(random), coord(random), coord(random));
+                const Vec3 target = center + Vec3(coord(random), coord(random), coord(random)) / 8.0;
+                rays.push_back(Ray3(origin, (target - origin).normalized()));
+            }
+
+            size_t hits = 0;
+            Benchmark::measure(name, 10, [&]() {
+                for (const Ray3& ray : rays) {
+                    PickResult pickResult;
+                    world->pick(ray, pickResult);
+                    hits += pickResult.size();
+                }
+            });
+            ASSERT_LT(0u, hits);
+
+            // what a tool asks for when hovering over the map
+            const auto query = [](const PickResult& pickResult) -> const Hit& {
+                return pickResult.query().type(Brush::BrushHit).occluded().first();
+            };
+
+            std::vector<FloatType> expected;
+            for (const Ray3& ray : rays) {
+                PickResult pickResult;
+                world->pick(ray, pickResult);
+                const Hit& hit = query(pickResult);
+                expected.push_back(hit.distance());
+            }
+
+            std::vector<FloatType> actual;
+            Benchmark::measure(name + ", nearest brush face", 10, [&]() { actual.clear(); }, [&]() {
+                for (const Ray3& ray : rays) {
+                    PickResult pickResult;
+                    world->pickNearest(ray, pickResult, query);
+                    const Hit& hit = query(pickResult);
+                    actual.push_back(hit.distance());
+                }
+            });
+            // compare the distances because adjacent faces may be hit at the same distance
+            ASSERT_EQ(expected.size(), actual.size());
+            for (size_t i = 0; i < expected.size(); ++i) {
+                ASSERT_TRUE(Math::isnan(expected[i]) ? Math::isnan(actual[i]) : Math::eq(expected[i], actual[i]));
+            }
+        }
+
+        TEST(PickBenchmark, pickSyntheticMap) {
+            benchPick("World/pick 1000 rays, synthetic 64x128", Benchmark::syntheticMap(64, 128));
+        }
+
+        TEST(PickBenchmark, pickSampleMap) {
+            benchPick("World/pick 1000 rays, rtz_q1", Benchmark::sampleMap("rtz_q1.map"));
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "VecMath.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+#include "IO/PointFileParser.h"
+#include "Model/PointFile.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Writes a point file with the given number of points that form a spiral, so that the direction changes
+         * slowly and most of the points are removed when the file is loaded.
+         */
+        static void writeSyntheticPointFile(const IO::Path& path, const size_t pointCount) {
+            std::ofstream stream(path.asString(), std::ios::out);
+            for (size_t i = 0; i < pointCount; ++i) {
+                const float angle = Math::radians(static_cast<float>(i));
+                const float radius = 1024.0f + static_cast<float>(i) / 16.0f;
+                stream << radius * std::cos(angle) << " " << radius * std::sin(angle) << " " << static_cast<float>(i) / 64.0f << "\n";
+            }
+        }
+
+        /**
+         * Parses the points line by line, as the point file was loaded before it was parsed from a mapped file.
+         */
+        static Vec3f::List loadLineByLine(const IO::Path& path) {
+            std::fstream stream(path.asString(), std::ios::in);
+            Vec3f::List points;
+            String line;
+            while (std::getline(stream, line))
+                points.push_back(Vec3f::parse(line));
+            return points;
+        }
+
+        TEST(PointFileBenchmark, loadPointFile) {
+            const size_t pointCount = 1000000;
+            const IO::Path path = IO::Disk::getCurrentWorkingDir() + IO::Path("PointFileBenchmark.pts");
+            writeSyntheticPointFile(path, pointCount);
+
+            Benchmark::measure("PointFile parse line by line, 1000000 points", 3,
+                               []() {},
+                               [&]() {
+                                   ASSERT_EQ(pointCount, loadLineByLine(path).size());
+                               });
+
+            Benchmark::measure("PointFile parse mapped, 1000000 points", 3,
+                               []() {},
+                               [&]() {
+                                   IO::MappedFile::Ptr file = IO::Disk::openFile(path);
+                                   IO::PointFileParser parser(file->begin(), file->end());
+                                   Vec3f::List points;
+                                   parser.parse(points);
+                                   ASSERT_EQ(pointCount, points.size());
+                               });
+
+            // includes removing the collinear points and subdividing the remaining segments
+            Benchmark::measure("PointFile load mapped, 1000000 points", 3,
+                               []() {},
+                               [&]() {
+                                   const PointFile pointFile(path);
+                                   ASSERT_FALSE(pointFile.empty());
+                               });
+
+            std::remove(path.asString().c_str());
+        }
+    }
+}
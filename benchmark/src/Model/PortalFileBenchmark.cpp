@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "StringUtils.h"
+#include "VecMath.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+#include "Model/PortalFile.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Writes a PRT1 file with the given number of portals to the given path. The portals are quads and octagons
+         * that are scattered over a grid, in the order in which a BSP compiler might write them.
+         */
+        static void writeSyntheticPortalFile(const IO::Path& path, const size_t portalCount) {
+            std::ofstream stream(path.asString(), std::ios::out);
+            stream << "PRT1\n" << portalCount << "\n" << portalCount << "\n";
+            for (size_t i = 0; i < portalCount; ++i) {
+                const size_t cell = (i * 7919) % portalCount;
+                const float x = static_cast<float>(cell % 64) * 128.0f;
+                const float y = static_cast<float>((cell / 64) % 64) * 128.0f;
+                const float z = static_cast<float>(cell / 4096) * 128.0f;
+                const size_t vertexCount = i % 5 == 0 ? 8 : 4;
+                stream << vertexCount << " " << i << " " << i + 1 << " ";
+                for (size_t j = 0; j < vertexCount; ++j) {
+                    const float angle = Math::radians(360.0f * static_cast<float>(j) / static_cast<float>(vertexCount));
+                    stream << "(" << x << " " << y + 32.0f * std::cos(angle) << " " << z + 32.0f * std::sin(angle) << " ) ";
+                }
+                stream << "\n";
+            }
+        }
+
+        /**
+         * Loads the portals line by line, as the portal file was loaded before it was parsed from a mapped file.
+         */
+        static Polygon3f::List loadLineByLine(const IO::Path& path) {
+            std::fstream stream(path.asString(), std::ios::in);
+            String line;
+            std::getline(stream, line);
+            std::getline(stream, line);
+            std::getline(stream, line);
+            const int portalCount = std::stoi(line);
+
+            Polygon3f::List portals;
+            for (int i = 0; i < portalCount; ++i) {
+                std::getline(stream, line);
+                const auto components = StringUtils::splitAndTrim(line, "() \n\t\r");
+                Vec3f::List vertices;
+                size_t ptr = 3;
+                const int vertexCount = std::stoi(components.at(0));
+                for (int j = 0; j < vertexCount; ++j) {
+                    vertices.push_back(Vec3f(std::stof(components.at(ptr)), std::stof(components.at(ptr + 1)), std::stof(components.at(ptr + 2))));
+                    ptr += 3;
+                }
+                portals.push_back(Polygon3f(vertices));
+            }
+            return portals;
+        }
+
+        TEST(PortalFileBenchmark, loadPortalFile) {
+            const size_t portalCount = 200000;
+            const IO::Path path = IO::Disk::getCurrentWorkingDir() + IO::Path("PortalFileBenchmark.prt");
+            writeSyntheticPortalFile(path, portalCount);
+
+            Benchmark::measure("PortalFile load line by line, 200000 portals", 3,
+                               []() {},
+                               [&]() {
+                                   ASSERT_EQ(portalCount, loadLineByLine(path).size());
+                               });
+
+            Benchmark::measure("PortalFile load mapped, 200000 portals", 3,
+                               []() {},
+                               [&]() {
+                                   const PortalFile portalFile(path);
+                                   ASSERT_EQ(portalCount, portalFile.portalCount());
+                               });
+
+            std::remove(path.asString().c_str());
+        }
+    }
+}
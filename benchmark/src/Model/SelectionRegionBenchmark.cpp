@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/AssortNodesVisitor.h"
+#include "Model/MapFormat.h"
+#include "Model/SelectionRegion.h"
+#include "Model/World.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace Model {
+        static const BBox3 WorldBounds(8192.0);
+
+        /**
+         * Returns the region that a rectangle covers in a 2D view looking down the Z axis.
+         */
+        static SelectionRegion rectangleRegion(const Vec2& min, const Vec2& max) {
+            Plane3::List planes;
+            planes.push_back(Plane3(Vec3(max, 0.0), Vec3::PosX));
+            planes.push_back(Plane3(Vec3(max, 0.0), Vec3::PosY));
+            planes.push_back(Plane3(Vec3(min, 0.0), Vec3::NegX));
+            planes.push_back(Plane3(Vec3(min, 0.0), Vec3::NegY));
+            return SelectionRegion(planes);
+        }
+
+        TEST(SelectionRegionBenchmark, selectBrushesInRectangle) {
+            const String source = Benchmark::syntheticMap(255, 128);
+            IO::SimpleParserStatus status(nullptr);
+            IO::WorldReader reader(source, nullptr);
+            const std::unique_ptr<World> world(reader.read(MapFormat::Standard, WorldBounds, status));
+            ASSERT_NE(nullptr, world);
+
+            CollectBrushesVisitor collect;
+            world->acceptAndRecurse(collect);
+            const BrushList& brushes = collect.brushes();
+
+            // the whole map and the lower left quarter of it
+            const SelectionRegion all = rectangleRegion(Vec2(-4096.0, -4096.0), Vec2(4096.0, 4096.0));
+            const SelectionRegion quarter = rectangleRegion(Vec2(-2048.0, -2048.0), Vec2(0.0, 0.0));
+
+            size_t count = 0;
+            Benchmark::measure("SelectionRegion/linear scan of " + std::to_string(brushes.size()) + " brushes, whole map", 10, [&]() { count = 0; }, [&]() {
+                for (const Brush* brush : brushes) {
+                    if (all.contains(brush))
+                        ++count;
+                }
+            });
+            ASSERT_EQ(brushes.size(), count);
+
+            NodeList nodes;
+            Benchmark::measure("SelectionRegion/find nodes in " + std::to_string(brushes.size()) + " brushes, whole map", 10, [&]() {
+                nodes = world->findNodesContainedIn(all);
+            });
+            ASSERT_LE(brushes.size(), nodes.size());
+
+            Benchmark::measure("SelectionRegion/find nodes in " + std::to_string(brushes.size()) + " brushes, quarter", 10, [&]() {
+                nodes = world->findNodesContainedIn(quarter);
+            });
+            ASSERT_LT(0u, nodes.size());
+            ASSERT_GT(brushes.size() / 2, nodes.size());
+
+            BrushFaceList faces;
+            Benchmark::measure("SelectionRegion/find faces in " + std::to_string(brushes.size()) + " brushes, quarter", 10, [&]() {
+                faces = world->findBrushFacesContainedIn(quarter);
+            });
+            ASSERT_LT(0u, faces.size());
+        }
+    }
+}
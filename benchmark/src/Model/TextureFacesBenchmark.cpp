@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "Assets/Texture.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/CollectMatchingBrushFacesVisitor.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Finds the faces that use one of a hundred textures in a map with a million faces, once by visiting all faces
+         * as the replace texture dialog used to, and once by asking the texture.
+         */
+        TEST(TextureFacesBenchmark, findFacesWithTexture) {
+            static const size_t BrushCount = 1000000 / 6;
+            static const size_t TextureCount = 100;
+
+            // the textures must outlive the faces
+            std::vector<std::unique_ptr<Assets::Texture>> textures;
+            for (size_t i = 0; i < TextureCount; ++i)
+                textures.push_back(std::make_unique<Assets::Texture>("texture" + std::to_string(i), 64, 64));
+
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            for (size_t i = 0; i < BrushCount; ++i)
+                world.defaultLayer()->addChild(builder.createCube(64.0, ""));
+
+            CollectBrushFacesVisitor collectAll;
+            world.acceptAndRecurse(collectAll);
+            const BrushFaceList& allFaces = collectAll.faces();
+
+            Benchmark::measure("TextureFaces/set textures of " + std::to_string(allFaces.size()) + " faces", 5, [&]() {
+                for (BrushFace* face : allFaces)
+                    face->setTexture(nullptr);
+            }, [&]() {
+                for (size_t i = 0; i < allFaces.size(); ++i)
+                    allFaces[i]->setTexture(textures[i % TextureCount].get());
+            });
+
+            const Assets::Texture* subject = textures[TextureCount / 2].get();
+            const size_t expectedCount = static_cast<size_t>(std::count_if(std::begin(allFaces), std::end(allFaces), [subject](const BrushFace* face) { return face->texture() == subject; }));
+
+            Benchmark::measure("TextureFaces/find faces by visiting " + std::to_string(allFaces.size()) + " faces", 5, [&]() {
+                CollectBrushFacesVisitor collect;
+                world.acceptAndRecurse(collect);
+                const BrushFaceList& faces = collect.faces();
+
+                BrushFaceList result;
+                std::copy_if(std::begin(faces), std::end(faces), std::back_inserter(result), [subject](const BrushFace* face) { return face->texture() == subject; });
+                ASSERT_EQ(expectedCount, result.size());
+            });
+
+            Benchmark::measure("TextureFaces/find faces by texture among " + std::to_string(allFaces.size()) + " faces", 5, [&]() {
+                const BrushFaceList& faces = subject->faces();
+
+                BrushFaceList result;
+                std::copy_if(std::begin(faces), std::end(faces), std::back_inserter(result), [](const BrushFace* face) { return face->brush()->parent() != nullptr; });
+                ASSERT_EQ(expectedCount, result.size());
+            });
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "Polyhedron.h"
+#include "TrenchBroom.h"
+
+#include <random>
+
+namespace TrenchBroom {
+    static Vec3::List randomPoints(const size_t count) {
+        std::mt19937 random(0);
+        std::uniform_real_distribution<FloatType> coord(-1024.0, 1024.0);
+
+        Vec3::List result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            // snap to the grid to get the degenerate cases that brushes produce
+            result.push_back(Vec3(coord(random), coord(random), coord(random)).rounded());
+        }
+        return result;
+    }
+
+    TEST(PolyhedronBenchmark, convexHull) {
+        for (const size_t count : { 8u, 64u, 256u }) {
+            const Vec3::List points = randomPoints(count);
+            Benchmark::measure("Polyhedron/convex hull of " + std::to_string(count) + " points", 10, [&]() {
+                const Polyhedron3 polyhedron(points);
+                ASSERT_TRUE(polyhedron.closed());
+            });
+        }
+    }
+
+    TEST(PolyhedronBenchmark, intersect) {
+        const Polyhedron3 cube(BBox3(64.0));
+        const Polyhedron3 other(BBox3(Vec3(-32.0, -32.0, -32.0), Vec3(96.0, 96.0, 96.0)));
+
+        Benchmark::measure("Polyhedron/1000 cube intersections", 10, [&]() {
+            for (size_t i = 0; i < 1000; ++i) {
+                const Polyhedron3 result = cube.intersect(other);
+                ASSERT_FALSE(result.empty());
+            }
+        });
+    }
+}
@@ -19,18 +19,20 @@
 
 #include <gtest/gtest.h>
 
+#include "BenchmarkUtils.h"
 #include "CollectionUtils.h"
 #include "Assets/Texture.h"
 #include "Model/Brush.h"
 #include "Model/BrushBuilder.h"
+#include "Model/Layer.h"
+#include "Model/NodeVisitor.h"
 #include "Model/World.h"
 #include "Model/MapFormat.h"
 #include "Renderer/BrushRenderer.h"
+#include "Renderer/OrthographicCamera.h"
 
 #include <vector>
-#include <chrono>
 #include <string>
-#include <iostream>
 #include <tuple>
 #include <algorithm>
 
@@ -79,23 +81,6 @@ namespace TrenchBroom {
             return {result, textures};
         }
 
-#ifdef __GNUC__
-#define TB_NOINLINE __attribute__((noinline))
-#else
-#define TB_NOINLINE
-#endif
-
-        // the noinline is so you can see the timeLambda when profiling
-        template<class L>
-        TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message) {
-            const auto start = std::chrono::high_resolution_clock::now();
-            lambda();
-            const auto end = std::chrono::high_resolution_clock::now();
-
-            printf("Time elapsed for '%s': %fms\n", message.c_str(),
-                   std::chrono::duration<double>(end - start).count() * 1000.0);
-        }
-
         TEST(BrushRendererBenchmark, benchBrushRenderer) {
             auto brushesTextures = makeBrushes();
             std::vector<Model::Brush*> brushes = brushesTextures.first;
@@ -103,23 +88,23 @@ namespace TrenchBroom {
 
             BrushRenderer r(false);
 
-            timeLambda([&](){ r.addBrushes(brushes); }, "add " + std::to_string(brushes.size()) + " brushes to BrushRenderer");
-            timeLambda([&](){
+            Benchmark::measure("BrushRenderer/add " + std::to_string(brushes.size()) + " brushes", 1, [&](){ r.addBrushes(brushes); });
+            Benchmark::measure("BrushRenderer/validate after adding " + std::to_string(brushes.size()) + " brushes", 1, [&](){
                 if (!r.valid()) {
                     r.validate();
                 }
-            }, "validate after adding " + std::to_string(brushes.size()) + " brushes to BrushRenderer");
+            });
 
             // Tiny change: remove the last brush
             std::vector<Model::Brush*> brushesMinusOne = brushes;
             brushesMinusOne.resize(brushes.size() - 1);
 
-            timeLambda([&](){ r.setBrushes(brushesMinusOne); }, "setBrushes to " + std::to_string(brushesMinusOne.size()) + " (removing one)");
-            timeLambda([&](){
+            Benchmark::measure("BrushRenderer/setBrushes removing one", 1, [&](){ r.setBrushes(brushesMinusOne); });
+            Benchmark::measure("BrushRenderer/validate after removing one brush", 1, [&](){
                 if (!r.valid()) {
                     r.validate();
                 }
-            }, "validate after removing one brush");
+            });
 
             // Large change: keep every second brush
             Model::BrushList brushesToKeep;
@@ -129,19 +114,197 @@ namespace TrenchBroom {
                 }
             }
 
-            timeLambda([&](){ r.setBrushes(brushesToKeep); },
-                       "set brushes from " + std::to_string(brushes.size()) +
-                       " to " + std::to_string(brushesToKeep.size()));
+            Benchmark::measure("BrushRenderer/setBrushes keeping every second brush", 1, [&](){ r.setBrushes(brushesToKeep); });
+            Benchmark::measure("BrushRenderer/validate with " + std::to_string(brushesToKeep.size()) + " brushes", 1, [&](){
+                if (!r.valid()) {
+                    r.validate();
+                }
+            });
+
+            VectorUtils::clearAndDelete(brushes);
+            VectorUtils::clearAndDelete(textures);
+        }
+
+        class CollectBrushesBySelection : public Model::NodeVisitor {
+        private:
+            Model::BrushList m_unselected;
+            Model::BrushList m_selected;
+        public:
+            const Model::BrushList& unselected() const { return m_unselected; }
+            const Model::BrushList& selected() const   { return m_selected; }
+        private:
+            void doVisit(Model::World* world) override   {}
+            void doVisit(Model::Layer* layer) override   {}
+            void doVisit(Model::Group* group) override   {}
+            void doVisit(Model::Entity* entity) override {}
+            void doVisit(Model::Brush* brush) override   {
+                if (brush->selected()) {
+                    m_selected.push_back(brush);
+                } else {
+                    m_unselected.push_back(brush);
+                }
+            }
+        };
+
+        /**
+         * Measures rebuilding the vertex caches of all brushes, which happens after the textures of the brushes have
+         * changed, e.g. when the user retextures a large selection or changes the texture collections.
+         */
+        TEST(BrushRendererBenchmark, rebuildVertexCaches) {
+            auto brushesTextures = makeBrushes();
+            std::vector<Model::Brush*> brushes = brushesTextures.first;
+            std::vector<Assets::Texture*> textures = brushesTextures.second;
 
-            timeLambda([&](){
-                           if (!r.valid()) {
-                               r.validate();
-                           }
-                       }, "validate with " + std::to_string(brushesToKeep.size()) + " brushes");
+            Benchmark::measure("BrushRenderer/rebuild vertex caches of " + std::to_string(brushes.size()) + " brushes", 20,
+                               [&]() {
+                                   for (Model::Brush* brush : brushes)
+                                       brush->invalidateVertexCache();
+                               },
+                               [&]() {
+                                   for (Model::Brush* brush : brushes)
+                                       brush->brushRendererBrushCache().validateVertexCache(brush);
+                               });
 
             VectorUtils::clearAndDelete(brushes);
             VectorUtils::clearAndDelete(textures);
         }
+
+        /**
+         * Compares the two ways of moving a newly selected brush from the default renderer to the selection
+         * renderer: collecting all brushes of the world and setting them again, or moving only the selected brush.
+         * Each iteration selects and deselects a brush, and both variants validate the renderers after each step,
+         * which is what happens when the next frame is rendered.
+         */
+        TEST(BrushRendererBenchmark, selectOneBrush) {
+            std::vector<Assets::Texture*> textures;
+            for (size_t i = 0; i < NumTextures; ++i) {
+                textures.push_back(new Assets::Texture("texture " + std::to_string(i), 64, 64));
+            }
+
+            {
+                // the world must be destroyed before the textures
+                const BBox3 worldBounds(8192.0);
+                Model::World world(Model::MapFormat::Standard, nullptr, worldBounds);
+                Model::BrushBuilder builder(&world, worldBounds);
+
+                Model::BrushList brushes;
+                size_t currentTextureIndex = 0;
+                for (size_t i = 0; i < NumBrushes; ++i) {
+                    Model::Brush* brush = builder.createCube(64.0, "");
+                    for (auto* face : brush->faces()) {
+                        face->setTexture(textures.at((currentTextureIndex++) % NumTextures));
+                    }
+                    world.defaultLayer()->addChild(brush);
+                    brushes.push_back(brush);
+                }
+
+                BrushRenderer defaultRenderer(false);
+                BrushRenderer selectionRenderer(false);
+                defaultRenderer.addBrushes(brushes);
+                defaultRenderer.validate();
+
+                const auto validate = [&]() {
+                    if (!defaultRenderer.valid()) {
+                        defaultRenderer.validate();
+                    }
+                    if (!selectionRenderer.valid()) {
+                        selectionRenderer.validate();
+                    }
+                };
+
+                const auto updateAll = [&]() {
+                    CollectBrushesBySelection collect;
+                    world.acceptAndRecurse(collect);
+                    defaultRenderer.setBrushes(collect.unselected());
+                    selectionRenderer.setBrushes(collect.selected());
+                    validate();
+                };
+
+                size_t index = 0;
+                Benchmark::measure("BrushRenderer/select one of " + std::to_string(brushes.size()) + " brushes, full update", 20, [&]() {
+                    Model::Brush* brush = brushes[index++ % brushes.size()];
+                    brush->select();
+                    updateAll();
+
+                    brush->deselect();
+                    updateAll();
+                });
+
+                Benchmark::measure("BrushRenderer/select one of " + std::to_string(brushes.size()) + " brushes, incremental update", 20, [&]() {
+                    Model::Brush* brush = brushes[index++ % brushes.size()];
+                    brush->select();
+
+                    const Model::BrushList changed(1, brush);
+                    defaultRenderer.removeBrushes(changed);
+                    selectionRenderer.addBrushes(changed);
+                    validate();
+
+                    brush->deselect();
+                    defaultRenderer.addBrushes(changed);
+                    selectionRenderer.removeBrushes(changed);
+                    validate();
+                });
+            }
+
+            VectorUtils::clearAndDelete(textures);
+        }
+
+        /**
+         * Measures the time it takes to find the edges that a 2D view renders when it looks at a map with 200k brushes
+         * from above, at zoom levels ranging from the entire map, where every brush is smaller than a pixel, to a few
+         * hundred units. The camera pans a little in every iteration like it does while the user drags the view.
+         */
+        TEST(BrushRendererBenchmark, findVisibleEdgesIn2DView) {
+            const size_t gridSize = 448;
+            const FloatType spacing = 48.0;
+
+            const BBox3 worldBounds(16384.0);
+            Model::World world(Model::MapFormat::Standard, nullptr, worldBounds);
+            Model::BrushBuilder builder(&world, worldBounds);
+
+            Model::BrushList brushes;
+            for (size_t x = 0; x < gridSize; ++x) {
+                for (size_t y = 0; y < gridSize; ++y) {
+                    const Vec3 min((static_cast<FloatType>(x) - gridSize / 2.0) * spacing, (static_cast<FloatType>(y) - gridSize / 2.0) * spacing, static_cast<FloatType>((x + y) % 8) * 32.0);
+                    brushes.push_back(builder.createCuboid(BBox3(min, min + Vec3(32.0, 32.0, 32.0)), ""));
+                }
+            }
+
+            BrushRenderer renderer(false);
+            renderer.addBrushes(brushes);
+            renderer.validate();
+
+            const Camera::Viewport viewport(0, 0, 1920, 1080);
+            OrthographicCamera camera(1.0f, 32768.0f, viewport, Vec3f(0.0f, 0.0f, 16384.0f), Vec3f::NegZ, Vec3f::PosY);
+
+            // builds the brush tree
+            BrushRenderer::VisibleEdges visibleEdges;
+            renderer.findVisibleEdges(camera, visibleEdges);
+
+            size_t previousRanges = 0;
+            for (const float zoom : { 0.01f, 0.2f, 1.0f, 4.0f }) {
+                camera.setZoom(zoom);
+                camera.moveTo(Vec3f(0.0f, 0.0f, 16384.0f));
+
+                Benchmark::measure("BrushRenderer/find visible edges of " + std::to_string(brushes.size()) + " brushes at zoom " + std::to_string(zoom), 20, [&]() {
+                    camera.moveBy(Vec3f(8.0f / zoom, 0.0f, 0.0f));
+                    visibleEdges = BrushRenderer::VisibleEdges();
+                    renderer.findVisibleEdges(camera, visibleEdges);
+                });
+
+                // when zoomed out, the brushes are collapsed into fewer points than there are pixels, and the more
+                // the view zooms in, the fewer brushes are visible
+                ASSERT_FALSE(visibleEdges.all);
+                ASSERT_LT(visibleEdges.points.size(), static_cast<size_t>(viewport.width * viewport.height));
+                if (zoom > 0.2f) {
+                    ASSERT_TRUE(visibleEdges.points.empty());
+                    ASSERT_LT(visibleEdges.offsets.size(), previousRanges);
+                }
+                previousRanges = visibleEdges.offsets.size();
+            }
+
+            VectorUtils::clearAndDelete(brushes);
+        }
     }
 }
 
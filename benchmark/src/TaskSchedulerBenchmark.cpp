@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "TaskScheduler.h"
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace TrenchBroom {
+    static double work(const size_t i) {
+        return std::sqrt(static_cast<double>(i)) * std::sin(static_cast<double>(i));
+    }
+
+    TEST(TaskSchedulerBenchmark, submitEmptyTasks) {
+        TaskScheduler& scheduler = TaskScheduler::instance();
+
+        Benchmark::measure("TaskScheduler submit 100k empty tasks", 10, []() {}, [&]() {
+            TaskGroup group(scheduler);
+            for (size_t i = 0; i < 100000; ++i)
+                group.run([]() {});
+            group.wait();
+        });
+    }
+
+    TEST(TaskSchedulerBenchmark, parallelFor) {
+        TaskScheduler& scheduler = TaskScheduler::instance();
+        std::vector<double> values(1000000);
+
+        Benchmark::measure("TaskScheduler serial for 1M", 10, []() {}, [&]() {
+            for (size_t i = 0; i < values.size(); ++i)
+                values[i] = work(i);
+        });
+
+        Benchmark::measure("TaskScheduler parallelFor 1M", 10, []() {}, [&]() {
+            scheduler.parallelFor(0, values.size(), [&](const size_t i) { values[i] = work(i); }, 1024);
+        });
+    }
+
+    TEST(TaskSchedulerBenchmark, parallelReduce) {
+        TaskScheduler& scheduler = TaskScheduler::instance();
+
+        double serial = 0.0;
+        Benchmark::measure("TaskScheduler serial reduce 1M", 10, [&]() { serial = 0.0; }, [&]() {
+            for (size_t i = 0; i < 1000000; ++i)
+                serial += work(i);
+        });
+
+        double parallel = 0.0;
+        Benchmark::measure("TaskScheduler parallelReduce 1M", 10, []() {}, [&]() {
+            parallel = scheduler.parallelReduce(0, 1000000, 0.0, work, [](const double lhs, const double rhs) { return lhs + rhs; }, 1024);
+        });
+
+        ASSERT_NEAR(serial, parallel, std::abs(serial) * 1e-9);
+    }
+
+    TEST(TaskSchedulerBenchmark, nestedGroups) {
+        TaskScheduler& scheduler = TaskScheduler::instance();
+
+        std::atomic<size_t> leaves(0);
+        Benchmark::measure("TaskScheduler nested groups 8^5", 10, [&]() { leaves = 0; }, [&]() {
+            scheduler.parallelFor(0, 8, [&](size_t) {
+                scheduler.parallelFor(0, 8, [&](size_t) {
+                    scheduler.parallelFor(0, 8, [&](size_t) {
+                        scheduler.parallelFor(0, 8, [&](size_t) {
+                            scheduler.parallelFor(0, 8, [&](size_t) { ++leaves; });
+                        });
+                    });
+                });
+            });
+        });
+        ASSERT_EQ(32768u, leaves);
+    }
+}
@@ -94,7 +94,7 @@ IF(COMPILER_IS_GNU AND TB_ENABLE_ASAN)
     TARGET_LINK_LIBRARIES(TrenchBroom asan)
 ENDIF()
 
-TARGET_LINK_LIBRARIES(TrenchBroom glew ${wxWidgets_LIBRARIES} ${FREETYPE_LIBRARIES} ${FREEIMAGE_LIBRARIES})
+TARGET_LINK_LIBRARIES(TrenchBroom glew ${wxWidgets_LIBRARIES} ${FREETYPE_LIBRARIES} ${FREEIMAGE_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
 IF (COMPILER_IS_MSVC)
     TARGET_LINK_LIBRARIES(TrenchBroom stackwalker)
 ENDIF()
@@ -27,8 +27,8 @@ ENDIF()
 ADD_TARGET_PROPERTY(TrenchBroom-Test INCLUDE_DIRECTORIES "${TEST_SOURCE_DIR}")
 ADD_TARGET_PROPERTY(TrenchBroom-Benchmark INCLUDE_DIRECTORIES "${BENCHMARK_SOURCE_DIR}")
 
-TARGET_LINK_LIBRARIES(TrenchBroom-Test gtest gmock ${wxWidgets_LIBRARIES} ${FREETYPE_LIBRARIES} ${FREEIMAGE_LIBRARIES})
-TARGET_LINK_LIBRARIES(TrenchBroom-Benchmark gtest gmock ${wxWidgets_LIBRARIES} ${FREETYPE_LIBRARIES} ${FREEIMAGE_LIBRARIES})
+TARGET_LINK_LIBRARIES(TrenchBroom-Test gtest gmock ${wxWidgets_LIBRARIES} ${FREETYPE_LIBRARIES} ${FREEIMAGE_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
+TARGET_LINK_LIBRARIES(TrenchBroom-Benchmark gtest gmock ${wxWidgets_LIBRARIES} ${FREETYPE_LIBRARIES} ${FREEIMAGE_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
 
 IF (COMPILER_IS_MSVC)
 	TARGET_LINK_LIBRARIES(TrenchBroom-Test stackwalker)
@@ -60,6 +60,11 @@ ADD_CUSTOM_COMMAND(TARGET TrenchBroom-Test POST_BUILD
 	COMMAND ${CMAKE_COMMAND} -E copy_directory "${CMAKE_SOURCE_DIR}/test/data" "${RESOURCE_DEST_DIR}/data"
 )
 
+# The benchmarks read the same sample maps, textures and archives
+ADD_CUSTOM_COMMAND(TARGET TrenchBroom-Benchmark POST_BUILD
+	COMMAND ${CMAKE_COMMAND} -E copy_directory "${CMAKE_SOURCE_DIR}/test/data" "${BENCHMARK_RESOURCE_DEST_DIR}/data"
+)
+
 ADD_CUSTOM_COMMAND(TARGET TrenchBroom-Test POST_BUILD
 	COMMAND ${CMAKE_COMMAND} -E make_directory "${RESOURCE_DEST_DIR}/data/GameConfig"
 )
@@ -32,14 +32,18 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <queue>
+#include <vector>
 
 template <typename T, size_t S, typename U, typename Cmp = std::less<U>>
 class AABBTree : public NodeTree<T,S,U,Cmp> {
 public:
     using List = typename NodeTree<T,S,U,Cmp>::List;
+    using Array = typename NodeTree<T,S,U,Cmp>::Array;
     using Box = typename NodeTree<T,S,U,Cmp>::Box;
     using DataType = typename NodeTree<T,S,U,Cmp>::DataType;
     using FloatType = typename NodeTree<T,S,U,Cmp>::FloatType;
+    using GetBounds = typename NodeTree<T,S,U,Cmp>::GetBounds;
 private:
     class InnerNode;
     class LeafNode;
@@ -222,6 +226,24 @@ private:
             return m_height;
         }
 
+        /**
+         * Returns the left child of this node.
+         *
+         * @return the left child
+         */
+        const Node* left() const {
+            return m_left;
+        }
+
+        /**
+         * Returns the right child of this node.
+         *
+         * @return the right child
+         */
+        const Node* right() const {
+            return m_right;
+        }
+
         const LeafNode* find(const Box& bounds, const U& data) const override {
             const LeafNode* result = nullptr;
             if (this->bounds().contains(bounds)) {
@@ -481,6 +503,28 @@ public:
         }
     }
 
+    /**
+     * Clears this tree and builds it top down from the given objects. Inserting the objects one by one can produce a
+     * badly unbalanced tree because inner nodes are never rotated, so this splits the objects recursively at the
+     * median of their centers along the axis in which the centers are spread the most.
+     *
+     * @param objects the objects to insert
+     * @param getBounds a function to compute the bounds from each object
+     */
+    void clearAndBuild(const List& objects, const GetBounds& getBounds) override {
+        build(std::begin(objects), std::end(objects), getBounds);
+    }
+
+    /**
+     * Clears this tree and builds it top down from the given objects, see above.
+     *
+     * @param objects the objects to insert
+     * @param getBounds a function to compute the bounds from each object
+     */
+    void clearAndBuild(const Array& objects, const GetBounds& getBounds) override {
+        build(std::begin(objects), std::end(objects), getBounds);
+    }
+
     bool remove(const Box& bounds, const U& data) override {
         if (!empty() && m_root->bounds().contains(bounds)) {
             const auto& [newRoot, result] = m_root->remove(bounds, data);
@@ -504,6 +548,49 @@ public:
         insert(newBounds, data);
     }
 
+private:
+    template <typename I>
+    void build(I cur, I end, const GetBounds& getBounds) {
+        clear();
+
+        std::vector<Node*> leaves;
+        while (cur != end) {
+            const U& data = *cur++;
+            leaves.push_back(new LeafNode(getBounds(data), data));
+        }
+
+        if (!leaves.empty()) {
+            m_root = build(std::begin(leaves), std::end(leaves));
+        }
+    }
+
+    static Node* build(const typename std::vector<Node*>::iterator begin, const typename std::vector<Node*>::iterator end) {
+        const auto count = std::distance(begin, end);
+        if (count == 1) {
+            return *begin;
+        }
+
+        Box centers((*begin)->bounds().center(), (*begin)->bounds().center());
+        for (auto it = std::next(begin); it != end; ++it) {
+            centers.mergeWith((*it)->bounds().center());
+        }
+
+        const Vec<T,S> spread = centers.size();
+        size_t axis = 0;
+        for (size_t i = 1; i < S; ++i) {
+            if (spread[i] > spread[axis]) {
+                axis = i;
+            }
+        }
+
+        const auto mid = std::next(begin, count / 2);
+        std::nth_element(begin, mid, end, [axis](const Node* lhs, const Node* rhs) {
+            return lhs->bounds().center()[axis] < rhs->bounds().center()[axis];
+        });
+
+        return new InnerNode(build(begin, mid), build(mid, end));
+    }
+public:
     void clear() override {
         if (!empty()) {
             delete m_root;
@@ -558,6 +645,181 @@ public:
         }
     }
 
+    /**
+     * Visits every data item in this tree whose bounding box intersects with the given ray in the order of the
+     * distance at which the ray enters the bounding box, nearest first. The distance is 0 for bounding boxes that
+     * contain the ray origin.
+     *
+     * The given function is called with each data item and its entry distance and returns whether to continue. Since
+     * no item that has not been visited yet can enter the ray earlier than the current one, a caller that is looking
+     * for the nearest hit can stop as soon as its best hit lies in front of the current entry distance, skipping the
+     * remaining subtrees entirely.
+     *
+     * @tparam F the function type
+     * @param ray the ray to test
+     * @param visit the function to call for each data item
+     */
+    template <typename F>
+    void findIntersectorsInOrder(const Ray<T,S>& ray, F visit) const {
+        if (empty()) {
+            return;
+        }
+
+        using Entry = std::pair<T, const Node*>;
+        const auto farther = [](const Entry& lhs, const Entry& rhs) { return lhs.first > rhs.first; };
+        std::priority_queue<Entry, std::vector<Entry>, decltype(farther)> queue(farther);
+
+        const auto push = [&](const Node* node) {
+            const auto& bounds = node->bounds();
+            const T distance = bounds.contains(ray.origin) ? static_cast<T>(0.0) : bounds.intersectWithRay(ray);
+            if (!Math::isnan(distance)) {
+                queue.push(Entry(distance, node));
+            }
+        };
+
+        push(m_root);
+        while (!queue.empty()) {
+            const Entry entry = queue.top();
+            queue.pop();
+
+            if (entry.second->leaf()) {
+                const auto* leaf = static_cast<const LeafNode*>(entry.second);
+                if (!visit(leaf->data(), entry.first)) {
+                    return;
+                }
+            } else {
+                const auto* innerNode = static_cast<const InnerNode*>(entry.second);
+                push(innerNode->left());
+                push(innerNode->right());
+            }
+        }
+    }
+
+    List findIntersectors(const Box& bounds) const override {
+        List result;
+        findIntersectors(bounds, std::back_inserter(result));
+        return result;
+    }
+
+    /**
+     * Finds every data item in this tree whose bounding box intersects with the given bounding box and appends it to
+     * the given output iterator.
+     *
+     * @tparam O the output iterator type
+     * @param bounds the bounding box to test
+     * @param out the output iterator to append to
+     */
+    template <typename O>
+    void findIntersectors(const Box& bounds, O out) const {
+        if (!empty()) {
+            LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return innerNode->bounds().intersects(bounds);
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (leaf->bounds().intersects(bounds)) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+            );
+            m_root->accept(visitor);
+        }
+    }
+
+    /**
+     * Finds every data item in this tree whose bounding box intersects with the given bounding box like the function
+     * above, but treats every intersecting subtree whose bounds satisfy the given predicate as a whole: instead of
+     * descending into it, its bounds are passed to the given collapse function. This allows callers to replace the
+     * subtrees that are too small to matter, e.g. because they cover less than a pixel on screen, by their bounds.
+     *
+     * @tparam O the output iterator type
+     * @tparam P the predicate type
+     * @tparam C the collapse function type
+     * @param bounds the bounding box to test
+     * @param out the output iterator to append to
+     * @param collapsible the predicate that decides whether a subtree is collapsed, called with its bounds
+     * @param collapse the function to call with the bounds of each collapsed subtree
+     */
+    template <typename O, typename P, typename C>
+    void findIntersectors(const Box& bounds, O out, P collapsible, C collapse) const {
+        if (!empty()) {
+            LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        if (!innerNode->bounds().intersects(bounds)) {
+                            return false;
+                        }
+                        if (collapsible(innerNode->bounds())) {
+                            collapse(innerNode->bounds());
+                            return false;
+                        }
+                        return true;
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (leaf->bounds().intersects(bounds)) {
+                            if (collapsible(leaf->bounds())) {
+                                collapse(leaf->bounds());
+                            } else {
+                                out = leaf->data();
+                                ++out;
+                            }
+                        }
+                    }
+            );
+            m_root->accept(visitor);
+        }
+    }
+
+    /**
+     * Visits every data item in this tree whose bounding box intersects with the given region. The region can be any
+     * convex volume, such as a view frustum, that provides the following functions:
+     *
+     * - bool intersects(const Box& bounds) const, which may be conservative, i.e., return true for some boxes that do
+     *   not actually intersect the region, and
+     * - bool contains(const Box& bounds) const, which must be exact or return false if in doubt.
+     *
+     * The given function is called with each data item and a flag indicating whether its bounding box is entirely
+     * contained in the region. Once the bounds of a subtree are contained in the region, the region is no longer
+     * tested against any of its nodes, so that selecting a large number of items only costs a walk over them.
+     *
+     * @tparam R the region type
+     * @tparam F the function type
+     * @param region the region to test
+     * @param visit the function to call for each data item
+     */
+    template <typename R, typename F>
+    void findInRegion(const R& region, F visit) const {
+        if (empty()) {
+            return;
+        }
+
+        using Entry = std::pair<const Node*, bool>;
+        std::vector<Entry> stack;
+
+        const auto push = [&](const Node* node, const bool parentContained) {
+            if (parentContained) {
+                stack.push_back(Entry(node, true));
+            } else if (region.intersects(node->bounds())) {
+                stack.push_back(Entry(node, region.contains(node->bounds())));
+            }
+        };
+
+        push(m_root, false);
+        while (!stack.empty()) {
+            const Entry entry = stack.back();
+            stack.pop_back();
+
+            if (entry.first->leaf()) {
+                const auto* leaf = static_cast<const LeafNode*>(entry.first);
+                visit(leaf->data(), entry.second);
+            } else {
+                const auto* innerNode = static_cast<const InnerNode*>(entry.first);
+                push(innerNode->right(), entry.second);
+                push(innerNode->left(), entry.second);
+            }
+        }
+    }
+
      List findContainers(const Vec<T,S>& point) const override {
          List result;
          findContainers(point, std::back_inserter(result));
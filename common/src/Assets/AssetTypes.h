@@ -34,6 +34,9 @@ namespace TrenchBroom {
         class Texture;
         typedef std::vector<Texture*> TextureList;
         
+        class TextureArray;
+        typedef std::vector<TextureArray*> TextureArrayList;
+
         class TextureCollection;
         typedef std::vector<TextureCollection*> TextureCollectionList;
         
@@ -22,25 +22,185 @@
 #include "CollectionUtils.h"
 #include "Exceptions.h"
 #include "Logger.h"
+#include "TaskScheduler.h"
 #include "Assets/EntityModel.h"
 #include "IO/EntityModelLoader.h"
 #include "Model/Entity.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
 
+#include <cassert>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+
 namespace TrenchBroom {
     namespace Assets {
+        /**
+         * The state that is shared between the manager and the background tasks that load its models. Every task
+         * loads the waiting model with the lowest priority value at the time it runs, so changing the priorities
+         * of waiting models changes the order in which they are loaded.
+         *
+         * The tasks may outlive the manager, so they keep the queue alive, and the manager detaches itself from
+         * the queue when it is destroyed.
+         */
+        class EntityModelManager::LoadQueue {
+        public:
+            struct Result {
+                IO::Path path;
+                EntityModel* model;
+                String error;
+            };
+            typedef std::vector<Result> ResultList;
+        private:
+            typedef std::map<IO::Path, float> RequestMap;
+
+            std::mutex m_mutex;
+            std::condition_variable m_idle;
+            const IO::EntityModelLoader* m_loader;
+            RequestMap m_requests;
+            ResultList m_results;
+            size_t m_runningCount;
+
+            // only accessed on the main thread
+            EntityModelManager* m_manager;
+        public:
+            explicit LoadQueue(EntityModelManager* manager) :
+            m_loader(nullptr),
+            m_runningCount(0),
+            m_manager(manager) {}
+
+            ~LoadQueue() {
+                for (const Result& result : m_results)
+                    delete result.model;
+            }
+
+            EntityModelManager* manager() const {
+                return m_manager;
+            }
+
+            void detach() {
+                m_manager = nullptr;
+            }
+
+            /**
+             * Discards all waiting models and loaded models that were not taken yet, and waits for the models that
+             * are currently being loaded. Must be called before the loader is changed or destroyed.
+             */
+            void cancel() {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_requests.clear();
+                m_idle.wait(lock, [this]() { return m_runningCount == 0; });
+
+                for (const Result& result : m_results)
+                    delete result.model;
+                m_results.clear();
+            }
+
+            void setLoader(const IO::EntityModelLoader* loader) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                assert(m_runningCount == 0);
+                m_loader = loader;
+            }
+
+            void request(const IO::Path& path) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_requests.insert(std::make_pair(path, std::numeric_limits<float>::max()));
+            }
+
+            void setPriority(const IO::Path& path, const float priority) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                RequestMap::iterator it = m_requests.find(path);
+                if (it != std::end(m_requests))
+                    it->second = std::min(it->second, priority);
+            }
+
+            /**
+             * Removes the given model from the waiting models. Returns false if the model is not waiting anymore.
+             */
+            bool remove(const IO::Path& path) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_requests.erase(path) > 0;
+            }
+
+            /**
+             * Loads the waiting model with the lowest priority value if there is one. Called by the background tasks.
+             *
+             * @return true if a model was loaded and false otherwise
+             */
+            bool loadNext() {
+                Result result;
+                const IO::EntityModelLoader* loader = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (m_requests.empty())
+                        return false;
+
+                    RequestMap::iterator next = std::begin(m_requests);
+                    for (RequestMap::iterator it = std::next(next); it != std::end(m_requests); ++it) {
+                        if (it->second < next->second)
+                            next = it;
+                    }
+
+                    result.path = next->first;
+                    result.model = nullptr;
+                    loader = m_loader;
+                    m_requests.erase(next);
+                    ++m_runningCount;
+                }
+
+                assert(loader != nullptr);
+                try {
+                    result.model = loader->loadEntityModel(result.path);
+                } catch (const std::exception& e) {
+                    // the tasks must not throw, and an exception must not leave the model waiting forever
+                    result.error = e.what();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_results.push_back(result);
+                    if (--m_runningCount == 0)
+                        m_idle.notify_all();
+                }
+                return true;
+            }
+
+            /**
+             * Returns at most the given number of loaded models in the order in which they finished loading.
+             */
+            ResultList takeResults(const size_t maxCount) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                const size_t count = std::min(maxCount, m_results.size());
+                ResultList results(std::begin(m_results), std::begin(m_results) + static_cast<ResultList::difference_type>(count));
+                m_results.erase(std::begin(m_results), std::begin(m_results) + static_cast<ResultList::difference_type>(count));
+                return results;
+            }
+        };
+
+        const size_t EntityModelManager::ModelUploadBudget;
+
         EntityModelManager::EntityModelManager(Logger* logger, int minFilter, int magFilter) :
+        EntityModelManager(logger, minFilter, magFilter, TaskScheduler::instance()) {}
+
+        EntityModelManager::EntityModelManager(Logger* logger, int minFilter, int magFilter, TaskScheduler& scheduler) :
         m_logger(logger),
         m_loader(nullptr),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_scheduler(scheduler),
+        m_loadQueue(std::make_shared<LoadQueue>(this)),
+        m_generation(0) {}
         
         EntityModelManager::~EntityModelManager() {
             clear();
+            m_loadQueue->detach();
         }
         
         void EntityModelManager::clear() {
+            m_loadQueue->cancel();
+            m_loadingModels.clear();
+
             MapUtils::clearAndDelete(m_renderers);
             MapUtils::clearAndDelete(m_models);
             m_rendererMismatches.clear();
@@ -61,6 +221,7 @@ namespace TrenchBroom {
         void EntityModelManager::setLoader(const IO::EntityModelLoader* loader) {
             clear();
             m_loader = loader;
+            m_loadQueue->setLoader(m_loader);
         }
 
         EntityModel* EntityModelManager::model(const IO::Path& path) const {
@@ -74,6 +235,11 @@ namespace TrenchBroom {
             if (m_modelMismatches.count(path) > 0)
                 return nullptr;
             
+            // if the model is still being loaded in the background, that result is discarded when it arrives
+            m_loadQueue->remove(path);
+            if (m_loadingModels.erase(path) > 0)
+                ++m_generation;
+
             try {
                 EntityModel* model = loadModel(path);
                 ensure(model != nullptr, "model is null");
@@ -99,11 +265,17 @@ namespace TrenchBroom {
         }
         
         Renderer::TexturedIndexRangeRenderer* EntityModelManager::renderer(const Assets::ModelSpecification& spec) const {
-            EntityModel* entityModel = safeGetModel(spec.path);
+            if (spec.path.isEmpty())
+                return nullptr;
 
-            if (entityModel == nullptr)
+            ModelCache::const_iterator modelIt = m_models.find(spec.path);
+            if (modelIt == std::end(m_models)) {
+                if (m_modelMismatches.count(spec.path) == 0)
+                    requestModel(spec.path);
                 return nullptr;
-            
+            }
+
+            EntityModel* entityModel = modelIt->second;
             RendererCache::const_iterator it = m_renderers.find(spec);
             if (it != std::end(m_renderers))
                 return it->second;
@@ -135,13 +307,49 @@ namespace TrenchBroom {
             return renderer(spec) != nullptr;
         }
 
+        bool EntityModelManager::isLoading(const IO::Path& path) const {
+            return m_loadingModels.count(path) > 0;
+        }
+
+        void EntityModelManager::setLoadPriority(const IO::Path& path, const float priority) {
+            if (isLoading(path))
+                m_loadQueue->setPriority(path, priority);
+        }
+
+        size_t EntityModelManager::generation() const {
+            return m_generation;
+        }
+
         EntityModel* EntityModelManager::loadModel(const IO::Path& path) const {
             ensure(m_loader != nullptr, "loader is null");
             return m_loader->loadEntityModel(path);
         }
 
+        void EntityModelManager::requestModel(const IO::Path& path) const {
+            if (m_loader == nullptr || !m_loadingModels.insert(path).second)
+                return;
+
+            m_loadQueue->request(path);
+
+            LoadQueuePtr queue = m_loadQueue;
+            TaskScheduler& scheduler = m_scheduler;
+            m_scheduler.submit([queue, &scheduler]() {
+                if (queue->loadNext())
+                    postModelsDidLoad(scheduler, queue);
+            });
+        }
+
+        void EntityModelManager::postModelsDidLoad(TaskScheduler& scheduler, LoadQueuePtr queue) {
+            scheduler.postToMainThread([queue]() {
+                EntityModelManager* manager = queue->manager();
+                if (manager != nullptr)
+                    manager->modelsDidLoadNotifier();
+            });
+        }
+
         void EntityModelManager::prepare(Renderer::Vbo& vbo) {
             resetTextureMode();
+            addLoadedModels();
             prepareModels();
             prepareRenderers(vbo);
         }
@@ -156,6 +364,35 @@ namespace TrenchBroom {
             }
         }
         
+        void EntityModelManager::addLoadedModels() {
+            const LoadQueue::ResultList results = m_loadQueue->takeResults(ModelUploadBudget);
+            if (results.empty())
+                return;
+
+            for (const LoadQueue::Result& result : results) {
+                if (m_loadingModels.erase(result.path) == 0 || m_models.count(result.path) > 0) {
+                    // the model was loaded synchronously in the meantime
+                    delete result.model;
+                } else if (result.model == nullptr) {
+                    m_modelMismatches.insert(result.path);
+
+                    if (m_logger != nullptr)
+                        m_logger->debug("Failed to load entity model %s: %s", result.path.asString().c_str(), result.error.c_str());
+                } else {
+                    m_models[result.path] = result.model;
+                    m_unpreparedModels.push_back(result.model);
+
+                    if (m_logger != nullptr)
+                        m_logger->debug("Loaded entity model %s", result.path.asString().c_str());
+                }
+            }
+
+            ++m_generation;
+
+            // the renderers only pick up the new models in the next frame, which may also add the remaining models
+            postModelsDidLoad(m_scheduler, m_loadQueue);
+        }
+
         void EntityModelManager::prepareModels() {
             for (Assets::EntityModel* model : m_unpreparedModels)
                 model->prepare(m_minFilter, m_magFilter);
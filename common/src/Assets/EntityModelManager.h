@@ -20,16 +20,19 @@
 #ifndef TrenchBroom_EntityModelManager
 #define TrenchBroom_EntityModelManager
 
+#include "Notifier.h"
 #include "Assets/ModelDefinition.h"
 #include "IO/Path.h"
 #include "Model/ModelTypes.h"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
 namespace TrenchBroom {
     class Logger;
+    class TaskScheduler;
     
     namespace IO {
         class EntityModelLoader;
@@ -43,8 +46,23 @@ namespace TrenchBroom {
     namespace Assets {
         class EntityModel;
         
+        /**
+         * Loads entity models and builds their renderers. Models that are requested through renderer or hasModel are
+         * loaded by background tasks, and these functions return null or false until the model is available. Models
+         * that finished loading are handed over to the renderers in prepare, which uploads at most
+         * ModelUploadBudget of them per call so that a large number of models does not stall a single frame.
+         * Whenever models become available, the generation is incremented and modelsDidLoadNotifier is notified on
+         * the main thread so that the views can render again.
+         *
+         * The function model loads the model synchronously if it is not available yet.
+         */
         class EntityModelManager {
+        public:
+            static const size_t ModelUploadBudget = 8;
         private:
+            class LoadQueue;
+            typedef std::shared_ptr<LoadQueue> LoadQueuePtr;
+
             typedef std::map<IO::Path, EntityModel*> ModelCache;
             typedef std::set<IO::Path> ModelMismatches;
             typedef std::vector<EntityModel*> ModelList;
@@ -67,8 +85,16 @@ namespace TrenchBroom {
 
             mutable ModelList m_unpreparedModels;
             mutable RendererList m_unpreparedRenderers;
+
+            TaskScheduler& m_scheduler;
+            LoadQueuePtr m_loadQueue;
+            mutable std::set<IO::Path> m_loadingModels;
+            mutable size_t m_generation;
+        public:
+            Notifier0 modelsDidLoadNotifier;
         public:
             EntityModelManager(Logger* logger, int minFilter, int magFilter);
+            EntityModelManager(Logger* logger, int minFilter, int magFilter, TaskScheduler& scheduler);
             ~EntityModelManager();
             
             void clear();
@@ -82,12 +108,32 @@ namespace TrenchBroom {
             
             bool hasModel(const Model::Entity* entity) const;
             bool hasModel(const Assets::ModelSpecification& spec) const;
+
+            /**
+             * Indicates whether the model with the given path was requested and is still being loaded.
+             */
+            bool isLoading(const IO::Path& path) const;
+
+            /**
+             * Sets the priority of a model that is still waiting to be loaded. Models with lower values are loaded
+             * first, e.g. the squared distance of the closest entity using the model to the camera. If the model is
+             * requested with several priorities, the lowest one is kept.
+             */
+            void setLoadPriority(const IO::Path& path, float priority);
+
+            /**
+             * Returns a number that changes whenever models that were loaded in the background become available.
+             */
+            size_t generation() const;
         private:
             EntityModel* loadModel(const IO::Path& path) const;
+            void requestModel(const IO::Path& path) const;
+            static void postModelsDidLoad(TaskScheduler& scheduler, LoadQueuePtr queue);
         public:
             void prepare(Renderer::Vbo& vbo);
         private:
             void resetTextureMode();
+            void addLoadedModels();
             void prepareModels();
             void prepareRenderers(Renderer::Vbo& vbo);
         };
@@ -18,11 +18,13 @@
  */
 
 #include "Md2Model.h"
+#include "BatchMath.h"
 #include "CollectionUtils.h"
 #include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "Renderer/VertexArray.h"
 #include "Renderer/IndexRangeMap.h"
+#include "Renderer/IndexRangeMapBuilder.h"
 #include "Renderer/TexturedIndexRangeMap.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
 
@@ -31,21 +33,199 @@
 
 namespace TrenchBroom {
     namespace Assets {
+        const Vec3f Md2Model::Normals[162] = {
+            Vec3f(-0.525731f, 0.000000f, 0.850651f),
+            Vec3f(-0.442863f, 0.238856f, 0.864188f),
+            Vec3f(-0.295242f, 0.000000f, 0.955423f),
+            Vec3f(-0.309017f, 0.500000f, 0.809017f),
+            Vec3f(-0.162460f, 0.262866f, 0.951056f),
+            Vec3f(0.000000f, 0.000000f, 1.000000f),
+            Vec3f(0.000000f, 0.850651f, 0.525731f),
+            Vec3f(-0.147621f, 0.716567f, 0.681718f),
+            Vec3f(0.147621f, 0.716567f, 0.681718f),
+            Vec3f(0.000000f, 0.525731f, 0.850651f),
+            Vec3f(0.309017f, 0.500000f, 0.809017f),
+            Vec3f(0.525731f, 0.000000f, 0.850651f),
+            Vec3f(0.295242f, 0.000000f, 0.955423f),
+            Vec3f(0.442863f, 0.238856f, 0.864188f),
+            Vec3f(0.162460f, 0.262866f, 0.951056f),
+            Vec3f(-0.681718f, 0.147621f, 0.716567f),
+            Vec3f(-0.809017f, 0.309017f, 0.500000f),
+            Vec3f(-0.587785f, 0.425325f, 0.688191f),
+            Vec3f(-0.850651f, 0.525731f, 0.000000f),
+            Vec3f(-0.864188f, 0.442863f, 0.238856f),
+            Vec3f(-0.716567f, 0.681718f, 0.147621f),
+            Vec3f(-0.688191f, 0.587785f, 0.425325f),
+            Vec3f(-0.500000f, 0.809017f, 0.309017f),
+            Vec3f(-0.238856f, 0.864188f, 0.442863f),
+            Vec3f(-0.425325f, 0.688191f, 0.587785f),
+            Vec3f(-0.716567f, 0.681718f, -0.147621f),
+            Vec3f(-0.500000f, 0.809017f, -0.309017f),
+            Vec3f(-0.525731f, 0.850651f, 0.000000f),
+            Vec3f(0.000000f, 0.850651f, -0.525731f),
+            Vec3f(-0.238856f, 0.864188f, -0.442863f),
+            Vec3f(0.000000f, 0.955423f, -0.295242f),
+            Vec3f(-0.262866f, 0.951056f, -0.162460f),
+            Vec3f(0.000000f, 1.000000f, 0.000000f),
+            Vec3f(0.000000f, 0.955423f, 0.295242f),
+            Vec3f(-0.262866f, 0.951056f, 0.162460f),
+            Vec3f(0.238856f, 0.864188f, 0.442863f),
+            Vec3f(0.262866f, 0.951056f, 0.162460f),
+            Vec3f(0.500000f, 0.809017f, 0.309017f),
+            Vec3f(0.238856f, 0.864188f, -0.442863f),
+            Vec3f(0.262866f, 0.951056f, -0.162460f),
+            Vec3f(0.500000f, 0.809017f, -0.309017f),
+            Vec3f(0.850651f, 0.525731f, 0.000000f),
+            Vec3f(0.716567f, 0.681718f, 0.147621f),
+            Vec3f(0.716567f, 0.681718f, -0.147621f),
+            Vec3f(0.525731f, 0.850651f, 0.000000f),
+            Vec3f(0.425325f, 0.688191f, 0.587785f),
+            Vec3f(0.864188f, 0.442863f, 0.238856f),
+            Vec3f(0.688191f, 0.587785f, 0.425325f),
+            Vec3f(0.809017f, 0.309017f, 0.500000f),
+            Vec3f(0.681718f, 0.147621f, 0.716567f),
+            Vec3f(0.587785f, 0.425325f, 0.688191f),
+            Vec3f(0.955423f, 0.295242f, 0.000000f),
+            Vec3f(1.000000f, 0.000000f, 0.000000f),
+            Vec3f(0.951056f, 0.162460f, 0.262866f),
+            Vec3f(0.850651f, -0.525731f, 0.000000f),
+            Vec3f(0.955423f, -0.295242f, 0.000000f),
+            Vec3f(0.864188f, -0.442863f, 0.238856f),
+            Vec3f(0.951056f, -0.162460f, 0.262866f),
+            Vec3f(0.809017f, -0.309017f, 0.500000f),
+            Vec3f(0.681718f, -0.147621f, 0.716567f),
+            Vec3f(0.850651f, 0.000000f, 0.525731f),
+            Vec3f(0.864188f, 0.442863f, -0.238856f),
+            Vec3f(0.809017f, 0.309017f, -0.500000f),
+            Vec3f(0.951056f, 0.162460f, -0.262866f),
+            Vec3f(0.525731f, 0.000000f, -0.850651f),
+            Vec3f(0.681718f, 0.147621f, -0.716567f),
+            Vec3f(0.681718f, -0.147621f, -0.716567f),
+            Vec3f(0.850651f, 0.000000f, -0.525731f),
+            Vec3f(0.809017f, -0.309017f, -0.500000f),
+            Vec3f(0.864188f, -0.442863f, -0.238856f),
+            Vec3f(0.951056f, -0.162460f, -0.262866f),
+            Vec3f(0.147621f, 0.716567f, -0.681718f),
+            Vec3f(0.309017f, 0.500000f, -0.809017f),
+            Vec3f(0.425325f, 0.688191f, -0.587785f),
+            Vec3f(0.442863f, 0.238856f, -0.864188f),
+            Vec3f(0.587785f, 0.425325f, -0.688191f),
+            Vec3f(0.688191f, 0.587785f, -0.425325f),
+            Vec3f(-0.147621f, 0.716567f, -0.681718f),
+            Vec3f(-0.309017f, 0.500000f, -0.809017f),
+            Vec3f(0.000000f, 0.525731f, -0.850651f),
+            Vec3f(-0.525731f, 0.000000f, -0.850651f),
+            Vec3f(-0.442863f, 0.238856f, -0.864188f),
+            Vec3f(-0.295242f, 0.000000f, -0.955423f),
+            Vec3f(-0.162460f, 0.262866f, -0.951056f),
+            Vec3f(0.000000f, 0.000000f, -1.000000f),
+            Vec3f(0.295242f, 0.000000f, -0.955423f),
+            Vec3f(0.162460f, 0.262866f, -0.951056f),
+            Vec3f(-0.442863f, -0.238856f, -0.864188f),
+            Vec3f(-0.309017f, -0.500000f, -0.809017f),
+            Vec3f(-0.162460f, -0.262866f, -0.951056f),
+            Vec3f(0.000000f, -0.850651f, -0.525731f),
+            Vec3f(-0.147621f, -0.716567f, -0.681718f),
+            Vec3f(0.147621f, -0.716567f, -0.681718f),
+            Vec3f(0.000000f, -0.525731f, -0.850651f),
+            Vec3f(0.309017f, -0.500000f, -0.809017f),
+            Vec3f(0.442863f, -0.238856f, -0.864188f),
+            Vec3f(0.162460f, -0.262866f, -0.951056f),
+            Vec3f(0.238856f, -0.864188f, -0.442863f),
+            Vec3f(0.500000f, -0.809017f, -0.309017f),
+            Vec3f(0.425325f, -0.688191f, -0.587785f),
+            Vec3f(0.716567f, -0.681718f, -0.147621f),
+            Vec3f(0.688191f, -0.587785f, -0.425325f),
+            Vec3f(0.587785f, -0.425325f, -0.688191f),
+            Vec3f(0.000000f, -0.955423f, -0.295242f),
+            Vec3f(0.000000f, -1.000000f, 0.000000f),
+            Vec3f(0.262866f, -0.951056f, -0.162460f),
+            Vec3f(0.000000f, -0.850651f, 0.525731f),
+            Vec3f(0.000000f, -0.955423f, 0.295242f),
+            Vec3f(0.238856f, -0.864188f, 0.442863f),
+            Vec3f(0.262866f, -0.951056f, 0.162460f),
+            Vec3f(0.500000f, -0.809017f, 0.309017f),
+            Vec3f(0.716567f, -0.681718f, 0.147621f),
+            Vec3f(0.525731f, -0.850651f, 0.000000f),
+            Vec3f(-0.238856f, -0.864188f, -0.442863f),
+            Vec3f(-0.500000f, -0.809017f, -0.309017f),
+            Vec3f(-0.262866f, -0.951056f, -0.162460f),
+            Vec3f(-0.850651f, -0.525731f, 0.000000f),
+            Vec3f(-0.716567f, -0.681718f, -0.147621f),
+            Vec3f(-0.716567f, -0.681718f, 0.147621f),
+            Vec3f(-0.525731f, -0.850651f, 0.000000f),
+            Vec3f(-0.500000f, -0.809017f, 0.309017f),
+            Vec3f(-0.238856f, -0.864188f, 0.442863f),
+            Vec3f(-0.262866f, -0.951056f, 0.162460f),
+            Vec3f(-0.864188f, -0.442863f, 0.238856f),
+            Vec3f(-0.809017f, -0.309017f, 0.500000f),
+            Vec3f(-0.688191f, -0.587785f, 0.425325f),
+            Vec3f(-0.681718f, -0.147621f, 0.716567f),
+            Vec3f(-0.442863f, -0.238856f, 0.864188f),
+            Vec3f(-0.587785f, -0.425325f, 0.688191f),
+            Vec3f(-0.309017f, -0.500000f, 0.809017f),
+            Vec3f(-0.147621f, -0.716567f, 0.681718f),
+            Vec3f(-0.425325f, -0.688191f, 0.587785f),
+            Vec3f(-0.162460f, -0.262866f, 0.951056f),
+            Vec3f(0.442863f, -0.238856f, 0.864188f),
+            Vec3f(0.162460f, -0.262866f, 0.951056f),
+            Vec3f(0.309017f, -0.500000f, 0.809017f),
+            Vec3f(0.147621f, -0.716567f, 0.681718f),
+            Vec3f(0.000000f, -0.525731f, 0.850651f),
+            Vec3f(0.425325f, -0.688191f, 0.587785f),
+            Vec3f(0.587785f, -0.425325f, 0.688191f),
+            Vec3f(0.688191f, -0.587785f, 0.425325f),
+            Vec3f(-0.955423f, 0.295242f, 0.000000f),
+            Vec3f(-0.951056f, 0.162460f, 0.262866f),
+            Vec3f(-1.000000f, 0.000000f, 0.000000f),
+            Vec3f(-0.850651f, 0.000000f, 0.525731f),
+            Vec3f(-0.955423f, -0.295242f, 0.000000f),
+            Vec3f(-0.951056f, -0.162460f, 0.262866f),
+            Vec3f(-0.864188f, 0.442863f, -0.238856f),
+            Vec3f(-0.951056f, 0.162460f, -0.262866f),
+            Vec3f(-0.809017f, 0.309017f, -0.500000f),
+            Vec3f(-0.864188f, -0.442863f, -0.238856f),
+            Vec3f(-0.951056f, -0.162460f, -0.262866f),
+            Vec3f(-0.809017f, -0.309017f, -0.500000f),
+            Vec3f(-0.681718f, 0.147621f, -0.716567f),
+            Vec3f(-0.681718f, -0.147621f, -0.716567f),
+            Vec3f(-0.850651f, 0.000000f, -0.525731f),
+            Vec3f(-0.688191f, 0.587785f, -0.425325f),
+            Vec3f(-0.587785f, 0.425325f, -0.688191f),
+            Vec3f(-0.425325f, 0.688191f, -0.587785f),
+            Vec3f(-0.425325f, -0.688191f, -0.587785f),
+            Vec3f(-0.587785f, -0.425325f, -0.688191f),
+            Vec3f(-0.688191f, -0.587785f, -0.425325f)
+        };
+
+        Md2Model::PackedFrame::PackedFrame(const size_t vertexCount) :
+        vertices(vertexCount) {}
+
+        Vec3f Md2Model::PackedFrame::vertex(const size_t index) const {
+            const PackedVertex& vertex = vertices[index];
+            const Vec3f position(static_cast<float>(vertex.x),
+                                 static_cast<float>(vertex.y),
+                                 static_cast<float>(vertex.z));
+            return position * scale + offset;
+        }
+
+        const Vec3f& Md2Model::PackedFrame::normal(const size_t index) const {
+            const PackedVertex& vertex = vertices[index];
+            return Normals[vertex.normalIndex];
+        }
+
+        Md2Model::Mesh::Mesh(const int i_vertexCount) :
+        type(i_vertexCount < 0 ? Fan : Strip),
+        vertexCount(static_cast<size_t>(i_vertexCount < 0 ? -i_vertexCount : i_vertexCount)),
+        vertices(vertexCount) {}
+
         Md2Model::Frame::Frame(const VertexList& vertices, const Renderer::IndexRangeMap& indices) :
         m_vertices(vertices),
         m_indices(indices),
-        m_bounds(std::begin(m_vertices), std::end(m_vertices), Renderer::GetVertexComponent1()) {}
+        m_bounds(BatchMath::boundsOfPoints(&m_vertices.front().v1, m_vertices.size(), sizeof(Vertex))) {}
 
         BBox3f Md2Model::Frame::transformedBounds(const Mat4x4f& transformation) const {
-            BBox3f transformedBounds;
-            
-            VertexList::const_iterator it = std::begin(m_vertices);
-            VertexList::const_iterator end = std::end(m_vertices);
-            
-            transformedBounds.min = transformedBounds.max = transformation * it->v1;
-            while (++it != end)
-                transformedBounds.mergeWith(transformation * it->v1);
-            return transformedBounds;
+            return BatchMath::transformedBounds(transformation, &m_vertices.front().v1, m_vertices.size(), sizeof(Vertex));
         }
 
         const Md2Model::VertexList& Md2Model::Frame::vertices() const {
@@ -60,10 +240,12 @@ namespace TrenchBroom {
             return m_bounds;
         }
 
-        Md2Model::Md2Model(const String& name, const TextureList& skins, const FrameList& frames) :
+        Md2Model::Md2Model(const String& name, const TextureList& skins, const PackedFrameList& frames, const MeshList& meshes) :
         m_name(name),
         m_skins(new TextureCollection(IO::Path(name), skins)),
-        m_frames(frames) {}
+        m_packedFrames(frames),
+        m_meshes(meshes),
+        m_frames(m_packedFrames.size(), nullptr) {}
         
         Md2Model::~Md2Model() {
             VectorUtils::clearAndDelete(m_frames);
@@ -71,14 +253,69 @@ namespace TrenchBroom {
             m_skins = nullptr;
         }
 
+        size_t Md2Model::frameCount() const {
+            return m_packedFrames.size();
+        }
+
+        size_t Md2Model::builtFrameCount() const {
+            return static_cast<size_t>(std::count_if(std::begin(m_frames), std::end(m_frames), [](const Frame* frame) { return frame != nullptr; }));
+        }
+
+        const Md2Model::Frame* Md2Model::frame(const size_t frameIndex) const {
+            ensure(frameIndex < m_frames.size(), "frame index out of range");
+
+            Frame*& frame = m_frames[frameIndex];
+            if (frame == nullptr)
+                frame = buildFrame(m_packedFrames[frameIndex]);
+            return frame;
+        }
+
+        Md2Model::Frame* Md2Model::buildFrame(const PackedFrame& packedFrame) const {
+            size_t vertexCount = 0;
+            Renderer::IndexRangeMap::Size size;
+            for (const Mesh& mesh : m_meshes) {
+                vertexCount += mesh.vertices.size();
+                if (mesh.type == Mesh::Fan)
+                    size.inc(GL_TRIANGLE_FAN);
+                else
+                    size.inc(GL_TRIANGLE_STRIP);
+            }
+
+            Renderer::IndexRangeMapBuilder<VertexSpec> builder(vertexCount, size);
+            for (const Mesh& mesh : m_meshes) {
+                if (!mesh.vertices.empty()) {
+                    if (mesh.type == Mesh::Fan)
+                        builder.addTriangleFan(getVertices(packedFrame, mesh.vertices));
+                    else
+                        builder.addTriangleStrip(getVertices(packedFrame, mesh.vertices));
+                }
+            }
+
+            return new Frame(builder.vertices(), builder.indexArray());
+        }
+
+        Md2Model::VertexList Md2Model::getVertices(const PackedFrame& packedFrame, const MeshVertexList& meshVertices) const {
+            VertexList result(0);
+            result.reserve(meshVertices.size());
+
+            for (const MeshVertex& meshVertex : meshVertices) {
+                const Vec3f position = packedFrame.vertex(meshVertex.vertexIndex);
+                const Vec3f& normal = packedFrame.normal(meshVertex.vertexIndex);
+                const Vec2f& texCoords = meshVertex.texCoords;
+
+                result.push_back(Vertex(position, normal, texCoords));
+            }
+
+            return result;
+        }
+
         Renderer::TexturedIndexRangeRenderer* Md2Model::doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const {
             const TextureList& textures = m_skins->textures();
             
             ensure(skinIndex < textures.size(), "skin index out of range");
-            ensure(frameIndex < m_frames.size(), "frame index out of range");
 
             const Assets::Texture* skin = textures[skinIndex];
-            const Frame* frame = m_frames[frameIndex];
+            const Frame* frame = this->frame(frameIndex);
             
             const VertexList& vertices = frame->vertices();
             const Renderer::IndexRangeMap& indices = frame->indices();
@@ -91,18 +328,12 @@ namespace TrenchBroom {
         
         BBox3f Md2Model::doGetBounds(const size_t skinIndex, const size_t frameIndex) const {
             ensure(skinIndex < m_skins->textures().size(), "skin index out of range");
-            ensure(frameIndex < m_frames.size(), "frame index out of range");
-            
-            const Frame* frame = m_frames[frameIndex];
-            return frame->bounds();
+            return frame(frameIndex)->bounds();
         }
         
         BBox3f Md2Model::doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const {
             ensure(skinIndex < m_skins->textures().size(), "skin index out of range");
-            ensure(frameIndex < m_frames.size(), "frame index out of range");
-            
-            const Frame* frame = m_frames[frameIndex];
-            return frame->transformedBounds(transformation);
+            return frame(frameIndex)->transformedBounds(transformation);
         }
 
         void Md2Model::doPrepare(const int minFilter, const int magFilter) {
@@ -33,12 +33,54 @@ namespace TrenchBroom {
     namespace Assets {
         class TextureCollection;
         
+        /**
+         * An MD2 model keeps the frames in the packed form in which they are stored in the model file, which is much
+         * smaller than the vertices that are needed for rendering. A frame's vertices are built when the frame is
+         * rendered or its bounds are requested for the first time, and only such frames are kept in the built form.
+         */
         class Md2Model : public EntityModel {
         public:
             typedef Renderer::VertexSpecs::P3NT2 VertexSpec;
             typedef VertexSpec::Vertex Vertex;
             typedef Vertex::List VertexList;
-            
+
+            struct PackedVertex {
+                unsigned char x, y, z;
+                unsigned char normalIndex;
+            };
+            typedef std::vector<PackedVertex> PackedVertexList;
+
+            struct PackedFrame {
+                Vec3f scale;
+                Vec3f offset;
+                PackedVertexList vertices;
+
+                PackedFrame(size_t vertexCount);
+                Vec3f vertex(size_t index) const;
+                const Vec3f& normal(size_t index) const;
+            };
+            typedef std::vector<PackedFrame> PackedFrameList;
+
+            struct MeshVertex {
+                Vec2f texCoords;
+                size_t vertexIndex;
+            };
+            typedef std::vector<MeshVertex> MeshVertexList;
+
+            struct Mesh {
+                enum Type {
+                    Fan,
+                    Strip
+                };
+
+                Type type;
+                size_t vertexCount;
+                MeshVertexList vertices;
+
+                Mesh(int i_vertexCount);
+            };
+            typedef std::vector<Mesh> MeshList;
+
             class Frame {
             private:
                 VertexList m_vertices;
@@ -55,13 +97,24 @@ namespace TrenchBroom {
 
             typedef std::vector<Frame*> FrameList;
         private:
+            static const Vec3f Normals[162];
+
             String m_name;
             TextureCollection* m_skins;
-            FrameList m_frames;
+            PackedFrameList m_packedFrames;
+            MeshList m_meshes;
+            mutable FrameList m_frames;
         public:
-            Md2Model(const String& name, const TextureList& skins, const FrameList& frames);
+            Md2Model(const String& name, const TextureList& skins, const PackedFrameList& frames, const MeshList& meshes);
             ~Md2Model() override;
+
+            size_t frameCount() const;
+            size_t builtFrameCount() const;
         private:
+            const Frame* frame(size_t frameIndex) const;
+            Frame* buildFrame(const PackedFrame& packedFrame) const;
+            VertexList getVertices(const PackedFrame& packedFrame, const MeshVertexList& meshVertices) const;
+
             Renderer::TexturedIndexRangeRenderer* doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const override;
             BBox3f doGetBounds(const size_t skinIndex, const size_t frameIndex) const override;
             BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const override;
@@ -19,6 +19,7 @@
 
 #include "MdlModel.h"
 
+#include "BatchMath.h"
 #include "CollectionUtils.h"
 #include "Assets/Texture.h"
 #include "Assets/Texture.h"
@@ -55,40 +56,90 @@ namespace TrenchBroom {
 
         MdlBaseFrame::~MdlBaseFrame() {}
 
-        MdlFrame::MdlFrame(const String& name, const VertexList& triangles, const BBox3f& bounds) :
+        MdlMesh::MdlMesh(const SkinVertexList& skinVertices, const SkinTriangleList& skinTriangles, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale) :
+        m_skinVertices(skinVertices),
+        m_skinTriangles(skinTriangles),
+        m_skinWidth(skinWidth),
+        m_skinHeight(skinHeight),
+        m_origin(origin),
+        m_scale(scale) {}
+
+        const MdlMesh::SkinVertexList& MdlMesh::skinVertices() const {
+            return m_skinVertices;
+        }
+
+        const MdlMesh::SkinTriangleList& MdlMesh::skinTriangles() const {
+            return m_skinTriangles;
+        }
+
+        Vec2f MdlMesh::texCoords(const SkinTriangle& triangle, const size_t vertexIndex) const {
+            const SkinVertex& skinVertex = m_skinVertices[vertexIndex];
+            Vec2f texCoords(static_cast<float>(skinVertex.s) / static_cast<float>(m_skinWidth),
+                            static_cast<float>(skinVertex.t) / static_cast<float>(m_skinHeight));
+            if (skinVertex.onseam && !triangle.front)
+                texCoords[0] += 0.5f;
+            return texCoords;
+        }
+
+        Vec3f MdlMesh::unpackVertex(const PackedVertex& vertex) const {
+            Vec3f result;
+            for (size_t i = 0; i < 3; ++i)
+                result[i] = m_origin[i] + m_scale[i]*static_cast<float>(vertex[i]);
+            return result;
+        }
+
+        MdlFrame::MdlFrame(const String& name, MdlMeshPtr mesh, const MdlMesh::PackedVertexList& packedVertices) :
         m_name(name),
-        m_triangles(triangles),
-        m_bounds(bounds) {}
+        m_mesh(mesh),
+        m_packedVertices(packedVertices),
+        m_built(false) {
+            if (m_packedVertices.empty()) {
+                m_bounds = BBox3f(-8.0f, 8.0f);
+            } else {
+                m_bounds.min = m_bounds.max = m_mesh->unpackVertex(m_packedVertices[0]);
+                for (size_t i = 1; i < m_packedVertices.size(); ++i)
+                    m_bounds.mergeWith(m_mesh->unpackVertex(m_packedVertices[i]));
+            }
+        }
         
         const MdlFrame* MdlFrame::firstFrame() const {
             return this;
         }
 
         const MdlFrame::VertexList& MdlFrame::triangles() const {
+            if (!m_built)
+                buildTriangles();
             return m_triangles;
         }
 
+        bool MdlFrame::built() const {
+            return m_built;
+        }
+
         BBox3f MdlFrame::bounds() const {
             return m_bounds;
         }
 
         BBox3f MdlFrame::transformedBounds(const Mat4x4f& transformation) const {
-            if (m_triangles.empty())
+            const VertexList& triangles = this->triangles();
+            if (triangles.empty())
                 return BBox3f(-8.0f, 8.0f);
-            
-            VertexList::const_iterator it = std::begin(m_triangles);
-            VertexList::const_iterator end = std::end(m_triangles);
-            
-            BBox3f bounds;
-            bounds.min = bounds.max = transformation * it->v1;
-            ++it;
-            
-            while (it != end) {
-                bounds.mergeWith(transformation * it->v1);
-                ++it;
+            return BatchMath::transformedBounds(transformation, &triangles.front().v1, triangles.size(), sizeof(Vertex));
+        }
+
+        void MdlFrame::buildTriangles() const {
+            const MdlMesh::SkinTriangleList& skinTriangles = m_mesh->skinTriangles();
+
+            m_triangles.clear();
+            m_triangles.reserve(3 * skinTriangles.size());
+            for (const MdlMesh::SkinTriangle& triangle : skinTriangles) {
+                for (size_t j = 0; j < 3; ++j) {
+                    const size_t vertexIndex = triangle.vertices[j];
+                    const Vec3f position = m_mesh->unpackVertex(m_packedVertices[vertexIndex]);
+                    m_triangles.push_back(Vertex(position, m_mesh->texCoords(triangle, vertexIndex)));
+                }
             }
-            
-            return bounds;
+            m_built = true;
         }
 
         MdlFrameGroup::~MdlFrameGroup() {
@@ -122,6 +173,21 @@ namespace TrenchBroom {
             m_frames.push_back(frame);
         }
 
+        size_t MdlModel::frameCount() const {
+            return m_frames.size();
+        }
+
+        size_t MdlModel::builtFrameCount() const {
+            // only the first frame of a frame group is ever rendered
+            size_t count = 0;
+            for (const MdlBaseFrame* frame : m_frames) {
+                const MdlFrame* firstFrame = frame->firstFrame();
+                if (firstFrame != nullptr && firstFrame->built())
+                    ++count;
+            }
+            return count;
+        }
+
         Renderer::TexturedIndexRangeRenderer* MdlModel::doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const {
             if (skinIndex >= m_skins.size())
                 return nullptr;
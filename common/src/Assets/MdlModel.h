@@ -29,6 +29,7 @@
 #include "Renderer/Vertex.h"
 #include "Renderer/IndexRangeMap.h"
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -50,26 +51,75 @@ namespace TrenchBroom {
 
         class MdlFrame;
         
+        /**
+         * The skin vertices and triangles that are shared by all frames of a model, and the scale and origin that
+         * unpack the vertex positions of the frames.
+         */
+        class MdlMesh {
+        public:
+            typedef Vec<unsigned char, 4> PackedVertex;
+            typedef std::vector<PackedVertex> PackedVertexList;
+
+            struct SkinVertex {
+                bool onseam;
+                int s;
+                int t;
+            };
+            typedef std::vector<SkinVertex> SkinVertexList;
+
+            struct SkinTriangle {
+                bool front;
+                size_t vertices[3];
+            };
+            typedef std::vector<SkinTriangle> SkinTriangleList;
+        private:
+            SkinVertexList m_skinVertices;
+            SkinTriangleList m_skinTriangles;
+            size_t m_skinWidth;
+            size_t m_skinHeight;
+            Vec3f m_origin;
+            Vec3f m_scale;
+        public:
+            MdlMesh(const SkinVertexList& skinVertices, const SkinTriangleList& skinTriangles, size_t skinWidth, size_t skinHeight, const Vec3f& origin, const Vec3f& scale);
+
+            const SkinVertexList& skinVertices() const;
+            const SkinTriangleList& skinTriangles() const;
+            Vec2f texCoords(const SkinTriangle& triangle, size_t vertexIndex) const;
+            Vec3f unpackVertex(const PackedVertex& vertex) const;
+        };
+
+        typedef std::shared_ptr<const MdlMesh> MdlMeshPtr;
+
         class MdlBaseFrame {
         public:
             virtual ~MdlBaseFrame();
             virtual const MdlFrame* firstFrame() const = 0;
         };
         
+        /**
+         * A frame keeps the packed vertex positions from the model file and builds its triangles when they are
+         * needed for the first time, so that the frames which are never rendered do not take up memory.
+         */
         class MdlFrame : public MdlBaseFrame {
         public:
             typedef Renderer::VertexSpecs::P3T2::Vertex Vertex;
             typedef Vertex::List VertexList;
         private:
             String m_name;
-            VertexList m_triangles;
+            MdlMeshPtr m_mesh;
+            MdlMesh::PackedVertexList m_packedVertices;
             BBox3f m_bounds;
+            mutable VertexList m_triangles;
+            mutable bool m_built;
         public:
-            MdlFrame(const String& name, const VertexList& triangles, const BBox3f& bounds);
+            MdlFrame(const String& name, MdlMeshPtr mesh, const MdlMesh::PackedVertexList& packedVertices);
             const MdlFrame* firstFrame() const override;
             const VertexList& triangles() const;
+            bool built() const;
             BBox3f bounds() const;
             BBox3f transformedBounds(const Mat4x4f& transformation) const;
+        private:
+            void buildTriangles() const;
         };
         
         class MdlFrameGroup : public MdlBaseFrame {
@@ -98,6 +148,9 @@ namespace TrenchBroom {
             
             void addSkin(MdlSkin* skin);
             void addFrame(MdlBaseFrame* frame);
+
+            size_t frameCount() const;
+            size_t builtFrameCount() const;
         private:
             Renderer::TexturedIndexRangeRenderer* doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const override;
             BBox3f doGetBounds(const size_t skinIndex, const size_t frameIndex) const override;
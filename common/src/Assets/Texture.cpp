@@ -58,7 +58,9 @@ namespace TrenchBroom {
         m_overridden(false),
         m_format(format),
         m_type(type),
-        m_textureId(0) {
+        m_textureId(0),
+        m_array(nullptr),
+        m_arrayLayer(0) {
             assert(m_width > 0);
             assert(m_height > 0);
             assert(buffer.size() >= m_width * m_height * bytesPerPixelForFormat(format));
@@ -76,7 +78,9 @@ namespace TrenchBroom {
         m_format(format),
         m_type(type),
         m_textureId(0),
-        m_buffers(buffers) {
+        m_buffers(buffers),
+        m_array(nullptr),
+        m_arrayLayer(0) {
             assert(m_width > 0);
             assert(m_height > 0);
             for (size_t i = 0; i < m_buffers.size(); ++i) {
@@ -94,7 +98,9 @@ namespace TrenchBroom {
         m_overridden(false),
         m_format(format),
         m_type(type),
-        m_textureId(0) {}
+        m_textureId(0),
+        m_array(nullptr),
+        m_arrayLayer(0) {}
 
         Texture::~Texture() {
             if (m_collection == nullptr && m_textureId != 0)
@@ -135,6 +141,10 @@ namespace TrenchBroom {
                 m_collection->decUsageCount();
         }
         
+        const std::vector<Model::BrushFace*>& Texture::faces() const {
+            return m_faces;
+        }
+
         bool Texture::overridden() const {
             return m_overridden;
         }
@@ -218,8 +228,21 @@ namespace TrenchBroom {
             glAssert(glBindTexture(GL_TEXTURE_2D, 0));
         }
 
+        const TextureArray* Texture::array() const {
+            return m_array;
+        }
+
+        size_t Texture::arrayLayer() const {
+            return m_arrayLayer;
+        }
+
         void Texture::setCollection(TextureCollection* collection) {
             m_collection = collection;
         }
+
+        void Texture::setArray(const TextureArray* array, const size_t arrayLayer) {
+            m_array = array;
+            m_arrayLayer = arrayLayer;
+        }
     }
 }
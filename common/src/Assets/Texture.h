@@ -29,7 +29,12 @@
 #include <vector>
 
 namespace TrenchBroom {
+    namespace Model {
+        class BrushFace;
+    }
+    
     namespace Assets {
+        class TextureArray;
         class TextureCollection;
         
         typedef Buffer<unsigned char> TextureBuffer;
@@ -53,11 +58,17 @@ namespace TrenchBroom {
             size_t m_usageCount;
             bool m_overridden;
 
+            // maintained by the faces themselves, every face knows its index in this list
+            std::vector<Model::BrushFace*> m_faces;
+
             GLenum m_format;
             TextureType m_type;
 
             mutable GLuint m_textureId;
             mutable TextureBuffer::List m_buffers;
+
+            const TextureArray* m_array;
+            size_t m_arrayLayer;
         public:
             Texture(const String& name, size_t width, size_t height, const Color& averageColor, const TextureBuffer& buffer, GLenum format, TextureType type);
             Texture(const String& name, size_t width, size_t height, const Color& averageColor, const TextureBuffer::List& buffers, GLenum format, TextureType type);
@@ -76,15 +87,36 @@ namespace TrenchBroom {
             bool overridden() const;
             void setOverridden(const bool overridden);
 
+            /**
+             * Returns the faces that use this texture, in no particular order. This includes faces of brushes that
+             * are not part of a map, such as copies that are being edited by a tool, but the faces of brushes that
+             * are removed from a map release their textures.
+             */
+            const std::vector<Model::BrushFace*>& faces() const;
+
             bool isPrepared() const;
             void prepare(GLuint textureId, int minFilter, int magFilter);
             void setMode(int minFilter, int magFilter);
 
             void activate() const;
             void deactivate() const;
+
+            /**
+             * Returns the array texture that holds a copy of this texture's image data, or null if this texture is
+             * not part of an array texture. Renderers can batch all faces whose textures share an array texture.
+             */
+            const TextureArray* array() const;
+            /**
+             * The index of the layer of this texture's array texture that holds this texture's image data. Only
+             * meaningful if array() is not null.
+             */
+            size_t arrayLayer() const;
         private:
             void setCollection(TextureCollection* collection);
+            void setArray(const TextureArray* array, size_t arrayLayer);
+            friend class TextureArray;
             friend class TextureCollection;
+            friend class Model::BrushFace;
         };
     }
 }
@@ -0,0 +1,183 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureArray.h"
+
+#include "Assets/Texture.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TextureArray::TextureArray(const TextureList& textures) :
+        m_width(0),
+        m_height(0),
+        m_textures(textures),
+        m_textureId(0) {
+            assert(m_textures.size() > 1);
+
+            const Texture* first = m_textures.front();
+            m_width = first->width();
+            m_height = first->height();
+
+            for (size_t i = 0; i < m_textures.size(); ++i) {
+                Texture* texture = m_textures[i];
+                assert(!texture->isPrepared());
+                assert(texture->width() == m_width);
+                assert(texture->height() == m_height);
+                assert(texture->m_format == first->m_format);
+                assert(texture->m_buffers.size() == first->m_buffers.size());
+                texture->setArray(this, i);
+            }
+        }
+
+        TextureArray::~TextureArray() {
+            for (Texture* texture : m_textures) {
+                if (texture->array() == this)
+                    texture->setArray(nullptr, 0);
+            }
+
+            if (m_textureId != 0) {
+                glAssert(glDeleteTextures(1, &m_textureId));
+                m_textureId = 0;
+            }
+        }
+
+        size_t TextureArray::width() const {
+            return m_width;
+        }
+
+        size_t TextureArray::height() const {
+            return m_height;
+        }
+
+        size_t TextureArray::layerCount() const {
+            return m_textures.size();
+        }
+
+        bool TextureArray::isPrepared() const {
+            return m_textureId != 0;
+        }
+
+        void TextureArray::prepare(const int minFilter, const int magFilter) {
+            assert(!isPrepared());
+
+            const Texture* first = m_textures.front();
+            const GLenum format = first->m_format;
+            const size_t bytesPerPixel = bytesPerPixelForFormat(format);
+
+            // same rule as in Texture::prepare
+            const bool generateMipmaps = (first->m_type == TextureType::Masked) || (first->m_buffers.size() == 1);
+            const size_t mipmapsToUpload = generateMipmaps ? 1u : first->m_buffers.size();
+
+            glAssert(glGenTextures(1, &m_textureId));
+
+            glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
+            glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
+            glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+            glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureId));
+            glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, minFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, magFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT));
+            glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT));
+            if (!generateMipmaps)
+                glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipmapsToUpload - 1)));
+
+            size_t mipWidth = m_width;
+            size_t mipHeight = m_height;
+
+            // the layers of one mip level must be contiguous in memory, so we copy them into a staging buffer
+            std::vector<unsigned char> levelData;
+            for (size_t j = 0; j < mipmapsToUpload; ++j) {
+                const size_t layerSize = bytesPerPixel * mipWidth * mipHeight;
+                levelData.resize(layerSize * m_textures.size());
+
+                for (size_t i = 0; i < m_textures.size(); ++i) {
+                    const TextureBuffer& buffer = m_textures[i]->m_buffers[j];
+                    assert(buffer.size() >= layerSize);
+                    std::memcpy(levelData.data() + i * layerSize, buffer.ptr(), layerSize);
+                }
+
+                glAssert(glTexImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(j), GL_RGBA,
+                                      static_cast<GLsizei>(mipWidth),
+                                      static_cast<GLsizei>(mipHeight),
+                                      static_cast<GLsizei>(m_textures.size()),
+                                      0, format, GL_UNSIGNED_BYTE, levelData.data()));
+                mipWidth  /= 2;
+                mipHeight /= 2;
+            }
+
+            if (generateMipmaps)
+                glAssert(glGenerateMipmap(GL_TEXTURE_2D_ARRAY));
+
+            glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+        }
+
+        void TextureArray::setMode(const int minFilter, const int magFilter) {
+            activate();
+            glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, minFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, magFilter));
+            deactivate();
+        }
+
+        void TextureArray::activate() const {
+            assert(isPrepared());
+            glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureId));
+        }
+
+        void TextureArray::deactivate() const {
+            glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+        }
+
+        TextureArrayList TextureArray::createTextureArrays(const TextureList& textures, const size_t maxLayers) {
+            using Key = std::tuple<size_t, size_t, GLenum, TextureType, size_t>;
+            std::map<Key, TextureList> groups;
+
+            for (Texture* texture : textures) {
+                // textures without image data (e.g. placeholders) cannot be uploaded
+                if (texture->m_buffers.empty() || texture->isPrepared() || texture->array() != nullptr)
+                    continue;
+
+                const Key key(texture->width(), texture->height(), texture->m_format, texture->m_type, texture->m_buffers.size());
+                groups[key].push_back(texture);
+            }
+
+            TextureArrayList result;
+            for (const auto& entry : groups) {
+                const TextureList& group = entry.second;
+                for (size_t first = 0; first < group.size(); first += maxLayers) {
+                    const size_t last = std::min(first + maxLayers, group.size());
+                    if (last - first > 1) {
+                        const TextureList layers(std::begin(group) + static_cast<long>(first), std::begin(group) + static_cast<long>(last));
+                        result.push_back(new TextureArray(layers));
+                    }
+                }
+            }
+            return result;
+        }
+    }
+}
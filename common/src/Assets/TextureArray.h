@@ -0,0 +1,75 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_TextureArray
+#define TrenchBroom_TextureArray
+
+#include "Assets/AssetTypes.h"
+#include "Renderer/GL.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        /**
+         * A GL array texture that holds the image data of several textures of the same size and format, one texture
+         * per layer. Faces whose textures share an array texture can be rendered with a single draw call by passing
+         * the layer index as the third texture coordinate.
+         *
+         * Array textures are used instead of atlases because each layer keeps its own wrap mode, so repeating
+         * textures work without any changes to the texture coordinates.
+         */
+        class TextureArray {
+        private:
+            size_t m_width;
+            size_t m_height;
+            TextureList m_textures;
+
+            GLuint m_textureId;
+        public:
+            /**
+             * Creates an array texture for the given textures and assigns the array layers to them. All textures
+             * must have the same size, format and number of mip levels, and they must not be prepared yet.
+             */
+            explicit TextureArray(const TextureList& textures);
+            ~TextureArray();
+
+            size_t width() const;
+            size_t height() const;
+            size_t layerCount() const;
+
+            bool isPrepared() const;
+            void prepare(int minFilter, int magFilter);
+            void setMode(int minFilter, int magFilter);
+
+            void activate() const;
+            void deactivate() const;
+
+            /**
+             * Groups the given textures by size and format and creates an array texture for every group that
+             * contains at least two textures. Textures that cannot share an array texture with another texture are
+             * left alone. Groups that exceed the given maximum number of layers are split.
+             */
+            static TextureArrayList createTextureArrays(const TextureList& textures, size_t maxLayers);
+        private:
+            TextureArray(const TextureArray& other);
+            TextureArray& operator=(const TextureArray& other);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureArray) */
@@ -21,6 +21,7 @@
 
 #include "CollectionUtils.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureArray.h"
 
 namespace TrenchBroom {
     namespace Assets {
@@ -47,6 +48,7 @@ namespace TrenchBroom {
         }
 
         TextureCollection::~TextureCollection() {
+            VectorUtils::clearAndDelete(m_textureArrays);
             VectorUtils::clearAndDelete(m_textures);
             if (!m_textureIds.empty()) {
                 glAssert(glDeleteTextures(static_cast<GLsizei>(m_textureIds.size()),
@@ -93,9 +95,20 @@ namespace TrenchBroom {
             return !m_textureIds.empty();
         }
 
-        void TextureCollection::prepare(const int minFilter, const int magFilter) {
+        void TextureCollection::prepare(const int minFilter, const int magFilter, const bool useTextureArrays) {
             assert(!prepared());
             
+            // the array textures must be uploaded first because preparing a texture releases its image data
+            if (useTextureArrays && glSupportsTextureArrays()) {
+                GLint maxLayers = 0;
+                glAssert(glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers));
+                if (maxLayers > 1) {
+                    m_textureArrays = TextureArray::createTextureArrays(m_textures, static_cast<size_t>(maxLayers));
+                    for (TextureArray* textureArray : m_textureArrays)
+                        textureArray->prepare(minFilter, magFilter);
+                }
+            }
+
             const size_t textureCount = m_textures.size();
             m_textureIds.resize(textureCount);
             glAssert(glGenTextures(static_cast<GLsizei>(textureCount),
@@ -112,6 +125,8 @@ namespace TrenchBroom {
                 Texture* texture = m_textures[i];
                 texture->setMode(minFilter, magFilter);
             }
+            for (TextureArray* textureArray : m_textureArrays)
+                textureArray->setMode(minFilter, magFilter);
         }
 
         void TextureCollection::incUsageCount() {
@@ -41,6 +41,7 @@ namespace TrenchBroom {
             size_t m_usageCount;
             
             TextureIdList m_textureIds;
+            TextureArrayList m_textureArrays;
             
             friend class Texture;
         public:
@@ -63,7 +64,11 @@ namespace TrenchBroom {
             size_t usageCount() const;
             
             bool prepared() const;
-            void prepare(int minFilter, int magFilter);
+            /**
+             * Uploads the textures of this collection. If useTextureArrays is set, textures of the same size and
+             * format are additionally uploaded into shared array textures, see TextureArray.
+             */
+            void prepare(int minFilter, int magFilter, bool useTextureArrays = false);
             void setTextureMode(int minFilter, int magFilter);
         private:
             void incUsageCount();
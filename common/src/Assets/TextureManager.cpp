@@ -52,7 +52,8 @@ namespace TrenchBroom {
         m_logger(logger),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_useTextureArrays(false) {}
         
         TextureManager::~TextureManager() {
             clear();
@@ -120,6 +121,10 @@ namespace TrenchBroom {
             m_resetTextureMode = true;
         }
 
+        void TextureManager::setUseTextureArrays(const bool useTextureArrays) {
+            m_useTextureArrays = useTextureArrays;
+        }
+
         void TextureManager::commitChanges() {
             resetTextureMode();
             prepare();
@@ -159,7 +164,7 @@ namespace TrenchBroom {
         
         void TextureManager::prepare() {
             std::for_each(std::begin(m_toPrepare), std::end(m_toPrepare),
-                          [this](auto collection) { collection->prepare(m_minFilter, m_magFilter); });
+                          [this](auto collection) { collection->prepare(m_minFilter, m_magFilter, m_useTextureArrays); });
             m_toPrepare.clear();
         }
         
@@ -55,6 +55,7 @@ namespace TrenchBroom {
             int m_minFilter;
             int m_magFilter;
             bool m_resetTextureMode;
+            bool m_useTextureArrays;
         public:
             Notifier0 usageCountDidChange;
         public:
@@ -69,6 +70,11 @@ namespace TrenchBroom {
             void clear();
             
             void setTextureMode(int minFilter, int magFilter);
+            /**
+             * Controls whether texture collections that are prepared from now on also upload their textures into
+             * array textures. Has no effect on texture collections that are already prepared.
+             */
+            void setUseTextureArrays(bool useTextureArrays);
             void commitChanges();
             
             Texture* texture(const String& name) const;
@@ -0,0 +1,361 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BatchMath_h
+#define TrenchBroom_BatchMath_h
+
+#include "BBox.h"
+#include "Mat.h"
+#include "MathUtils.h"
+#include "Plane.h"
+#include "Vec.h"
+
+#include <cassert>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TB_BATCH_MATH_SSE2
+#include <emmintrin.h>
+#endif
+
+/**
+ * Functions that apply the same operation to an array of points or boxes at once. They compute the same results as
+ * applying the operators of Mat, Plane and BBox to each element, but the float and double versions process whole
+ * points or several points at once using SSE2 if it is available.
+ *
+ * The points can be members of larger vertex structs; in that case, the stride is the size of the struct in bytes.
+ */
+namespace BatchMath {
+    namespace PointStatusMask {
+        typedef unsigned int Type;
+        static const Type PSAbove  = 1 << Math::PointStatus::PSAbove;
+        static const Type PSBelow  = 1 << Math::PointStatus::PSBelow;
+        static const Type PSInside = 1 << Math::PointStatus::PSInside;
+    }
+
+    template <typename T>
+    const Vec<T,3>& pointAt(const Vec<T,3>* points, const size_t index, const size_t stride) {
+        return *reinterpret_cast<const Vec<T,3>*>(reinterpret_cast<const char*>(points) + index * stride);
+    }
+
+    template <typename T>
+    bool isAffine(const Mat<T,4,4>& transformation) {
+        return (transformation[0][3] == static_cast<T>(0.0) &&
+                transformation[1][3] == static_cast<T>(0.0) &&
+                transformation[2][3] == static_cast<T>(0.0) &&
+                transformation[3][3] == static_cast<T>(1.0));
+    }
+
+    namespace Scalar {
+        template <typename T>
+        void transformPoints(const Mat<T,4,4>& transformation, const Vec<T,3>* points, const size_t count, Vec<T,3>* result) {
+            for (size_t i = 0; i < count; ++i)
+                result[i] = transformation * points[i];
+        }
+
+        template <typename T>
+        BBox<T,3> boundsOfPoints(const Vec<T,3>* points, const size_t count, const size_t stride = sizeof(Vec<T,3>)) {
+            assert(count > 0);
+            BBox<T,3> result;
+            result.min = result.max = pointAt(points, 0, stride);
+            for (size_t i = 1; i < count; ++i)
+                result.mergeWith(pointAt(points, i, stride));
+            return result;
+        }
+
+        template <typename T>
+        BBox<T,3> transformedBounds(const Mat<T,4,4>& transformation, const Vec<T,3>* points, const size_t count, const size_t stride = sizeof(Vec<T,3>)) {
+            assert(count > 0);
+            BBox<T,3> result;
+            result.min = result.max = transformation * pointAt(points, 0, stride);
+            for (size_t i = 1; i < count; ++i)
+                result.mergeWith(transformation * pointAt(points, i, stride));
+            return result;
+        }
+
+        template <typename T, size_t S>
+        BBox<T,S> mergeBounds(const BBox<T,S>* boxes, const size_t count) {
+            assert(count > 0);
+            BBox<T,S> result = boxes[0];
+            for (size_t i = 1; i < count; ++i)
+                result.mergeWith(boxes[i]);
+            return result;
+        }
+
+        template <typename T>
+        PointStatusMask::Type classifyPoints(const Plane<T,3>& plane, const Vec<T,3>* points, const size_t count, const T epsilon = Math::Constants<T>::pointStatusEpsilon()) {
+            PointStatusMask::Type result = 0;
+            for (size_t i = 0; i < count; ++i)
+                result |= static_cast<PointStatusMask::Type>(1 << plane.pointStatus(points[i], epsilon));
+            return result;
+        }
+    }
+
+    /**
+     * Transforms the given points and stores them in the given result array, which may be the same as the points array.
+     */
+    template <typename T>
+    void transformPoints(const Mat<T,4,4>& transformation, const Vec<T,3>* points, const size_t count, Vec<T,3>* result) {
+        Scalar::transformPoints(transformation, points, count, result);
+    }
+
+    /**
+     * Returns the bounds of the given points, of which there must be at least one.
+     */
+    template <typename T>
+    BBox<T,3> boundsOfPoints(const Vec<T,3>* points, const size_t count, const size_t stride = sizeof(Vec<T,3>)) {
+        return Scalar::boundsOfPoints(points, count, stride);
+    }
+
+    /**
+     * Returns the bounds of the given points after transforming them, without storing the transformed points.
+     */
+    template <typename T>
+    BBox<T,3> transformedBounds(const Mat<T,4,4>& transformation, const Vec<T,3>* points, const size_t count, const size_t stride = sizeof(Vec<T,3>)) {
+        return Scalar::transformedBounds(transformation, points, count, stride);
+    }
+
+    /**
+     * Returns the smallest box that contains all of the given boxes, of which there must be at least one.
+     */
+    template <typename T, size_t S>
+    BBox<T,S> mergeBounds(const BBox<T,S>* boxes, const size_t count) {
+        return Scalar::mergeBounds(boxes, count);
+    }
+
+    /**
+     * Returns a mask of the point statuses of the given points with respect to the given plane. The mask contains the
+     * bit 1 << s for every status s that at least one of the points has.
+     */
+    template <typename T>
+    PointStatusMask::Type classifyPoints(const Plane<T,3>& plane, const Vec<T,3>* points, const size_t count, const T epsilon = Math::Constants<T>::pointStatusEpsilon()) {
+        return Scalar::classifyPoints(plane, points, count, epsilon);
+    }
+
+#ifdef TB_BATCH_MATH_SSE2
+    namespace SSE2 {
+        // A column of a 4x4 float matrix or a point with a fourth component fits into one register. The transformation
+        // adds the products in the same order as Mat::operator*, starting with zero, so that the results are identical.
+        struct Mat4x4fColumns {
+            __m128 c[4];
+
+            Mat4x4fColumns(const Mat4x4f& transformation) {
+                for (size_t i = 0; i < 4; ++i)
+                    c[i] = _mm_loadu_ps(transformation[i].v);
+            }
+
+            __m128 transform(const Vec3f& point, const bool affine) const {
+                __m128 result = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(c[0], _mm_set1_ps(point[0])));
+                result = _mm_add_ps(result, _mm_mul_ps(c[1], _mm_set1_ps(point[1])));
+                result = _mm_add_ps(result, _mm_mul_ps(c[2], _mm_set1_ps(point[2])));
+                result = _mm_add_ps(result, c[3]);
+                if (!affine)
+                    result = _mm_div_ps(result, _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 3, 3, 3)));
+                return result;
+            }
+        };
+
+        // Double columns are split into two registers holding the rows 0, 1 and 2, 3.
+        struct Mat4x4dColumns {
+            __m128d lo[4];
+            __m128d hi[4];
+
+            Mat4x4dColumns(const Mat4x4d& transformation) {
+                for (size_t i = 0; i < 4; ++i) {
+                    lo[i] = _mm_loadu_pd(transformation[i].v);
+                    hi[i] = _mm_loadu_pd(transformation[i].v + 2);
+                }
+            }
+
+            void transform(const Vec3d& point, const bool affine, __m128d& resultLo, __m128d& resultHi) const {
+                const __m128d x = _mm_set1_pd(point[0]);
+                const __m128d y = _mm_set1_pd(point[1]);
+                const __m128d z = _mm_set1_pd(point[2]);
+                resultLo = _mm_add_pd(_mm_setzero_pd(), _mm_mul_pd(lo[0], x));
+                resultHi = _mm_add_pd(_mm_setzero_pd(), _mm_mul_pd(hi[0], x));
+                resultLo = _mm_add_pd(resultLo, _mm_mul_pd(lo[1], y));
+                resultHi = _mm_add_pd(resultHi, _mm_mul_pd(hi[1], y));
+                resultLo = _mm_add_pd(resultLo, _mm_mul_pd(lo[2], z));
+                resultHi = _mm_add_pd(resultHi, _mm_mul_pd(hi[2], z));
+                resultLo = _mm_add_pd(resultLo, lo[3]);
+                resultHi = _mm_add_pd(resultHi, hi[3]);
+                if (!affine) {
+                    const __m128d w = _mm_unpackhi_pd(resultHi, resultHi);
+                    resultLo = _mm_div_pd(resultLo, w);
+                    resultHi = _mm_div_pd(resultHi, w);
+                }
+            }
+        };
+
+        inline __m128 load(const Vec3f& point) {
+            return _mm_setr_ps(point[0], point[1], point[2], 0.0f);
+        }
+
+        inline void store(const __m128 value, Vec3f& result) {
+            _mm_storel_pi(reinterpret_cast<__m64*>(result.v), value);
+            _mm_store_ss(result.v + 2, _mm_movehl_ps(value, value));
+        }
+
+        inline BBox3f toBBox(const __m128 min, const __m128 max) {
+            BBox3f result;
+            store(min, result.min);
+            store(max, result.max);
+            return result;
+        }
+
+        // The argument order of min and max matches std::min and std::max in BBox::mergeWith.
+        inline BBox3f transformedBounds(const Mat4x4f& transformation, const Vec3f* points, const size_t count, const size_t stride) {
+            assert(count > 0);
+            const Mat4x4fColumns columns(transformation);
+            const bool affine = isAffine(transformation);
+
+            __m128 min = columns.transform(pointAt(points, 0, stride), affine);
+            __m128 max = min;
+            for (size_t i = 1; i < count; ++i) {
+                const __m128 point = columns.transform(pointAt(points, i, stride), affine);
+                min = _mm_min_ps(point, min);
+                max = _mm_max_ps(point, max);
+            }
+            return toBBox(min, max);
+        }
+
+        inline BBox3d transformedBounds(const Mat4x4d& transformation, const Vec3d* points, const size_t count, const size_t stride) {
+            assert(count > 0);
+            const Mat4x4dColumns columns(transformation);
+            const bool affine = isAffine(transformation);
+
+            __m128d minLo, minHi;
+            columns.transform(pointAt(points, 0, stride), affine, minLo, minHi);
+            __m128d maxLo = minLo, maxHi = minHi;
+            for (size_t i = 1; i < count; ++i) {
+                __m128d pointLo, pointHi;
+                columns.transform(pointAt(points, i, stride), affine, pointLo, pointHi);
+                minLo = _mm_min_pd(pointLo, minLo);
+                minHi = _mm_min_pd(pointHi, minHi);
+                maxLo = _mm_max_pd(pointLo, maxLo);
+                maxHi = _mm_max_pd(pointHi, maxHi);
+            }
+
+            BBox3d result;
+            _mm_storeu_pd(result.min.v, minLo);
+            _mm_store_sd(result.min.v + 2, minHi);
+            _mm_storeu_pd(result.max.v, maxLo);
+            _mm_store_sd(result.max.v + 2, maxHi);
+            return result;
+        }
+
+        // Classifies two points at a time by computing their distances in the lanes of one register.
+        inline PointStatusMask::Type classifyPoints(const Plane3d& plane, const Vec3d* points, const size_t count, const double epsilon) {
+            const __m128d nx = _mm_set1_pd(plane.normal[0]);
+            const __m128d ny = _mm_set1_pd(plane.normal[1]);
+            const __m128d nz = _mm_set1_pd(plane.normal[2]);
+            const __m128d d  = _mm_set1_pd(plane.distance);
+            const __m128d above = _mm_set1_pd(epsilon);
+            const __m128d below = _mm_set1_pd(-epsilon);
+            const __m128d all   = _mm_castsi128_pd(_mm_set1_epi32(-1));
+
+            __m128d anyAbove = _mm_setzero_pd();
+            __m128d anyBelow = _mm_setzero_pd();
+            __m128d anyInside = _mm_setzero_pd();
+
+            size_t i = 0;
+            for (; i + 1 < count; i += 2) {
+                const Vec3d& p0 = points[i];
+                const Vec3d& p1 = points[i + 1];
+                __m128d distance = _mm_add_pd(_mm_setzero_pd(), _mm_mul_pd(_mm_setr_pd(p0[0], p1[0]), nx));
+                distance = _mm_add_pd(distance, _mm_mul_pd(_mm_setr_pd(p0[1], p1[1]), ny));
+                distance = _mm_add_pd(distance, _mm_mul_pd(_mm_setr_pd(p0[2], p1[2]), nz));
+                distance = _mm_sub_pd(distance, d);
+
+                const __m128d isAbove = _mm_cmpgt_pd(distance, above);
+                const __m128d isBelow = _mm_cmplt_pd(distance, below);
+                anyAbove  = _mm_or_pd(anyAbove, isAbove);
+                anyBelow  = _mm_or_pd(anyBelow, isBelow);
+                anyInside = _mm_or_pd(anyInside, _mm_andnot_pd(_mm_or_pd(isAbove, isBelow), all));
+            }
+
+            PointStatusMask::Type result = 0;
+            if (_mm_movemask_pd(anyAbove) != 0)
+                result |= PointStatusMask::PSAbove;
+            if (_mm_movemask_pd(anyBelow) != 0)
+                result |= PointStatusMask::PSBelow;
+            if (_mm_movemask_pd(anyInside) != 0)
+                result |= PointStatusMask::PSInside;
+            if (i < count)
+                result |= Scalar::classifyPoints(plane, points + i, count - i, epsilon);
+            return result;
+        }
+    }
+
+    inline void transformPoints(const Mat4x4f& transformation, const Vec3f* points, const size_t count, Vec3f* result) {
+        const SSE2::Mat4x4fColumns columns(transformation);
+        const bool affine = isAffine(transformation);
+        for (size_t i = 0; i < count; ++i)
+            SSE2::store(columns.transform(points[i], affine), result[i]);
+    }
+
+    inline void transformPoints(const Mat4x4d& transformation, const Vec3d* points, const size_t count, Vec3d* result) {
+        const SSE2::Mat4x4dColumns columns(transformation);
+        const bool affine = isAffine(transformation);
+        for (size_t i = 0; i < count; ++i) {
+            __m128d lo, hi;
+            columns.transform(points[i], affine, lo, hi);
+            _mm_storeu_pd(result[i].v, lo);
+            _mm_store_sd(result[i].v + 2, hi);
+        }
+    }
+
+    inline BBox3f boundsOfPoints(const Vec3f* points, const size_t count, const size_t stride = sizeof(Vec3f)) {
+        assert(count > 0);
+        __m128 min = SSE2::load(pointAt(points, 0, stride));
+        __m128 max = min;
+        for (size_t i = 1; i < count; ++i) {
+            const __m128 point = SSE2::load(pointAt(points, i, stride));
+            min = _mm_min_ps(point, min);
+            max = _mm_max_ps(point, max);
+        }
+        return SSE2::toBBox(min, max);
+    }
+
+    inline BBox3f transformedBounds(const Mat4x4f& transformation, const Vec3f* points, const size_t count, const size_t stride = sizeof(Vec3f)) {
+        return SSE2::transformedBounds(transformation, points, count, stride);
+    }
+
+    inline BBox3d transformedBounds(const Mat4x4d& transformation, const Vec3d* points, const size_t count, const size_t stride = sizeof(Vec3d)) {
+        return SSE2::transformedBounds(transformation, points, count, stride);
+    }
+
+    inline BBox3f mergeBounds(const BBox3f* boxes, const size_t count) {
+        assert(count > 0);
+        __m128 min = SSE2::load(boxes[0].min);
+        __m128 max = SSE2::load(boxes[0].max);
+        for (size_t i = 1; i < count; ++i) {
+            min = _mm_min_ps(SSE2::load(boxes[i].min), min);
+            max = _mm_max_ps(SSE2::load(boxes[i].max), max);
+        }
+        return SSE2::toBBox(min, max);
+    }
+
+    inline PointStatusMask::Type classifyPoints(const Plane3d& plane, const Vec3d* points, const size_t count, const double epsilon = Math::Constants<double>::pointStatusEpsilon()) {
+        return SSE2::classifyPoints(plane, points, count, epsilon);
+    }
+#endif
+}
+
+#endif
@@ -75,6 +75,11 @@ public:
     }
 };
 
+class OperationCancelledException : public ExceptionStream<OperationCancelledException> {
+public:
+    using ExceptionStream::ExceptionStream;
+};
+
 class VboException : public ExceptionStream<VboException> {
 public:
     using ExceptionStream::ExceptionStream;
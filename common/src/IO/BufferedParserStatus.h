@@ -0,0 +1,51 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BufferedParserStatus
+#define TrenchBroom_BufferedParserStatus
+
+#include "Logger.h"
+#include "StringUtils.h"
+#include "IO/ParserStatus.h"
+
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Records the messages of a parser that runs on a worker thread so that they can be passed on to the actual
+         * status on the calling thread later, in the order in which they were logged. Progress is ignored.
+         */
+        class BufferedParserStatus : public ParserStatus {
+        private:
+            typedef std::pair<Logger::LogLevel, String> Message;
+            std::vector<Message> m_messages;
+        public:
+            BufferedParserStatus();
+
+            void replay(ParserStatus& status) const;
+        private:
+            void doProgress(double progress) override;
+            void doLog(Logger::LogLevel level, const String& str) override;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_BufferedParserStatus) */
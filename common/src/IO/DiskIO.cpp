@@ -106,6 +106,11 @@ namespace TrenchBroom {
                 const Path fixedPath = fixPath(path);
                 return ::wxFileExists(fixedPath.asString());
             }
+
+            std::time_t fileModificationTime(const Path& path) {
+                const Path fixedPath = fixPath(path);
+                return ::wxFileModificationTime(fixedPath.asString());
+            }
             
             String replaceForbiddenChars(const String& name) {
                 static const String forbidden = wxFileName::GetForbiddenChars().ToStdString();
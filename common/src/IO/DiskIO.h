@@ -27,6 +27,8 @@
 #include "IO/MappedFile.h"
 #include "IO/Path.h"
 
+#include <ctime>
+
 namespace TrenchBroom {
     namespace IO {
         namespace Disk {
@@ -36,6 +38,7 @@ namespace TrenchBroom {
             
             bool directoryExists(const Path& path);
             bool fileExists(const Path& path);
+            std::time_t fileModificationTime(const Path& path);
             
             String replaceForbiddenChars(const String& name);
             
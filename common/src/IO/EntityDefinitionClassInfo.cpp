@@ -22,8 +22,36 @@
 #include "Assets/AttributeDefinition.h"
 #include "Model/EntityAttributes.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace TrenchBroom {
     namespace IO {
+        /**
+         * Merges two attribute definition lists that are sorted by name into a list that is sorted by name. If both
+         * lists contain a definition with the same name, the given function returns the definition to use.
+         */
+        template <typename M>
+        static Assets::AttributeDefinitionList mergeSorted(const Assets::AttributeDefinitionList& lhs, const Assets::AttributeDefinitionList& rhs, M merge) {
+            Assets::AttributeDefinitionList result;
+            result.reserve(lhs.size() + rhs.size());
+
+            auto lhsIt = std::begin(lhs);
+            auto rhsIt = std::begin(rhs);
+            while (lhsIt != std::end(lhs) && rhsIt != std::end(rhs)) {
+                const int cmp = (*lhsIt)->name().compare((*rhsIt)->name());
+                if (cmp < 0)
+                    result.push_back(*lhsIt++);
+                else if (cmp > 0)
+                    result.push_back(*rhsIt++);
+                else
+                    result.push_back(merge(*lhsIt++, *rhsIt++));
+            }
+            result.insert(std::end(result), lhsIt, std::end(lhs));
+            result.insert(std::end(result), rhsIt, std::end(rhs));
+            return result;
+        }
+
         EntityDefinitionClassInfo::EntityDefinitionClassInfo() :
         m_line(0),
         m_column(0),
@@ -31,6 +59,7 @@ namespace TrenchBroom {
         m_hasColor(false),
         m_size(BBox3(-8.0, 8.0)),
         m_hasSize(false),
+        m_attributes(std::make_shared<const Assets::AttributeDefinitionList>()),
         m_hasModelDefinition(false) {}
         
         EntityDefinitionClassInfo::EntityDefinitionClassInfo(const size_t line, const size_t column, const Color& defaultColor) :
@@ -41,6 +70,7 @@ namespace TrenchBroom {
         m_hasColor(false),
         m_size(BBox3(-8.0, 8.0)),
         m_hasSize(false),
+        m_attributes(std::make_shared<const Assets::AttributeDefinitionList>()),
         m_hasModelDefinition(false) {}
         
         
@@ -80,12 +110,8 @@ namespace TrenchBroom {
             return m_hasSize;
         }
 
-        Assets::AttributeDefinitionList EntityDefinitionClassInfo::attributeList() const {
-            return MapUtils::valueList(m_attributes);
-        }
-        
-        const Assets::AttributeDefinitionMap& EntityDefinitionClassInfo::attributeMap() const {
-            return m_attributes;
+        const Assets::AttributeDefinitionList& EntityDefinitionClassInfo::attributeList() const {
+            return *m_attributes;
         }
         
         const Assets::ModelDefinition& EntityDefinitionClassInfo::modelDefinition() const {
@@ -116,11 +142,17 @@ namespace TrenchBroom {
         }
         
         void EntityDefinitionClassInfo::addAttributeDefinition(Assets::AttributeDefinitionPtr attributeDefinition) {
-            m_attributes[attributeDefinition->name()] = attributeDefinition;
+            const Assets::AttributeDefinitionList added(1, attributeDefinition);
+            m_attributes = std::make_shared<const Assets::AttributeDefinitionList>(mergeSorted(*m_attributes, added, [](const Assets::AttributeDefinitionPtr&, const Assets::AttributeDefinitionPtr& newAttribute) { return newAttribute; }));
         }
         
         void EntityDefinitionClassInfo::addAttributeDefinitions(const Assets::AttributeDefinitionMap& attributeDefinitions) {
-            m_attributes.insert(std::begin(attributeDefinitions), std::end(attributeDefinitions));
+            if (attributeDefinitions.empty())
+                return;
+
+            // the map is sorted by name already
+            const Assets::AttributeDefinitionList added = MapUtils::valueList(attributeDefinitions);
+            m_attributes = std::make_shared<const Assets::AttributeDefinitionList>(mergeSorted(*m_attributes, added, [](const Assets::AttributeDefinitionPtr& oldAttribute, const Assets::AttributeDefinitionPtr&) { return oldAttribute; }));
         }
         
         void EntityDefinitionClassInfo::setModelDefinition(const Assets::ModelDefinition& modelDefinition) {
@@ -141,43 +173,49 @@ namespace TrenchBroom {
                     if (!hasSize() && baseClass.hasSize())
                         setSize(baseClass.size());
                     
-                    const Assets::AttributeDefinitionMap& baseProperties = baseClass.attributeMap();
-                    for (const auto& entry : baseProperties) {
-                        const Assets::AttributeDefinitionPtr baseAttribute = entry.second;
-                        
-                        Assets::AttributeDefinitionMap::iterator classAttributeIt = m_attributes.find(baseAttribute->name());
-                        if (classAttributeIt != std::end(m_attributes)) {
-                            // the class already has a definition for this attribute, attempt merging them
-                            mergeProperties(classAttributeIt->second.get(), baseAttribute.get());
-                        } else {
-                            // the class doesn't have a definition for this attribute, add the base class attribute
-                            addAttributeDefinition(baseAttribute);
-                        }
-                    }
+                    m_attributes = mergeAttributes(m_attributes, baseClass.m_attributes);
                     
                     m_modelDefinition.append(baseClass.modelDefinition());
                 }
             }
         }
 
-        void EntityDefinitionClassInfo::mergeProperties(Assets::AttributeDefinition* classAttribute, const Assets::AttributeDefinition* baseclassAttribute) {
+        EntityDefinitionClassInfo::AttributeListPtr EntityDefinitionClassInfo::mergeAttributes(const AttributeListPtr& classAttributes, const AttributeListPtr& baseclassAttributes) {
+            // share the lists instead of copying them if there is nothing to merge
+            if (baseclassAttributes->empty())
+                return classAttributes;
+            if (classAttributes->empty())
+                return baseclassAttributes;
+            return std::make_shared<const Assets::AttributeDefinitionList>(mergeSorted(*classAttributes, *baseclassAttributes, &EntityDefinitionClassInfo::mergeProperties));
+        }
+
+        Assets::AttributeDefinitionPtr EntityDefinitionClassInfo::mergeProperties(const Assets::AttributeDefinitionPtr& classAttribute, const Assets::AttributeDefinitionPtr& baseclassAttribute) {
             // for now, only merge spawnflags
             if (baseclassAttribute->type() == Assets::AttributeDefinition::Type_FlagsAttribute &&
                 classAttribute->type() == Assets::AttributeDefinition::Type_FlagsAttribute &&
                 baseclassAttribute->name() == Model::AttributeNames::Spawnflags &&
                 classAttribute->name() == Model::AttributeNames::Spawnflags) {
                 
-                const Assets::FlagsAttributeDefinition* baseclassFlags = static_cast<const Assets::FlagsAttributeDefinition*>(baseclassAttribute);
-                Assets::FlagsAttributeDefinition* classFlags = static_cast<Assets::FlagsAttributeDefinition*>(classAttribute);
+                const Assets::FlagsAttributeDefinition* baseclassFlags = static_cast<const Assets::FlagsAttributeDefinition*>(baseclassAttribute.get());
+                const Assets::FlagsAttributeDefinition* classFlags = static_cast<const Assets::FlagsAttributeDefinition*>(classAttribute.get());
                 
+                // the class attribute may be shared with other classes, so the flags are added to a copy
+                std::shared_ptr<Assets::FlagsAttributeDefinition> mergedFlags;
                 for (int i = 0; i < 24; ++i) {
                     const Assets::FlagsAttributeOption* baseclassFlag = baseclassFlags->option(static_cast<int>(1 << i));
                     const Assets::FlagsAttributeOption* classFlag = classFlags->option(static_cast<int>(1 << i));
                     
-                    if (baseclassFlag != nullptr && classFlag == nullptr)
-                        classFlags->addOption(baseclassFlag->value(), baseclassFlag->shortDescription(), baseclassFlag->longDescription(), baseclassFlag->isDefault());
+                    if (baseclassFlag != nullptr && classFlag == nullptr) {
+                        if (mergedFlags == nullptr)
+                            mergedFlags = std::make_shared<Assets::FlagsAttributeDefinition>(*classFlags);
+                        mergedFlags->addOption(baseclassFlag->value(), baseclassFlag->shortDescription(), baseclassFlag->longDescription(), baseclassFlag->isDefault());
+                    }
                 }
+                
+                if (mergedFlags != nullptr)
+                    return mergedFlags;
             }
+            return classAttribute;
         }
     }
 }
@@ -28,14 +28,22 @@
 #include "Assets/ModelDefinition.h"
 
 #include <map>
+#include <memory>
 
 namespace TrenchBroom {
     namespace IO {
         class EntityDefinitionClassInfo;
         typedef std::map<String, EntityDefinitionClassInfo> EntityDefinitionClassInfoMap;
         
+        /**
+         * Collects the properties of an entity definition while it is parsed. The attribute definitions are kept in
+         * an immutable list that is sorted by name and shared with other class infos, so copying a class info or
+         * inheriting all attributes of a base class does not copy the list.
+         */
         class EntityDefinitionClassInfo {
         private:
+            typedef std::shared_ptr<const Assets::AttributeDefinitionList> AttributeListPtr;
+
             size_t m_line;
             size_t m_column;
             String m_name;
@@ -45,7 +53,7 @@ namespace TrenchBroom {
             bool m_hasColor;
             BBox3 m_size;
             bool m_hasSize;
-            Assets::AttributeDefinitionMap m_attributes;
+            AttributeListPtr m_attributes;
             Assets::ModelDefinition m_modelDefinition;
             bool m_hasModelDefinition;
         public:
@@ -61,8 +69,7 @@ namespace TrenchBroom {
             bool hasColor() const;
             const BBox3& size() const;
             bool hasSize() const;
-            Assets::AttributeDefinitionList attributeList() const;
-            const Assets::AttributeDefinitionMap& attributeMap() const;
+            const Assets::AttributeDefinitionList& attributeList() const;
             const Assets::ModelDefinition& modelDefinition() const;
             bool hasModelDefinition() const;
 
@@ -76,7 +83,8 @@ namespace TrenchBroom {
         
             void resolveBaseClasses(const EntityDefinitionClassInfoMap& baseClasses, const StringList& classnames);
         private:
-            static void mergeProperties(Assets::AttributeDefinition* classAttribute, const Assets::AttributeDefinition* baseclassAttribute);
+            static AttributeListPtr mergeAttributes(const AttributeListPtr& classAttributes, const AttributeListPtr& baseclassAttributes);
+            static Assets::AttributeDefinitionPtr mergeProperties(const Assets::AttributeDefinitionPtr& classAttribute, const Assets::AttributeDefinitionPtr& baseclassAttribute);
         };
     }
 }
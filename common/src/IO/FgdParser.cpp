@@ -21,9 +21,11 @@
 
 #include "CollectionUtils.h"
 #include "Exceptions.h"
+#include "TaskScheduler.h"
 #include "Assets/EntityDefinition.h"
 #include "Assets/AttributeDefinition.h"
 #include "Assets/ModelDefinition.h"
+#include "IO/BufferedParserStatus.h"
 #include "IO/ELParser.h"
 #include "IO/LegacyModelDefinitionParser.h"
 #include "IO/ParserStatus.h"
@@ -33,6 +35,9 @@ namespace TrenchBroom {
         FgdTokenizer::FgdTokenizer(const char* begin, const char* end) :
         Tokenizer(begin, end, "", 0) {}
         
+        FgdTokenizer::FgdTokenizer(const char* begin, const char* end, const size_t line, const size_t column) :
+        Tokenizer(begin, end, "", 0, line, column) {}
+        
         FgdTokenizer::FgdTokenizer(const String& str) :
         Tokenizer(str, "", 0) {}
         
@@ -103,13 +108,23 @@ namespace TrenchBroom {
         }
         
         FgdParser::FgdParser(const char* begin, const char* end, const Color& defaultEntityColor) :
+        m_begin(begin),
+        m_end(end),
         m_defaultEntityColor(defaultEntityColor),
         m_tokenizer(FgdTokenizer(begin, end)) {}
         
         FgdParser::FgdParser(const String& str, const Color& defaultEntityColor) :
+        m_begin(str.c_str()),
+        m_end(str.c_str() + str.size()),
         m_defaultEntityColor(defaultEntityColor),
         m_tokenizer(FgdTokenizer(str)) {}
         
+        FgdParser::FgdParser(const Section& section, const Color& defaultEntityColor) :
+        m_begin(section.begin),
+        m_end(section.end),
+        m_defaultEntityColor(defaultEntityColor),
+        m_tokenizer(FgdTokenizer(section.begin, section.end, section.line, section.column)) {}
+        
         FgdParser::TokenNameMap FgdParser::tokenNames() const {
             using namespace FgdToken;
             
@@ -130,68 +145,205 @@ namespace TrenchBroom {
         }
 
         Assets::EntityDefinitionList FgdParser::doParseDefinitions(ParserStatus& status) {
-            Assets::EntityDefinitionList definitions;
-            try {
-                Assets::EntityDefinition* definition = parseDefinition(status);
-                status.progress(m_tokenizer.progress());
-                while (definition != nullptr) {
-                    definitions.push_back(definition);
-                    definition = parseDefinition(status);
-                    status.progress(m_tokenizer.progress());
+            ParsedClassList classes;
+            const SectionList sections = findSections();
+            if (sections.size() > 1) {
+                try {
+                    classes = parseSections(sections, status);
+                } catch (const Exception&) {
+                    // parse the file again so that the error is reported exactly as if it was parsed sequentially
+                    classes = parseClasses(status);
                 }
-                return definitions;
-            } catch (...) {
-                VectorUtils::clearAndDelete(definitions);
-                throw;
+            } else {
+                classes = parseClasses(status);
             }
+            return resolveClasses(classes, status);
         }
         
-        Assets::EntityDefinition* FgdParser::parseDefinition(ParserStatus& status) {
-            Token token = m_tokenizer.nextToken();
-            if (token.type() == FgdToken::Eof)
-                return nullptr;
+        FgdParser::SectionList FgdParser::findSections() const {
+            static const size_t MinClassesPerSection = 128;
             
-            const String classname = token.data();
-            if (StringUtils::caseInsensitiveEqual(classname, "@SolidClass")) {
-                return parseSolidClass(status);
-            } else if (StringUtils::caseInsensitiveEqual(classname, "@PointClass")) {
-                return parsePointClass(status);
-            } else if (StringUtils::caseInsensitiveEqual(classname, "@BaseClass")) {
-                const EntityDefinitionClassInfo baseClass = parseBaseClass(status);
-                m_baseClasses[baseClass.name()] = baseClass;
-                return parseDefinition(status);
-            } else if (StringUtils::caseInsensitiveEqual(classname, "@Main")) {
-                skipMainClass(status);
-                return parseDefinition(status);
-            } else {
-                const String msg = "Unknown entity definition class '" + classname + "'";
-                status.error(token.line(), token.column(), msg);
-                throw ParserException(token.line(), token.column(), msg);
+            struct ClassStart {
+                const char* position;
+                size_t line;
+                size_t column;
+            };
+            std::vector<ClassStart> classStarts;
+            
+            // A quick scan that finds the '@' characters which start a class, skipping over comments and quoted
+            // strings and ignoring everything in parentheses or brackets. If the scan misses a class, its section
+            // just contains one more class, and if it finds something that doesn't start a class, parsing the
+            // section fails and the file is parsed sequentially.
+            const char* c = m_begin;
+            size_t line = 1;
+            size_t column = 1;
+            size_t depth = 0;
+            bool tokenStart = true;
+            
+            const auto advance = [&]() {
+                if (*c == '\n') {
+                    ++line;
+                    column = 1;
+                } else {
+                    ++column;
+                }
+                ++c;
+            };
+            
+            while (c < m_end) {
+                if (tokenStart) {
+                    if (*c == '/') {
+                        advance();
+                        if (c < m_end && *c == '/') {
+                            while (c < m_end && *c != '\n' && *c != '\r')
+                                advance();
+                        }
+                        continue;
+                    } else if (*c == '"') {
+                        advance();
+                        while (c < m_end && *c != '"')
+                            advance();
+                        if (c < m_end)
+                            advance();
+                        continue;
+                    } else if (*c == '@' && depth == 0) {
+                        classStarts.push_back({ c, line, column });
+                    }
+                }
+                
+                switch (*c) {
+                    case '(':
+                    case '[':
+                        ++depth;
+                        tokenStart = true;
+                        break;
+                    case ')':
+                    case ']':
+                        if (depth > 0)
+                            --depth;
+                        tokenStart = true;
+                        break;
+                    case ' ':
+                    case '\t':
+                    case '\n':
+                    case '\r':
+                    case ':':
+                    case ',':
+                    case '=':
+                        tokenStart = true;
+                        break;
+                    default:
+                        tokenStart = false;
+                        break;
+                }
+                advance();
             }
+            
+            // a few sections per thread so that threads which finish early can take over the remaining ones
+            const size_t maxSectionCount = 4 * (TaskScheduler::instance().workerCount() + 1);
+            const size_t sectionCount = std::min(classStarts.size() / MinClassesPerSection, maxSectionCount);
+            
+            SectionList sections;
+            if (sectionCount <= 1)
+                return sections;
+            
+            sections.reserve(sectionCount);
+            for (size_t i = 0; i < sectionCount; ++i) {
+                // the first section also contains everything before the first class
+                if (i == 0) {
+                    sections.push_back({ m_begin, m_end, 1, 1 });
+                } else {
+                    const ClassStart& start = classStarts[classStarts.size() * i / sectionCount];
+                    sections.back().end = start.position;
+                    sections.push_back({ start.position, m_end, start.line, start.column });
+                }
+            }
+            return sections;
         }
         
-        Assets::EntityDefinition* FgdParser::parseSolidClass(ParserStatus& status) {
-            EntityDefinitionClassInfo classInfo = parseClass(status);
-            if (classInfo.hasSize())
-                status.warn(classInfo.line(), classInfo.column(), "Solid entity definition must not have a size");
-            if (classInfo.hasModelDefinition())
-                status.warn(classInfo.line(), classInfo.column(), "Solid entity definition must not have model definitions");
-            return new Assets::BrushEntityDefinition(classInfo.name(), classInfo.color(), classInfo.description(), classInfo.attributeList());
+        FgdParser::ParsedClassList FgdParser::parseSections(const SectionList& sections, ParserStatus& status) const {
+            std::vector<ParsedClassList> sectionClasses(sections.size());
+            std::vector<BufferedParserStatus> sectionStatus(sections.size());
+            
+            TaskScheduler::instance().parallelFor(0, sections.size(), [&](const size_t i) {
+                FgdParser parser(sections[i], m_defaultEntityColor);
+                sectionClasses[i] = parser.parseClasses(sectionStatus[i]);
+            });
+            
+            ParsedClassList classes;
+            const double length = static_cast<double>(m_end - m_begin);
+            for (size_t i = 0; i < sections.size(); ++i) {
+                sectionStatus[i].replay(status);
+                
+                const Section& section = sections[i];
+                const double sectionOffset = static_cast<double>(section.begin - m_begin);
+                const double sectionLength = static_cast<double>(section.end - section.begin);
+                for (ParsedClass& parsedClass : sectionClasses[i]) {
+                    parsedClass.progress = (sectionOffset + parsedClass.progress * sectionLength) / length;
+                    classes.push_back(std::move(parsedClass));
+                }
+            }
+            return classes;
         }
         
-        Assets::EntityDefinition* FgdParser::parsePointClass(ParserStatus& status) {
-            EntityDefinitionClassInfo classInfo = parseClass(status);
-            return new Assets::PointEntityDefinition(classInfo.name(), classInfo.color(), classInfo.size(), classInfo.description(), classInfo.attributeList(), classInfo.modelDefinition());
+        Assets::EntityDefinitionList FgdParser::resolveClasses(ParsedClassList& classes, ParserStatus& status) {
+            Assets::EntityDefinitionList definitions;
+            try {
+                for (ParsedClass& parsedClass : classes) {
+                    EntityDefinitionClassInfo& classInfo = parsedClass.classInfo;
+                    classInfo.resolveBaseClasses(m_baseClasses, parsedClass.superClasses);
+                    
+                    switch (parsedClass.type) {
+                        case ClassType_Solid:
+                            if (classInfo.hasSize())
+                                status.warn(classInfo.line(), classInfo.column(), "Solid entity definition must not have a size");
+                            if (classInfo.hasModelDefinition())
+                                status.warn(classInfo.line(), classInfo.column(), "Solid entity definition must not have model definitions");
+                            definitions.push_back(new Assets::BrushEntityDefinition(classInfo.name(), classInfo.color(), classInfo.description(), classInfo.attributeList()));
+                            break;
+                        case ClassType_Point:
+                            definitions.push_back(new Assets::PointEntityDefinition(classInfo.name(), classInfo.color(), classInfo.size(), classInfo.description(), classInfo.attributeList(), classInfo.modelDefinition()));
+                            break;
+                        case ClassType_Base:
+                            if (m_baseClasses.count(classInfo.name()) > 0)
+                                status.warn(classInfo.line(), classInfo.column(), "Redefinition of base class '" + classInfo.name() + "'");
+                            m_baseClasses[classInfo.name()] = classInfo;
+                            break;
+                    }
+                    status.progress(parsedClass.progress);
+                }
+                return definitions;
+            } catch (...) {
+                VectorUtils::clearAndDelete(definitions);
+                throw;
+            }
         }
         
-        EntityDefinitionClassInfo FgdParser::parseBaseClass(ParserStatus& status) {
-            EntityDefinitionClassInfo classInfo = parseClass(status);
-            if (m_baseClasses.count(classInfo.name()) > 0)
-                status.warn(classInfo.line(), classInfo.column(), "Redefinition of base class '" + classInfo.name() + "'");
-            return classInfo;
+        FgdParser::ParsedClassList FgdParser::parseClasses(ParserStatus& status) {
+            ParsedClassList classes;
+            
+            Token token = m_tokenizer.nextToken();
+            while (token.type() != FgdToken::Eof) {
+                const String classname = token.data();
+                if (StringUtils::caseInsensitiveEqual(classname, "@SolidClass")) {
+                    classes.push_back(parseClass(status, ClassType_Solid));
+                } else if (StringUtils::caseInsensitiveEqual(classname, "@PointClass")) {
+                    classes.push_back(parseClass(status, ClassType_Point));
+                } else if (StringUtils::caseInsensitiveEqual(classname, "@BaseClass")) {
+                    classes.push_back(parseClass(status, ClassType_Base));
+                } else if (StringUtils::caseInsensitiveEqual(classname, "@Main")) {
+                    skipMainClass(status);
+                } else {
+                    const String msg = "Unknown entity definition class '" + classname + "'";
+                    status.error(token.line(), token.column(), msg);
+                    throw ParserException(token.line(), token.column(), msg);
+                }
+                token = m_tokenizer.nextToken();
+            }
+            return classes;
         }
         
-        EntityDefinitionClassInfo FgdParser::parseClass(ParserStatus& status) {
+        FgdParser::ParsedClass FgdParser::parseClass(ParserStatus& status, const ClassType type) {
             Token token;
             expect(status, FgdToken::Word | FgdToken::Equality, token = m_tokenizer.nextToken());
             
@@ -236,8 +388,7 @@ namespace TrenchBroom {
             }
             
             classInfo.addAttributeDefinitions(parseProperties(status));
-            classInfo.resolveBaseClasses(m_baseClasses, superClasses);
-            return classInfo;
+            return ParsedClass { type, std::move(classInfo), std::move(superClasses), m_tokenizer.progress() };
         }
 
         void FgdParser::skipMainClass(ParserStatus& status) {
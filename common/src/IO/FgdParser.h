@@ -31,6 +31,8 @@
 #include "IO/Token.h"
 #include "IO/Tokenizer.h"
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace IO {
         namespace FgdToken {
@@ -52,6 +54,7 @@ namespace TrenchBroom {
         class FgdTokenizer : public Tokenizer<FgdToken::Type> {
         public:
             FgdTokenizer(const char* begin, const char* end);
+            FgdTokenizer(const char* begin, const char* end, size_t line, size_t column);
             FgdTokenizer(const String& str);
         private:
             static const String WordDelims;
@@ -71,6 +74,36 @@ namespace TrenchBroom {
                 DefaultValue(const T& i_value) : present(true), value(i_value) {}
             };
             
+            typedef enum {
+                ClassType_Solid,
+                ClassType_Point,
+                ClassType_Base
+            } ClassType;
+            
+            /**
+             * A class whose base classes have not been resolved yet.
+             */
+            struct ParsedClass {
+                ClassType type;
+                EntityDefinitionClassInfo classInfo;
+                StringList superClasses;
+                double progress;
+            };
+            typedef std::vector<ParsedClass> ParsedClassList;
+            
+            /**
+             * A part of the file that contains a number of complete class definitions.
+             */
+            struct Section {
+                const char* begin;
+                const char* end;
+                size_t line;
+                size_t column;
+            };
+            typedef std::vector<Section> SectionList;
+            
+            const char* m_begin;
+            const char* m_end;
             Color m_defaultEntityColor;
             FgdTokenizer m_tokenizer;
             EntityDefinitionClassInfoMap m_baseClasses;
@@ -78,14 +111,17 @@ namespace TrenchBroom {
             FgdParser(const char* begin, const char* end, const Color& defaultEntityColor);
             FgdParser(const String& str, const Color& defaultEntityColor);
         private:
+            FgdParser(const Section& section, const Color& defaultEntityColor);
+            
             TokenNameMap tokenNames() const override;
             Assets::EntityDefinitionList doParseDefinitions(ParserStatus& status) override;
             
-            Assets::EntityDefinition* parseDefinition(ParserStatus& status);
-            Assets::EntityDefinition* parseSolidClass(ParserStatus& status);
-            Assets::EntityDefinition* parsePointClass(ParserStatus& status);
-            EntityDefinitionClassInfo parseBaseClass(ParserStatus& status);
-            EntityDefinitionClassInfo parseClass(ParserStatus& status);
+            SectionList findSections() const;
+            ParsedClassList parseSections(const SectionList& sections, ParserStatus& status) const;
+            Assets::EntityDefinitionList resolveClasses(ParsedClassList& classes, ParserStatus& status);
+            
+            ParsedClassList parseClasses(ParserStatus& status);
+            ParsedClass parseClass(ParserStatus& status, ClassType type);
             void skipMainClass(ParserStatus& status);
             
             StringList parseSuperClasses(ParserStatus& status);
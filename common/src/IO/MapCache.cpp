@@ -0,0 +1,410 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "CollectionUtils.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/NodeVisitor.h"
+#include "Model/World.h"
+
+#include <ostream>
+
+namespace TrenchBroom {
+    namespace IO {
+        /*
+         The cache starts with a header that contains the magic number, the format version, the map format and the
+         size and CRC32 checksum of the map file. It is followed by the world's attributes and file position, the children of the default
+         layer and the custom layers. Each layer consists of its name, its file position and its children. Nodes are
+         written depth first, each one is prefixed with its type. All strings are interned: a string is written as its
+         index in the table of strings read so far, and the first occurrence of a string is followed by its length and
+         its characters.
+         */
+        static const uint32_t Magic = 0x434D4254; // "TBMC"
+        static const uint32_t Version = 2;
+
+        typedef enum {
+            NodeType_Group = 1,
+            NodeType_Entity = 2,
+            NodeType_Brush = 3
+        } NodeType;
+
+        namespace MapCache {
+            Path cachePath(const Path& mapPath) {
+                return mapPath.addExtension("tbcache");
+            }
+
+            bool isUpToDate(const Path& mapPath) {
+                const Path path = cachePath(mapPath);
+                return Disk::fileExists(path) && Disk::fileModificationTime(path) >= Disk::fileModificationTime(mapPath);
+            }
+
+            struct CrcTable {
+                uint32_t values[256];
+
+                CrcTable() {
+                    for (uint32_t i = 0; i < 256; ++i) {
+                        uint32_t crc = i;
+                        for (size_t j = 0; j < 8; ++j)
+                            crc = (crc & 1) != 0 ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+                        values[i] = crc;
+                    }
+                }
+            };
+
+            uint32_t checksum(const char* begin, const char* end) {
+                static const CrcTable table;
+                uint32_t crc = 0xFFFFFFFF;
+                for (const char* c = begin; c < end; ++c)
+                    crc = table.values[(crc ^ static_cast<unsigned char>(*c)) & 0xFF] ^ (crc >> 8);
+                return crc ^ 0xFFFFFFFF;
+            }
+        }
+
+        class MapCacheWriter::WriteNode : public Model::ConstNodeVisitor {
+        private:
+            MapCacheWriter& m_writer;
+        public:
+            WriteNode(MapCacheWriter& writer) :
+            m_writer(writer) {}
+        private:
+            void doVisit(const Model::World* world) override {}
+            void doVisit(const Model::Layer* layer) override {}
+
+            void doVisit(const Model::Group* group) override {
+                m_writer.write<uint8_t>(NodeType_Group);
+                m_writer.writeString(group->name());
+                m_writer.writeFilePosition(group);
+                m_writer.writeChildren(group);
+            }
+
+            void doVisit(const Model::Entity* entity) override {
+                m_writer.write<uint8_t>(NodeType_Entity);
+                m_writer.writeAttributes(entity->attributes());
+                m_writer.writeFilePosition(entity);
+                m_writer.writeChildren(entity);
+            }
+
+            void doVisit(const Model::Brush* brush) override {
+                m_writer.write<uint8_t>(NodeType_Brush);
+                m_writer.writeFilePosition(brush);
+
+                const Model::BrushFaceList& faces = brush->faces();
+                m_writer.write<uint32_t>(static_cast<uint32_t>(faces.size()));
+                for (const Model::BrushFace* face : faces)
+                    m_writer.writeBrushFace(face);
+            }
+        };
+
+        MapCacheWriter::MapCacheWriter(const Model::World* world, const char* mapBegin, const char* mapEnd, std::ostream& stream) :
+        m_world(world),
+        m_mapFileSize(static_cast<size_t>(mapEnd - mapBegin)),
+        m_mapChecksum(MapCache::checksum(mapBegin, mapEnd)),
+        m_stream(stream) {
+            ensure(m_world != nullptr, "world is null");
+        }
+
+        void MapCacheWriter::writeCache() {
+            m_strings.clear();
+
+            write<uint32_t>(Magic);
+            write<uint32_t>(Version);
+            write<uint32_t>(static_cast<uint32_t>(m_world->format()));
+            write<uint64_t>(static_cast<uint64_t>(m_mapFileSize));
+            write<uint32_t>(m_mapChecksum);
+
+            writeAttributes(m_world->attributes());
+            writeFilePosition(m_world);
+            writeChildren(m_world->defaultLayer());
+
+            const Model::LayerList customLayers = m_world->customLayers();
+            write<uint32_t>(static_cast<uint32_t>(customLayers.size()));
+            for (const Model::Layer* layer : customLayers)
+                writeLayer(layer);
+        }
+
+        void MapCacheWriter::writeLayer(const Model::Layer* layer) {
+            writeString(layer->name());
+            writeFilePosition(layer);
+            writeChildren(layer);
+        }
+
+        void MapCacheWriter::writeChildren(const Model::Node* node) {
+            write<uint32_t>(static_cast<uint32_t>(node->childCount()));
+
+            WriteNode writeNode(*this);
+            node->iterate(writeNode);
+        }
+
+        void MapCacheWriter::writeBrushFace(const Model::BrushFace* face) {
+            const Model::BrushFace::Points& points = face->points();
+            writeVec(points[0]);
+            writeVec(points[1]);
+            writeVec(points[2]);
+
+            const Model::BrushFaceAttributes& attribs = face->attribs();
+            writeString(attribs.textureName());
+            write<float>(attribs.xOffset());
+            write<float>(attribs.yOffset());
+            write<float>(attribs.rotation());
+            write<float>(attribs.xScale());
+            write<float>(attribs.yScale());
+            write<int32_t>(attribs.surfaceContents());
+            write<int32_t>(attribs.surfaceFlags());
+            write<float>(attribs.surfaceValue());
+
+            if (m_world->format() == Model::MapFormat::Valve) {
+                writeVec(face->textureXAxis());
+                writeVec(face->textureYAxis());
+            }
+        }
+
+        void MapCacheWriter::writeAttributes(const Model::EntityAttribute::List& attributes) {
+            write<uint32_t>(static_cast<uint32_t>(attributes.size()));
+            for (const Model::EntityAttribute& attribute : attributes) {
+                writeString(attribute.name());
+                writeString(attribute.value());
+            }
+        }
+
+        void MapCacheWriter::writeFilePosition(const Model::Node* node) {
+            write<uint64_t>(static_cast<uint64_t>(node->lineNumber()));
+            write<uint64_t>(static_cast<uint64_t>(node->lineCount()));
+        }
+
+        void MapCacheWriter::writeString(const String& str) {
+            const auto result = m_strings.insert(std::make_pair(str, static_cast<unsigned int>(m_strings.size())));
+            write<uint32_t>(result.first->second);
+            if (result.second) {
+                write<uint32_t>(static_cast<uint32_t>(str.size()));
+                m_stream.write(str.data(), static_cast<std::streamsize>(str.size()));
+            }
+        }
+
+        void MapCacheWriter::writeVec(const Vec3& vec) {
+            write<double>(vec.x());
+            write<double>(vec.y());
+            write<double>(vec.z());
+        }
+
+        MapCacheReader::MapCacheReader(const char* begin, const char* end, const Model::BrushContentTypeBuilder* brushContentTypeBuilder) :
+        m_reader(begin, end),
+        m_brushContentTypeBuilder(brushContentTypeBuilder),
+        m_format(Model::MapFormat::Unknown),
+        m_world(nullptr) {}
+
+        Model::World* MapCacheReader::read(const Model::MapFormat::Type format, const BBox3& worldBounds, const char* mapBegin, const char* mapEnd) {
+            m_format = format;
+            m_worldBounds = worldBounds;
+            m_strings.clear();
+
+            readHeader(mapBegin, mapEnd);
+
+            assert(m_world == nullptr);
+            m_world = new Model::World(m_format, m_brushContentTypeBuilder, m_worldBounds);
+            m_world->disableNodeTreeUpdates();
+
+            try {
+                readWorld();
+            } catch (...) {
+                delete m_world;
+                m_world = nullptr;
+                throw;
+            }
+
+            Model::World* world = m_world;
+            m_world = nullptr;
+
+            world->rebuildNodeTree();
+            world->enableNodeTreeUpdates();
+            return world;
+        }
+
+        void MapCacheReader::readHeader(const char* mapBegin, const char* mapEnd) {
+            if (read<uint32_t>() != Magic)
+                throw FileFormatException("Not a map cache");
+            if (read<uint32_t>() != Version)
+                throw FileFormatException("Unsupported map cache version");
+            if (read<uint32_t>() != static_cast<uint32_t>(m_format))
+                throw FileFormatException("Map cache was written for a different map format");
+            if (read<uint64_t>() != static_cast<uint64_t>(mapEnd - mapBegin))
+                throw FileFormatException("Map cache does not match map file");
+            // the modification time and size of the map file do not reliably tell whether it was changed
+            if (read<uint32_t>() != MapCache::checksum(mapBegin, mapEnd))
+                throw FileFormatException("Map cache does not match map file");
+        }
+
+        void MapCacheReader::readWorld() {
+            m_world->setAttributes(readAttributes());
+            readFilePosition(m_world);
+            readChildren(m_world->defaultLayer());
+
+            const size_t layerCount = readCount();
+            for (size_t i = 0; i < layerCount; ++i) {
+                Model::Layer* layer = m_world->createLayer(readString(), m_worldBounds);
+                m_world->addChild(layer);
+                readFilePosition(layer);
+                readChildren(layer);
+            }
+        }
+
+        void MapCacheReader::readChildren(Model::Node* parent) {
+            const size_t childCount = readCount();
+            for (size_t i = 0; i < childCount; ++i) {
+                switch (read<uint8_t>()) {
+                    case NodeType_Group:
+                        readGroup(parent);
+                        break;
+                    case NodeType_Entity:
+                        readEntity(parent);
+                        break;
+                    case NodeType_Brush:
+                        readBrush(parent);
+                        break;
+                    default:
+                        throw FileFormatException("Unknown node type in map cache");
+                }
+            }
+        }
+
+        void MapCacheReader::readGroup(Model::Node* parent) {
+            Model::Group* group = m_world->createGroup(readString());
+            addChild(parent, group);
+            readFilePosition(group);
+            readChildren(group);
+        }
+
+        void MapCacheReader::readEntity(Model::Node* parent) {
+            const Model::EntityAttribute::List attributes = readAttributes();
+
+            Model::Entity* entity = m_world->createEntity();
+            entity->setAttributes(attributes);
+            addChild(parent, entity);
+            readFilePosition(entity);
+            readChildren(entity);
+        }
+
+        void MapCacheReader::readBrush(Model::Node* parent) {
+            const size_t lineNumber = read<uint64_t>();
+            const size_t lineCount = read<uint64_t>();
+
+            Model::BrushFaceList faces;
+            try {
+                const size_t faceCount = readCount();
+                for (size_t i = 0; i < faceCount; ++i)
+                    faces.push_back(readBrushFace());
+            } catch (...) {
+                VectorUtils::clearAndDelete(faces);
+                throw;
+            }
+
+            // the map reader sorts the faces, too, so that the brushes are identical to those read from the map file
+            Model::BrushFace::sortFaces(faces);
+
+            // the brush deletes the faces if it cannot be built
+            Model::Brush* brush = m_world->createBrush(m_worldBounds, faces);
+            addChild(parent, brush);
+            brush->setFilePosition(lineNumber, lineCount);
+        }
+
+        Model::BrushFace* MapCacheReader::readBrushFace() {
+            const Vec3 point1 = readVec();
+            const Vec3 point2 = readVec();
+            const Vec3 point3 = readVec();
+
+            Model::BrushFaceAttributes attribs(readString());
+            attribs.setXOffset(read<float>());
+            attribs.setYOffset(read<float>());
+            attribs.setRotation(read<float>());
+            attribs.setXScale(read<float>());
+            attribs.setYScale(read<float>());
+            attribs.setSurfaceContents(read<int32_t>());
+            attribs.setSurfaceFlags(read<int32_t>());
+            attribs.setSurfaceValue(read<float>());
+
+            if (m_format == Model::MapFormat::Valve) {
+                const Vec3 texAxisX = readVec();
+                const Vec3 texAxisY = readVec();
+                return m_world->createFace(point1, point2, point3, attribs, texAxisX, texAxisY);
+            }
+            return m_world->createFace(point1, point2, point3, attribs);
+        }
+
+        void MapCacheReader::addChild(Model::Node* parent, Model::Node* child) {
+            if (!parent->canAddChild(child)) {
+                delete child;
+                throw FileFormatException("Invalid node hierarchy in map cache");
+            }
+            parent->addChild(child);
+        }
+
+        Model::EntityAttribute::List MapCacheReader::readAttributes() {
+            Model::EntityAttribute::List result;
+
+            const size_t attributeCount = readCount();
+            for (size_t i = 0; i < attributeCount; ++i) {
+                // copy the name because reading the value may grow the string table
+                const String name = readString();
+                const String& value = readString();
+                result.push_back(Model::EntityAttribute(name, value));
+            }
+
+            return result;
+        }
+
+        void MapCacheReader::readFilePosition(Model::Node* node) {
+            const size_t lineNumber = read<uint64_t>();
+            const size_t lineCount = read<uint64_t>();
+            node->setFilePosition(lineNumber, lineCount);
+        }
+
+        const String& MapCacheReader::readString() {
+            const size_t index = read<uint32_t>();
+            if (index < m_strings.size())
+                return m_strings[index];
+            if (index > m_strings.size())
+                throw FileFormatException("Invalid string index in map cache");
+
+            const size_t length = read<uint32_t>();
+            if (!m_reader.canRead(length))
+                throw FileFormatException("Unexpected end of map cache");
+
+            m_strings.push_back(m_reader.readString(length));
+            return m_strings.back();
+        }
+
+        Vec3 MapCacheReader::readVec() {
+            const double x = read<double>();
+            const double y = read<double>();
+            const double z = read<double>();
+            return Vec3(x, y, z);
+        }
+
+        size_t MapCacheReader::readCount() {
+            return read<uint32_t>();
+        }
+    }
+}
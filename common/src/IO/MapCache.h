@@ -0,0 +1,135 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_MapCache
+#define TrenchBroom_MapCache
+
+#include "Exceptions.h"
+#include "TrenchBroom.h"
+#include "VecMath.h"
+#include "StringUtils.h"
+#include "IO/CharArrayReader.h"
+#include "Model/EntityAttributes.h"
+#include "Model/MapFormat.h"
+#include "Model/ModelTypes.h"
+
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class BrushContentTypeBuilder;
+    }
+
+    namespace IO {
+        class Path;
+
+        /**
+         * A map cache is a binary snapshot of a map's node tree that is written next to the map file when the map is
+         * saved. Reading it only requires a single pass over a memory mapped file and skips tokenizing and parsing the
+         * map source, so reopening a large map is much faster.
+         *
+         * The cache records the size and a CRC32 checksum of the map file it was written for. It is only used if both
+         * still match the map file, otherwise the map is parsed as usual. The map file stays authoritative, so a cache
+         * that is older than the map file is not even opened.
+         */
+        namespace MapCache {
+            Path cachePath(const Path& mapPath);
+            bool isUpToDate(const Path& mapPath);
+            uint32_t checksum(const char* begin, const char* end);
+        }
+
+        class MapCacheWriter {
+        private:
+            class WriteNode;
+            typedef std::map<String, unsigned int> StringIndexMap;
+
+            const Model::World* m_world;
+            size_t m_mapFileSize;
+            uint32_t m_mapChecksum;
+            std::ostream& m_stream;
+            StringIndexMap m_strings;
+        public:
+            /**
+             * Creates a writer for the cache of the given world, which was read from or written to the given map
+             * source.
+             */
+            MapCacheWriter(const Model::World* world, const char* mapBegin, const char* mapEnd, std::ostream& stream);
+
+            void writeCache();
+        private:
+            void writeLayer(const Model::Layer* layer);
+            void writeChildren(const Model::Node* node);
+            void writeBrushFace(const Model::BrushFace* face);
+            void writeAttributes(const Model::EntityAttribute::List& attributes);
+            void writeFilePosition(const Model::Node* node);
+            void writeString(const String& str);
+            void writeVec(const Vec3& vec);
+
+            template <typename T>
+            void write(const T value) {
+                m_stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+        };
+
+        class MapCacheReader {
+        private:
+            CharArrayReader m_reader;
+            const Model::BrushContentTypeBuilder* m_brushContentTypeBuilder;
+            Model::MapFormat::Type m_format;
+            BBox3 m_worldBounds;
+            Model::World* m_world;
+            std::vector<String> m_strings;
+        public:
+            MapCacheReader(const char* begin, const char* end, const Model::BrushContentTypeBuilder* brushContentTypeBuilder);
+
+            /**
+             * Reads the cached world. Throws a FileFormatException if the cache is damaged, if it was written by an
+             * incompatible version, or if it does not match the given format or map source.
+             */
+            Model::World* read(Model::MapFormat::Type format, const BBox3& worldBounds, const char* mapBegin, const char* mapEnd);
+        private:
+            void readHeader(const char* mapBegin, const char* mapEnd);
+            void readWorld();
+            void readChildren(Model::Node* parent);
+            void readGroup(Model::Node* parent);
+            void readEntity(Model::Node* parent);
+            void readBrush(Model::Node* parent);
+            Model::BrushFace* readBrushFace();
+            void addChild(Model::Node* parent, Model::Node* child);
+            Model::EntityAttribute::List readAttributes();
+            void readFilePosition(Model::Node* node);
+            const String& readString();
+            Vec3 readVec();
+            size_t readCount();
+
+            template <typename T>
+            T read() {
+                if (!m_reader.canRead(sizeof(T)))
+                    throw FileFormatException("Unexpected end of map cache");
+                T result;
+                m_reader.read(reinterpret_cast<char*>(&result), sizeof(T));
+                return result;
+            }
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_MapCache) */
@@ -28,199 +28,9 @@
 #include "IO/IOUtils.h"
 #include "IO/MappedFile.h"
 #include "IO/Path.h"
-#include "Renderer/IndexRangeMap.h"
-#include "Renderer/IndexRangeMapBuilder.h"
-#include "Renderer/Vertex.h"
-#include "Renderer/VertexSpec.h"
 
 namespace TrenchBroom {
     namespace IO {
-        const Vec3f Md2Parser::Normals[162] = {
-            Vec3f(-0.525731f, 0.000000f, 0.850651f),
-            Vec3f(-0.442863f, 0.238856f, 0.864188f),
-            Vec3f(-0.295242f, 0.000000f, 0.955423f),
-            Vec3f(-0.309017f, 0.500000f, 0.809017f),
-            Vec3f(-0.162460f, 0.262866f, 0.951056f),
-            Vec3f(0.000000f, 0.000000f, 1.000000f),
-            Vec3f(0.000000f, 0.850651f, 0.525731f),
-            Vec3f(-0.147621f, 0.716567f, 0.681718f),
-            Vec3f(0.147621f, 0.716567f, 0.681718f),
-            Vec3f(0.000000f, 0.525731f, 0.850651f),
-            Vec3f(0.309017f, 0.500000f, 0.809017f),
-            Vec3f(0.525731f, 0.000000f, 0.850651f),
-            Vec3f(0.295242f, 0.000000f, 0.955423f),
-            Vec3f(0.442863f, 0.238856f, 0.864188f),
-            Vec3f(0.162460f, 0.262866f, 0.951056f),
-            Vec3f(-0.681718f, 0.147621f, 0.716567f),
-            Vec3f(-0.809017f, 0.309017f, 0.500000f),
-            Vec3f(-0.587785f, 0.425325f, 0.688191f),
-            Vec3f(-0.850651f, 0.525731f, 0.000000f),
-            Vec3f(-0.864188f, 0.442863f, 0.238856f),
-            Vec3f(-0.716567f, 0.681718f, 0.147621f),
-            Vec3f(-0.688191f, 0.587785f, 0.425325f),
-            Vec3f(-0.500000f, 0.809017f, 0.309017f),
-            Vec3f(-0.238856f, 0.864188f, 0.442863f),
-            Vec3f(-0.425325f, 0.688191f, 0.587785f),
-            Vec3f(-0.716567f, 0.681718f, -0.147621f),
-            Vec3f(-0.500000f, 0.809017f, -0.309017f),
-            Vec3f(-0.525731f, 0.850651f, 0.000000f),
-            Vec3f(0.000000f, 0.850651f, -0.525731f),
-            Vec3f(-0.238856f, 0.864188f, -0.442863f),
-            Vec3f(0.000000f, 0.955423f, -0.295242f),
-            Vec3f(-0.262866f, 0.951056f, -0.162460f),
-            Vec3f(0.000000f, 1.000000f, 0.000000f),
-            Vec3f(0.000000f, 0.955423f, 0.295242f),
-            Vec3f(-0.262866f, 0.951056f, 0.162460f),
-            Vec3f(0.238856f, 0.864188f, 0.442863f),
-            Vec3f(0.262866f, 0.951056f, 0.162460f),
-            Vec3f(0.500000f, 0.809017f, 0.309017f),
-            Vec3f(0.238856f, 0.864188f, -0.442863f),
-            Vec3f(0.262866f, 0.951056f, -0.162460f),
-            Vec3f(0.500000f, 0.809017f, -0.309017f),
-            Vec3f(0.850651f, 0.525731f, 0.000000f),
-            Vec3f(0.716567f, 0.681718f, 0.147621f),
-            Vec3f(0.716567f, 0.681718f, -0.147621f),
-            Vec3f(0.525731f, 0.850651f, 0.000000f),
-            Vec3f(0.425325f, 0.688191f, 0.587785f),
-            Vec3f(0.864188f, 0.442863f, 0.238856f),
-            Vec3f(0.688191f, 0.587785f, 0.425325f),
-            Vec3f(0.809017f, 0.309017f, 0.500000f),
-            Vec3f(0.681718f, 0.147621f, 0.716567f),
-            Vec3f(0.587785f, 0.425325f, 0.688191f),
-            Vec3f(0.955423f, 0.295242f, 0.000000f),
-            Vec3f(1.000000f, 0.000000f, 0.000000f),
-            Vec3f(0.951056f, 0.162460f, 0.262866f),
-            Vec3f(0.850651f, -0.525731f, 0.000000f),
-            Vec3f(0.955423f, -0.295242f, 0.000000f),
-            Vec3f(0.864188f, -0.442863f, 0.238856f),
-            Vec3f(0.951056f, -0.162460f, 0.262866f),
-            Vec3f(0.809017f, -0.309017f, 0.500000f),
-            Vec3f(0.681718f, -0.147621f, 0.716567f),
-            Vec3f(0.850651f, 0.000000f, 0.525731f),
-            Vec3f(0.864188f, 0.442863f, -0.238856f),
-            Vec3f(0.809017f, 0.309017f, -0.500000f),
-            Vec3f(0.951056f, 0.162460f, -0.262866f),
-            Vec3f(0.525731f, 0.000000f, -0.850651f),
-            Vec3f(0.681718f, 0.147621f, -0.716567f),
-            Vec3f(0.681718f, -0.147621f, -0.716567f),
-            Vec3f(0.850651f, 0.000000f, -0.525731f),
-            Vec3f(0.809017f, -0.309017f, -0.500000f),
-            Vec3f(0.864188f, -0.442863f, -0.238856f),
-            Vec3f(0.951056f, -0.162460f, -0.262866f),
-            Vec3f(0.147621f, 0.716567f, -0.681718f),
-            Vec3f(0.309017f, 0.500000f, -0.809017f),
-            Vec3f(0.425325f, 0.688191f, -0.587785f),
-            Vec3f(0.442863f, 0.238856f, -0.864188f),
-            Vec3f(0.587785f, 0.425325f, -0.688191f),
-            Vec3f(0.688191f, 0.587785f, -0.425325f),
-            Vec3f(-0.147621f, 0.716567f, -0.681718f),
-            Vec3f(-0.309017f, 0.500000f, -0.809017f),
-            Vec3f(0.000000f, 0.525731f, -0.850651f),
-            Vec3f(-0.525731f, 0.000000f, -0.850651f),
-            Vec3f(-0.442863f, 0.238856f, -0.864188f),
-            Vec3f(-0.295242f, 0.000000f, -0.955423f),
-            Vec3f(-0.162460f, 0.262866f, -0.951056f),
-            Vec3f(0.000000f, 0.000000f, -1.000000f),
-            Vec3f(0.295242f, 0.000000f, -0.955423f),
-            Vec3f(0.162460f, 0.262866f, -0.951056f),
-            Vec3f(-0.442863f, -0.238856f, -0.864188f),
-            Vec3f(-0.309017f, -0.500000f, -0.809017f),
-            Vec3f(-0.162460f, -0.262866f, -0.951056f),
-            Vec3f(0.000000f, -0.850651f, -0.525731f),
-            Vec3f(-0.147621f, -0.716567f, -0.681718f),
-            Vec3f(0.147621f, -0.716567f, -0.681718f),
-            Vec3f(0.000000f, -0.525731f, -0.850651f),
-            Vec3f(0.309017f, -0.500000f, -0.809017f),
-            Vec3f(0.442863f, -0.238856f, -0.864188f),
-            Vec3f(0.162460f, -0.262866f, -0.951056f),
-            Vec3f(0.238856f, -0.864188f, -0.442863f),
-            Vec3f(0.500000f, -0.809017f, -0.309017f),
-            Vec3f(0.425325f, -0.688191f, -0.587785f),
-            Vec3f(0.716567f, -0.681718f, -0.147621f),
-            Vec3f(0.688191f, -0.587785f, -0.425325f),
-            Vec3f(0.587785f, -0.425325f, -0.688191f),
-            Vec3f(0.000000f, -0.955423f, -0.295242f),
-            Vec3f(0.000000f, -1.000000f, 0.000000f),
-            Vec3f(0.262866f, -0.951056f, -0.162460f),
-            Vec3f(0.000000f, -0.850651f, 0.525731f),
-            Vec3f(0.000000f, -0.955423f, 0.295242f),
-            Vec3f(0.238856f, -0.864188f, 0.442863f),
-            Vec3f(0.262866f, -0.951056f, 0.162460f),
-            Vec3f(0.500000f, -0.809017f, 0.309017f),
-            Vec3f(0.716567f, -0.681718f, 0.147621f),
-            Vec3f(0.525731f, -0.850651f, 0.000000f),
-            Vec3f(-0.238856f, -0.864188f, -0.442863f),
-            Vec3f(-0.500000f, -0.809017f, -0.309017f),
-            Vec3f(-0.262866f, -0.951056f, -0.162460f),
-            Vec3f(-0.850651f, -0.525731f, 0.000000f),
-            Vec3f(-0.716567f, -0.681718f, -0.147621f),
-            Vec3f(-0.716567f, -0.681718f, 0.147621f),
-            Vec3f(-0.525731f, -0.850651f, 0.000000f),
-            Vec3f(-0.500000f, -0.809017f, 0.309017f),
-            Vec3f(-0.238856f, -0.864188f, 0.442863f),
-            Vec3f(-0.262866f, -0.951056f, 0.162460f),
-            Vec3f(-0.864188f, -0.442863f, 0.238856f),
-            Vec3f(-0.809017f, -0.309017f, 0.500000f),
-            Vec3f(-0.688191f, -0.587785f, 0.425325f),
-            Vec3f(-0.681718f, -0.147621f, 0.716567f),
-            Vec3f(-0.442863f, -0.238856f, 0.864188f),
-            Vec3f(-0.587785f, -0.425325f, 0.688191f),
-            Vec3f(-0.309017f, -0.500000f, 0.809017f),
-            Vec3f(-0.147621f, -0.716567f, 0.681718f),
-            Vec3f(-0.425325f, -0.688191f, 0.587785f),
-            Vec3f(-0.162460f, -0.262866f, 0.951056f),
-            Vec3f(0.442863f, -0.238856f, 0.864188f),
-            Vec3f(0.162460f, -0.262866f, 0.951056f),
-            Vec3f(0.309017f, -0.500000f, 0.809017f),
-            Vec3f(0.147621f, -0.716567f, 0.681718f),
-            Vec3f(0.000000f, -0.525731f, 0.850651f),
-            Vec3f(0.425325f, -0.688191f, 0.587785f),
-            Vec3f(0.587785f, -0.425325f, 0.688191f),
-            Vec3f(0.688191f, -0.587785f, 0.425325f),
-            Vec3f(-0.955423f, 0.295242f, 0.000000f),
-            Vec3f(-0.951056f, 0.162460f, 0.262866f),
-            Vec3f(-1.000000f, 0.000000f, 0.000000f),
-            Vec3f(-0.850651f, 0.000000f, 0.525731f),
-            Vec3f(-0.955423f, -0.295242f, 0.000000f),
-            Vec3f(-0.951056f, -0.162460f, 0.262866f),
-            Vec3f(-0.864188f, 0.442863f, -0.238856f),
-            Vec3f(-0.951056f, 0.162460f, -0.262866f),
-            Vec3f(-0.809017f, 0.309017f, -0.500000f),
-            Vec3f(-0.864188f, -0.442863f, -0.238856f),
-            Vec3f(-0.951056f, -0.162460f, -0.262866f),
-            Vec3f(-0.809017f, -0.309017f, -0.500000f),
-            Vec3f(-0.681718f, 0.147621f, -0.716567f),
-            Vec3f(-0.681718f, -0.147621f, -0.716567f),
-            Vec3f(-0.850651f, 0.000000f, -0.525731f),
-            Vec3f(-0.688191f, 0.587785f, -0.425325f),
-            Vec3f(-0.587785f, 0.425325f, -0.688191f),
-            Vec3f(-0.425325f, 0.688191f, -0.587785f),
-            Vec3f(-0.425325f, -0.688191f, -0.587785f),
-            Vec3f(-0.587785f, -0.425325f, -0.688191f),
-            Vec3f(-0.688191f, -0.587785f, -0.425325f)
-        };
-        
-        Md2Parser::Md2Frame::Md2Frame(const size_t vertexCount) :
-        vertices(vertexCount) {}
-
-        Vec3f Md2Parser::Md2Frame::vertex(const size_t index) const {
-            const Md2Vertex& vertex = vertices[index];
-            const Vec3f position(static_cast<float>(vertex.x),
-                                 static_cast<float>(vertex.y),
-                                 static_cast<float>(vertex.z));
-            return position * scale + offset;
-        }
-
-        const Vec3f& Md2Parser::Md2Frame::normal(const size_t index) const {
-            const Md2Vertex& vertex = vertices[index];
-            return Normals[vertex.normalIndex];
-        }
-
-        Md2Parser::Md2Mesh::Md2Mesh(const int i_vertexCount) :
-        type(i_vertexCount < 0 ? Fan : Strip),
-        vertexCount(static_cast<size_t>(i_vertexCount < 0 ? -i_vertexCount : i_vertexCount)),
-        vertices(vertexCount) {}
-
         Md2Parser::Md2Parser(const String& name, const char* begin, const char* end, const Assets::Palette& palette, const FileSystem& fs) :
         m_name(name),
         m_begin(begin),
@@ -257,8 +67,8 @@ namespace TrenchBroom {
             const size_t commandOffset = readSize<int32_t>(cursor);
 
             const Md2SkinList skins = parseSkins(m_begin + skinOffset, skinCount);
-            const Md2FrameList frames = parseFrames(m_begin + frameOffset, frameCount, frameVertexCount);
-            const Md2MeshList meshes = parseMeshes(m_begin + commandOffset, commandCount);
+            const Assets::Md2Model::PackedFrameList frames = parseFrames(m_begin + frameOffset, frameCount, frameVertexCount);
+            const Assets::Md2Model::MeshList meshes = parseMeshes(m_begin + commandOffset, commandCount);
             
             return buildModel(skins, frames, meshes);
         }
@@ -269,27 +79,27 @@ namespace TrenchBroom {
             return skins;
         }
 
-        Md2Parser::Md2FrameList Md2Parser::parseFrames(const char* begin, const size_t frameCount, const size_t frameVertexCount) {
-            Md2FrameList frames(frameCount, Md2Frame(frameVertexCount));
+        Assets::Md2Model::PackedFrameList Md2Parser::parseFrames(const char* begin, const size_t frameCount, const size_t frameVertexCount) {
+            Assets::Md2Model::PackedFrameList frames(frameCount, Assets::Md2Model::PackedFrame(frameVertexCount));
 
             const char* cursor = begin;
             for (size_t i = 0; i < frameCount; ++i) {
                 frames[i].scale = readVec3f(cursor);
                 frames[i].offset = readVec3f(cursor);
-                readBytes(cursor, frames[i].name, Md2Layout::FrameNameLength);
+                cursor += Md2Layout::FrameNameLength;
                 readVector(cursor, frames[i].vertices);
             }
             
             return frames;
         }
 
-        Md2Parser::Md2MeshList Md2Parser::parseMeshes(const char* begin, const size_t commandCount) {
-            Md2MeshList meshes;
+        Assets::Md2Model::MeshList Md2Parser::parseMeshes(const char* begin, const size_t commandCount) {
+            Assets::Md2Model::MeshList meshes;
             
             const char* cursor = begin;
             const char* end = begin + commandCount * 4;
             while (cursor < end) {
-                Md2Mesh mesh(readInt<int32_t>(cursor));
+                Assets::Md2Model::Mesh mesh(readInt<int32_t>(cursor));
                 for (size_t i = 0; i < mesh.vertexCount; ++i) {
                     assert(cursor < end);
                     mesh.vertices[i].texCoords[0] = readFloat<float>(cursor);
@@ -303,10 +113,9 @@ namespace TrenchBroom {
             return meshes;
         }
 
-        Assets::EntityModel* Md2Parser::buildModel(const Md2SkinList& skins, const Md2FrameList& frames, const Md2MeshList& meshes) {
+        Assets::EntityModel* Md2Parser::buildModel(const Md2SkinList& skins, const Assets::Md2Model::PackedFrameList& frames, const Assets::Md2Model::MeshList& meshes) {
             const Assets::TextureList modelTextures = loadTextures(skins);
-            const Assets::Md2Model::FrameList modelFrames = buildFrames(frames, meshes);
-            return new Assets::Md2Model(m_name, modelTextures, modelFrames);
+            return new Assets::Md2Model(m_name, modelTextures, frames, meshes);
         }
 
         Assets::TextureList Md2Parser::loadTextures(const Md2SkinList& skins) {
@@ -336,56 +145,5 @@ namespace TrenchBroom {
             
             return new Assets::Texture(skin.name, image.width(), image.height(), avgColor, rgbaImage, GL_RGBA, Assets::TextureType::Opaque);
         }
-
-        Assets::Md2Model::FrameList Md2Parser::buildFrames(const Md2FrameList& frames, const Md2MeshList& meshes) {
-            Assets::Md2Model::FrameList modelFrames;
-            modelFrames.reserve(frames.size());
-            
-            for (const Md2Frame& frame : frames)
-                modelFrames.push_back(buildFrame(frame, meshes));
-            return modelFrames;
-        }
-
-        Assets::Md2Model::Frame* Md2Parser::buildFrame(const Md2Frame& frame, const Md2MeshList& meshes) {
-            size_t vertexCount = 0;
-            Renderer::IndexRangeMap::Size size;
-            for (const Md2Mesh& md2Mesh : meshes) {
-                vertexCount += md2Mesh.vertices.size();
-                if (md2Mesh.type == Md2Mesh::Fan)
-                    size.inc(GL_TRIANGLE_FAN);
-                else
-                    size.inc(GL_TRIANGLE_STRIP);
-            }
-
-            Renderer::IndexRangeMapBuilder<Assets::Md2Model::VertexSpec> builder(vertexCount, size);
-            for (const Md2Mesh& md2Mesh : meshes) {
-                if (!md2Mesh.vertices.empty()) {
-                    vertexCount += md2Mesh.vertices.size();
-                    if (md2Mesh.type == Md2Mesh::Fan)
-                        builder.addTriangleFan(getVertices(frame, md2Mesh.vertices));
-                    else
-                        builder.addTriangleStrip(getVertices(frame, md2Mesh.vertices));
-                }
-            }
-            
-            return new Assets::Md2Model::Frame(builder.vertices(), builder.indexArray());
-        }
-        
-        Assets::Md2Model::VertexList Md2Parser::getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) const {
-            typedef Assets::Md2Model::Vertex Vertex;
-
-            Vertex::List result(0);
-            result.reserve(meshVertices.size());
-            
-            for (const Md2MeshVertex& md2MeshVertex : meshVertices) {
-                const Vec3f position = frame.vertex(md2MeshVertex.vertexIndex);
-                const Vec3f& normal = frame.normal(md2MeshVertex.vertexIndex);
-                const Vec2f& texCoords = md2MeshVertex.texCoords;
-                
-                result.push_back(Vertex(position, normal, texCoords));
-            }
-            
-            return result;
-        }
     }
 }
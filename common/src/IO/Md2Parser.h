@@ -48,52 +48,11 @@ namespace TrenchBroom {
         // see http://tfc.duke.free.fr/coding/md2-specs-en.html
         class Md2Parser : public EntityModelParser {
         private:
-            static const Vec3f Normals[162];
-
             struct Md2Skin {
                 char name[Md2Layout::SkinNameLength];
             };
             typedef std::vector<Md2Skin> Md2SkinList;
             
-            struct Md2Vertex {
-                unsigned char x, y, z;
-                unsigned char normalIndex;
-            };
-            typedef std::vector<Md2Vertex> Md2VertexList;
-            
-            struct Md2Frame {
-                Vec3f scale;
-                Vec3f offset;
-                char name[Md2Layout::FrameNameLength];
-                Md2VertexList vertices;
-                
-                Md2Frame(size_t vertexCount);
-                Vec3f vertex(size_t index) const;
-                const Vec3f& normal(size_t index) const;
-            };
-            typedef std::vector<Md2Frame> Md2FrameList;
-
-            struct Md2MeshVertex {
-                Vec2f texCoords;
-                size_t vertexIndex;
-            };
-            typedef std::vector<Md2MeshVertex> Md2MeshVertexList;
-            
-            struct Md2Mesh {
-                enum Type {
-                    Fan,
-                    Strip
-                };
-                
-                Type type;
-                size_t vertexCount;
-                Md2MeshVertexList vertices;
-                
-                Md2Mesh(int i_vertexCount);
-            };
-            typedef std::vector<Md2Mesh> Md2MeshList;
-            
-            
             String m_name;
             const char* m_begin;
             /* const char* m_end; */
@@ -104,14 +63,11 @@ namespace TrenchBroom {
         private:
             Assets::EntityModel* doParseModel() override;
             Md2SkinList parseSkins(const char* begin, const size_t skinCount);
-            Md2FrameList parseFrames(const char* begin, const size_t frameCount, const size_t frameVertexCount);
-            Md2MeshList parseMeshes(const char* begin, const size_t commandCount);
-            Assets::EntityModel* buildModel(const Md2SkinList& skins, const Md2FrameList& frames, const Md2MeshList& meshes);
+            Assets::Md2Model::PackedFrameList parseFrames(const char* begin, const size_t frameCount, const size_t frameVertexCount);
+            Assets::Md2Model::MeshList parseMeshes(const char* begin, const size_t commandCount);
+            Assets::EntityModel* buildModel(const Md2SkinList& skins, const Assets::Md2Model::PackedFrameList& frames, const Assets::Md2Model::MeshList& meshes);
             Assets::TextureList loadTextures(const Md2SkinList& skins);
             Assets::Texture* readTexture(const Md2Skin& skin);
-            Assets::Md2Model::FrameList buildFrames(const Md2FrameList& frames, const Md2MeshList& meshes);
-            Assets::Md2Model::Frame* buildFrame(const Md2Frame& frame, const Md2MeshList& meshes);
-            Assets::Md2Model::VertexList getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) const;
         };
     }
 }
@@ -234,9 +234,10 @@ namespace TrenchBroom {
             const int flags = readInt<int32_t>(cursor);
             
             parseSkins(cursor, *model, skinCount, skinWidth, skinHeight, flags);
-            const MdlSkinVertexList skinVertices = parseSkinVertices(cursor, skinVertexCount);
-            const MdlSkinTriangleList skinTriangles = parseSkinTriangles(cursor, skinTriangleCount);
-            parseFrames(cursor, *model, frameCount, skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale);
+            const Assets::MdlMesh::SkinVertexList skinVertices = parseSkinVertices(cursor, skinVertexCount);
+            const Assets::MdlMesh::SkinTriangleList skinTriangles = parseSkinTriangles(cursor, skinTriangleCount);
+            const Assets::MdlMeshPtr mesh(new Assets::MdlMesh(skinVertices, skinTriangles, skinWidth, skinHeight, origin, scale));
+            parseFrames(cursor, *model, frameCount, mesh);
 
             assert(cursor <= m_end);
             return model;
@@ -291,8 +292,8 @@ namespace TrenchBroom {
             }
         }
 
-        MdlParser::MdlSkinVertexList MdlParser::parseSkinVertices(const char*& cursor, const size_t count) {
-            MdlSkinVertexList vertices(count);
+        Assets::MdlMesh::SkinVertexList MdlParser::parseSkinVertices(const char*& cursor, const size_t count) {
+            Assets::MdlMesh::SkinVertexList vertices(count);
             for (size_t i = 0; i < count; ++i) {
                 vertices[i].onseam = readBool<int32_t>(cursor);
                 vertices[i].s = readInt<int32_t>(cursor);
@@ -301,8 +302,8 @@ namespace TrenchBroom {
             return vertices;
         }
 
-        MdlParser::MdlSkinTriangleList MdlParser::parseSkinTriangles(const char*& cursor, const size_t count) {
-            MdlSkinTriangleList triangles(count);
+        Assets::MdlMesh::SkinTriangleList MdlParser::parseSkinTriangles(const char*& cursor, const size_t count) {
+            Assets::MdlMesh::SkinTriangleList triangles(count);
             for (size_t i = 0; i < count; ++i) {
                 triangles[i].front = readBool<int32_t>(cursor);
                 for (size_t j = 0; j < 3; ++j)
@@ -311,11 +312,11 @@ namespace TrenchBroom {
             return triangles;
         }
 
-        void MdlParser::parseFrames(const char*& cursor, Assets::MdlModel& model, const size_t count, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale) {
+        void MdlParser::parseFrames(const char*& cursor, Assets::MdlModel& model, const size_t count, Assets::MdlMeshPtr mesh) {
             for (size_t i = 0; i < count; ++i) {
                 const int type = readInt<int32_t>(cursor);
                 if (type == 0) { // single frame
-                    model.addFrame(parseFrame(cursor, skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale));
+                    model.addFrame(parseFrame(cursor, mesh));
                 } else { // frame group
                     Assets::MdlFrameGroup* frameGroup = new Assets::MdlFrameGroup();
                     
@@ -327,7 +328,7 @@ namespace TrenchBroom {
 
                     for (size_t j = 0; j < groupFrameCount; ++j) {
                         const float time = readFloat<float>(timeCursor);
-                        Assets::MdlFrame* frame = parseFrame(frameCursor, skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale);
+                        Assets::MdlFrame* frame = parseFrame(frameCursor, mesh);
                         frameGroup->addFrame(frame, time);
                     }
                     
@@ -337,55 +338,20 @@ namespace TrenchBroom {
             }
         }
 
-        Assets::MdlFrame* MdlParser::parseFrame(const char*& cursor, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale) {
+        Assets::MdlFrame* MdlParser::parseFrame(const char*& cursor, Assets::MdlMeshPtr mesh) {
             char name[MdlLayout::SimpleFrameLength + 1];
             name[MdlLayout::SimpleFrameLength] = 0;
             cursor += MdlLayout::SimpleFrameName;
             readBytes(cursor, name, MdlLayout::SimpleFrameLength);
             
-            PackedFrameVertexList packedVertices(skinVertices.size());
-            for (size_t i = 0; i < skinVertices.size(); ++i)
+            const size_t vertexCount = mesh->skinVertices().size();
+            Assets::MdlMesh::PackedVertexList packedVertices(vertexCount);
+            for (size_t i = 0; i < vertexCount; ++i)
                 for (size_t j = 0; j < 4; ++j)
                     packedVertices[i][j] = static_cast<unsigned char>(*cursor++);
             
-            Vec3f::List positions(skinVertices.size());
-            BBox3f bounds;
-            
-            positions[0] = unpackFrameVertex(packedVertices[0], origin, scale);
-            bounds.min = bounds.max = positions[0];
-            
-            for (size_t i = 1; i < skinVertices.size(); ++i) {
-                positions[i] = unpackFrameVertex(packedVertices[i], origin, scale);
-                bounds.mergeWith(positions[i]);
-            }
-            
-            Assets::MdlFrame::VertexList frameTriangles;
-            frameTriangles.reserve(skinTriangles.size());
-            for (size_t i = 0; i < skinTriangles.size(); ++i) {
-                const MdlSkinTriangle& triangle = skinTriangles[i];
-                for (size_t j = 0; j < 3; ++j) {
-                    const size_t vertexIndex = triangle.vertices[j];
-                    const MdlSkinVertex& skinVertex = skinVertices[vertexIndex];
-                    // const size_t normalIndex = static_cast<size_t>(packedVertices[vertexIndex].w());
-                    
-                    Vec2f texCoords (static_cast<float>(skinVertex.s) / static_cast<float>(skinWidth),
-                                     static_cast<float>(skinVertex.t) / static_cast<float>(skinHeight));
-                    if (skinVertex.onseam && !triangle.front)
-                        texCoords[0] += 0.5f;
-                    
-                    frameTriangles.push_back(Assets::MdlFrame::Vertex(positions[vertexIndex], texCoords));
-                }
-            }
-            
-            assert(frameTriangles.size()%3 == 0);
-            return new Assets::MdlFrame(String(name), frameTriangles, bounds);
-        }
-
-        Vec3f MdlParser::unpackFrameVertex(const PackedFrameVertex& vertex, const Vec3f& origin, const Vec3f& scale) const {
-            Vec3f result;
-            for (size_t i = 0; i < 3; ++i)
-                result[i] = origin[i] + scale[i]*static_cast<float>(vertex[i]);
-            return result;
+            // the triangles are built when the frame is used
+            return new Assets::MdlFrame(String(name), mesh, packedVertices);
         }
     }
 }
@@ -24,14 +24,13 @@
 #include "StringUtils.h"
 #include "ByteBuffer.h"
 #include "Assets/AssetTypes.h"
+#include "Assets/MdlModel.h"
 #include "IO/EntityModelParser.h"
 
 #include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
-        class MdlModel;
-        class MdlFrame;
         class Palette;
     }
     
@@ -40,22 +39,6 @@ namespace TrenchBroom {
         private:
             static const Vec3f Normals[162];
             
-            struct MdlSkinVertex {
-                bool onseam;
-                int s;
-                int t;
-            };
-            
-            struct MdlSkinTriangle {
-                bool front;
-                size_t vertices[3];
-            };
-            
-            typedef std::vector<MdlSkinVertex> MdlSkinVertexList;
-            typedef std::vector<MdlSkinTriangle> MdlSkinTriangleList;
-            typedef Vec<unsigned char, 4> PackedFrameVertex;
-            typedef std::vector<PackedFrameVertex> PackedFrameVertexList;
-            
             String m_name;
             const char* m_begin;
             const char* m_end;
@@ -66,11 +49,10 @@ namespace TrenchBroom {
             Assets::EntityModel* doParseModel() override;
             
             void parseSkins(const char*& cursor, Assets::MdlModel& model, size_t count, size_t width, size_t height, int flags);
-            MdlSkinVertexList parseSkinVertices(const char*& cursor, const size_t count);
-            MdlSkinTriangleList parseSkinTriangles(const char*& cursor, const size_t count);
-            void parseFrames(const char*& cursor, Assets::MdlModel& model, const size_t count, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale);
-            Assets::MdlFrame* parseFrame(const char*& cursor, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale);
-            Vec3f unpackFrameVertex(const PackedFrameVertex& vertex, const Vec3f& origin, const Vec3f& scale) const;
+            Assets::MdlMesh::SkinVertexList parseSkinVertices(const char*& cursor, const size_t count);
+            Assets::MdlMesh::SkinTriangleList parseSkinTriangles(const char*& cursor, const size_t count);
+            void parseFrames(const char*& cursor, Assets::MdlModel& model, const size_t count, Assets::MdlMeshPtr mesh);
+            Assets::MdlFrame* parseFrame(const char*& cursor, Assets::MdlMeshPtr mesh);
         };
     }
 }
@@ -112,6 +112,7 @@ namespace TrenchBroom {
             const Vec3& normal = face->boundary().normal;
             const size_t normalIndex = m_normals.index(normal);
             
+            const Model::TexCoordProjection texCoordProjection = face->textureCoordProjection();
             const Model::BrushFace::VertexList vertices = face->vertices();
             IndexedVertexList indexedVertices;
             indexedVertices.reserve(vertices.size());
@@ -119,7 +120,7 @@ namespace TrenchBroom {
             for (const Model::BrushVertex* vertex : vertices) {
             Model::BrushFace::VertexList::const_iterator it, end;
                 const Vec3& position = vertex->position();
-                const Vec2f texCoords = face->textureCoords(position);
+                const Vec2f texCoords = texCoordProjection.project(position);
                 
                 const size_t vertexIndex = m_vertices.index(position);
                 const size_t texCoordsIndex = m_texCoords.index(texCoords);
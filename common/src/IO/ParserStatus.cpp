@@ -32,6 +32,10 @@ namespace TrenchBroom {
             doProgress(progress);
         }
 
+        bool ParserStatus::cancelled() const {
+            return doCancelled();
+        }
+
         void ParserStatus::debug(const size_t line, const size_t column, const String& str) {
             log(Logger::LogLevel_Debug, line, column, str);
         }
@@ -94,6 +98,10 @@ namespace TrenchBroom {
             return msg.str();
         }
 
+        bool ParserStatus::doCancelled() const {
+            return false;
+        }
+
         void ParserStatus::doLog(const Logger::LogLevel level, const String& str) {
             if (m_logger != nullptr)
                 m_logger->log(level, str);
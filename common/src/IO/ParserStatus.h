@@ -25,15 +25,24 @@
 
 namespace TrenchBroom {
     namespace IO {
+        class BufferedParserStatus;
+
         class ParserStatus {
         private:
             Logger* m_logger;
+
+            friend class BufferedParserStatus;
         protected:
             ParserStatus(Logger* logger);
         public:
             virtual ~ParserStatus();
         public:
             void progress(double progress);
+            /**
+             * Indicates whether the user has asked to stop parsing. Parsers that support cancellation check this
+             * between top level elements and throw an OperationCancelledException if it returns true.
+             */
+            bool cancelled() const;
 
             void debug(size_t line, size_t column, const String& str);
             void info(size_t line, size_t column, const String& str);
@@ -54,6 +63,7 @@ namespace TrenchBroom {
             String buildMessage(size_t line, const String& str) const;
         private:
             virtual void doProgress(double progress) = 0;
+            virtual bool doCancelled() const;
             virtual void doLog(Logger::LogLevel level, const String& str);
         };
     }
@@ -0,0 +1,37 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PointFileParser.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        PointFileParser::PointFileParser(const char* begin, const char* end) :
+        m_scanner(begin, end) {}
+
+        void PointFileParser::parse(Vec3f::List& points) {
+            while (!m_scanner.eof()) {
+                const float x = m_scanner.readFloat();
+                const float y = m_scanner.readFloat();
+                const float z = m_scanner.readFloat();
+                points.push_back(Vec3f(x, y, z));
+            }
+        }
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_PointFileParser
+#define TrenchBroom_PointFileParser
+
+#include "VecMath.h"
+#include "IO/TextScanner.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Parses the points of a point file directly from the given memory. Every point consists of three numbers,
+         * and line breaks are not significant.
+         */
+        class PointFileParser {
+        private:
+            TextScanner m_scanner;
+        public:
+            PointFileParser(const char* begin, const char* end);
+
+            /**
+             * Appends the points to the given list.
+             */
+            void parse(Vec3f::List& points);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_PointFileParser) */
@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PortalFileParser.h"
+
+#include "Exceptions.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        PortalFileParser::PortalFileParser(const char* begin, const char* end) :
+        m_scanner(begin, end) {}
+
+        void PortalFileParser::parse(Vec3f::List& vertices, std::vector<size_t>& offsets) {
+            const size_t portalCount = parseHeader();
+
+            // most portals are quads
+            offsets.reserve(offsets.size() + portalCount + 1);
+            vertices.reserve(vertices.size() + 4 * portalCount);
+
+            for (size_t i = 0; i < portalCount; ++i) {
+                offsets.push_back(vertices.size());
+                parsePortal(vertices);
+            }
+            offsets.push_back(vertices.size());
+        }
+
+        size_t PortalFileParser::parseHeader() {
+            const size_t line = m_scanner.line();
+            const String formatCode = m_scanner.readWord();
+
+            if (formatCode == "PRT1") {
+                parseCount(); // number of leafs (ignored)
+                return parseCount();
+            } else if (formatCode == "PRT2") {
+                parseCount(); // number of leafs (ignored)
+                parseCount(); // number of clusters (ignored)
+                return parseCount();
+            } else if (formatCode == "PRT1-AM") {
+                parseCount(); // number of clusters (ignored)
+                const size_t portalCount = parseCount();
+                parseCount(); // number of leafs (ignored)
+                return portalCount;
+            } else {
+                throw ParserException(line, 1, "Unknown portal format: " + formatCode);
+            }
+        }
+
+        void PortalFileParser::parsePortal(Vec3f::List& vertices) {
+            const size_t vertexCount = parseCount();
+            if (vertexCount < 3)
+                throw ParserException(m_scanner.line(), m_scanner.column(), "Portal has fewer than three vertices");
+
+            parseCount(); // first leaf (ignored)
+            parseCount(); // second leaf (ignored)
+
+            for (size_t i = 0; i < vertexCount; ++i)
+                vertices.push_back(parseVertex());
+        }
+
+        Vec3f PortalFileParser::parseVertex() {
+            m_scanner.expect('(');
+            const float x = m_scanner.readFloat();
+            const float y = m_scanner.readFloat();
+            const float z = m_scanner.readFloat();
+            m_scanner.expect(')');
+            return Vec3f(x, y, z);
+        }
+
+        size_t PortalFileParser::parseCount() {
+            const int count = m_scanner.readInteger();
+            if (count < 0)
+                throw ParserException(m_scanner.line(), m_scanner.column(), "Expected a non-negative integer");
+            return static_cast<size_t>(count);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_PortalFileParser
+#define TrenchBroom_PortalFileParser
+
+#include "VecMath.h"
+#include "IO/TextScanner.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Parses the portals of a PRT1, PRT1-AM or PRT2 file directly from the given memory. The vertices of all
+         * portals are appended to a single list, so that no memory is allocated per portal or per line.
+         */
+        class PortalFileParser {
+        private:
+            TextScanner m_scanner;
+        public:
+            PortalFileParser(const char* begin, const char* end);
+
+            /**
+             * Appends the vertices of every portal to the given vertex list and the index of its first vertex to the
+             * given offsets. Finally, the vertex count is appended to the offsets, so that portal i consists of the
+             * vertices in [offsets[i], offsets[i+1]).
+             */
+            void parse(Vec3f::List& vertices, std::vector<size_t>& offsets);
+        private:
+            size_t parseHeader();
+            void parsePortal(Vec3f::List& vertices);
+            Vec3f parseVertex();
+            size_t parseCount();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_PortalFileParser) */
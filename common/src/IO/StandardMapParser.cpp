@@ -179,6 +179,7 @@ namespace TrenchBroom {
             while (token.type() != QuakeMapToken::Eof) {
                 expect(QuakeMapToken::OBrace, token);
                 parseEntity(status);
+                updateProgress(status);
                 token = m_tokenizer.peekToken();
             }
         }
@@ -190,6 +191,7 @@ namespace TrenchBroom {
             while (token.type() != QuakeMapToken::Eof) {
                 expect(QuakeMapToken::OBrace, token);
                 parseBrush(status);
+                updateProgress(status);
                 token = m_tokenizer.peekToken();
             }
         }
@@ -215,6 +217,12 @@ namespace TrenchBroom {
             formatSet(format);
         }
 
+        void StandardMapParser::updateProgress(ParserStatus& status) {
+            status.progress(m_tokenizer.progress());
+            if (status.cancelled())
+                throw OperationCancelledException("Parsing cancelled");
+        }
+
         void StandardMapParser::parseEntity(ParserStatus& status) {
             Token token = m_tokenizer.nextToken();
             if (token.type() == QuakeMapToken::Eof)
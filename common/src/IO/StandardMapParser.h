@@ -83,6 +83,7 @@ namespace TrenchBroom {
             void reset();
         private:
             void setFormat(Model::MapFormat::Type format);
+            void updateProgress(ParserStatus& status);
             
             void parseEntity(ParserStatus& status);
             void parseEntityAttribute(Model::EntityAttribute::List& attributes, AttributeNames& names, ParserStatus& status);
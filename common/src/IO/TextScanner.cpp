@@ -0,0 +1,184 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TextScanner.h"
+
+#include "Exceptions.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace TrenchBroom {
+    namespace IO {
+        static bool isWhitespace(const char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        static bool isDelimiter(const char c) {
+            return isWhitespace(c) || c == '(' || c == ')';
+        }
+
+        TextScanner::TextScanner(const char* begin, const char* end) :
+        m_cur(begin),
+        m_end(end),
+        m_lineBegin(begin),
+        m_line(1) {}
+
+        bool TextScanner::eof() {
+            skipWhitespace();
+            return m_cur == m_end;
+        }
+
+        size_t TextScanner::line() const {
+            return m_line;
+        }
+
+        size_t TextScanner::column() const {
+            return static_cast<size_t>(m_cur - m_lineBegin) + 1;
+        }
+
+        String TextScanner::readWord() {
+            skipWhitespace();
+            const char* end = tokenEnd();
+            if (end == m_cur)
+                error("Expected word");
+
+            const String result(m_cur, end);
+            m_cur = end;
+            return result;
+        }
+
+        int TextScanner::readInteger() {
+            skipWhitespace();
+            const char* c = m_cur;
+            const bool negative = c < m_end && *c == '-';
+            if (c < m_end && (*c == '-' || *c == '+'))
+                ++c;
+
+            const char* digits = c;
+            int result = 0;
+            while (c < m_end && *c >= '0' && *c <= '9')
+                result = 10 * result + (*c++ - '0');
+
+            if (c == digits || (c < m_end && !isDelimiter(*c)))
+                error("Expected integer");
+
+            m_cur = c;
+            return negative ? -result : result;
+        }
+
+        float TextScanner::readFloat() {
+            skipWhitespace();
+            const char* end = tokenEnd();
+
+            float result;
+            if (!parseDecimal(m_cur, end, result) && !parseFloat(m_cur, end, result))
+                error("Expected number");
+
+            m_cur = end;
+            return result;
+        }
+
+        bool TextScanner::parseDecimal(const char* begin, const char* end, float& result) {
+            // Numbers without an exponent whose digits form an integer of at most 2^24 are parsed into a mantissa that
+            // is exact in a float, as are the powers of ten up to 10^10 that it is divided by, so the quotient is
+            // rounded correctly. This covers most numbers written by the compilers and is much faster than strtof,
+            // which parses all other numbers.
+            static const float PowersOfTen[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+            static const size_t MaxFractionDigits = 10;
+            static const uint64_t MaxMantissa = uint64_t(1) << 24;
+            static const size_t MaxDigits = 18;
+
+            const char* c = begin;
+            const bool negative = c < end && *c == '-';
+            if (c < end && (*c == '-' || *c == '+'))
+                ++c;
+
+            uint64_t mantissa = 0;
+            size_t digits = 0;
+            size_t fractionDigits = 0;
+            bool fraction = false;
+            for (; c < end; ++c) {
+                if (*c >= '0' && *c <= '9') {
+                    mantissa = 10 * mantissa + static_cast<uint64_t>(*c - '0');
+                    ++digits;
+                    if (fraction)
+                        ++fractionDigits;
+                } else if (*c == '.' && !fraction) {
+                    fraction = true;
+                } else {
+                    return false;
+                }
+            }
+
+            if (digits == 0 || digits > MaxDigits || mantissa > MaxMantissa || fractionDigits > MaxFractionDigits)
+                return false;
+
+            const float value = static_cast<float>(mantissa) / PowersOfTen[fractionDigits];
+            result = negative ? -value : value;
+            return true;
+        }
+
+        bool TextScanner::parseFloat(const char* begin, const char* end, float& result) {
+            // the text is not null terminated, so the number is copied to a buffer
+            static const size_t BufferSize = 64;
+            const size_t length = static_cast<size_t>(end - begin);
+            if (length == 0 || length >= BufferSize)
+                return false;
+
+            char buffer[BufferSize];
+            std::memcpy(buffer, begin, length);
+            buffer[length] = 0;
+
+            char* parsedEnd = nullptr;
+            result = std::strtof(buffer, &parsedEnd);
+            return parsedEnd == buffer + length;
+        }
+
+        void TextScanner::expect(const char c) {
+            skipWhitespace();
+            if (m_cur == m_end || *m_cur != c)
+                error("Expected '" + String(1, c) + "'");
+            ++m_cur;
+        }
+
+        void TextScanner::skipWhitespace() {
+            while (m_cur < m_end && isWhitespace(*m_cur)) {
+                if (*m_cur == '\n') {
+                    ++m_line;
+                    m_lineBegin = m_cur + 1;
+                }
+                ++m_cur;
+            }
+        }
+
+        const char* TextScanner::tokenEnd() const {
+            const char* end = m_cur;
+            while (end < m_end && !isDelimiter(*end))
+                ++end;
+            return end;
+        }
+
+        void TextScanner::error(const String& message) const {
+            throw ParserException(line(), column(), message);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_TextScanner
+#define TrenchBroom_TextScanner
+
+#include "StringUtils.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Reads whitespace separated words, numbers and single characters from text in memory without allocating
+         * memory. Unlike a tokenizer, it does not classify tokens, and it only tracks the position of the current
+         * line, which makes it much faster for large files in simple numeric formats such as portal and point files.
+         *
+         * All read functions skip leading whitespace and throw a ParserException if the text does not match.
+         */
+        class TextScanner {
+        private:
+            const char* m_cur;
+            const char* m_end;
+            const char* m_lineBegin;
+            size_t m_line;
+        public:
+            TextScanner(const char* begin, const char* end);
+
+            /**
+             * Skips whitespace and checks whether the end of the text was reached.
+             */
+            bool eof();
+
+            size_t line() const;
+            size_t column() const;
+
+            String readWord();
+            int readInteger();
+            float readFloat();
+            void expect(char c);
+        private:
+            void skipWhitespace();
+            const char* tokenEnd() const;
+            void error(const String& message) const;
+
+            static bool parseDecimal(const char* begin, const char* end, float& result);
+            static bool parseFloat(const char* begin, const char* end, float& result);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextScanner) */
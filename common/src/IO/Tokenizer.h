@@ -59,11 +59,14 @@ namespace TrenchBroom {
             const char* m_end;
             String m_escapableChars;
             char m_escapeChar;
+            size_t m_firstLine;
+            size_t m_firstColumn;
             size_t m_line;
             size_t m_column;
             bool m_escaped;
         public:
             TokenizerState(const char* begin, const char* end, const String& escapableChars, char escapeChar);
+            TokenizerState(const char* begin, const char* end, const String& escapableChars, char escapeChar, size_t line, size_t column);
             
             size_t length() const;
             const char* begin() const;
@@ -131,6 +134,13 @@ namespace TrenchBroom {
             Tokenizer(const char* begin, const char* end, const String& escapableChars, const char escapeChar) :
             m_state(new TokenizerState(begin, end, escapableChars, escapeChar)) {}
 
+            /**
+             * Creates a tokenizer for a part of a larger text. The given line and column are those of the first
+             * character in the larger text, so that the tokens report their position in the larger text.
+             */
+            Tokenizer(const char* begin, const char* end, const String& escapableChars, const char escapeChar, const size_t line, const size_t column) :
+            m_state(new TokenizerState(begin, end, escapableChars, escapeChar, line, column)) {}
+
             Tokenizer(const String& str, const String& escapableChars, const char escapeChar) :
             m_state(new TokenizerState(str.c_str(), str.c_str() + str.size(), escapableChars, escapeChar)) {}
 
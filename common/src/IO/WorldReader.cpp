@@ -37,7 +37,13 @@ namespace TrenchBroom {
         m_world(nullptr) {}
         
         Model::World* WorldReader::read(Model::MapFormat::Type format, const BBox3& worldBounds, ParserStatus& status) {
-            readEntities(format, worldBounds, status);
+            try {
+                readEntities(format, worldBounds, status);
+            } catch (...) {
+                delete m_world;
+                m_world = nullptr;
+                throw;
+            }
             m_world->rebuildNodeTree();
             m_world->enableNodeTreeUpdates();
             return m_world;
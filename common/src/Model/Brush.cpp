@@ -21,6 +21,7 @@
 
 #include "CollectionUtils.h"
 #include "Macros.h"
+#include "TaskScheduler.h"
 #include "Model/BrushContentTypeBuilder.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
@@ -269,13 +270,6 @@ namespace TrenchBroom {
             }
         };
 
-        class Brush::QueryCallback : public BrushGeometry::Callback {
-        public:
-            Plane3 plane(const BrushFaceGeometry* face) const override {
-                return face->payload()->boundary();
-            }
-        };
-
         class Brush::FaceMatchingCallback {
         public:
             void operator()(BrushFaceGeometry* left, BrushFaceGeometry* right) const {
@@ -293,7 +287,8 @@ namespace TrenchBroom {
         m_contentTypeBuilder(nullptr),
         m_contentType(0),
         m_transparent(false),
-        m_contentTypeValid(true) {
+        m_contentTypeValid(true),
+        m_convexDataValid(false) {
             addFaces(faces);
             try {
                 buildGeometry(worldBounds);
@@ -1083,6 +1078,24 @@ namespace TrenchBroom {
             return brushes;
         }
 
+        std::vector<BrushList> Brush::subtract(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const BrushList& minuends, const Brush* subtrahend) {
+            // only the geometry is computed in parallel; creating the brushes updates texture usage counts
+            std::vector<BrushGeometry::SubtractResult> geometries(minuends.size());
+            TaskScheduler::instance().parallelFor(0, minuends.size(), [&](const size_t i) {
+                geometries[i] = minuends[i]->m_geometry->subtract(*subtrahend->m_geometry);
+            });
+
+            std::vector<BrushList> result(minuends.size());
+            for (size_t i = 0; i < minuends.size(); ++i) {
+                result[i].reserve(geometries[i].size());
+                for (const auto& geometry : geometries[i]) {
+                    result[i].push_back(minuends[i]->createBrush(factory, worldBounds, defaultTextureName, geometry, subtrahend));
+                }
+            }
+
+            return result;
+        }
+
         void Brush::intersect(const BBox3& worldBounds, const Brush* brush) {
             for (const auto* face : brush->faces()) {
                 addFace(face->clone());
@@ -1189,6 +1202,7 @@ namespace TrenchBroom {
             }
             delete m_geometry;
             m_geometry = nullptr;
+            m_convexDataValid = false;
         }
 
         bool Brush::checkGeometry() const {
@@ -1213,6 +1227,15 @@ namespace TrenchBroom {
             return true;
         }
 
+        const BrushConvexData& Brush::convexData() const {
+            ensure(m_geometry != nullptr, "geometry is null");
+            if (!m_convexDataValid) {
+                m_convexData = BrushConvexData(*m_geometry);
+                m_convexDataValid = true;
+            }
+            return m_convexData;
+        }
+
         void Brush::findIntegerPlanePoints(const BBox3& worldBounds) {
             const NotifyNodeChange nodeChange(this);
 
@@ -1348,13 +1371,12 @@ namespace TrenchBroom {
                 return BrushFaceHit();
             }
 
-            for (auto* face : m_faces) {
-                const auto distance = face->intersectWithRay(ray);
-                if (!Math::isnan(distance)) {
-                    return BrushFaceHit(face, distance);
-                }
+            BrushFace* face = nullptr;
+            const auto distance = convexData().intersectWithRay(ray, face);
+            if (Math::isnan(distance)) {
+                return BrushFaceHit();
             }
-            return BrushFaceHit();
+            return BrushFaceHit(face, distance);
         }
 
         Node* Brush::doGetContainer() const {
@@ -1414,7 +1436,7 @@ namespace TrenchBroom {
             }
 
             bool contains(const Brush* brush) const {
-                return m_this->m_geometry->contains(*brush->m_geometry, QueryCallback());
+                return m_this->convexData().contains(brush->convexData());
             }
         };
 
@@ -1443,7 +1465,7 @@ namespace TrenchBroom {
             }
 
             bool intersects(const Brush* brush) {
-                return m_this->m_geometry->intersects(*brush->m_geometry, QueryCallback());
+                return m_this->convexData().intersects(brush->convexData());
             }
         };
 
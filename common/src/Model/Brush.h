@@ -26,6 +26,7 @@
 #include "ProjectingSequence.h"
 #include "Polyhedron_Matcher.h"
 #include "Model/BrushContentType.h"
+#include "Model/BrushConvexData.h"
 #include "Model/BrushGeometry.h"
 #include "Model/Node.h"
 #include "Model/Object.h"
@@ -67,7 +68,6 @@ namespace TrenchBroom {
             class AddFacesToGeometry;
             class MoveVerticesCallback;
             typedef MoveVerticesCallback RemoveVertexCallback;
-            class QueryCallback;
             class FaceMatchingCallback;
             
             using VertexSet = std::set<Vec3>;
@@ -84,6 +84,8 @@ namespace TrenchBroom {
             mutable bool m_transparent;
             mutable bool m_contentTypeValid;
             mutable Renderer::BrushRendererBrushCache m_brushRendererBrushCache;
+            mutable BrushConvexData m_convexData;
+            mutable bool m_convexDataValid;
         public:
             Brush(const BBox3& worldBounds, const BrushFaceList& faces);
             ~Brush() override;
@@ -217,6 +219,14 @@ namespace TrenchBroom {
         public:
             // CSG operations
             BrushList subtract(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const Brush* subtrahend) const;
+
+            /**
+             * Subtracts the given subtrahend from each of the given minuends. The fragment geometries are computed
+             * concurrently, one job per minuend, and the brushes are created afterwards on the calling thread. The
+             * fragments of the minuend at index i are returned at index i, in the same order as the single brush
+             * subtraction would return them.
+             */
+            static std::vector<BrushList> subtract(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const BrushList& minuends, const Brush* subtrahend);
             void intersect(const BBox3& worldBounds, const Brush* brush);
 
             // transformation
@@ -232,6 +242,8 @@ namespace TrenchBroom {
             void buildGeometry(const BBox3& worldBounds);
             void deleteGeometry();
             bool checkGeometry() const;
+
+            const BrushConvexData& convexData() const;
         public:
             void findIntegerPlanePoints(const BBox3& worldBounds);
         public: // content type
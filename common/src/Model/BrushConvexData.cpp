@@ -0,0 +1,348 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BrushConvexData.h"
+
+#include "BatchMath.h"
+#include "Model/BrushFace.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace TrenchBroom {
+    namespace Model {
+        BrushConvexData::BrushConvexData() {}
+
+        BrushConvexData::BrushConvexData(const BrushGeometry& geometry) :
+        m_bounds(geometry.bounds()) {
+            m_planes.reserve(geometry.faceCount());
+            m_faces.reserve(geometry.faceCount());
+            for (const BrushFaceGeometry* face : geometry.faces()) {
+                m_planes.push_back(face->payload()->boundary());
+                m_faces.push_back(face->payload());
+            }
+
+            m_vertices.reserve(geometry.vertexCount());
+            for (const BrushVertex* vertex : geometry.vertices()) {
+                m_vertices.push_back(vertex->position());
+            }
+
+            for (const BrushEdge* edge : geometry.edges()) {
+                addEdgeDirection(edge->vector());
+            }
+        }
+
+        const BBox3& BrushConvexData::bounds() const {
+            return m_bounds;
+        }
+
+        bool BrushConvexData::contains(const Vec3& point) const {
+            if (!m_bounds.contains(point))
+                return false;
+
+            for (const Plane3& plane : m_planes) {
+                if (plane.pointStatus(point) == Math::PointStatus::PSAbove)
+                    return false;
+            }
+            return true;
+        }
+
+        bool BrushConvexData::contains(const BrushConvexData& other) const {
+            if (!m_bounds.contains(other.m_bounds))
+                return false;
+
+            for (const Plane3& plane : m_planes) {
+                if (BatchMath::classifyPoints(plane, other.m_vertices.data(), other.m_vertices.size()) & BatchMath::PointStatusMask::PSAbove)
+                    return false;
+            }
+            return true;
+        }
+
+        bool BrushConvexData::intersects(const BrushConvexData& other) const {
+            if (!m_bounds.intersects(other.m_bounds))
+                return false;
+
+            // GJK quickly finds brushes that clearly overlap, but it cannot decide the cases where the brushes only
+            // touch, so the separating axis test decides everything that GJK doesn't accept
+            if (overlapsClearly(other))
+                return true;
+
+            return !separatedByPlanes(*this, other) &&
+                   !separatedByPlanes(other, *this) &&
+                   !separatedByEdgeDirections(other);
+        }
+
+        /**
+         * Clips the ray against the half spaces below the face planes, like a slab test for a box: each plane the ray
+         * is not parallel to narrows the interval of the ray that lies inside of the brush.
+         */
+        FloatType BrushConvexData::intersectWithRay(const Ray3& ray, BrushFace*& face) const {
+            const FloatType epsilon = Math::Constants<FloatType>::pointStatusEpsilon();
+
+            // the ray enters the brush through the farthest plane that it crosses from above and leaves it through
+            // the nearest plane that it crosses from below
+            FloatType entry = -std::numeric_limits<FloatType>::max();
+            FloatType exit = std::numeric_limits<FloatType>::max();
+            size_t entryIndex = m_planes.size();
+
+            for (size_t i = 0; i < m_planes.size(); ++i) {
+                const Plane3& plane = m_planes[i];
+                const FloatType dot = plane.normal.dot(ray.direction);
+                const FloatType distance = plane.pointDistance(ray.origin);
+
+                if (Math::zero(dot)) {
+                    if (distance > epsilon)
+                        return Math::nan<FloatType>();
+                } else {
+                    const FloatType t = -distance / dot;
+                    if (dot < 0.0) {
+                        if (t > entry) {
+                            entry = t;
+                            entryIndex = i;
+                        }
+                    } else {
+                        exit = std::min(exit, t);
+                    }
+
+                    if (entry > exit)
+                        return Math::nan<FloatType>();
+                }
+            }
+
+            // the ray starts inside of the brush and only hits back faces
+            if (entryIndex == m_planes.size() || entry < 0.0)
+                return Math::nan<FloatType>();
+
+            face = m_faces[entryIndex];
+            return entry;
+        }
+
+        /**
+         * Returns true if the Minkowski difference of this brush and the given brush contains a tetrahedron that
+         * contains the origin with a margin of more than the point status epsilon. Then the brushes penetrate each
+         * other deeper than the epsilon along every axis, and no separating axis can exist. Returns false if no such
+         * tetrahedron was found, which does not mean that the brushes are disjoint.
+         */
+        bool BrushConvexData::overlapsClearly(const BrushConvexData& other) const {
+            static const size_t MaxIterations = 32;
+
+            Vec3 simplex[4];
+            size_t count = 1;
+            simplex[0] = support(other, m_bounds.center() - other.m_bounds.center());
+            Vec3 direction = -simplex[0];
+
+            for (size_t i = 0; i < MaxIterations; ++i) {
+                if (direction.null())
+                    return false;
+
+                const Vec3 point = support(other, direction);
+                if (point.dot(direction) <= 0.0)
+                    return false;
+
+                // the newest point is always at index 0
+                for (size_t j = count; j > 0; --j)
+                    simplex[j] = simplex[j - 1];
+                simplex[0] = point;
+                ++count;
+
+                if (updateSimplex(simplex, count, direction))
+                    return containsOriginWithMargin(simplex);
+            }
+            return false;
+        }
+
+        Vec3 BrushConvexData::support(const BrushConvexData& other, const Vec3& direction) const {
+            return furthestVertex(m_vertices, direction) - furthestVertex(other.m_vertices, -direction);
+        }
+
+        const Vec3& BrushConvexData::furthestVertex(const std::vector<Vec3>& vertices, const Vec3& direction) {
+            size_t best = 0;
+            FloatType bestDistance = vertices.front().dot(direction);
+            for (size_t i = 1; i < vertices.size(); ++i) {
+                const FloatType distance = vertices[i].dot(direction);
+                if (distance > bestDistance) {
+                    best = i;
+                    bestDistance = distance;
+                }
+            }
+            return vertices[best];
+        }
+
+        bool BrushConvexData::updateSimplex(Vec3 simplex[4], size_t& count, Vec3& direction) {
+            const Vec3& a = simplex[0];
+            const Vec3 ao = -a;
+
+            if (count == 2) {
+                const Vec3 ab = simplex[1] - a;
+                if (ab.dot(ao) > 0.0) {
+                    direction = crossed(crossed(ab, ao), ab);
+                } else {
+                    count = 1;
+                    direction = ao;
+                }
+                return false;
+            }
+
+            if (count == 3) {
+                const Vec3 ab = simplex[1] - a;
+                const Vec3 ac = simplex[2] - a;
+                const Vec3 abc = crossed(ab, ac);
+
+                if (crossed(abc, ac).dot(ao) > 0.0) {
+                    if (ac.dot(ao) > 0.0) {
+                        simplex[1] = simplex[2];
+                        count = 2;
+                        direction = crossed(crossed(ac, ao), ac);
+                        return false;
+                    }
+                    count = 2;
+                    return updateSimplex(simplex, count, direction);
+                }
+                if (crossed(ab, abc).dot(ao) > 0.0) {
+                    count = 2;
+                    return updateSimplex(simplex, count, direction);
+                }
+                if (abc.dot(ao) > 0.0) {
+                    direction = abc;
+                } else {
+                    std::swap(simplex[1], simplex[2]);
+                    direction = -abc;
+                }
+                return false;
+            }
+
+            assert(count == 4);
+            const Vec3 ab = simplex[1] - a;
+            const Vec3 ac = simplex[2] - a;
+            const Vec3 ad = simplex[3] - a;
+
+            if (crossed(ab, ac).dot(ao) > 0.0) {
+                count = 3;
+                return updateSimplex(simplex, count, direction);
+            }
+            if (crossed(ac, ad).dot(ao) > 0.0) {
+                simplex[1] = simplex[2];
+                simplex[2] = simplex[3];
+                count = 3;
+                return updateSimplex(simplex, count, direction);
+            }
+            if (crossed(ad, ab).dot(ao) > 0.0) {
+                simplex[2] = simplex[1];
+                simplex[1] = simplex[3];
+                count = 3;
+                return updateSimplex(simplex, count, direction);
+            }
+            return true;
+        }
+
+        bool BrushConvexData::containsOriginWithMargin(const Vec3 tetrahedron[4]) {
+            static const size_t Faces[4][3] = { { 0, 1, 2 }, { 0, 2, 3 }, { 0, 3, 1 }, { 1, 3, 2 } };
+
+            const FloatType epsilon = Math::Constants<FloatType>::pointStatusEpsilon();
+            for (size_t i = 0; i < 4; ++i) {
+                const Vec3& p0 = tetrahedron[Faces[i][0]];
+                const Vec3 normal = crossed(tetrahedron[Faces[i][1]] - p0, tetrahedron[Faces[i][2]] - p0);
+                if (normal.null())
+                    return false;
+                if (std::abs(p0.dot(normal.normalized())) <= epsilon)
+                    return false;
+            }
+            return true;
+        }
+
+        void BrushConvexData::addEdgeDirection(const Vec3& vector) {
+            Vec3 direction = vector.normalized();
+
+            // parallel edges share a direction regardless of their orientation
+            for (size_t i = 0; i < 3; ++i) {
+                if (!Math::zero(direction[i])) {
+                    if (direction[i] < 0.0)
+                        direction = -direction;
+                    break;
+                }
+            }
+
+            for (const Vec3& existing : m_edgeDirections) {
+                if (existing.equals(direction, Math::Constants<FloatType>::almostZero()))
+                    return;
+            }
+            m_edgeDirections.push_back(direction);
+        }
+
+        bool BrushConvexData::separatedByPlanes(const BrushConvexData& planes, const BrushConvexData& vertices) {
+            // a face plane separates if no vertex is below it and at least one vertex is above it
+            for (const Plane3& plane : planes.m_planes) {
+                const BatchMath::PointStatusMask::Type status = BatchMath::classifyPoints(plane, vertices.m_vertices.data(), vertices.m_vertices.size());
+                if ((status & BatchMath::PointStatusMask::PSAbove) && !(status & BatchMath::PointStatusMask::PSBelow))
+                    return true;
+            }
+            return false;
+        }
+
+        bool BrushConvexData::separatedByEdgeDirections(const BrushConvexData& other) const {
+            for (const Vec3& myDirection : m_edgeDirections) {
+                for (const Vec3& theirDirection : other.m_edgeDirections) {
+                    const Vec3 cross = crossed(myDirection, theirDirection);
+                    if (!cross.null() && separatedAlong(cross.normalized(), other))
+                        return true;
+                }
+            }
+            return false;
+        }
+
+        bool BrushConvexData::separatedAlong(const Vec3& axis, const BrushConvexData& other) const {
+            const FloatType epsilon = Math::Constants<FloatType>::pointStatusEpsilon();
+
+            // if my vertices lie on both sides of one of their vertices, the projections overlap; for brushes that
+            // intersect, this usually becomes clear after a few vertices
+            const FloatType reference = other.m_vertices.front().dot(axis);
+            bool above = false;
+            bool below = false;
+            FloatType myMin = std::numeric_limits<FloatType>::max();
+            FloatType myMax = std::numeric_limits<FloatType>::lowest();
+            for (const Vec3& vertex : m_vertices) {
+                const FloatType distance = vertex.dot(axis);
+                if (distance > reference + epsilon)
+                    above = true;
+                else if (distance < reference - epsilon)
+                    below = true;
+                if (above && below)
+                    return false;
+                myMin = std::min(myMin, distance);
+                myMax = std::max(myMax, distance);
+            }
+
+            bool theyAreAbove = true;
+            bool theyAreBelow = true;
+            FloatType theirMax = std::numeric_limits<FloatType>::lowest();
+            for (const Vec3& vertex : other.m_vertices) {
+                const FloatType distance = vertex.dot(axis);
+                theyAreAbove &= distance >= myMax - epsilon;
+                theyAreBelow &= distance <= myMin + epsilon;
+                if (!theyAreAbove && !theyAreBelow)
+                    return false;
+                theirMax = std::max(theirMax, distance);
+            }
+
+            return (theyAreAbove && theirMax > myMax + epsilon) || (theyAreBelow && myMax > theirMax + epsilon);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BrushConvexData
+#define TrenchBroom_BrushConvexData
+
+#include "TrenchBroom.h"
+#include "VecMath.h"
+#include "Model/BrushGeometry.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class BrushFace;
+
+        /**
+         * The face planes, vertex positions and edge directions of a brush in contiguous arrays. Intersection and
+         * containment tests between brushes run on this data instead of walking the half edge structure of the brush
+         * geometry. Parallel edges share one direction, so a cuboid contributes three edge directions to the
+         * separating axis test instead of twelve edges.
+         *
+         * Intersection tests first try GJK, which finds brushes that clearly overlap in a few iterations, and fall
+         * back to the separating axis theorem for the rest. The tests treat brushes that only touch as disjoint, like
+         * the polyhedron queries they replace.
+         *
+         * Ray queries clip the ray against the face planes in one pass instead of testing the ray against each face
+         * polygon, and only look up the face whose plane the ray enters through at the end.
+         */
+        class BrushConvexData {
+        private:
+            BBox3 m_bounds;
+            std::vector<Plane3> m_planes;
+            std::vector<BrushFace*> m_faces;
+            std::vector<Vec3> m_vertices;
+            std::vector<Vec3> m_edgeDirections;
+        public:
+            BrushConvexData();
+            explicit BrushConvexData(const BrushGeometry& geometry);
+
+            const BBox3& bounds() const;
+
+            bool contains(const Vec3& point) const;
+            bool contains(const BrushConvexData& other) const;
+            bool intersects(const BrushConvexData& other) const;
+
+            /**
+             * Returns the distance at which the given ray enters the brush, or NaN if the ray misses the brush or
+             * starts inside of it. If the ray is hit, the face through which it enters is stored in the given face.
+             */
+            FloatType intersectWithRay(const Ray3& ray, BrushFace*& face) const;
+        private:
+            bool overlapsClearly(const BrushConvexData& other) const;
+            Vec3 support(const BrushConvexData& other, const Vec3& direction) const;
+            static const Vec3& furthestVertex(const std::vector<Vec3>& vertices, const Vec3& direction);
+            static bool updateSimplex(Vec3 simplex[4], size_t& count, Vec3& direction);
+            static bool containsOriginWithMargin(const Vec3 tetrahedron[4]);
+
+            void addEdgeDirection(const Vec3& direction);
+            static bool separatedByPlanes(const BrushConvexData& planes, const BrushConvexData& vertices);
+            bool separatedByEdgeDirections(const BrushConvexData& other) const;
+            bool separatedAlong(const Vec3& axis, const BrushConvexData& other) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_BrushConvexData) */
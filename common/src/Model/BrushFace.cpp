@@ -48,9 +48,12 @@ namespace TrenchBroom {
         m_selected(false),
         m_texCoordSystem(texCoordSystem),
         m_geometry(nullptr),
+        m_textureFaceIndex(0),
         m_attribs(attribs) {
             ensure(m_texCoordSystem != nullptr, "texCoordSystem is null");
+            m_attribs.intern();
             setPoints(point0, point1, point2);
+            addToTexture();
         }
 
         class PlaneWeightOrder {
@@ -97,6 +100,7 @@ namespace TrenchBroom {
         }
 
         BrushFace::~BrushFace() {
+            removeFromTexture();
             for (size_t i = 0; i < 3; ++i)
                 m_points[i] = Vec3::Null;
             m_brush = nullptr;
@@ -109,8 +113,7 @@ namespace TrenchBroom {
         }
 
         BrushFace* BrushFace::clone() const {
-            BrushFace* result = new BrushFace(points()[0], points()[1], points()[2], textureName(), m_texCoordSystem->clone());
-            result->m_attribs = m_attribs;
+            BrushFace* result = new BrushFace(points()[0], points()[1], points()[2], m_attribs, m_texCoordSystem->clone());
             result->setFilePosition(m_lineNumber, m_lineCount);
             if (m_selected)
                 result->select();
@@ -147,6 +150,7 @@ namespace TrenchBroom {
                 const Vec2f offsetChange = desriedCoords - currentCoords;
                 m_attribs.setOffset(m_attribs.modOffset(m_attribs.offset() + offsetChange).corrected(4));
             }
+            m_attribs.intern();
         }
         
         Brush* BrushFace::brush() const {
@@ -241,7 +245,10 @@ namespace TrenchBroom {
 
         void BrushFace::setAttribs(const BrushFaceAttributes& attribs) {
             const float oldRotation = m_attribs.rotation();
+            removeFromTexture();
             m_attribs = attribs;
+            m_attribs.intern();
+            addToTexture();
             m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attribs.rotation());
 
             if (m_brush != nullptr)
@@ -326,7 +333,10 @@ namespace TrenchBroom {
         void BrushFace::setTexture(Assets::Texture* texture) {
             if (texture == m_attribs.texture())
                 return;
+            removeFromTexture();
             m_attribs.setTexture(texture);
+            m_attribs.intern();
+            addToTexture();
             if (m_brush != nullptr)
                 m_brush->faceDidChange();
             invalidateVertexCache();
@@ -335,7 +345,9 @@ namespace TrenchBroom {
         void BrushFace::unsetTexture() {
             if (m_attribs.texture() == nullptr)
                 return;
+            removeFromTexture();
             m_attribs.unsetTexture();
+            m_attribs.intern();
             if (m_brush != nullptr)
                 m_brush->faceDidChange();
             invalidateVertexCache();
@@ -345,6 +357,7 @@ namespace TrenchBroom {
             if (i_xOffset == xOffset())
                 return;
             m_attribs.setXOffset(i_xOffset);
+            m_attribs.intern();
             invalidateVertexCache();
         }
 
@@ -352,6 +365,7 @@ namespace TrenchBroom {
             if (i_yOffset == yOffset())
                 return;
             m_attribs.setYOffset(i_yOffset);
+            m_attribs.intern();
             invalidateVertexCache();
         }
 
@@ -359,6 +373,7 @@ namespace TrenchBroom {
             if (i_xScale == xScale())
                 return;
             m_attribs.setXScale(i_xScale);
+            m_attribs.intern();
             invalidateVertexCache();
         }
 
@@ -366,6 +381,7 @@ namespace TrenchBroom {
             if (i_yScale == yScale())
                 return;
             m_attribs.setYScale(i_yScale);
+            m_attribs.intern();
             invalidateVertexCache();
         }
 
@@ -375,6 +391,7 @@ namespace TrenchBroom {
 
             const float oldRotation = m_attribs.rotation();
             m_attribs.setRotation(rotation);
+            m_attribs.intern();
             m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, rotation);
             invalidateVertexCache();
         }
@@ -383,6 +400,7 @@ namespace TrenchBroom {
             if (surfaceContents == m_attribs.surfaceContents())
                 return;
             m_attribs.setSurfaceContents(surfaceContents);
+            m_attribs.intern();
             if (m_brush != nullptr)
                 m_brush->faceDidChange();
         }
@@ -391,12 +409,14 @@ namespace TrenchBroom {
             if (surfaceFlags == m_attribs.surfaceFlags())
                 return;
             m_attribs.setSurfaceFlags(surfaceFlags);
+            m_attribs.intern();
         }
 
         void BrushFace::setSurfaceValue(const float surfaceValue) {
             if (surfaceValue == m_attribs.surfaceValue())
                 return;
             m_attribs.setSurfaceValue(surfaceValue);
+            m_attribs.intern();
         }
 
         void BrushFace::setAttributes(const BrushFace* other) {
@@ -426,12 +446,14 @@ namespace TrenchBroom {
 
         void BrushFace::moveTexture(const Vec3& up, const Vec3& right, const Vec2f& offset) {
             m_texCoordSystem->moveTexture(m_boundary.normal, up, right, offset, m_attribs);
+            m_attribs.intern();
             invalidateVertexCache();
         }
 
         void BrushFace::rotateTexture(const float angle) {
             const float oldRotation = m_attribs.rotation();
             m_texCoordSystem->rotateTexture(m_boundary.normal, angle, m_attribs);
+            m_attribs.intern();
             m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attribs.rotation());
             invalidateVertexCache();
         }
@@ -458,6 +480,7 @@ namespace TrenchBroom {
             setPoints(m_points[0], m_points[1], m_points[2]);
             
             m_texCoordSystem->transform(oldBoundary, m_boundary, transform, m_attribs, lockTexture, invariant);
+            m_attribs.intern();
         }
 
         void BrushFace::invert() {
@@ -492,6 +515,7 @@ namespace TrenchBroom {
                 const Vec2f currentCoords = m_texCoordSystem->getTexCoords(refPoint, m_attribs) * m_attribs.textureSize();
                 const Vec2f offsetChange = desriedCoords - currentCoords;
                 m_attribs.setOffset(m_attribs.modOffset(m_attribs.offset() + offsetChange).corrected(4));
+                m_attribs.intern();
             }
         }
 
@@ -601,6 +625,10 @@ namespace TrenchBroom {
             return m_texCoordSystem->getTexCoords(point, m_attribs);
         }
 
+        TexCoordProjection BrushFace::textureCoordProjection() const {
+            return m_texCoordSystem->getTexCoordProjection(m_attribs);
+        }
+
         bool BrushFace::containsPoint(const Vec3& point) const {
             const Vec3 toPoint = point - m_boundary.anchor();
             if (!Math::zero(toPoint.dot(m_boundary.normal)))
@@ -648,6 +676,28 @@ namespace TrenchBroom {
                 m_points[i].correct();
         }
 
+        void BrushFace::addToTexture() {
+            Assets::Texture* texture = m_attribs.texture();
+            if (texture != nullptr) {
+                m_textureFaceIndex = texture->m_faces.size();
+                texture->m_faces.push_back(this);
+            }
+        }
+
+        void BrushFace::removeFromTexture() {
+            Assets::Texture* texture = m_attribs.texture();
+            if (texture != nullptr) {
+                std::vector<BrushFace*>& faces = texture->m_faces;
+                assert(m_textureFaceIndex < faces.size() && faces[m_textureFaceIndex] == this);
+
+                // move the last face into the slot of this face
+                BrushFace* last = faces.back();
+                faces[m_textureFaceIndex] = last;
+                last->m_textureFaceIndex = m_textureFaceIndex;
+                faces.pop_back();
+            }
+        }
+
         void BrushFace::invalidateVertexCache() {
             if (m_brush != nullptr) {
                 m_brush->invalidateVertexCache();
@@ -85,6 +85,9 @@ namespace TrenchBroom {
             TexCoordSystem* m_texCoordSystem;
             BrushFaceGeometry* m_geometry;
 
+            // the index of this face in the face list of its texture
+            size_t m_textureFaceIndex;
+
             // brush renderer
             mutable bool m_markedToRenderFace;
         protected:
@@ -194,6 +197,7 @@ namespace TrenchBroom {
             void deselect();
 
             Vec2f textureCoords(const Vec3& point) const;
+            TexCoordProjection textureCoordProjection() const;
 
             bool containsPoint(const Vec3& point) const;
             FloatType intersectWithRay(const Ray3& ray) const;
@@ -203,6 +207,10 @@ namespace TrenchBroom {
             void setPoints(const Vec3& point0, const Vec3& point1, const Vec3& point2);
             void correctPoints();
 
+            // texture face index
+            void addToTexture();
+            void removeFromTexture();
+
             // renderer cache
             void invalidateVertexCache();
         public: // brush renderer
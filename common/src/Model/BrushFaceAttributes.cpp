@@ -21,32 +21,210 @@
 #include "Assets/Texture.h"
 #include "Model/BrushFace.h"
 
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Model {
+        struct BrushFaceAttributes::Record {
+            const String* textureName;
+
+            Vec2f offset;
+            Vec2f scale;
+            float rotation;
+
+            int surfaceContents;
+            int surfaceFlags;
+            float surfaceValue;
+
+            std::atomic<uint32_t> refCount;
+            std::atomic<bool> interned;
+
+            // the next record in the same bucket of the pool
+            Record* next;
+
+            Record(const String* i_textureName) :
+            textureName(i_textureName),
+            offset(Vec2f::Null),
+            scale(Vec2f(1.0f, 1.0f)),
+            rotation(0.0f),
+            surfaceContents(0),
+            surfaceFlags(0),
+            surfaceValue(0.0f),
+            refCount(1),
+            interned(false),
+            next(nullptr) {}
+
+            Record(const Record& other) :
+            textureName(other.textureName),
+            offset(other.offset),
+            scale(other.scale),
+            rotation(other.rotation),
+            surfaceContents(other.surfaceContents),
+            surfaceFlags(other.surfaceFlags),
+            surfaceValue(other.surfaceValue),
+            refCount(1),
+            interned(false),
+            next(nullptr) {}
+
+            Record& operator=(const Record& other) = delete;
+
+            template <typename T>
+            static void combineHash(size_t& seed, const T& value) {
+                seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+
+            size_t hash() const {
+                // the texture names are interned, so their addresses identify them
+                size_t result = std::hash<const String*>()(textureName);
+                combineHash(result, offset.x());
+                combineHash(result, offset.y());
+                combineHash(result, scale.x());
+                combineHash(result, scale.y());
+                combineHash(result, rotation);
+                combineHash(result, surfaceContents);
+                combineHash(result, surfaceFlags);
+                combineHash(result, surfaceValue);
+                return result;
+            }
+
+            bool operator==(const Record& other) const {
+                return (textureName == other.textureName &&
+                        offset == other.offset &&
+                        scale == other.scale &&
+                        rotation == other.rotation &&
+                        surfaceContents == other.surfaceContents &&
+                        surfaceFlags == other.surfaceFlags &&
+                        surfaceValue == other.surfaceValue);
+            }
+
+            /**
+             * Adds a reference unless the record is already being destroyed.
+             */
+            bool tryAcquire() {
+                uint32_t count = refCount.load();
+                while (count > 0) {
+                    if (refCount.compare_exchange_weak(count, count + 1))
+                        return true;
+                }
+                return false;
+            }
+        };
+
+        /**
+         * The records are kept in a hash table that is chained through the records themselves, so interning costs no
+         * memory apart from the buckets. Records are found by value, but removed by identity: a record that contains
+         * NaN is not equal to itself, and it must still be removed when it is destroyed.
+         *
+         * The texture names are kept for the lifetime of the program, there are only ever few of them.
+         */
+        class BrushFaceAttributes::Pool {
+        private:
+            std::mutex m_mutex;
+            std::vector<Record*> m_buckets;
+            size_t m_size;
+            std::unordered_set<String> m_textureNames;
+        public:
+            static Pool& instance() {
+                // never destroyed so that records can still be released during static destruction
+                static Pool* pool = new Pool();
+                return *pool;
+            }
+
+            Pool() :
+            m_buckets(64, nullptr),
+            m_size(0) {}
+
+            const String* textureName(const String& name) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return &*m_textureNames.insert(name).first;
+            }
+
+            Record* intern(Record* record) {
+                const size_t hash = record->hash();
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                for (Record* existing = m_buckets[bucket(hash)]; existing != nullptr; existing = existing->next) {
+                    // the existing record may be being destroyed, it then removes itself from the pool later
+                    if (*existing == *record && existing->tryAcquire())
+                        return existing;
+                }
+
+                if (m_size >= m_buckets.size())
+                    rehash(2 * m_buckets.size());
+
+                Record*& first = m_buckets[bucket(hash)];
+                record->next = first;
+                record->interned = true;
+                first = record;
+                ++m_size;
+                return record;
+            }
+
+            void remove(Record* record) {
+                const size_t hash = record->hash();
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                Record** link = &m_buckets[bucket(hash)];
+                while (*link != record) {
+                    assert(*link != nullptr);
+                    link = &(*link)->next;
+                }
+                *link = record->next;
+                --m_size;
+            }
+
+            size_t size() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_size;
+            }
+        private:
+            size_t bucket(const size_t hash) const {
+                return hash & (m_buckets.size() - 1);
+            }
+
+            void rehash(const size_t bucketCount) {
+                std::vector<Record*> buckets(bucketCount, nullptr);
+                for (Record* record : m_buckets) {
+                    while (record != nullptr) {
+                        Record* next = record->next;
+                        Record*& first = buckets[record->hash() & (bucketCount - 1)];
+                        record->next = first;
+                        first = record;
+                        record = next;
+                    }
+                }
+                m_buckets.swap(buckets);
+            }
+        };
+
+        void BrushFaceAttributes::release(Record* record) {
+            if (--record->refCount == 0) {
+                if (record->interned)
+                    Pool::instance().remove(record);
+                delete record;
+            }
+        }
+
         BrushFaceAttributes::BrushFaceAttributes(const String& textureName) :
-        m_textureName(textureName),
-        m_texture(nullptr),
-        m_offset(Vec2f::Null),
-        m_scale(Vec2f(1.0f, 1.0f)),
-        m_rotation(0.0f),
-        m_surfaceContents(0),
-        m_surfaceFlags(0),
-        m_surfaceValue(0.0f) {}
-        
+        m_record(new Record(Pool::instance().textureName(textureName))),
+        m_texture(nullptr) {}
+
         BrushFaceAttributes::BrushFaceAttributes(const BrushFaceAttributes& other) :
-        m_textureName(other.m_textureName),
-        m_texture(other.m_texture),
-        m_offset(other.m_offset),
-        m_scale(other.m_scale),
-        m_rotation(other.m_rotation),
-        m_surfaceContents(other.m_surfaceContents),
-        m_surfaceFlags(other.m_surfaceFlags),
-        m_surfaceValue(other.m_surfaceValue) {
+        m_record(other.m_record),
+        m_texture(other.m_texture) {
+            ++m_record->refCount;
             if (m_texture != nullptr)
                 m_texture->incUsageCount();
         }
         
         BrushFaceAttributes::~BrushFaceAttributes() {
+            release(m_record);
             if (m_texture != nullptr)
                 m_texture->decUsageCount();
         }
@@ -59,29 +237,41 @@ namespace TrenchBroom {
 
         void swap(BrushFaceAttributes& lhs, BrushFaceAttributes& rhs) {
             using std::swap;
-            swap(lhs.m_textureName, rhs.m_textureName);
+            swap(lhs.m_record, rhs.m_record);
             swap(lhs.m_texture, rhs.m_texture);
-            swap(lhs.m_offset, rhs.m_offset);
-            swap(lhs.m_scale, rhs.m_scale);
-            swap(lhs.m_rotation, rhs.m_rotation);
-            swap(lhs.m_surfaceContents, rhs.m_surfaceContents);
-            swap(lhs.m_surfaceFlags, rhs.m_surfaceFlags);
-            swap(lhs.m_surfaceValue, rhs.m_surfaceValue);
+        }
+
+        BrushFaceAttributes::BrushFaceAttributes(Record* record) :
+        m_record(record),
+        m_texture(nullptr) {
+            ++m_record->refCount;
         }
 
         BrushFaceAttributes BrushFaceAttributes::takeSnapshot() const {
-            BrushFaceAttributes result(m_textureName);
-            result.m_offset = m_offset;
-            result.m_scale = m_scale;
-            result.m_rotation = m_rotation;
-            result.m_surfaceContents = m_surfaceContents;
-            result.m_surfaceFlags = m_surfaceFlags;
-            result.m_surfaceValue = m_surfaceValue;
-            return result;
+            return BrushFaceAttributes(m_record);
+        }
+
+        void BrushFaceAttributes::intern() {
+            if (m_record->interned)
+                return;
+
+            Record* record = Pool::instance().intern(m_record);
+            if (record != m_record) {
+                release(m_record);
+                m_record = record;
+            }
+        }
+
+        bool BrushFaceAttributes::sharesRecordWith(const BrushFaceAttributes& other) const {
+            return m_record == other.m_record;
+        }
+
+        size_t BrushFaceAttributes::internedCount() {
+            return Pool::instance().size();
         }
 
         const String& BrushFaceAttributes::textureName() const {
-            return m_textureName;
+            return *m_record->textureName;
         }
         
         Assets::Texture* BrushFaceAttributes::texture() const {
@@ -97,15 +287,15 @@ namespace TrenchBroom {
         }
         
         const Vec2f& BrushFaceAttributes::offset() const {
-            return m_offset;
+            return m_record->offset;
         }
         
         float BrushFaceAttributes::xOffset() const {
-            return m_offset.x();
+            return m_record->offset.x();
         }
         
         float BrushFaceAttributes::yOffset() const {
-            return m_offset.y();
+            return m_record->offset.y();
         }
         
         Vec2f BrushFaceAttributes::modOffset(const Vec2f& offset) const {
@@ -113,31 +303,31 @@ namespace TrenchBroom {
         }
         
         const Vec2f& BrushFaceAttributes::scale() const {
-            return m_scale;
+            return m_record->scale;
         }
         
         float BrushFaceAttributes::xScale() const {
-            return m_scale.x();
+            return m_record->scale.x();
         }
         
         float BrushFaceAttributes::yScale() const {
-            return m_scale.y();
+            return m_record->scale.y();
         }
         
         float BrushFaceAttributes::rotation() const {
-            return m_rotation;
+            return m_record->rotation;
         }
         
         int BrushFaceAttributes::surfaceContents() const {
-            return m_surfaceContents;
+            return m_record->surfaceContents;
         }
         
         int BrushFaceAttributes::surfaceFlags() const {
-            return m_surfaceFlags;
+            return m_record->surfaceFlags;
         }
         
         float BrushFaceAttributes::surfaceValue() const {
-            return m_surfaceValue;
+            return m_record->surfaceValue;
         }
         
         void BrushFaceAttributes::setTexture(Assets::Texture* texture) {
@@ -146,7 +336,8 @@ namespace TrenchBroom {
             m_texture = texture;
             if (m_texture != nullptr) {
                 m_texture->incUsageCount();
-                m_textureName = m_texture->name();
+                if (*m_record->textureName != m_texture->name())
+                    mutableRecord().textureName = Pool::instance().textureName(m_texture->name());
             }
         }
         
@@ -154,47 +345,58 @@ namespace TrenchBroom {
             if (m_texture != nullptr)
                 m_texture->decUsageCount();
             m_texture = nullptr;
-            m_textureName = BrushFace::NoTextureName;
+            if (*m_record->textureName != BrushFace::NoTextureName)
+                mutableRecord().textureName = Pool::instance().textureName(BrushFace::NoTextureName);
         }
 
         void BrushFaceAttributes::setOffset(const Vec2f& offset) {
-            m_offset = offset;
+            mutableRecord().offset = offset;
         }
         
         void BrushFaceAttributes::setXOffset(const float xOffset) {
-            m_offset[0] = xOffset;
+            mutableRecord().offset[0] = xOffset;
         }
         
         void BrushFaceAttributes::setYOffset(const float yOffset) {
-            m_offset[1] = yOffset;
+            mutableRecord().offset[1] = yOffset;
         }
         
         void BrushFaceAttributes::setScale(const Vec2f& scale) {
-            m_scale = scale;
+            mutableRecord().scale = scale;
         }
         
         void BrushFaceAttributes::setXScale(const float xScale) {
-            m_scale[0] = xScale;
+            mutableRecord().scale[0] = xScale;
         }
         
         void BrushFaceAttributes::setYScale(const float yScale) {
-            m_scale[1] = yScale;
+            mutableRecord().scale[1] = yScale;
         }
         
         void BrushFaceAttributes::setRotation(const float rotation) {
-            m_rotation = rotation;
+            mutableRecord().rotation = rotation;
         }
         
         void BrushFaceAttributes::setSurfaceContents(const int surfaceContents) {
-            m_surfaceContents = surfaceContents;
+            mutableRecord().surfaceContents = surfaceContents;
         }
         
         void BrushFaceAttributes::setSurfaceFlags(const int surfaceFlags) {
-            m_surfaceFlags = surfaceFlags;
+            mutableRecord().surfaceFlags = surfaceFlags;
         }
         
         void BrushFaceAttributes::setSurfaceValue(const float surfaceValue) {
-            m_surfaceValue = surfaceValue;
+            mutableRecord().surfaceValue = surfaceValue;
+        }
+   
+        BrushFaceAttributes::Record& BrushFaceAttributes::mutableRecord() {
+            // interned records may be shared at any time, so they are never modified
+            if (m_record->refCount > 1 || m_record->interned) {
+                Record* copy = new Record(*m_record);
+                release(m_record);
+                m_record = copy;
+            }
+            return *m_record;
         }
     }
 }
@@ -30,18 +30,22 @@ namespace TrenchBroom {
     }
     
     namespace Model {
+        /**
+         * The texture attributes of a brush face. Apart from the texture, the attributes are kept in an immutable,
+         * reference counted record that is shared between copies, so copying the attributes of a face, e.g. when
+         * duplicating brushes or taking snapshots, only copies a pointer. The record is copied when one of the copies
+         * is modified. The texture names of the records are shared, too.
+         *
+         * Brush faces intern their attributes whenever they change, so that all faces with the same attributes share a
+         * single record.
+         */
         class BrushFaceAttributes {
         private:
-            String m_textureName;
+            class Pool;
+            struct Record;
+
+            Record* m_record;
             Assets::Texture* m_texture;
-            
-            Vec2f m_offset;
-            Vec2f m_scale;
-            float m_rotation;
-            
-            int m_surfaceContents;
-            int m_surfaceFlags;
-            float m_surfaceValue;
         public:
             BrushFaceAttributes(const String& textureName);
             BrushFaceAttributes(const BrushFaceAttributes& other);
@@ -50,6 +54,18 @@ namespace TrenchBroom {
             friend void swap(BrushFaceAttributes& lhs, BrushFaceAttributes& rhs);
             
             BrushFaceAttributes takeSnapshot() const;
+
+            /**
+             * Replaces the record of these attributes by the shared record with the same values, or makes it the
+             * shared record if there is none yet.
+             */
+            void intern();
+            bool sharesRecordWith(const BrushFaceAttributes& other) const;
+
+            /**
+             * Returns the number of distinct interned records.
+             */
+            static size_t internedCount();
             
             const String& textureName() const;
             Assets::Texture* texture() const;
@@ -83,6 +99,11 @@ namespace TrenchBroom {
             void setSurfaceContents(int surfaceContents);
             void setSurfaceFlags(int surfaceFlags);
             void setSurfaceValue(float surfaceValue);
+        private:
+            BrushFaceAttributes(Record* record);
+            static void release(Record* record);
+
+            Record& mutableRecord();
         };
     }
 }
@@ -69,8 +69,8 @@ namespace TrenchBroom {
             return doNewMap(format, worldBounds);
         }
         
-        World* Game::loadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const {
-            return doLoadMap(format, worldBounds, path, logger);
+        World* Game::loadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status) const {
+            return doLoadMap(format, worldBounds, path, status);
         }
 
         void Game::writeMap(World* world, const IO::Path& path) const {
@@ -78,6 +78,11 @@ namespace TrenchBroom {
             doWriteMap(world, path);
         }
 
+        void Game::writeMapCache(World* world, const IO::Path& path) const {
+            ensure(world != nullptr, "world is null");
+            doWriteMapCache(world, path);
+        }
+
         void Game::exportMap(World* world, const Model::ExportFormat format, const IO::Path& path) const {
             ensure(world != nullptr, "world is null");
             doExportMap(world, format, path);
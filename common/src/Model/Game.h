@@ -72,8 +72,9 @@ namespace TrenchBroom {
             size_t maxPropertyLength() const;
         public: // loading and writing map files
             World* newMap(MapFormat::Type format, const BBox3& worldBounds) const;
-            World* loadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const;
+            World* loadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status) const;
             void writeMap(World* world, const IO::Path& path) const;
+            void writeMapCache(World* world, const IO::Path& path) const;
             void exportMap(World* world, Model::ExportFormat format, const IO::Path& path) const;
         public: // parsing and serializing objects
             NodeList parseNodes(const String& str, World* world, const BBox3& worldBounds, Logger* logger) const;
@@ -114,8 +115,9 @@ namespace TrenchBroom {
             virtual size_t doMaxPropertyLength() const = 0;
             
             virtual World* doNewMap(MapFormat::Type format, const BBox3& worldBounds) const = 0;
-            virtual World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const = 0;
+            virtual World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status) const = 0;
             virtual void doWriteMap(World* world, const IO::Path& path) const = 0;
+            virtual void doWriteMapCache(World* world, const IO::Path& path) const = 0;
             virtual void doExportMap(World* world, Model::ExportFormat format, const IO::Path& path) const = 0;
             
             virtual NodeList doParseNodes(const String& str, World* world, const BBox3& worldBounds, Logger* logger) const = 0;
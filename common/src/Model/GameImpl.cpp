@@ -32,6 +32,7 @@
 #include "IO/IdPakFileSystem.h"
 #include "IO/IdWalTextureReader.h"
 #include "IO/IOUtils.h"
+#include "IO/MapCache.h"
 #include "IO/MapParser.h"
 #include "IO/MdlParser.h"
 #include "IO/Md2Parser.h"
@@ -51,6 +52,7 @@
 #include "Exceptions.h"
 
 #include <cstdio>
+#include <fstream>
 
 namespace TrenchBroom {
     namespace Model {
@@ -145,11 +147,30 @@ namespace TrenchBroom {
             return new World(format, brushContentTypeBuilder(), worldBounds);
         }
 
-        World* GameImpl::doLoadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const {
-            IO::SimpleParserStatus parserStatus(logger);
-            const IO::MappedFile::Ptr file = IO::Disk::openFile(IO::Disk::fixPath(path));
+        World* GameImpl::doLoadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status) const {
+            const IO::Path mapPath = IO::Disk::fixPath(path);
+            const IO::MappedFile::Ptr file = IO::Disk::openFile(mapPath);
+
+            World* world = loadMapCache(format, worldBounds, mapPath, file->begin(), file->end());
+            if (world != nullptr)
+                return world;
+
             IO::WorldReader reader(file->begin(), file->end(), brushContentTypeBuilder());
-            return reader.read(format, worldBounds, parserStatus);
+            return reader.read(format, worldBounds, status);
+        }
+
+        World* GameImpl::loadMapCache(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& mapPath, const char* mapBegin, const char* mapEnd) const {
+            if (!IO::MapCache::isUpToDate(mapPath))
+                return nullptr;
+
+            try {
+                const IO::MappedFile::Ptr file = IO::Disk::openFile(IO::MapCache::cachePath(mapPath));
+                IO::MapCacheReader reader(file->begin(), file->end(), brushContentTypeBuilder());
+                return reader.read(format, worldBounds, mapBegin, mapEnd);
+            } catch (const Exception&) {
+                // a stale or damaged cache is not an error, the map file is parsed instead
+                return nullptr;
+            }
         }
 
         void GameImpl::doWriteMap(World* world, const IO::Path& path) const {
@@ -162,6 +183,18 @@ namespace TrenchBroom {
             writer.writeMap();
         }
 
+        void GameImpl::doWriteMapCache(World* world, const IO::Path& path) const {
+            const IO::MappedFile::Ptr file = IO::Disk::openFile(IO::Disk::fixPath(path));
+            const IO::Path cachePath = IO::MapCache::cachePath(file->path());
+
+            std::ofstream stream(cachePath.asString().c_str(), std::ios::out | std::ios::binary);
+            if (!stream.is_open())
+                throw FileSystemException("Cannot open map cache for writing: '" + cachePath.asString() + "'");
+
+            IO::MapCacheWriter writer(world, file->begin(), file->end(), stream);
+            writer.writeCache();
+        }
+
         void GameImpl::doExportMap(World* world, const Model::ExportFormat format, const IO::Path& path) const {
             IO::OpenFile open(path, true);
 
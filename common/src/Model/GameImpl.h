@@ -59,8 +59,10 @@ namespace TrenchBroom {
             size_t doMaxPropertyLength() const override;
 
             World* doNewMap(MapFormat::Type format, const BBox3& worldBounds) const override;
-            World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const override;
+            World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status) const override;
+            World* loadMapCache(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& mapPath, const char* mapBegin, const char* mapEnd) const;
             void doWriteMap(World* world, const IO::Path& path) const override;
+            void doWriteMapCache(World* world, const IO::Path& path) const override;
             void doExportMap(World* world, Model::ExportFormat format, const IO::Path& path) const override;
 
             NodeList doParseNodes(const String& str, World* world, const BBox3& worldBounds, Logger* logger) const override;
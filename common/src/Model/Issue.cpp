@@ -24,6 +24,7 @@
 #include "Model/EditorContext.h"
 #include "Model/Node.h"
 
+#include <atomic>
 #include <cassert>
 
 namespace TrenchBroom {
@@ -87,7 +88,8 @@ namespace TrenchBroom {
         }
 
         size_t Issue::nextSeqId() {
-            static size_t seqId = 0;
+            // issues are created concurrently when the issue generator registry generates them
+            static std::atomic<size_t> seqId(0);
             return seqId++;
         }
 
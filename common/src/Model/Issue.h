@@ -26,9 +26,13 @@ namespace TrenchBroom {
     namespace Model {
         class EditorContext;
         
+        class IssueGeneratorRegistry;
+        
         class Issue {
         private:
             size_t m_seqId;
+
+            friend class IssueGeneratorRegistry;
         protected:
             Node* const m_node;
         public:
@@ -20,12 +20,22 @@
 #include "IssueGeneratorRegistry.h"
 
 #include "CollectionUtils.h"
+#include "TaskScheduler.h"
+#include "Model/Issue.h"
 #include "Model/IssueGenerator.h"
+#include "Model/Node.h"
 
 #include <cassert>
+#include <chrono>
+#include <functional>
 
 namespace TrenchBroom {
     namespace Model {
+        IssueGeneratorRegistry::Stats::Stats() :
+        nodeCount(0),
+        issueCount(0),
+        milliseconds(0.0) {}
+        
         IssueGeneratorRegistry::~IssueGeneratorRegistry() {
             clearGenerators();
         }
@@ -34,6 +44,10 @@ namespace TrenchBroom {
             return m_generators;
         }
 
+        const IssueGeneratorRegistry::StatsList& IssueGeneratorRegistry::stats() const {
+            return m_stats;
+        }
+
         IssueQuickFixList IssueGeneratorRegistry::quickFixes(const IssueType issueTypes) const {
             IssueQuickFixList result;
             for (const IssueGenerator* generator : m_generators) {
@@ -47,14 +61,48 @@ namespace TrenchBroom {
             ensure(generator != nullptr, "generator is null");
             assert(!VectorUtils::contains(m_generators, generator));
             m_generators.push_back(generator);
+            m_stats.push_back(Stats());
         }
         
         void IssueGeneratorRegistry::unregisterAllGenerators() {
             clearGenerators();
         }
 
+        void IssueGeneratorRegistry::generateIssues(const NodeList& nodes, TaskScheduler& scheduler) {
+            std::vector<IssueList> issues(nodes.size());
+            
+            for (size_t i = 0; i < m_generators.size(); ++i) {
+                const IssueGenerator* generator = m_generators[i];
+                
+                const auto start = std::chrono::steady_clock::now();
+                const size_t issueCount = scheduler.parallelReduce(0, nodes.size(), size_t(0), [&](const size_t j) {
+                    const size_t previousCount = issues[j].size();
+                    nodes[j]->generateIssues(generator, issues[j]);
+                    return issues[j].size() - previousCount;
+                }, std::plus<size_t>(), GrainSize);
+                const auto end = std::chrono::steady_clock::now();
+                
+                Stats& stats = m_stats[i];
+                stats.nodeCount += nodes.size();
+                stats.issueCount += issueCount;
+                stats.milliseconds += std::chrono::duration<double, std::milli>(end - start).count();
+            }
+            
+            // the issues were created in no particular order, so their sequence ids are reassigned
+            for (size_t j = 0; j < nodes.size(); ++j) {
+                for (Issue* issue : issues[j])
+                    issue->m_seqId = Issue::nextSeqId();
+                nodes[j]->setIssues(issues[j]);
+            }
+        }
+        
+        void IssueGeneratorRegistry::generateIssues(const NodeList& nodes) {
+            generateIssues(nodes, TaskScheduler::instance());
+        }
+
         void IssueGeneratorRegistry::clearGenerators() {
             VectorUtils::clearAndDelete(m_generators);
+            m_stats.clear();
         }
     }
 }
@@ -25,20 +25,49 @@
 #include <vector>
 
 namespace TrenchBroom {
+    class TaskScheduler;
+    
     namespace Model {
         class IssueGenerator;
         
         class IssueGeneratorRegistry {
+        public:
+            /**
+             * The work done by a generator since it was registered: the number of nodes it checked, the number of
+             * issues it found and the time it took.
+             */
+            struct Stats {
+                size_t nodeCount;
+                size_t issueCount;
+                double milliseconds;
+                
+                Stats();
+            };
+            
+            typedef std::vector<Stats> StatsList;
         private:
+            static const size_t GrainSize = 64;
+            
             IssueGeneratorList m_generators;
+            StatsList m_stats;
         public:
             ~IssueGeneratorRegistry();
             
             const IssueGeneratorList& registeredGenerators() const;
+            const StatsList& stats() const;
             IssueQuickFixList quickFixes(IssueType issueTypes) const;
             
             void registerGenerator(IssueGenerator* generator);
             void unregisterAllGenerators();
+            
+            /**
+             * Generates the issues of the given nodes and replaces their current issues. Every generator runs on all
+             * nodes before the next generator starts, and the nodes are checked concurrently, so generators must only
+             * modify the node they check. The issues of each node are in the order of the generators, and their
+             * sequence ids follow the order of the nodes, just as if the nodes had been validated one by one.
+             */
+            void generateIssues(const NodeList& nodes, TaskScheduler& scheduler);
+            void generateIssues(const NodeList& nodes);
         private:
             void clearGenerators();
         };
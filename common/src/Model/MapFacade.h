@@ -53,6 +53,7 @@ namespace TrenchBroom {
             virtual void selectTouching(bool del) = 0;
             virtual void selectInside(bool del) = 0;
             virtual void selectNodesWithFilePosition(const std::vector<size_t>& positions) = 0;
+            virtual void selectFacesWithTexture(const Assets::Texture* texture) = 0;
             virtual void select(const NodeList& nodes) = 0;
             virtual void select(Node* node) = 0;
             virtual void select(const BrushFaceList& faces) = 0;
@@ -568,6 +568,10 @@ namespace TrenchBroom {
             return m_lineNumber;
         }
 
+        size_t Node::lineCount() const {
+            return m_lineCount;
+        }
+
         void Node::setFilePosition(const size_t lineNumber, const size_t lineCount) {
             m_lineNumber = lineNumber;
             m_lineCount = lineCount;
@@ -595,7 +599,7 @@ namespace TrenchBroom {
 
         void Node::validateIssues(const IssueGeneratorList& issueGenerators) {
             if (!m_issuesValid) {
-                std::for_each(std::begin(issueGenerators), std::end(issueGenerators), [this](const IssueGenerator* generator) { doGenerateIssues(generator, m_issues); });
+                std::for_each(std::begin(issueGenerators), std::end(issueGenerators), [this](const IssueGenerator* generator) { generateIssues(generator, m_issues); });
                 m_issuesValid = true;
             }
         }
@@ -604,6 +608,20 @@ namespace TrenchBroom {
             clearIssues();
             m_issuesValid = false;
         }
+
+        bool Node::issuesValid() const {
+            return m_issuesValid;
+        }
+
+        void Node::generateIssues(const IssueGenerator* generator, IssueList& issues) {
+            doGenerateIssues(generator, issues);
+        }
+
+        void Node::setIssues(const IssueList& issues) {
+            clearIssues();
+            m_issues = issues;
+            m_issuesValid = true;
+        }
         
         void Node::clearIssues() const {
             VectorUtils::clearAndDelete(m_issues);
@@ -256,6 +256,7 @@ namespace TrenchBroom {
             FloatType intersectWithRay(const Ray3& ray) const;
         public: // file position
             size_t lineNumber() const;
+            size_t lineCount() const;
             void setFilePosition(size_t lineNumber, size_t lineCount);
             bool containsLine(size_t lineNumber) const;
         public: // issue management
@@ -263,8 +264,11 @@ namespace TrenchBroom {
             
             bool issueHidden(IssueType type) const;
             void setIssueHidden(IssueType type, bool hidden);
-        public: // should only be called from this and from the world
+        public: // should only be called from this, from the world and from the issue generator registry
             void invalidateIssues() const;
+            bool issuesValid() const;
+            void generateIssues(const IssueGenerator* generator, IssueList& issues);
+            void setIssues(const IssueList& issues);
         private:
             void validateIssues(const IssueGeneratorList& issueGenerators);
             void clearIssues() const;
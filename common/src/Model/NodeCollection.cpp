@@ -38,75 +38,80 @@ namespace TrenchBroom {
             m_collection(collection) {}
         private:
             void doVisit(World* world) override   {}
-            void doVisit(Layer* layer) override   { m_collection.m_nodes.push_back(layer);  m_collection.m_layers.push_back(layer); }
-            void doVisit(Group* group) override   { m_collection.m_nodes.push_back(group);  m_collection.m_groups.push_back(group); }
-            void doVisit(Entity* entity) override { m_collection.m_nodes.push_back(entity); m_collection.m_entities.push_back(entity); }
-            void doVisit(Brush* brush) override   { m_collection.m_nodes.push_back(brush);  m_collection.m_brushes.push_back(brush); }
+            void doVisit(Layer* layer) override   { add(m_collection.m_layers, layer); }
+            void doVisit(Group* group) override   { add(m_collection.m_groups, group); }
+            void doVisit(Entity* entity) override { add(m_collection.m_entities, entity); }
+            void doVisit(Brush* brush) override   { add(m_collection.m_brushes, brush); }
+
+            template <typename L, typename N>
+            void add(L& typedList, N* node) {
+                const Slot slot = { m_collection.m_nodes.size(), typedList.size() };
+                if (m_collection.m_slots.insert(std::make_pair(node, slot)).second) {
+                    m_collection.m_nodes.push_back(node);
+                    typedList.push_back(node);
+                }
+            }
         };
 
         class NodeCollection::RemoveNode : public NodeVisitor {
         private:
             NodeCollection& m_collection;
-            NodeList::iterator m_nodeRem;
-            LayerList::iterator m_layerRem;
-            GroupList::iterator m_groupRem;
-            EntityList::iterator m_entityRem;
-            BrushList::iterator m_brushRem;
         public:
             RemoveNode(NodeCollection& collection) :
-            m_collection(collection),
-            m_nodeRem(std::end(m_collection.m_nodes)),
-            m_layerRem(std::end(m_collection.m_layers)),
-            m_groupRem(std::end(m_collection.m_groups)),
-            m_entityRem(std::end(m_collection.m_entities)),
-            m_brushRem(std::end(m_collection.m_brushes)) {}
-            
-            ~RemoveNode() override {
-                m_collection.m_nodes.erase(m_nodeRem, std::end(m_collection.m_nodes));
-                m_collection.m_layers.erase(m_layerRem, std::end(m_collection.m_layers));
-                m_collection.m_groups.erase(m_groupRem, std::end(m_collection.m_groups));
-                m_collection.m_entities.erase(m_entityRem, std::end(m_collection.m_entities));
-                m_collection.m_brushes.erase(m_brushRem, std::end(m_collection.m_brushes));
-            }
+            m_collection(collection) {}
         private:
             void doVisit(World* world) override   {}
-            void doVisit(Layer* layer) override   { remove(m_collection.m_nodes, m_nodeRem, layer);  remove(m_collection.m_layers, m_layerRem, layer); }
-            void doVisit(Group* group) override   { remove(m_collection.m_nodes, m_nodeRem, group);  remove(m_collection.m_groups, m_groupRem, group); }
-            void doVisit(Entity* entity) override { remove(m_collection.m_nodes, m_nodeRem, entity); remove(m_collection.m_entities, m_entityRem, entity); }
-            void doVisit(Brush* brush) override   { remove(m_collection.m_nodes, m_nodeRem, brush);  remove(m_collection.m_brushes, m_brushRem, brush); }
-            
-            template <typename V, typename E>
-            void remove(V& collection, typename V::iterator& rem, E& elem) {
-                rem = std::remove(std::begin(collection), rem, elem);
+            void doVisit(Layer* layer) override   { remove(m_collection.m_layers, layer); }
+            void doVisit(Group* group) override   { remove(m_collection.m_groups, group); }
+            void doVisit(Entity* entity) override { remove(m_collection.m_entities, entity); }
+            void doVisit(Brush* brush) override   { remove(m_collection.m_brushes, brush); }
+
+            template <typename L, typename N>
+            void remove(L& typedList, N* node) {
+                const auto it = m_collection.m_slots.find(node);
+                if (it == std::end(m_collection.m_slots))
+                    return;
+
+                const Slot& slot = it->second;
+                assert(m_collection.m_nodes[slot.node] == node);
+                assert(typedList[slot.typed] == node);
+                m_collection.m_nodes[slot.node] = nullptr;
+                typedList[slot.typed] = nullptr;
+
+                m_collection.m_slots.erase(it);
+                ++m_collection.m_removedCount;
             }
         };
 
+        NodeCollection::NodeCollection() :
+        m_removedCount(0) {}
+
         bool NodeCollection::empty() const {
-            return m_nodes.empty();
+            return m_slots.empty();
         }
         
         size_t NodeCollection::nodeCount() const {
-            return m_nodes.size();
+            return m_slots.size();
         }
         
         size_t NodeCollection::layerCount() const {
-            return m_layers.size();
+            return layers().size();
         }
         
         size_t NodeCollection::groupCount() const {
-            return m_groups.size();
+            return groups().size();
         }
         
         size_t NodeCollection::entityCount() const {
-            return m_entities.size();
+            return entities().size();
         }
         
         size_t NodeCollection::brushCount() const {
-            return m_brushes.size();
+            return brushes().size();
         }
 
         bool NodeCollection::hasLayers() const {
-            return !m_layers.empty();
+            return layerCount() > 0;
         }
         
         bool NodeCollection::hasOnlyLayers() const {
@@ -114,7 +119,7 @@ namespace TrenchBroom {
         }
         
         bool NodeCollection::hasGroups() const {
-            return !m_groups.empty();
+            return groupCount() > 0;
         }
         
         bool NodeCollection::hasOnlyGroups() const {
@@ -122,7 +127,7 @@ namespace TrenchBroom {
         }
         
         bool NodeCollection::hasEntities() const {
-            return !m_entities.empty();
+            return entityCount() > 0;
         }
         
         bool NodeCollection::hasOnlyEntities() const {
@@ -130,46 +135,59 @@ namespace TrenchBroom {
         }
         
         bool NodeCollection::hasBrushes() const {
-            return !m_brushes.empty();
+            return brushCount() > 0;
         }
         
         bool NodeCollection::hasOnlyBrushes() const {
             return !empty() && nodeCount() == brushCount();
         }
 
+        bool NodeCollection::contains(const Node* node) const {
+            return m_slots.count(const_cast<Node*>(node)) > 0;
+        }
+
         NodeList::iterator NodeCollection::begin() {
+            compact();
             return std::begin(m_nodes);
         }
         
         NodeList::iterator NodeCollection::end() {
+            compact();
             return std::end(m_nodes);
         }
         
         NodeList::const_iterator NodeCollection::begin() const {
+            compact();
             return std::begin(m_nodes);
         }
         
         NodeList::const_iterator NodeCollection::end() const {
+            compact();
             return std::end(m_nodes);
         }
 
         const NodeList& NodeCollection::nodes() const {
+            compact();
             return m_nodes;
         }
         
         const LayerList& NodeCollection::layers() const {
+            compact();
             return m_layers;
         }
         
         const GroupList& NodeCollection::groups() const {
+            compact();
             return m_groups;
         }
         
         const EntityList& NodeCollection::entities() const {
+            compact();
             return m_entities;
         }
         
         const BrushList& NodeCollection::brushes() const {
+            compact();
             return m_brushes;
         }
         
@@ -201,6 +219,39 @@ namespace TrenchBroom {
             m_groups.clear();
             m_entities.clear();
             m_brushes.clear();
+            m_slots.clear();
+            m_removedCount = 0;
+        }
+
+        template <typename L>
+        static void removeNullEntries(L& list) {
+            list.erase(std::remove(std::begin(list), std::end(list), nullptr), std::end(list));
+        }
+
+        template <typename L, typename M>
+        static void updateTypedSlots(const L& list, M& slots) {
+            for (size_t i = 0; i < list.size(); ++i)
+                slots.at(list[i]).typed = i;
+        }
+
+        void NodeCollection::compact() const {
+            if (m_removedCount == 0)
+                return;
+
+            removeNullEntries(m_nodes);
+            removeNullEntries(m_layers);
+            removeNullEntries(m_groups);
+            removeNullEntries(m_entities);
+            removeNullEntries(m_brushes);
+
+            for (size_t i = 0; i < m_nodes.size(); ++i)
+                m_slots.at(m_nodes[i]).node = i;
+            updateTypedSlots(m_layers, m_slots);
+            updateTypedSlots(m_groups, m_slots);
+            updateTypedSlots(m_entities, m_slots);
+            updateTypedSlots(m_brushes, m_slots);
+
+            m_removedCount = 0;
         }
     }
 }
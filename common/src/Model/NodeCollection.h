@@ -23,19 +23,41 @@
 #include "Model/ModelTypes.h"
 #include "Model/NodeVisitor.h"
 
+#include <unordered_map>
+
 namespace TrenchBroom {
     namespace Model {
+        /**
+         * An insertion ordered set of nodes that also keeps the layers, groups, entities and brushes in separate
+         * lists. Adding a node that is already contained does nothing.
+         *
+         * Removing a node only leaves a null entry in the lists, so that removing any number of nodes takes constant
+         * time per node. The null entries are dropped the next time the lists are accessed, which keeps the order of
+         * the remaining nodes.
+         */
         class NodeCollection {
         private:
             class AddNode;
             class RemoveNode;
+
+            struct Slot {
+                size_t node;
+                size_t typed;
+            };
+            typedef std::unordered_map<Node*, Slot> SlotMap;
         private:
-            NodeList m_nodes;
-            LayerList m_layers;
-            GroupList m_groups;
-            EntityList m_entities;
-            BrushList m_brushes;
+            // mutable because removed entries are dropped lazily when the lists are accessed
+            mutable NodeList m_nodes;
+            mutable LayerList m_layers;
+            mutable GroupList m_groups;
+            mutable EntityList m_entities;
+            mutable BrushList m_brushes;
+
+            mutable SlotMap m_slots;
+            mutable size_t m_removedCount;
         public:
+            NodeCollection();
+
             bool empty() const;
             size_t nodeCount() const;
             size_t layerCount() const;
@@ -52,6 +74,8 @@ namespace TrenchBroom {
             bool hasBrushes() const;
             bool hasOnlyBrushes() const;
 
+            bool contains(const Node* node) const;
+
             NodeList::iterator begin();
             NodeList::iterator end();
             NodeList::const_iterator begin() const;
@@ -70,6 +94,8 @@ namespace TrenchBroom {
             void removeNode(Node* node);
             
             void clear();
+        private:
+            void compact() const;
         };
     }
 }
@@ -19,10 +19,11 @@
 
 #include "PointFile.h"
 
+#include "IO/DiskIO.h"
 #include "IO/Path.h"
+#include "IO/PointFileParser.h"
 
 #include <cassert>
-#include <fstream>
 
 namespace TrenchBroom {
     namespace Model {
@@ -72,40 +73,34 @@ namespace TrenchBroom {
             --m_current;
         }
         
-        void PointFile::load(const IO::Path& pointFilePath) {
-            static const float Threshold = Math::radians(15.0f);
-            
-            std::fstream stream(pointFilePath.asString().c_str(), std::ios::in);
-            assert(stream.is_open());
-            
-            Vec3f::List points;
-            String line;
-            
-            if (!stream.eof()) {
-                std::getline(stream, line);
-                points.push_back(Vec3f::parse(line));
-                Vec3f lastPoint = points.back();
-                
-                if (!stream.eof()) {
-                    std::getline(stream, line);
-                    Vec3f curPoint = Vec3f::parse(line);
-                    Vec3f refDir = (curPoint - lastPoint).normalized();
-                    
-                    while (!stream.eof()) {
-                        lastPoint = curPoint;
-                        std::getline(stream, line);
-                        curPoint = Vec3f::parse(line);
-                        
-                        const Vec3f dir = (curPoint - lastPoint).normalized();
-                        if (std::acos(dir.dot(refDir)) > Threshold) {
-                            points.push_back(lastPoint);
-                            refDir = dir;
-                        }
-                    }
-                    
-                    points.push_back(curPoint);
+        void PointFile::simplify(Vec3f::List& points) {
+            // the angle between two directions exceeds the threshold if the cosine is less than its cosine
+            static const float CosThreshold = std::cos(Math::radians(15.0f));
+            if (points.size() < 3)
+                return;
+
+            // keep only the points where the direction changes noticeably, compacting the list in place
+            size_t count = 1;
+            Vec3f refDir = (points[1] - points[0]).normalized();
+            for (size_t i = 2; i < points.size(); ++i) {
+                const Vec3f lastPoint = points[i - 1];
+                const Vec3f dir = (points[i] - lastPoint).normalized();
+                if (dir.dot(refDir) < CosThreshold) {
+                    points[count++] = lastPoint;
+                    refDir = dir;
                 }
             }
+            points[count++] = points.back();
+            points.resize(count);
+        }
+
+        void PointFile::load(const IO::Path& pointFilePath) {
+            IO::MappedFile::Ptr file = IO::Disk::openFile(pointFilePath);
+            IO::PointFileParser parser(file->begin(), file->end());
+
+            Vec3f::List points;
+            parser.parse(points);
+            simplify(points);
 
             if (points.size() > 1) {
                 for (size_t i = 0; i < points.size() - 1; ++i) {
@@ -48,6 +48,7 @@ namespace TrenchBroom {
             void retreat();
         private:
             void load(const IO::Path& pointFilePath);
+            static void simplify(Vec3f::List& points);
         };
     }
 }
@@ -17,86 +17,158 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #include "PortalFile.h"
 
+#include "IO/DiskIO.h"
 #include "IO/Path.h"
+#include "IO/PortalFileParser.h"
 
+#include <algorithm>
 #include <cassert>
-#include <fstream>
+#include <numeric>
 
 namespace TrenchBroom {
     namespace Model {
+        const size_t PortalFile::MaxChunkSize;
+
+        PortalFile::Chunk::Chunk(const BBox3f& i_bounds, const size_t i_firstPortal, const size_t i_portalCount) :
+        bounds(i_bounds),
+        firstPortal(i_firstPortal),
+        portalCount(i_portalCount) {}
+
         PortalFile::PortalFile() {}
 
         PortalFile::PortalFile(const IO::Path& path) {
             load(path);
         }
         
-        const Polygon3f::List& PortalFile::portals() const {
-            return m_portals;
+        PortalFile::PortalFile(Vec3f::List& vertices, std::vector<size_t>& offsets) {
+            using std::swap;
+            swap(m_vertices, vertices);
+            swap(m_offsets, offsets);
+            buildChunks();
         }
-        
+
+        size_t PortalFile::portalCount() const {
+            return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+        }
+
+        size_t PortalFile::vertexCount() const {
+            return m_vertices.size();
+        }
+
+        const Vec3f::List& PortalFile::vertices() const {
+            return m_vertices;
+        }
+
+        size_t PortalFile::firstVertex(const size_t portalIndex) const {
+            assert(portalIndex < portalCount());
+            return m_offsets[portalIndex];
+        }
+
+        size_t PortalFile::vertexCount(const size_t portalIndex) const {
+            assert(portalIndex < portalCount());
+            return m_offsets[portalIndex + 1] - m_offsets[portalIndex];
+        }
+
+        Polygon3f PortalFile::portal(const size_t portalIndex) const {
+            const auto first = std::begin(m_vertices) + static_cast<std::ptrdiff_t>(firstVertex(portalIndex));
+            const auto last = first + static_cast<std::ptrdiff_t>(vertexCount(portalIndex));
+            return Polygon3f(Vec3f::List(first, last));
+        }
+
+        Polygon3f::List PortalFile::portals() const {
+            Polygon3f::List result;
+            result.reserve(portalCount());
+            for (size_t i = 0; i < portalCount(); ++i)
+                result.push_back(portal(i));
+            return result;
+        }
+
+        const PortalFile::ChunkList& PortalFile::chunks() const {
+            return m_chunks;
+        }
+
         void PortalFile::load(const IO::Path& portalFilePath) {
-            std::fstream stream(portalFilePath.asString(), std::ios::in);
-            if (!stream.good()) {
-                throw FileFormatException("Couldn't open file");
-            }
-            
-            String line;
-            int numPortals;
-            
-            // read header
-            std::getline(stream, line);
-            const String formatCode = StringUtils::trim(line); // trim off any trailing \r
+            IO::MappedFile::Ptr file = IO::Disk::openFile(portalFilePath);
+            IO::PortalFileParser parser(file->begin(), file->end());
+            parser.parse(m_vertices, m_offsets);
+            buildChunks();
+        }
+
+        void PortalFile::buildChunks() {
+            const size_t count = portalCount();
+            if (count == 0)
+                return;
             
-            if (formatCode == "PRT1") {
-                std::getline(stream, line); // number of leafs (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
-            } else if (formatCode == "PRT2") {
-                std::getline(stream, line); // number of leafs (ignored)
-                std::getline(stream, line); // number of clusters (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
-            } else if (formatCode == "PRT1-AM") {
-                std::getline(stream, line); // number of clusters (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
-                std::getline(stream, line); // number of leafs (ignored)
-            } else {
-                throw FileFormatException("Unknown portal format: " + formatCode);
+            // small files keep the order of the portals in the file
+            std::vector<size_t> portalIndices(count);
+            std::iota(std::begin(portalIndices), std::end(portalIndices), 0);
+            if (count <= MaxChunkSize) {
+                m_chunks.push_back(Chunk(bounds(portalIndices, 0, count), 0, count));
+                return;
             }
-            
-            if (!stream.good()) {
-                throw FileFormatException("Error reading header");
+
+            Vec3f::List centers;
+            centers.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+                centers.push_back(bounds(portalIndices, i, 1).center());
+
+            buildChunks(portalIndices, 0, count, centers);
+
+            // reorder the portals so that every chunk refers to a contiguous range of portals and vertices
+            Vec3f::List vertices;
+            vertices.reserve(m_vertices.size());
+            std::vector<size_t> offsets;
+            offsets.reserve(m_offsets.size());
+
+            for (const size_t portalIndex : portalIndices) {
+                offsets.push_back(vertices.size());
+                const auto first = std::begin(m_vertices) + static_cast<std::ptrdiff_t>(firstVertex(portalIndex));
+                const auto last = first + static_cast<std::ptrdiff_t>(vertexCount(portalIndex));
+                vertices.insert(std::end(vertices), first, last);
             }
-            
-            // read portals
-            for (int i = 0; i < numPortals; ++i) {
-                std::getline(stream, line);
-                const auto components = StringUtils::splitAndTrim(line, "() \n\t\r");
-                
-                if (!stream.good() || components.size() < 3) {
-                    throw FileFormatException("Error reading portal");
-                }
-                
-                Vec3f::List verts;
-                size_t ptr = 3;
-                const int numPoints = std::stoi(components.at(0));
-                for (int j = 0; j < numPoints; ++j) {
-                    if (ptr + 2 >= components.size()) {
-                        throw FileFormatException("Error reading portal");
-                    }
-                    
-                    const Vec3f vert(std::stof(components.at(ptr)),
-                                     std::stof(components.at(ptr+1)),
-                                     std::stof(components.at(ptr+2)));
-                    verts.push_back(vert);
-                    ptr += 3;
-                }
-                
-                m_portals.push_back(Polygon3f(verts));
+            offsets.push_back(vertices.size());
+
+            using std::swap;
+            swap(m_vertices, vertices);
+            swap(m_offsets, offsets);
+        }
+
+        void PortalFile::buildChunks(std::vector<size_t>& portalIndices, const size_t first, const size_t count, const Vec3f::List& centers) {
+            if (count <= MaxChunkSize) {
+                m_chunks.push_back(Chunk(bounds(portalIndices, first, count), first, count));
+                return;
+            }
+
+            // split at the median of the portal centers along the longest axis of their bounds
+            BBox3f centerBounds(centers[portalIndices[first]], centers[portalIndices[first]]);
+            for (size_t i = first + 1; i < first + count; ++i)
+                centerBounds = centerBounds.mergedWith(centers[portalIndices[i]]);
+            const size_t axis = centerBounds.size().firstComponent();
+
+            const auto begin = std::begin(portalIndices) + static_cast<std::ptrdiff_t>(first);
+            const auto middle = begin + static_cast<std::ptrdiff_t>(count / 2);
+            const auto end = begin + static_cast<std::ptrdiff_t>(count);
+            std::nth_element(begin, middle, end, [&centers, axis](const size_t lhs, const size_t rhs) {
+                return centers[lhs][axis] < centers[rhs][axis];
+            });
+
+            buildChunks(portalIndices, first, count / 2, centers);
+            buildChunks(portalIndices, first + count / 2, count - count / 2, centers);
+        }
+
+        BBox3f PortalFile::bounds(const std::vector<size_t>& portalIndices, const size_t first, const size_t count) const {
+            assert(count > 0);
+            const Vec3f& vertex = m_vertices[m_offsets[portalIndices[first]]];
+            BBox3f result(vertex, vertex);
+            for (size_t i = first; i < first + count; ++i) {
+                const size_t portalIndex = portalIndices[i];
+                for (size_t j = m_offsets[portalIndex]; j < m_offsets[portalIndex + 1]; ++j)
+                    result = result.mergedWith(m_vertices[j]);
             }
+            return result;
         }
     }
 }
@@ -17,31 +17,69 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #ifndef TrenchBroom_PortalFile
 #define TrenchBroom_PortalFile
 
 #include "TrenchBroom.h"
 #include "VecMath.h"
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace IO {
         class Path;
     }
     
     namespace Model {
+        /**
+         * The portals are stored as one packed list of vertices. Large files are sorted into spatially coherent
+         * chunks of portals so that a renderer can skip the chunks that are not visible.
+         */
         class PortalFile {
+        public:
+            static const size_t MaxChunkSize = 2048;
+
+            struct Chunk {
+                BBox3f bounds;
+                size_t firstPortal;
+                size_t portalCount;
+                
+                Chunk(const BBox3f& i_bounds, size_t i_firstPortal, size_t i_portalCount);
+            };
+            typedef std::vector<Chunk> ChunkList;
         private:
-            Polygon3f::List m_portals;
+            Vec3f::List m_vertices;
+            std::vector<size_t> m_offsets;
+            ChunkList m_chunks;
         public:
             PortalFile();
             /**
              * Constructor throws an exception if portalFilePath couldn't be read.
              */
             explicit PortalFile(const IO::Path& portalFilePath);
+
+            /**
+             * Creates a portal file from the given portal vertices, see IO::PortalFileParser::parse.
+             */
+            PortalFile(Vec3f::List& vertices, std::vector<size_t>& offsets);
+
+            size_t portalCount() const;
+            size_t vertexCount() const;
             
-            const Polygon3f::List& portals() const;
+            const Vec3f::List& vertices() const;
+            size_t firstVertex(size_t portalIndex) const;
+            size_t vertexCount(size_t portalIndex) const;
+
+            Polygon3f portal(size_t portalIndex) const;
+            Polygon3f::List portals() const;
+
+            const ChunkList& chunks() const;
         private:
             void load(const IO::Path& portalFilePath);
+            void buildChunks();
+            void buildChunks(std::vector<size_t>& portalIndices, size_t first, size_t count, const Vec3f::List& centers);
+            BBox3f bounds(const std::vector<size_t>& portalIndices, size_t first, size_t count) const;
         };
     }
 }
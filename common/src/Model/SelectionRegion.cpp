@@ -0,0 +1,106 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "SelectionRegion.h"
+
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        SelectionRegion::SelectionRegion() :
+        m_empty(true) {}
+
+        SelectionRegion::SelectionRegion(const Plane3::List& planes) :
+        m_planes(planes),
+        m_empty(false) {}
+
+        bool SelectionRegion::empty() const {
+            return m_empty;
+        }
+
+        const Plane3::List& SelectionRegion::planes() const {
+            return m_planes;
+        }
+
+        bool SelectionRegion::contains(const Vec3& point) const {
+            if (m_empty)
+                return false;
+
+            for (const Plane3& plane : m_planes) {
+                if (plane.pointDistance(point) > Math::Constants<FloatType>::pointStatusEpsilon())
+                    return false;
+            }
+            return true;
+        }
+
+        bool SelectionRegion::contains(const BBox3& bounds) const {
+            if (m_empty)
+                return false;
+
+            // the bounds are contained if their corner that lies farthest along each plane normal is below the plane
+            for (const Plane3& plane : m_planes) {
+                Vec3 corner;
+                for (size_t i = 0; i < 3; ++i)
+                    corner[i] = plane.normal[i] >= 0.0 ? bounds.max[i] : bounds.min[i];
+                if (plane.pointDistance(corner) > Math::Constants<FloatType>::pointStatusEpsilon())
+                    return false;
+            }
+            return true;
+        }
+
+        bool SelectionRegion::contains(const Brush* brush) const {
+            if (m_empty)
+                return false;
+
+            for (const BrushVertex* vertex : brush->vertices()) {
+                if (!contains(vertex->position()))
+                    return false;
+            }
+            return true;
+        }
+
+        bool SelectionRegion::contains(const BrushFace* face) const {
+            if (m_empty)
+                return false;
+
+            for (const BrushVertex* vertex : face->vertices()) {
+                if (!contains(vertex->position()))
+                    return false;
+            }
+            return true;
+        }
+
+        bool SelectionRegion::intersects(const BBox3& bounds) const {
+            if (m_empty)
+                return false;
+
+            // the bounds lie outside if their corner that lies farthest against a plane normal is above the plane
+            for (const Plane3& plane : m_planes) {
+                Vec3 corner;
+                for (size_t i = 0; i < 3; ++i)
+                    corner[i] = plane.normal[i] >= 0.0 ? bounds.min[i] : bounds.max[i];
+                if (plane.pointDistance(corner) > Math::Constants<FloatType>::pointStatusEpsilon())
+                    return false;
+            }
+            return true;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_SelectionRegion
+#define TrenchBroom_SelectionRegion
+
+#include "TrenchBroom.h"
+#include "VecMath.h"
+#include "Model/ModelTypes.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * A convex region of space that is bounded by planes whose normals point outwards, such as the part of the
+         * view frustum that is covered by a rectangle on the screen. Region selection selects the objects that are
+         * contained in such a region.
+         *
+         * The region can be used as a region for AABBTree::findInRegion.
+         */
+        class SelectionRegion {
+        private:
+            Plane3::List m_planes;
+            bool m_empty;
+        public:
+            /**
+             * Creates an empty region that contains and intersects nothing.
+             */
+            SelectionRegion();
+
+            /**
+             * Creates a region that consists of every point that lies on or below each of the given planes.
+             */
+            explicit SelectionRegion(const Plane3::List& planes);
+
+            bool empty() const;
+            const Plane3::List& planes() const;
+
+            bool contains(const Vec3& point) const;
+            bool contains(const BBox3& bounds) const;
+            bool contains(const Brush* brush) const;
+            bool contains(const BrushFace* face) const;
+
+            /**
+             * Indicates whether the given bounds may intersect this region. This test is conservative, i.e., it can
+             * return true for bounds that lie outside of this region near one of its corners.
+             */
+            bool intersects(const BBox3& bounds) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_SelectionRegion) */
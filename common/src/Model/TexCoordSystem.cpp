@@ -33,6 +33,12 @@ namespace TrenchBroom {
             return doClone();
         }
         
+        TexCoordProjection::TexCoordProjection(const Vec3& xAxis, const Vec3& yAxis, const Vec2f& offset, const Vec2f& textureSize) :
+        m_xAxis(xAxis),
+        m_yAxis(yAxis),
+        m_offset(offset),
+        m_textureSize(textureSize) {}
+
         TexCoordSystem::TexCoordSystem() {}
 
         TexCoordSystem::~TexCoordSystem() {}
@@ -72,6 +78,14 @@ namespace TrenchBroom {
         Vec2f TexCoordSystem::getTexCoords(const Vec3& point, const BrushFaceAttributes& attribs) const {
             return doGetTexCoords(point, attribs);
         }
+
+        TexCoordProjection TexCoordSystem::getTexCoordProjection(const BrushFaceAttributes& attribs) const {
+            const Vec2f& scale = attribs.scale();
+            return TexCoordProjection(safeScaleAxis(getXAxis(), scale.x()),
+                                      safeScaleAxis(getYAxis(), scale.y()),
+                                      attribs.offset(),
+                                      attribs.textureSize());
+        }
         
         void TexCoordSystem::setRotation(const Vec3& normal, const float oldAngle, const float newAngle) {
             doSetRotation(normal, oldAngle, newAngle);
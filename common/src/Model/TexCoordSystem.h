@@ -52,6 +52,25 @@ namespace TrenchBroom {
         	Projection,
             Rotation
         };
+
+        /**
+         * Maps points on a face to texture coordinates. The projection is computed once from the texture axes and
+         * the face attributes and yields the same coordinates as TexCoordSystem::getTexCoords, so that the vertices
+         * of a face can be mapped without looking up the axes and the attributes for each of them.
+         */
+        class TexCoordProjection {
+        private:
+            Vec3 m_xAxis;
+            Vec3 m_yAxis;
+            Vec2f m_offset;
+            Vec2f m_textureSize;
+        public:
+            TexCoordProjection(const Vec3& xAxis, const Vec3& yAxis, const Vec2f& offset, const Vec2f& textureSize);
+
+            Vec2f project(const Vec3& point) const {
+                return (Vec2f(point.dot(m_xAxis), point.dot(m_yAxis)) + m_offset) / m_textureSize;
+            }
+        };
         
         class TexCoordSystem {
         public:
@@ -70,6 +89,7 @@ namespace TrenchBroom {
             void resetTextureAxesToParallel(const Vec3& normal, float angle);
             
             Vec2f getTexCoords(const Vec3& point, const BrushFaceAttributes& attribs) const;
+            TexCoordProjection getTexCoordProjection(const BrushFaceAttributes& attribs) const;
             
             void setRotation(const Vec3& normal, float oldAngle, float newAngle);
             void transform(const Plane3& oldBoundary, const Plane3& newBoundary, const Mat4x4& transformation, BrushFaceAttributes& attribs, bool lockTexture, const Vec3& invariant);
@@ -23,7 +23,13 @@
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/CollectNodesWithDescendantSelectionCountVisitor.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
 #include "Model/IssueGenerator.h"
+#include "Model/PickResult.h"
+
+#include <iterator>
+#include <limits>
 
 namespace TrenchBroom {
     namespace Model {
@@ -77,6 +83,10 @@ namespace TrenchBroom {
             return m_issueGeneratorRegistry.registeredGenerators();
         }
 
+        const IssueGeneratorRegistry::StatsList& World::issueGeneratorStats() const {
+            return m_issueGeneratorRegistry.stats();
+        }
+
         IssueQuickFixList World::quickFixes(const IssueType issueTypes) const {
             return m_issueGeneratorRegistry.quickFixes(issueTypes);
         }
@@ -91,6 +101,31 @@ namespace TrenchBroom {
             invalidateAllIssues();
         }
 
+        class World::CollectNodesWithInvalidIssuesVisitor : public NodeVisitor {
+        private:
+            NodeList m_nodes;
+        public:
+            const NodeList& nodes() const { return m_nodes; }
+        private:
+            void doVisit(World* world) override   { collect(world);  }
+            void doVisit(Layer* layer) override   { collect(layer);  }
+            void doVisit(Group* group) override   { collect(group);  }
+            void doVisit(Entity* entity) override { collect(entity); }
+            void doVisit(Brush* brush) override   { collect(brush);  }
+
+            void collect(Node* node) {
+                if (!node->issuesValid())
+                    m_nodes.push_back(node);
+            }
+        };
+
+        void World::validateAllIssues() {
+            CollectNodesWithInvalidIssuesVisitor visitor;
+            acceptAndRecurse(visitor);
+            if (!visitor.nodes().empty())
+                m_issueGeneratorRegistry.generateIssues(visitor.nodes());
+        }
+
         class World::AddNodeToNodeTree : public NodeVisitor {
         private:
             NodeTree& m_nodeTree;
@@ -169,6 +204,94 @@ namespace TrenchBroom {
             m_nodeTree.clearAndBuild(collect.nodes(), [](const auto* node){ return node->bounds(); });
         }
 
+        NodeList World::findNodesIntersecting(const BBox3& bounds) const {
+            NodeList result;
+            m_nodeTree.findIntersectors(bounds, std::back_inserter(result));
+            return result;
+        }
+
+        class World::RegionContainsNode : public ConstNodeVisitor, public NodeQuery<bool> {
+        private:
+            const SelectionRegion& m_region;
+        public:
+            RegionContainsNode(const SelectionRegion& region) :
+            m_region(region) {}
+        private:
+            void doVisit(const World* world) override   { setResult(false); }
+            void doVisit(const Layer* layer) override   { setResult(false); }
+            void doVisit(const Group* group) override   { setResult(m_region.contains(group->bounds())); }
+            void doVisit(const Entity* entity) override { setResult(m_region.contains(entity->bounds())); }
+            void doVisit(const Brush* brush) override   { setResult(m_region.contains(brush)); }
+        };
+
+        NodeList World::findNodesContainedIn(const SelectionRegion& region) const {
+            NodeList result;
+            m_nodeTree.findInRegion(region, [&](Node* node, const bool contained) {
+                if (contained) {
+                    result.push_back(node);
+                } else {
+                    RegionContainsNode visitor(region);
+                    node->accept(visitor);
+                    if (visitor.result())
+                        result.push_back(node);
+                }
+            });
+            return result;
+        }
+
+        class World::CollectBrushFacesInRegion : public ConstNodeVisitor {
+        private:
+            const SelectionRegion& m_region;
+            bool m_contained;
+            BrushFaceList& m_faces;
+        public:
+            CollectBrushFacesInRegion(const SelectionRegion& region, const bool contained, BrushFaceList& faces) :
+            m_region(region),
+            m_contained(contained),
+            m_faces(faces) {}
+        private:
+            void doVisit(const World* world) override   {}
+            void doVisit(const Layer* layer) override   {}
+            void doVisit(const Group* group) override   {}
+            void doVisit(const Entity* entity) override {}
+            void doVisit(const Brush* brush) override   {
+                for (BrushFace* face : brush->faces()) {
+                    if (m_contained || m_region.contains(face))
+                        m_faces.push_back(face);
+                }
+            }
+        };
+
+        BrushFaceList World::findBrushFacesContainedIn(const SelectionRegion& region) const {
+            BrushFaceList result;
+            m_nodeTree.findInRegion(region, [&](const Node* node, const bool contained) {
+                CollectBrushFacesInRegion visitor(region, contained, result);
+                node->accept(visitor);
+            });
+            return result;
+        }
+
+        void World::pickNearest(const Ray3& ray, PickResult& pickResult, const PickQuery& query) const {
+            // only run the query again if the last node has added a hit
+            size_t hitCount = std::numeric_limits<size_t>::max();
+            FloatType nearestDistance = std::numeric_limits<FloatType>::max();
+
+            m_nodeTree.findIntersectorsInOrder(ray, [&](const Node* node, const FloatType entryDistance) {
+                if (pickResult.size() != hitCount) {
+                    hitCount = pickResult.size();
+                    const Hit& hit = query(pickResult);
+                    nearestDistance = hit.isMatch() ? hit.distance() : std::numeric_limits<FloatType>::max();
+                }
+
+                // the node and all remaining nodes are behind the nearest hit
+                if (Math::lt(nearestDistance, entryDistance))
+                    return false;
+
+                node->pick(ray, pickResult);
+                return true;
+            });
+        }
+
         class World::InvalidateAllIssuesVisitor : public NodeVisitor {
         private:
             void doVisit(World* world) override   { invalidateIssues(world);  }
@@ -30,10 +30,12 @@
 #include "Model/ModelFactory.h"
 #include "Model/ModelFactoryImpl.h"
 #include "Model/Node.h"
+#include "Model/SelectionRegion.h"
 
 namespace TrenchBroom {
     namespace Model {
         class BrushContentTypeBuilder;
+        class Hit;
         class PickResult;
         
         class World : public AttributableNode, public ModelFactory {
@@ -67,20 +69,66 @@ namespace TrenchBroom {
         public: // selection
             // issue generator registration
             const IssueGeneratorList& registeredIssueGenerators() const;
+            const IssueGeneratorRegistry::StatsList& issueGeneratorStats() const;
             IssueQuickFixList quickFixes(IssueType issueTypes) const;
             void registerIssueGenerator(IssueGenerator* issueGenerator);
             void unregisterAllIssueGenerators();
+
+            /**
+             * Generates the issues of every node whose issues are not valid. The nodes are checked concurrently.
+             */
+            void validateAllIssues();
         private:
             class AddNodeToNodeTree;
             class RemoveNodeFromNodeTree;
             class UpdateNodeInNodeTree;
+            class RegionContainsNode;
+            class CollectBrushFacesInRegion;
         public: // node tree bulk updating
             class MatchTreeNodes;
             void disableNodeTreeUpdates();
             void enableNodeTreeUpdates();
             void rebuildNodeTree();
+        public: // node tree queries
+            /**
+             * Returns the groups, entities and brushes whose bounds intersect the given bounds.
+             */
+            NodeList findNodesIntersecting(const BBox3& bounds) const;
+
+            /**
+             * Returns the groups, entities and brushes that are entirely contained in the given region. Brushes are
+             * tested by their vertices, and groups and entities by their bounds.
+             */
+            NodeList findNodesContainedIn(const SelectionRegion& region) const;
+
+            /**
+             * Returns the brush faces whose vertices are all contained in the given region.
+             */
+            BrushFaceList findBrushFacesContainedIn(const SelectionRegion& region) const;
+
+            /**
+             * Calls the given function for every group, entity and brush whose bounds intersect the given region,
+             * together with a flag that indicates whether its bounds are entirely contained in the region.
+             */
+            template <typename F>
+            void findNodesInRegion(const SelectionRegion& region, F visit) const {
+                m_nodeTree.findInRegion(region, visit);
+            }
+
+            typedef std::function<const Hit&(const PickResult&)> PickQuery;
+            /**
+             * Picks the groups, entities and brushes whose bounds are hit by the given ray front to back and stops
+             * as soon as the hit returned by the given query lies in front of every node that has not been picked
+             * yet. The query then returns the same hit as if every node had been picked, but the pick result only
+             * contains the hits that were found up to that point.
+             *
+             * This relies on the pick result ordering its hits by distance, which is the case for
+             * PickResult::byDistance.
+             */
+            void pickNearest(const Ray3& ray, PickResult& pickResult, const PickQuery& query) const;
         private:
             class InvalidateAllIssuesVisitor;
+            class CollectNodesWithInvalidIssuesVisitor;
             void invalidateAllIssues();
         private: // implement Node interface
             const BBox3& doGetBounds() const override;
@@ -118,8 +118,11 @@ namespace TrenchBroom {
 
         Preference<int> TextureMinFilter(IO::Path("Renderer/Texture mode min filter"), 0x2700);
         Preference<int> TextureMagFilter(IO::Path("Renderer/Texture mode mag filter"), 0x2600);
+        Preference<bool> TextureArrays(IO::Path("Renderer/Use texture arrays"), false);
+        Preference<bool> ShowFrameTimings(IO::Path("Renderer/Show frame timings"), false);
 
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
+        Preference<bool> WriteMapCache(IO::Path("Editor/Write map cache"), true);
 
         Preference<IO::Path>& RendererFontPath() {
             static Preference<IO::Path> fontPath(IO::Path("Renderer/Font name"), IO::Path("fonts/SourceSansPro-Regular.otf"));
@@ -115,8 +115,11 @@ namespace TrenchBroom {
         
         extern Preference<int> TextureMinFilter;
         extern Preference<int> TextureMagFilter;
+        extern Preference<bool> TextureArrays;
+        extern Preference<bool> ShowFrameTimings;
         
         extern Preference<bool> TextureLock;
+        extern Preference<bool> WriteMapCache;
         
         Preference<IO::Path>& RendererFontPath();
         extern Preference<int> RendererFontSize;
@@ -28,7 +28,9 @@
 #include "Model/NodeVisitor.h"
 #include "Renderer/IndexArrayMapBuilder.h"
 #include "Renderer/BrushRendererArrays.h"
+#include "Renderer/Camera.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/RenderUtils.h"
 #include "Renderer/TexturedIndexArrayBuilder.h"
 #include "Renderer/VertexSpec.h"
@@ -114,10 +116,21 @@ namespace TrenchBroom {
                                    EdgeRenderPolicy::RenderAll);
         }
 
+        // VisibleEdges
+
+        BrushRenderer::VisibleEdges::VisibleEdges() :
+        all(false) {}
+
         // BrushRenderer
 
+        /**
+         * If more brushes than this are validated at once, the brush tree is built again instead of being updated.
+         */
+        static const size_t MinBrushTreeRebuildCount = 256;
+
         BrushRenderer::BrushRenderer(const bool transparent) :
         m_filter(new NoFilter(transparent)),
+        m_brushTreeValid(false),
         m_showEdges(false),
         m_grayscale(false),
         m_tint(false),
@@ -138,6 +151,14 @@ namespace TrenchBroom {
             }
         }
 
+        void BrushRenderer::removeBrushes(const Model::BrushList& brushes) {
+            for (auto* brush : brushes) {
+                if (m_allBrushes.find(brush) != m_allBrushes.end()) {
+                    removeBrush(brush);
+                }
+            }
+        }
+
         void BrushRenderer::setBrushes(const Model::BrushList& brushes) {
             // start with adding nothing, and removing everything
             std::set<const Model::Brush*> toAdd;
@@ -161,6 +182,7 @@ namespace TrenchBroom {
         }
 
         void BrushRenderer::invalidate() {
+            invalidateBrushTree();
             for (auto& brush : m_allBrushes) {
                 // this will also invalidate already invalid brushes, which
                 // is unnecessary
@@ -193,14 +215,17 @@ namespace TrenchBroom {
             m_brushInfo.clear();
             m_allBrushes.clear();
             m_invalidBrushes.clear();
+            invalidateBrushTree();
 
             m_vertexArray = std::make_shared<BrushVertexArray>();
             m_edgeIndices = std::make_shared<BrushIndexArray>();
             m_transparentFaces = std::make_shared<TextureToBrushIndicesMap>();
             m_opaqueFaces = std::make_shared<TextureToBrushIndicesMap>();
+            m_transparentArrayFaces = std::make_shared<TextureArrayToBrushIndicesMap>();
+            m_opaqueArrayFaces = std::make_shared<TextureArrayToBrushIndicesMap>();
 
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
+            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_opaqueArrayFaces, m_faceColor);
+            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_transparentArrayFaces, m_faceColor);
             m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
         }
 
@@ -254,19 +279,27 @@ namespace TrenchBroom {
         
         void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!m_allBrushes.empty()) {
-                if (!valid())
+                if (!valid()) {
+                    ProfileScope scope(renderContext.profiler(), "Validate brushes");
                     validate();
+                }
                 if (renderContext.showFaces())
                     renderOpaqueFaces(renderBatch);
-                if (renderContext.showEdges() || m_showEdges)
-                    renderEdges(renderBatch);
+                if (renderContext.showEdges() || m_showEdges) {
+                    if (renderContext.render2D())
+                        renderVisibleEdges(renderContext, renderBatch);
+                    else
+                        renderEdges(renderBatch);
+                }
             }
         }
         
         void BrushRenderer::renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!m_allBrushes.empty()) {
-                if (!valid())
+                if (!valid()) {
+                    ProfileScope scope(renderContext.profiler(), "Validate brushes");
                     validate();
+                }
                 if (renderContext.showFaces())
                     renderTransparentFaces(renderBatch);
             }
@@ -293,6 +326,28 @@ namespace TrenchBroom {
             m_edgeRenderer.render(renderBatch, m_edgeColor);
         }
 
+        void BrushRenderer::renderVisibleEdges(RenderContext& renderContext, RenderBatch& renderBatch) {
+            VisibleEdges visibleEdges;
+            {
+                ProfileScope scope(renderContext.profiler(), "Cull brush edges");
+                findVisibleEdges(renderContext.camera(), visibleEdges);
+            }
+
+            if (visibleEdges.all) {
+                renderEdges(renderBatch);
+                return;
+            }
+
+            IndexedEdgeRenderer edgeRenderer(m_vertexArray, m_edgeIndices, visibleEdges.offsets, visibleEdges.counts);
+            DirectEdgeRenderer pointRenderer(VertexArray::swap(visibleEdges.points), GL_POINTS);
+            if (m_showOccludedEdges) {
+                edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+                pointRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+            }
+            edgeRenderer.render(renderBatch, m_edgeColor);
+            pointRenderer.render(renderBatch, m_edgeColor);
+        }
+
         class BrushRenderer::FilterWrapper : public BrushRenderer::Filter {
         private:
             const Filter& m_filter;
@@ -320,17 +375,110 @@ namespace TrenchBroom {
         void BrushRenderer::validate() {
             assert(!valid());
 
+            if (m_invalidBrushes.size() > std::max(MinBrushTreeRebuildCount, m_brushInfo.size() / 4)) {
+                invalidateBrushTree();
+            }
+
             for (auto brush : m_invalidBrushes) {
                 validateBrush(brush);
             }
             m_invalidBrushes.clear();
             assert(valid());
 
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
+            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_opaqueArrayFaces, m_faceColor);
+            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_transparentArrayFaces, m_faceColor);
             m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
         }
 
+        void BrushRenderer::findVisibleEdges(const Camera& camera, VisibleEdges& result) {
+            assert(valid());
+            if (!m_brushTreeValid) {
+                buildBrushTree();
+            }
+
+            // the view volume of a 2D view is an axis aligned box, so its corners bound it exactly
+            const Camera::Viewport& viewport = camera.unzoomedViewport();
+            const float left = static_cast<float>(viewport.x);
+            const float top = static_cast<float>(viewport.y);
+            const float right = left + static_cast<float>(viewport.width);
+            const float bottom = top + static_cast<float>(viewport.height);
+
+            const Vec3 corner(camera.unproject(left, top, 0.0f));
+            BBox3 viewBounds(corner, corner);
+            for (const float depth : { 0.0f, 1.0f }) {
+                viewBounds.mergeWith(Vec3(camera.unproject(left, top, depth)));
+                viewBounds.mergeWith(Vec3(camera.unproject(right, top, depth)));
+                viewBounds.mergeWith(Vec3(camera.unproject(left, bottom, depth)));
+                viewBounds.mergeWith(Vec3(camera.unproject(right, bottom, depth)));
+            }
+
+            const FloatType pixelSize = static_cast<FloatType>((camera.unproject(left + 1.0f, top, 0.5f) - camera.unproject(left, top, 0.5f)).length());
+            const size_t viewAxis = camera.direction().firstComponent();
+
+            const auto subPixel = [&](const BBox3& bounds) {
+                const Vec3 size = bounds.size();
+                for (size_t i = 0; i < 3; ++i) {
+                    if (i != viewAxis && size[i] >= pixelSize)
+                        return false;
+                }
+                return true;
+            };
+            const auto collapse = [&](const BBox3& bounds) {
+                result.points.push_back(VertexSpecs::P3::Vertex(Vec3f(bounds.center())));
+            };
+
+            std::vector<const Model::Brush*> brushes;
+            m_brushTree.findIntersectors(viewBounds, std::back_inserter(brushes), subPixel, collapse);
+
+            // a single draw call for all edges is cheaper unless culling skips a good part of them
+            if (result.points.empty() && 2 * brushes.size() > m_brushInfo.size()) {
+                result.all = true;
+                return;
+            }
+
+            std::vector<const AllocationTracker::Block*> blocks;
+            blocks.reserve(brushes.size());
+            for (const Model::Brush* brush : brushes) {
+                const auto it = m_brushInfo.find(brush);
+                assert(it != m_brushInfo.end() && it->second.edgeIndicesKey != nullptr);
+                blocks.push_back(it->second.edgeIndicesKey);
+            }
+
+            // merge the ranges of brushes that are adjacent in the index array
+            std::sort(std::begin(blocks), std::end(blocks), [](const AllocationTracker::Block* lhs, const AllocationTracker::Block* rhs) {
+                return lhs->pos < rhs->pos;
+            });
+
+            for (const AllocationTracker::Block* block : blocks) {
+                const GLint offset = static_cast<GLint>(block->pos);
+                const GLsizei count = static_cast<GLsizei>(block->size);
+                if (!result.offsets.empty() && result.offsets.back() + result.counts.back() == offset) {
+                    result.counts.back() += count;
+                } else {
+                    result.offsets.push_back(offset);
+                    result.counts.push_back(count);
+                }
+            }
+        }
+
+        void BrushRenderer::invalidateBrushTree() {
+            m_brushTree.clear();
+            m_brushTreeValid = false;
+        }
+
+        void BrushRenderer::buildBrushTree() {
+            BrushTree::Array brushes;
+            brushes.reserve(m_brushInfo.size());
+            for (const auto& [brush, info] : m_brushInfo) {
+                if (info.edgeIndicesKey != nullptr) {
+                    brushes.push_back(brush);
+                }
+            }
+
+            m_brushTree.clearAndBuild(brushes, [this](const Model::Brush* brush) { return m_brushInfo.at(brush).bounds; });
+            m_brushTreeValid = true;
+        }
+
         static size_t triIndicesCountForPolygon(const size_t vertexCount) {
             assert(vertexCount >= 3);
             const size_t indexCount = 3 * (vertexCount - 2);
@@ -445,6 +593,11 @@ namespace TrenchBroom {
                 }
             }
 
+            info.bounds = brush->bounds();
+            if (m_brushTreeValid && info.edgeIndicesKey != nullptr) {
+                m_brushTree.insert(info.bounds, brush);
+            }
+
             // insert face indices
 
             auto& facesSortedByTex = brushCache.cachedFacesSortedByTexture();
@@ -452,22 +605,29 @@ namespace TrenchBroom {
 
             std::shared_ptr<TextureToBrushIndicesMap> faceVboPtr = \
                 (renderType == Filter::RenderOpacity::Opaque) ? m_opaqueFaces : m_transparentFaces;
+            std::shared_ptr<TextureArrayToBrushIndicesMap> arrayFaceVboPtr = \
+                (renderType == Filter::RenderOpacity::Opaque) ? m_opaqueArrayFaces : m_transparentArrayFaces;
 
             size_t nextI;
             for (size_t i = 0; i < facesSortedByTexSize; i = nextI) {
+                const Assets::TextureArray* textureArray = facesSortedByTex[i].textureArray;
                 const Assets::Texture* texture = facesSortedByTex[i].texture;
 
                 size_t indexCount = 0;
 
-                // find the i value for the next texture
-                for (nextI = i + 1; nextI < facesSortedByTexSize && facesSortedByTex[nextI].texture == texture; ++nextI) {
+                // find the i value for the next texture; faces whose textures share an array are drawn together
+                for (nextI = i + 1; nextI < facesSortedByTexSize; ++nextI) {
+                    const BrushRendererBrushCache::CachedFace& next = facesSortedByTex[nextI];
+                    if (next.textureArray != textureArray || (textureArray == nullptr && next.texture != texture)) {
+                        break;
+                    }
                 }
 
                 // process all faces with this texture (they'll be consecutive)
                 for (size_t j = i; j < nextI; ++j) {
                     const BrushRendererBrushCache::CachedFace& cache = facesSortedByTex[j];
                     if (cache.face->isMarked()) {
-                        assert(cache.texture == texture);
+                        assert(textureArray != nullptr || cache.texture == texture);
                         indexCount += triIndicesCountForPolygon(cache.vertexCount);
                     }
                 }
@@ -477,9 +637,16 @@ namespace TrenchBroom {
                     continue;
                 }
 
-                TextureToBrushIndicesMap& faceVboMap = *faceVboPtr;
-                std::shared_ptr<BrushIndexArray>& holderPtr = faceVboMap[texture];
+                std::shared_ptr<BrushIndexArray>* holderPtrPtr;
+                if (textureArray != nullptr) {
+                    TextureArrayToBrushIndicesMap& arrayFaceVboMap = *arrayFaceVboPtr;
+                    holderPtrPtr = &arrayFaceVboMap[textureArray];
+                } else {
+                    TextureToBrushIndicesMap& faceVboMap = *faceVboPtr;
+                    holderPtrPtr = &faceVboMap[texture];
+                }
 
+                std::shared_ptr<BrushIndexArray>& holderPtr = *holderPtrPtr;
                 if (holderPtr == nullptr) {
                     // inserts into map!
                     holderPtr = std::make_shared<BrushIndexArray>();
@@ -489,9 +656,17 @@ namespace TrenchBroom {
 
                 // update info
                 if (renderType == Filter::RenderOpacity::Opaque) {
-                    info.opaqueFaceIndicesKeys.push_back({texture, key});
+                    if (textureArray != nullptr) {
+                        info.opaqueFaceArrayIndicesKeys.push_back({textureArray, key});
+                    } else {
+                        info.opaqueFaceIndicesKeys.push_back({texture, key});
+                    }
                 } else {
-                    info.transparentFaceIndicesKeys.push_back({texture, key});
+                    if (textureArray != nullptr) {
+                        info.transparentFaceArrayIndicesKeys.push_back({textureArray, key});
+                    } else {
+                        info.transparentFaceIndicesKeys.push_back({texture, key});
+                    }
                 }
 
                 // process all faces with this texture (they'll be consecutive)
@@ -554,6 +729,9 @@ namespace TrenchBroom {
             }
 
             const BrushInfo& info = it->second;
+            if (m_brushTreeValid && info.edgeIndicesKey != nullptr) {
+                m_brushTree.remove(info.bounds, brush);
+            }
 
             // update Vbo's
             m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
@@ -569,6 +747,14 @@ namespace TrenchBroom {
                 std::shared_ptr<BrushIndexArray> faceIndexHolder = m_transparentFaces->at(texture);
                 faceIndexHolder->zeroElementsWithKey(transparentKey);
             }
+            for (const auto& [textureArray, opaqueKey] : info.opaqueFaceArrayIndicesKeys) {
+                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_opaqueArrayFaces->at(textureArray);
+                faceIndexHolder->zeroElementsWithKey(opaqueKey);
+            }
+            for (const auto& [textureArray, transparentKey] : info.transparentFaceArrayIndicesKeys) {
+                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_transparentArrayFaces->at(textureArray);
+                faceIndexHolder->zeroElementsWithKey(transparentKey);
+            }
 
             m_brushInfo.erase(it);
         }
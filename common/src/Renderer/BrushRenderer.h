@@ -20,12 +20,16 @@
 #ifndef TrenchBroom_BrushRenderer
 #define TrenchBroom_BrushRenderer
 
+#include "AABBTree.h"
 #include "Color.h"
+#include "TrenchBroom.h"
 #include "Model/ModelTypes.h"
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/FaceRenderer.h"
 #include "Model/Brush.h"
 #include "Renderer/AllocationTracker.h"
+#include "Renderer/GL.h"
+#include "Renderer/VertexSpec.h"
 
 #include <tuple>
 #include <map>
@@ -37,6 +41,7 @@ namespace TrenchBroom {
     }
     
     namespace Renderer {
+        class Camera;
         class RenderBatch;
         class RenderContext;
         class Vbo;
@@ -123,16 +128,41 @@ namespace TrenchBroom {
                 NoFilter(const NoFilter& other);
                 NoFilter& operator=(const NoFilter& other);
             };
+
+            /**
+             * The edges that a 2D view has to render, see findVisibleEdges.
+             */
+            struct VisibleEdges {
+                /**
+                 * Whether all edges should be rendered because culling would not skip enough of them to pay off.
+                 */
+                bool all;
+                /**
+                 * The ranges of edge indices of the brushes that are visible and larger than a pixel.
+                 */
+                GLIndices offsets;
+                GLCounts counts;
+                /**
+                 * One point for every group of visible brushes that together cover less than a pixel.
+                 */
+                VertexSpecs::P3::Vertex::List points;
+
+                VisibleEdges();
+            };
         private:
             class FilterWrapper;
+            typedef AABBTree<FloatType, 3, const Model::Brush*> BrushTree;
         private:
             Filter* m_filter;
 
             struct BrushInfo {
+                BBox3 bounds;
                 AllocationTracker::Block* vertexHolderKey;
                 AllocationTracker::Block* edgeIndicesKey;
                 std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>> opaqueFaceIndicesKeys;
                 std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>> transparentFaceIndicesKeys;
+                std::vector<std::pair<const Assets::TextureArray*, AllocationTracker::Block*>> opaqueFaceArrayIndicesKeys;
+                std::vector<std::pair<const Assets::TextureArray*, AllocationTracker::Block*>> transparentFaceArrayIndicesKeys;
             };
             /**
              * Tracks all brushes that are stored in the VBO, with the information necessary to remove them
@@ -147,10 +177,20 @@ namespace TrenchBroom {
             std::set<const Model::Brush*> m_allBrushes;
             std::set<const Model::Brush*> m_invalidBrushes;
 
+            /**
+             * Contains the brushes with edge indices in the VBO for culling in 2D views. The tree is built when it is
+             * first needed and then kept up to date as brushes are added to and removed from the VBO, unless so many
+             * brushes change at once that building it again is cheaper.
+             */
+            BrushTree m_brushTree;
+            bool m_brushTreeValid;
+
             BrushVertexArrayPtr m_vertexArray;
             BrushIndexArrayPtr m_edgeIndices;
             std::shared_ptr<TextureToBrushIndicesMap> m_transparentFaces;
             std::shared_ptr<TextureToBrushIndicesMap> m_opaqueFaces;
+            std::shared_ptr<TextureArrayToBrushIndicesMap> m_transparentArrayFaces;
+            std::shared_ptr<TextureArrayToBrushIndicesMap> m_opaqueArrayFaces;
 
             FaceRenderer m_opaqueFaceRenderer;
             FaceRenderer m_transparentFaceRenderer;
@@ -171,6 +211,7 @@ namespace TrenchBroom {
             template <typename FilterT>
             BrushRenderer(const FilterT& filter) :
             m_filter(new FilterT(filter)),
+            m_brushTreeValid(false),
             m_showEdges(false),
             m_grayscale(false),
             m_tint(false),
@@ -188,6 +229,10 @@ namespace TrenchBroom {
              * New brushes are invalidated, brushes already in the BrushRenderer are not invalidated.
              */
             void addBrushes(const Model::BrushList& brushes);
+            /**
+             * Brushes that are not in the BrushRenderer are ignored.
+             */
+            void removeBrushes(const Model::BrushList& brushes);
             /**
              * New brushes are invalidated, brushes already in the BrushRenderer are not invalidated.
              */
@@ -223,13 +268,26 @@ namespace TrenchBroom {
             void renderOpaqueFaces(RenderBatch& renderBatch);
             void renderTransparentFaces(RenderBatch& renderBatch);
             void renderEdges(RenderBatch& renderBatch);
+            void renderVisibleEdges(RenderContext& renderContext, RenderBatch& renderBatch);
 
         public:
             /**
              * Only exposed for benchmarking.
              */
             void validate();
+
+            /**
+             * Finds the edges that must be rendered in a 2D view with the given orthographic camera. Brushes outside
+             * of the camera's view volume are culled, and groups of brushes that cover less than a pixel are
+             * collapsed into a single point each.
+             *
+             * Only exposed for benchmarking.
+             */
+            void findVisibleEdges(const Camera& camera, VisibleEdges& result);
         private:
+            void invalidateBrushTree();
+            void buildBrushTree();
+
             void validateBrush(const Model::Brush* brush);
             void addBrush(const Model::Brush* brush);
             void removeBrush(const Model::Brush* brush);
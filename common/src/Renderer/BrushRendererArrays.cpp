@@ -86,6 +86,22 @@ namespace TrenchBroom {
             glAssert(glDrawElements(primType, renderCount, glType<Index>(), renderOffset));
         }
 
+        void IndexHolder::render(const PrimType primType, const GLIndices& offsets, const GLCounts& counts) const {
+            assert(offsets.size() == counts.size());
+            if (offsets.empty()) {
+                return;
+            }
+
+            std::vector<const GLvoid*> renderOffsets;
+            renderOffsets.reserve(offsets.size());
+            for (const GLint offset : offsets) {
+                renderOffsets.push_back(reinterpret_cast<GLvoid *>(m_block->offset() + sizeof(Index) * static_cast<size_t>(offset)));
+            }
+
+            const GLsizei primCount = static_cast<GLsizei>(offsets.size());
+            glAssert(glMultiDrawElements(primType, counts.data(), glType<Index>(), renderOffsets.data(), primCount));
+        }
+
         std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index> &elements) {
             return std::make_shared<IndexHolder>(elements);
         }
@@ -133,6 +149,11 @@ namespace TrenchBroom {
             m_indexHolder.render(primType, 0, m_indexHolder.size());
         }
 
+        void BrushIndexArray::render(const PrimType primType, const GLIndices& offsets, const GLCounts& counts) const {
+            assert(m_indexHolder.prepared());
+            m_indexHolder.render(primType, offsets, counts);
+        }
+
         bool BrushIndexArray::prepared() const {
             return m_indexHolder.prepared();
         }
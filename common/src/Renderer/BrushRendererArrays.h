@@ -206,6 +206,11 @@ namespace TrenchBroom {
             explicit IndexHolder(std::vector<Index>& elements);
             void zeroRange(size_t offsetWithinBlock, size_t count);
             void render(PrimType primType, size_t offset, size_t count) const;
+            /**
+             * Renders the given ranges of indices with a single draw call. Each range is given by the offset of its
+             * first index and its number of indices.
+             */
+            void render(PrimType primType, const GLIndices& offsets, const GLCounts& counts) const;
 
             static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements);
         };
@@ -239,6 +244,10 @@ namespace TrenchBroom {
             void zeroElementsWithKey(AllocationTracker::Block* key);
 
             void render(const PrimType primType) const;
+            /**
+             * Renders only the given ranges of indices, see IndexHolder::render.
+             */
+            void render(const PrimType primType, const GLIndices& offsets, const GLCounts& counts) const;
             bool prepared() const;
             void prepare(Vbo& vbo);
         };
@@ -289,7 +298,7 @@ namespace TrenchBroom {
          */
         class BrushVertexArray {
         private:
-            using Vertex = Renderer::VertexSpecs::P3NT2::Vertex;
+            using Vertex = Renderer::VertexSpecs::P3NT3::Vertex;
 
             VertexHolder<Vertex> m_vertexHolder;
             AllocationTracker m_allocationTracker;
@@ -19,6 +19,7 @@
 
 #include "BrushRendererBrushCache.h"
 
+#include "Assets/Texture.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
@@ -27,7 +28,8 @@ namespace TrenchBroom {
     namespace Renderer {
         BrushRendererBrushCache::CachedFace::CachedFace(Model::BrushFace* i_face,
                                                         const size_t i_indexOfFirstVertexRelativeToBrush)
-                : texture(i_face->texture()),
+                : textureArray(i_face->texture() != nullptr ? i_face->texture()->array() : nullptr),
+                  texture(i_face->texture()),
                   face(i_face),
                   vertexCount(i_face->vertexCount()),
                   indexOfFirstVertexRelativeToBrush(i_indexOfFirstVertexRelativeToBrush) {}
@@ -67,6 +69,11 @@ namespace TrenchBroom {
             for (Model::BrushFace* face : brush->faces()) {
                 const size_t indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
 
+                const Assets::Texture* texture = face->texture();
+                const float layer = (texture != nullptr && texture->array() != nullptr) ? static_cast<float>(texture->arrayLayer()) : 0.0f;
+                const Model::TexCoordProjection texCoordProjection = face->textureCoordProjection();
+                const Vec3& normal = face->boundary().normal;
+
                 const Model::BrushHalfEdge* first = face->geometry()->boundary().front();
                 const Model::BrushHalfEdge* current = first;
                 do {
@@ -80,7 +87,8 @@ namespace TrenchBroom {
                     vertex->setPayload(static_cast<GLuint>(currentIndex));
 
                     const Vec3& position = vertex->position();
-                    m_cachedVertices.emplace_back(position, face->boundary().normal, face->textureCoords(position));
+                    const Vec2f texCoords = texCoordProjection.project(position);
+                    m_cachedVertices.emplace_back(position, normal, Vec3f(texCoords.x(), texCoords.y(), layer));
 
                     // The boundary is in CCW order, but the renderer expects CW order:
                     current = current->previous();
@@ -91,11 +99,17 @@ namespace TrenchBroom {
             }
 
             // Sort by texture so BrushRenderer can efficiently step through the BrushFaces
-            // grouped by texture (via `BrushRendererBrushCache::cachedFacesSortedByTexture()`), without needing to build an std::map
+            // grouped by texture (via `BrushRendererBrushCache::cachedFacesSortedByTexture()`), without needing to build an std::map.
+            // Faces whose textures share a texture array are sorted next to each other so that they can be batched.
 
             std::sort(m_cachedFacesSortedByTexture.begin(),
                       m_cachedFacesSortedByTexture.end(),
-                      [](const CachedFace& a, const CachedFace& b){ return a.texture < b.texture; });
+                      [](const CachedFace& a, const CachedFace& b){
+                          if (a.textureArray != b.textureArray) {
+                              return a.textureArray < b.textureArray;
+                          }
+                          return a.texture < b.texture;
+                      });
 
             // Build edge index cache
 
@@ -27,6 +27,7 @@
 namespace TrenchBroom {
     namespace Assets {
         class Texture;
+        class TextureArray;
     }
 
     namespace Model {
@@ -37,10 +38,11 @@ namespace TrenchBroom {
     namespace Renderer {
         class BrushRendererBrushCache {
         public:
-            using VertexSpec = Renderer::VertexSpecs::P3NT2;
+            using VertexSpec = Renderer::VertexSpecs::P3NT3;
             using Vertex = VertexSpec::Vertex;
 
             struct CachedFace {
+                const Assets::TextureArray* textureArray;
                 const Assets::Texture* texture;
                 Model::BrushFace* face;
                 size_t vertexCount;
@@ -86,9 +88,14 @@ namespace TrenchBroom {
             void validateVertexCache(const Model::Brush* brush);
 
             /**
-             * Returns all vertices for all faces of the brush.
+             * Returns all vertices for all faces of the brush. The third texture coordinate of each vertex holds the
+             * layer of the face's texture in its texture array, or 0 if the texture is not part of an array.
              */
             const std::vector<Vertex>& cachedVertices() const;
+            /**
+             * Returns the faces of the brush sorted by texture array first and by texture second, so that faces
+             * whose textures share an array are consecutive.
+             */
             const std::vector<CachedFace>& cachedFacesSortedByTexture() const;
             const std::vector<CachedEdge>& cachedEdges() const;
         };
@@ -155,6 +155,24 @@ namespace TrenchBroom {
             doComputeFrustumPlanes(top, right, bottom, left);
         }
 
+        bool Camera::intersectsFrustum(const BBox3f& bounds) const {
+            Plane3f planes[4];
+            frustumPlanes(planes[0], planes[1], planes[2], planes[3]);
+
+            for (size_t i = 0; i < 4; ++i) {
+                const Plane3f& plane = planes[i];
+
+                // the bounds are outside if the vertex that lies furthest in the opposite direction of the outward
+                // facing normal is above the plane
+                Vec3f vertex;
+                for (size_t j = 0; j < 3; ++j)
+                    vertex[j] = plane.normal[j] > 0.0f ? bounds.min[j] : bounds.max[j];
+                if (plane.normal.dot(vertex) > plane.distance)
+                    return false;
+            }
+            return true;
+        }
+
         Ray3f Camera::viewRay() const {
             return Ray3f(m_position, m_direction);
         }
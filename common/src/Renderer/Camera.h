@@ -105,6 +105,11 @@ namespace TrenchBroom {
             const Mat4x4f orthogonalBillboardMatrix() const;
             const Mat4x4f verticalBillboardMatrix() const;
             void frustumPlanes(Plane3f& topPlane, Plane3f& rightPlane, Plane3f& bottomPlane, Plane3f& leftPlane) const;
+            /**
+             * Checks whether the given bounds may be visible, that is, whether they are not entirely outside of one of
+             * the side planes of the frustum. The near and far planes are not considered.
+             */
+            bool intersectsFrustum(const BBox3f& bounds) const;
             
             Ray3f viewRay() const;
             Ray3f pickRay(int x, int y) const;
@@ -163,10 +163,13 @@ namespace TrenchBroom {
 
         // IndexedEdgeRenderer::Render
 
-        IndexedEdgeRenderer::Render::Render(const EdgeRenderer::Params& params, BrushVertexArrayPtr vertexArray, BrushIndexArrayPtr indexArray) :
+        IndexedEdgeRenderer::Render::Render(const EdgeRenderer::Params& params, BrushVertexArrayPtr vertexArray, BrushIndexArrayPtr indexArray, const bool renderRanges, const GLIndices& offsets, const GLCounts& counts) :
         RenderBase(params),
         m_vertexArray(vertexArray),
-        m_indexArray(indexArray) {}
+        m_indexArray(indexArray),
+        m_renderRanges(renderRanges),
+        m_offsets(offsets),
+        m_counts(counts) {}
 
         void IndexedEdgeRenderer::Render::prepareVerticesAndIndices(Vbo& vertexVbo, Vbo& indexVbo) {
             m_vertexArray->prepare(vertexVbo);
@@ -182,21 +185,37 @@ namespace TrenchBroom {
         
         void IndexedEdgeRenderer::Render::doRenderVertices(RenderContext& renderContext) {
             m_vertexArray->setupVertices();
-            m_indexArray->render(GL_LINES);
+            if (m_renderRanges) {
+                m_indexArray->render(GL_LINES, m_offsets, m_counts);
+            } else {
+                m_indexArray->render(GL_LINES);
+            }
             m_vertexArray->cleanupVertices();
         }
 
         // IndexedEdgeRenderer
 
-        IndexedEdgeRenderer::IndexedEdgeRenderer() {}
+        IndexedEdgeRenderer::IndexedEdgeRenderer() :
+        m_renderRanges(false) {}
         
         IndexedEdgeRenderer::IndexedEdgeRenderer(BrushVertexArrayPtr vertexArray, BrushIndexArrayPtr indexArray) :
         m_vertexArray(vertexArray),
-        m_indexArray(indexArray) {}
+        m_indexArray(indexArray),
+        m_renderRanges(false) {}
+        
+        IndexedEdgeRenderer::IndexedEdgeRenderer(BrushVertexArrayPtr vertexArray, BrushIndexArrayPtr indexArray, const GLIndices& offsets, const GLCounts& counts) :
+        m_vertexArray(vertexArray),
+        m_indexArray(indexArray),
+        m_renderRanges(true),
+        m_offsets(offsets),
+        m_counts(counts) {}
         
         IndexedEdgeRenderer::IndexedEdgeRenderer(const IndexedEdgeRenderer& other) :
         m_vertexArray(other.m_vertexArray),
-        m_indexArray(other.m_indexArray) {}
+        m_indexArray(other.m_indexArray),
+        m_renderRanges(other.m_renderRanges),
+        m_offsets(other.m_offsets),
+        m_counts(other.m_counts) {}
         
         IndexedEdgeRenderer& IndexedEdgeRenderer::operator=(IndexedEdgeRenderer other) {
             using std::swap;
@@ -208,10 +227,13 @@ namespace TrenchBroom {
             using std::swap;
             swap(left.m_vertexArray, right.m_vertexArray);
             swap(left.m_indexArray, right.m_indexArray);
+            swap(left.m_renderRanges, right.m_renderRanges);
+            swap(left.m_offsets, right.m_offsets);
+            swap(left.m_counts, right.m_counts);
         }
         
         void IndexedEdgeRenderer::doRender(RenderBatch& renderBatch, const EdgeRenderer::Params& params) {
-            renderBatch.addOneShot(new Render(params, m_vertexArray, m_indexArray));
+            renderBatch.addOneShot(new Render(params, m_vertexArray, m_indexArray, m_renderRanges, m_offsets, m_counts));
         }
     }
 }
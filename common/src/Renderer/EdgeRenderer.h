@@ -114,8 +114,11 @@ namespace TrenchBroom {
             private:
                 BrushVertexArrayPtr m_vertexArray;
                 BrushIndexArrayPtr m_indexArray;
+                bool m_renderRanges;
+                GLIndices m_offsets;
+                GLCounts m_counts;
             public:
-                Render(const Params& params, BrushVertexArrayPtr vertexArray, BrushIndexArrayPtr indexArray);
+                Render(const Params& params, BrushVertexArrayPtr vertexArray, BrushIndexArrayPtr indexArray, bool renderRanges, const GLIndices& offsets, const GLCounts& counts);
             private:
                 void prepareVerticesAndIndices(Vbo& vertexVbo, Vbo& indexVbo) override;
                 void doRender(RenderContext& renderContext) override;
@@ -124,9 +127,17 @@ namespace TrenchBroom {
         private:
             BrushVertexArrayPtr m_vertexArray;
             BrushIndexArrayPtr m_indexArray;
+            bool m_renderRanges;
+            GLIndices m_offsets;
+            GLCounts m_counts;
         public:
             IndexedEdgeRenderer();
             IndexedEdgeRenderer(BrushVertexArrayPtr vertexArray, BrushIndexArrayPtr indexArray);
+            /**
+             * Creates a renderer that renders only the given ranges of the given index array. Each range is given by
+             * the offset of its first index and its number of indices.
+             */
+            IndexedEdgeRenderer(BrushVertexArrayPtr vertexArray, BrushIndexArrayPtr indexArray, const GLIndices& offsets, const GLCounts& counts);
 
             IndexedEdgeRenderer(const IndexedEdgeRenderer& other);
             IndexedEdgeRenderer& operator=(IndexedEdgeRenderer other);
@@ -19,6 +19,7 @@
 
 #include "EntityLinkRenderer.h"
 
+#include "CollectionUtils.h"
 #include "Macros.h"
 #include "Model/AttributableNode.h"
 #include "Model/CollectMatchingNodesVisitor.h"
@@ -33,15 +34,65 @@
 #include "Renderer/Shaders.h"
 #include "View/MapDocument.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace TrenchBroom {
     namespace Renderer {
+        template <typename V>
+        EntityLinkRenderer::LinkVertexArray<V>::LinkVertexArray() :
+        m_vertexHolder(),
+        m_allocationTracker(0) {}
+
+        template <typename V>
+        AllocationTracker::Block* EntityLinkRenderer::LinkVertexArray<V>::insertVertices(const std::vector<V>& vertices) {
+            assert(!vertices.empty());
+
+            AllocationTracker::Block* block = m_allocationTracker.allocate(vertices.size());
+            if (block == nullptr) {
+                const size_t newSize = std::max(2 * m_allocationTracker.capacity(),
+                                                m_allocationTracker.capacity() + vertices.size());
+                m_allocationTracker.expand(newSize);
+                m_vertexHolder.resize(newSize);
+
+                block = m_allocationTracker.allocate(vertices.size());
+                assert(block != nullptr);
+            }
+
+            V* dest = m_vertexHolder.getPointerToWriteElementsTo(block->pos, vertices.size());
+            std::copy(std::begin(vertices), std::end(vertices), dest);
+            return block;
+        }
+
+        template <typename V>
+        void EntityLinkRenderer::LinkVertexArray<V>::deleteVertices(AllocationTracker::Block* block) {
+            // the vertices remain in the VBO, but they are not rendered because only allocated ranges are drawn
+            m_allocationTracker.free(block);
+        }
+
+        template <typename V>
+        void EntityLinkRenderer::LinkVertexArray<V>::prepare(Vbo& vbo) {
+            m_vertexHolder.prepare(vbo);
+        }
+
+        template <typename V>
+        void EntityLinkRenderer::LinkVertexArray<V>::render(const PrimType primType, const GLIndices& indices, const GLCounts& counts) {
+            assert(indices.size() == counts.size());
+            if (indices.empty())
+                return;
+
+            assert(m_vertexHolder.prepared());
+            m_vertexHolder.setupVertices();
+            glAssert(glMultiDrawArrays(primType, indices.data(), counts.data(), static_cast<GLsizei>(indices.size())));
+            m_vertexHolder.cleanupVertices();
+        }
+
         EntityLinkRenderer::EntityLinkRenderer(View::MapDocumentWPtr document) :
         m_document(document),
         m_defaultColor(0.5f, 1.0f, 0.5f, 1.0f),
         m_selectedColor(1.0f, 0.0f, 0.0f, 1.0f),
-        m_valid(false) {}
+        m_valid(false),
+        m_linkCacheValid(false) {}
         
         void EntityLinkRenderer::setDefaultColor(const Color& color) {
             if (color == m_defaultColor)
@@ -63,6 +114,7 @@ namespace TrenchBroom {
 
         void EntityLinkRenderer::invalidate() {
             m_valid = false;
+            clearLinkCache();
         }
 
         void EntityLinkRenderer::doPrepareVertices(Vbo& vertexVbo) {
@@ -72,6 +124,10 @@ namespace TrenchBroom {
                 // Upload the VBO's
                 m_entityLinks.prepare(vertexVbo);
                 m_entityLinkArrows.prepare(vertexVbo);
+
+                // only uploads the ranges that were rewritten since the last upload
+                m_cachedLinks.prepare(vertexVbo);
+                m_cachedLinkArrows.prepare(vertexVbo);
             }
         }
 
@@ -89,10 +145,12 @@ namespace TrenchBroom {
             glAssert(glDisable(GL_DEPTH_TEST));
             shader.set("Alpha", 0.4f);
             m_entityLinks.render(GL_LINES);
+            m_cachedLinks.render(GL_LINES, m_cachedLinkIndices, m_cachedLinkCounts);
 
             glAssert(glEnable(GL_DEPTH_TEST));
             shader.set("Alpha", 1.0f);
             m_entityLinks.render(GL_LINES);
+            m_cachedLinks.render(GL_LINES, m_cachedLinkIndices, m_cachedLinkCounts);
         }
 
         void EntityLinkRenderer::renderArrows(RenderContext& renderContext) {
@@ -103,10 +161,12 @@ namespace TrenchBroom {
             glAssert(glDisable(GL_DEPTH_TEST));
             shader.set("Alpha", 0.4f);
             m_entityLinkArrows.render(GL_LINES);
+            m_cachedLinkArrows.render(GL_LINES, m_cachedArrowIndices, m_cachedArrowCounts);
 
             glAssert(glEnable(GL_DEPTH_TEST));
             shader.set("Alpha", 1.0f);
             m_entityLinkArrows.render(GL_LINES);
+            m_cachedLinkArrows.render(GL_LINES, m_cachedArrowIndices, m_cachedArrowCounts);
         }
 
         void EntityLinkRenderer::validate() {
@@ -119,6 +179,7 @@ namespace TrenchBroom {
 
             m_entityLinks = VertexArray::swap(links);
             m_entityLinkArrows = VertexArray::swap(arrows);
+            updateCachedLinkRanges();
 
             m_valid = true;
         }
@@ -198,32 +259,26 @@ namespace TrenchBroom {
             virtual void visitEntity(Model::Entity* entity) = 0;
         protected:
             void addLink(const Model::AttributableNode* source, const Model::AttributableNode* target) {
-                const bool anySelected = source->selected() || source->descendantSelected() || target->selected() || target->descendantSelected();
-                const Color& sourceColor = anySelected ? m_selectedColor : m_defaultColor;
-                Color targetColor = anySelected ? m_selectedColor : m_defaultColor;
-                
-                m_links.push_back(Vertex(source->linkSourceAnchor(), sourceColor));
-                m_links.push_back(Vertex(target->linkTargetAnchor(), targetColor));
+                EntityLinkRenderer::addLink(m_links, source, target, m_defaultColor, m_selectedColor);
             }
         };
         
-        class EntityLinkRenderer::CollectAllLinksVisitor : public CollectLinksVisitor {
+        class EntityLinkRenderer::CollectAllLinksVisitor : public Model::NodeVisitor {
+        private:
+            EntityLinkRenderer& m_renderer;
+            const Model::EditorContext& m_editorContext;
         public:
-            CollectAllLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, Vertex::List& links) :
-            CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
+            CollectAllLinksVisitor(EntityLinkRenderer& renderer, const Model::EditorContext& editorContext) :
+            m_renderer(renderer),
+            m_editorContext(editorContext) {}
         private:
-            void visitEntity(Model::Entity* entity) override {
-                if (m_editorContext.visible(entity)) {
-                    addTargets(entity, entity->linkTargets());
-                    addTargets(entity, entity->killTargets());
-                }
-            }
-            
-            void addTargets(Model::Entity* source, const Model::AttributableNodeList& targets) {
-                for (const Model::AttributableNode* target : targets) {
-                    if (m_editorContext.visible(target))
-                        addLink(source, target);
-                }
+            void doVisit(Model::World* world) override   {}
+            void doVisit(Model::Layer* layer) override   {}
+            void doVisit(Model::Group* group) override   {}
+            void doVisit(Model::Brush* brush) override   {}
+            void doVisit(Model::Entity* entity) override {
+                m_renderer.updateLinksFromSource(m_editorContext, entity);
+                stopRecursion();
             }
         };
         
@@ -294,34 +349,155 @@ namespace TrenchBroom {
             }
         };
         
-        void EntityLinkRenderer::getLinks(Vertex::List& links) const {
+        void EntityLinkRenderer::addLink(Vertex::List& links, const Model::AttributableNode* source, const Model::AttributableNode* target, const Color& defaultColor, const Color& selectedColor) {
+            const bool anySelected = source->selected() || source->descendantSelected() || target->selected() || target->descendantSelected();
+            const Color& color = anySelected ? selectedColor : defaultColor;
+
+            links.push_back(Vertex(source->linkSourceAnchor(), color));
+            links.push_back(Vertex(target->linkTargetAnchor(), color));
+        }
+
+        void EntityLinkRenderer::invalidateNodes(const Model::NodeList& nodes) {
+            m_valid = false;
+            if (!m_linkCacheValid)
+                return;
+
+            // a node affects the links of the entities that contain it or that it contains
+            CollectEntitiesVisitor collectEntities;
+            Model::Node::acceptAndEscalate(std::begin(nodes), std::end(nodes), collectEntities);
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collectEntities);
+
+            // the links of an entity are rebuilt from their sources, which include the sources of links that no longer
+            // exist, e.g. because the targetname of the entity was changed
+            Model::AttributableNodeList sources;
+            for (Model::Node* node : collectEntities.nodes()) {
+                Model::AttributableNode* entity = static_cast<Model::Entity*>(node);
+                sources.push_back(entity);
+                VectorUtils::append(sources, entity->linkSources());
+                VectorUtils::append(sources, entity->killSources());
+
+                const auto it = m_sourcesByTarget.find(entity);
+                if (it != std::end(m_sourcesByTarget)) {
+                    for (const Model::AttributableNode* source : it->second)
+                        sources.push_back(const_cast<Model::AttributableNode*>(source));
+                }
+            }
+
+            // only entities are link sources
+            CollectEntitiesVisitor collectSources;
+            Model::Node::accept(std::begin(sources), std::end(sources), collectSources);
+
+            View::MapDocumentSPtr document = lock(m_document);
+            const Model::EditorContext& editorContext = document->editorContext();
+            for (const Model::Node* source : collectSources.nodes())
+                updateLinksFromSource(editorContext, static_cast<const Model::Entity*>(source));
+        }
+
+        void EntityLinkRenderer::getLinks(Vertex::List& links) {
             View::MapDocumentSPtr document = lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
             switch (editorContext.entityLinkMode()) {
                 case Model::EditorContext::EntityLinkMode_All:
-                    getAllLinks(links);
+                    // rendered from the link cache
+                    validateLinkCache();
                     break;
                 case Model::EditorContext::EntityLinkMode_Transitive:
+                    clearLinkCache();
                     getTransitiveSelectedLinks(links);
                     break;
                 case Model::EditorContext::EntityLinkMode_Direct:
+                    clearLinkCache();
                     getDirectSelectedLinks(links);
                     break;
                 case Model::EditorContext::EntityLinkMode_None:
+                    clearLinkCache();
                     break;
                 switchDefault()
             }
         }
         
-        void EntityLinkRenderer::getAllLinks(Vertex::List& links) const {
+        void EntityLinkRenderer::validateLinkCache() {
+            if (m_linkCacheValid)
+                return;
+
             View::MapDocumentSPtr document = lock(m_document);
-            const Model::EditorContext& editorContext = document->editorContext();
-            
-            CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, links);
-            
             Model::World* world = document->world();
-            if (world != nullptr)
+            if (world != nullptr) {
+                CollectAllLinksVisitor collectLinks(*this, document->editorContext());
                 world->acceptAndRecurse(collectLinks);
+            }
+            m_linkCacheValid = true;
+        }
+
+        void EntityLinkRenderer::updateCachedLinkRanges() {
+            m_cachedLinkIndices.clear();
+            m_cachedLinkCounts.clear();
+            m_cachedArrowIndices.clear();
+            m_cachedArrowCounts.clear();
+
+            for (const auto& entry : m_linksBySource) {
+                const SourceLinks& links = entry.second;
+                m_cachedLinkIndices.push_back(static_cast<GLint>(links.links->pos));
+                m_cachedLinkCounts.push_back(static_cast<GLsizei>(links.links->size));
+                m_cachedArrowIndices.push_back(static_cast<GLint>(links.arrows->pos));
+                m_cachedArrowCounts.push_back(static_cast<GLsizei>(links.arrows->size));
+            }
+        }
+
+        void EntityLinkRenderer::clearLinkCache() {
+            for (const auto& entry : m_linksBySource) {
+                m_cachedLinks.deleteVertices(entry.second.links);
+                m_cachedLinkArrows.deleteVertices(entry.second.arrows);
+            }
+            m_linksBySource.clear();
+            m_sourcesByTarget.clear();
+            m_linkCacheValid = false;
+        }
+
+        void EntityLinkRenderer::updateLinksFromSource(const Model::EditorContext& editorContext, const Model::AttributableNode* source) {
+            removeLinksFromSource(source);
+            if (!editorContext.visible(source))
+                return;
+
+            SourceLinks links;
+            Vertex::List vertices;
+            for (const Model::AttributableNodeList* targets : { &source->linkTargets(), &source->killTargets() }) {
+                for (Model::AttributableNode* target : *targets) {
+                    if (editorContext.visible(target)) {
+                        addLink(vertices, source, target, m_defaultColor, m_selectedColor);
+                        links.targets.push_back(target);
+                        m_sourcesByTarget[target].insert(source);
+                    }
+                }
+            }
+
+            if (!links.targets.empty()) {
+                ArrowVertex::List arrows;
+                getArrows(arrows, vertices);
+
+                links.links = m_cachedLinks.insertVertices(vertices);
+                links.arrows = m_cachedLinkArrows.insertVertices(arrows);
+                m_linksBySource.insert(std::make_pair(source, std::move(links)));
+            }
+        }
+
+        void EntityLinkRenderer::removeLinksFromSource(const Model::AttributableNode* source) {
+            const auto it = m_linksBySource.find(source);
+            if (it == std::end(m_linksBySource))
+                return;
+
+            for (const Model::AttributableNode* target : it->second.targets) {
+                const auto sourcesIt = m_sourcesByTarget.find(target);
+                if (sourcesIt != std::end(m_sourcesByTarget)) {
+                    sourcesIt->second.erase(source);
+                    if (sourcesIt->second.empty())
+                        m_sourcesByTarget.erase(sourcesIt);
+                }
+            }
+
+            m_cachedLinks.deleteVertices(it->second.links);
+            m_cachedLinkArrows.deleteVertices(it->second.arrows);
+            m_linksBySource.erase(it);
         }
         
         void EntityLinkRenderer::getTransitiveSelectedLinks(Vertex::List& links) const {
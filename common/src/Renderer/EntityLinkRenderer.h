@@ -22,11 +22,16 @@
 
 #include "Color.h"
 #include "Model/ModelTypes.h"
+#include "Renderer/AllocationTracker.h"
+#include "Renderer/BrushRendererArrays.h"
 #include "Renderer/Renderable.h"
 #include "Renderer/Vertex.h"
 #include "Renderer/VertexArray.h"
 #include "View/ViewTypes.h"
 
+#include <unordered_map>
+#include <unordered_set>
+
 namespace TrenchBroom {
     namespace Model {
         class EditorContext;
@@ -49,6 +54,25 @@ namespace TrenchBroom {
                     T03,                 // arrow position (exposed in shader as gl_MultiTexCoord0)
                     T13>::Vertex;        // direction the arrow is pointing (exposed in shader as gl_MultiTexCoord1)
 
+            /**
+             * A vertex buffer in which ranges can be allocated and freed individually. Only the modified ranges are
+             * uploaded when the buffer is prepared, and the allocated ranges are rendered with a single draw call.
+             */
+            template <typename V>
+            class LinkVertexArray {
+            private:
+                VertexHolder<V> m_vertexHolder;
+                AllocationTracker m_allocationTracker;
+            public:
+                LinkVertexArray();
+
+                AllocationTracker::Block* insertVertices(const std::vector<V>& vertices);
+                void deleteVertices(AllocationTracker::Block* block);
+
+                void prepare(Vbo& vbo);
+                void render(PrimType primType, const GLIndices& indices, const GLCounts& counts);
+            };
+
             View::MapDocumentWPtr m_document;
             
             Color m_defaultColor;
@@ -57,7 +81,32 @@ namespace TrenchBroom {
             VertexArray m_entityLinks;
             VertexArray m_entityLinkArrows;
 
+            LinkVertexArray<Vertex> m_cachedLinks;
+            LinkVertexArray<ArrowVertex> m_cachedLinkArrows;
+            GLIndices m_cachedLinkIndices;
+            GLCounts m_cachedLinkCounts;
+            GLIndices m_cachedArrowIndices;
+            GLCounts m_cachedArrowCounts;
+
             bool m_valid;
+
+            struct SourceLinks {
+                Model::AttributableNodeList targets;
+                AllocationTracker::Block* links;
+                AllocationTracker::Block* arrows;
+            };
+            typedef std::unordered_map<const Model::AttributableNode*, SourceLinks> SourceLinksMap;
+            typedef std::unordered_map<const Model::AttributableNode*, std::unordered_set<const Model::AttributableNode*>> TargetSourcesMap;
+
+            /**
+             * When all links are shown, the vertices of the links of every source entity are kept in their own ranges
+             * of m_cachedLinks and m_cachedLinkArrows, and the sources of the cached links are indexed by their
+             * targets. When nodes change, only the ranges of the affected sources are rewritten, and the world is only
+             * traversed if the cache was discarded entirely.
+             */
+            SourceLinksMap m_linksBySource;
+            TargetSourcesMap m_sourcesByTarget;
+            bool m_linkCacheValid;
         public:
             EntityLinkRenderer(View::MapDocumentWPtr document);
             
@@ -66,6 +115,12 @@ namespace TrenchBroom {
             
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void invalidate();
+            /**
+             * Updates the links that start or end at the given nodes, their ancestor entities or their descendant
+             * entities. Must be called when these nodes changed, were added to or removed from the world, or when
+             * their selection state changed.
+             */
+            void invalidateNodes(const Model::NodeList& nodes);
         private:
             void doPrepareVertices(Vbo& vertexVbo) override;
             void doRender(RenderContext& renderContext) override;
@@ -85,8 +140,14 @@ namespace TrenchBroom {
             class CollectTransitiveSelectedLinksVisitor;
             class CollectDirectSelectedLinksVisitor;
 
-            void getLinks(Vertex::List& links) const;
-            void getAllLinks(Vertex::List& links) const;
+            static void addLink(Vertex::List& links, const Model::AttributableNode* source, const Model::AttributableNode* target, const Color& defaultColor, const Color& selectedColor);
+
+            void getLinks(Vertex::List& links);
+            void validateLinkCache();
+            void updateCachedLinkRanges();
+            void clearLinkCache();
+            void updateLinksFromSource(const Model::EditorContext& editorContext, const Model::AttributableNode* source);
+            void removeLinksFromSource(const Model::AttributableNode* source);
             void getTransitiveSelectedLinks(Vertex::List& links) const;
             void getDirectSelectedLinks(Vertex::List& links) const;
             void collectSelectedLinks(CollectLinksVisitor& collectLinks) const;
@@ -28,6 +28,7 @@
 #include "Assets/EntityModelManager.h"
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
+#include "Renderer/Camera.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
@@ -39,6 +40,7 @@ namespace TrenchBroom {
         EntityModelRenderer::EntityModelRenderer(Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext) :
         m_entityModelManager(entityModelManager),
         m_editorContext(editorContext),
+        m_modelGeneration(m_entityModelManager.generation()),
         m_applyTinting(false),
         m_showHiddenEntities(false) {}
 
@@ -51,11 +53,14 @@ namespace TrenchBroom {
             TexturedIndexRangeRenderer* renderer = m_entityModelManager.renderer(modelSpec);
             if (renderer != nullptr)
                 m_entities.insert(std::make_pair(entity, renderer));
+            updatePendingEntity(entity, renderer);
         }
         
         void EntityModelRenderer::updateEntity(Model::Entity* entity) {
             const Assets::ModelSpecification& modelSpec = entity->modelSpecification();
             TexturedIndexRangeRenderer* renderer = m_entityModelManager.renderer(modelSpec);
+            updatePendingEntity(entity, renderer);
+
             EntityMap::iterator it = m_entities.find(entity);
             
             if (renderer == nullptr && it == std::end(m_entities))
@@ -71,8 +76,43 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityModelRenderer::removeEntity(Model::Entity* entity) {
+            m_entities.erase(entity);
+            m_pendingEntities.erase(entity);
+        }
+
         void EntityModelRenderer::clear() {
             m_entities.clear();
+            m_pendingEntities.clear();
+        }
+
+        bool EntityModelRenderer::updatePendingEntities() {
+            const size_t modelGeneration = m_entityModelManager.generation();
+            if (modelGeneration == m_modelGeneration)
+                return false;
+            m_modelGeneration = modelGeneration;
+
+            // updateEntity removes the entities that are not pending anymore
+            const Model::EntitySet pendingEntities = m_pendingEntities;
+            for (Model::Entity* entity : pendingEntities)
+                updateEntity(entity);
+            return m_pendingEntities.size() != pendingEntities.size();
+        }
+
+        void EntityModelRenderer::updatePendingEntity(Model::Entity* entity, const TexturedIndexRangeRenderer* renderer) {
+            if (renderer == nullptr && m_entityModelManager.isLoading(entity->modelSpecification().path))
+                m_pendingEntities.insert(entity);
+            else
+                m_pendingEntities.erase(entity);
+        }
+
+        void EntityModelRenderer::prioritizePendingEntities(const RenderContext& renderContext) {
+            // load the models of the entities that are closest to the camera first
+            const Vec3f& cameraPosition = renderContext.camera().position();
+            for (const Model::Entity* entity : m_pendingEntities) {
+                const float distance2 = (Vec3f(entity->origin()) - cameraPosition).squaredLength();
+                m_entityModelManager.setLoadPriority(entity->modelSpecification().path, distance2);
+            }
         }
 
         bool EntityModelRenderer::applyTinting() const {
@@ -108,6 +148,8 @@ namespace TrenchBroom {
         }
         
         void EntityModelRenderer::doRender(RenderContext& renderContext) {
+            prioritizePendingEntities(renderContext);
+
             PreferenceManager& prefs = PreferenceManager::instance();
             
             ActiveShader shader(renderContext.shaderManager(), Shaders::EntityModelShader);
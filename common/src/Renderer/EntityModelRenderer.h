@@ -52,6 +52,13 @@ namespace TrenchBroom {
             const Model::EditorContext& m_editorContext;
             
             EntityMap m_entities;
+
+            /**
+             * The entities whose models are still being loaded, and the generation of the model manager when their
+             * renderers were last looked up.
+             */
+            Model::EntitySet m_pendingEntities;
+            size_t m_modelGeneration;
             
             bool m_applyTinting;
             Color m_tintColor;
@@ -85,7 +92,16 @@ namespace TrenchBroom {
 
             void addEntity(Model::Entity* entity);
             void updateEntity(Model::Entity* entity);
+            void removeEntity(Model::Entity* entity);
             void clear();
+
+            /**
+             * Looks up the renderers of the entities whose models were still being loaded if the model manager has
+             * made models available since the last call.
+             *
+             * @return true if any of these entities has changed, i.e. its model was loaded or failed to load
+             */
+            bool updatePendingEntities();
             
             bool applyTinting() const;
             void setApplyTinting(const bool applyTinting);
@@ -97,6 +113,9 @@ namespace TrenchBroom {
             
             void render(RenderBatch& renderBatch);
         private:
+            void updatePendingEntity(Model::Entity* entity, const TexturedIndexRangeRenderer* renderer);
+            void prioritizePendingEntities(const RenderContext& renderContext);
+
             void doPrepareVertices(Vbo& vertexVbo) override;
             void doRender(RenderContext& renderContext) override;
         };
@@ -77,10 +77,49 @@ namespace TrenchBroom {
         
         void EntityRenderer::setEntities(const Model::EntityList& entities) {
             m_entities = entities;
+            m_entityIndices.clear();
+            for (size_t i = 0; i < m_entities.size(); ++i)
+                m_entityIndices[m_entities[i]] = i;
             m_modelRenderer.setEntities(std::begin(m_entities), std::end(m_entities));
             invalidate();
         }
 
+        void EntityRenderer::addEntities(const Model::EntityList& entities) {
+            if (entities.empty())
+                return;
+
+            for (Model::Entity* entity : entities) {
+                if (m_entityIndices.insert(std::make_pair(entity, m_entities.size())).second) {
+                    m_entities.push_back(entity);
+                    m_modelRenderer.addEntity(entity);
+                }
+            }
+            invalidateBounds();
+        }
+
+        void EntityRenderer::removeEntities(const Model::EntityList& entities) {
+            if (entities.empty())
+                return;
+
+            for (Model::Entity* entity : entities) {
+                const auto it = m_entityIndices.find(entity);
+                if (it == std::end(m_entityIndices))
+                    continue;
+
+                // move the last entity into the slot of the removed entity
+                const size_t index = it->second;
+                m_entityIndices.erase(it);
+                if (index + 1 < m_entities.size()) {
+                    m_entities[index] = m_entities.back();
+                    m_entityIndices[m_entities[index]] = index;
+                }
+                m_entities.pop_back();
+
+                m_modelRenderer.removeEntity(entity);
+            }
+            invalidateBounds();
+        }
+
         void EntityRenderer::invalidate() {
             invalidateBounds();
             reloadModels();
@@ -88,6 +127,7 @@ namespace TrenchBroom {
 
         void EntityRenderer::clear() {
             m_entities.clear();
+            m_entityIndices.clear();
             m_pointEntityWireframeBoundsRenderer = DirectEdgeRenderer();
             m_brushEntityWireframeBoundsRenderer = DirectEdgeRenderer();
             m_solidBoundsRenderer = TriangleRenderer();
@@ -151,6 +191,10 @@ namespace TrenchBroom {
         }
 
         void EntityRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
+            // entities whose models are still being loaded are drawn as solid boxes until the models are available
+            if (m_modelRenderer.updatePendingEntities())
+                invalidateBounds();
+
             if (!m_entities.empty()) {
                 renderBounds(renderContext, renderBatch);
                 renderModels(renderContext, renderBatch);
@@ -209,16 +253,16 @@ namespace TrenchBroom {
                 Renderer::RenderService renderService(renderContext, renderBatch);
                 renderService.setForegroundColor(m_overlayTextColor);
                 renderService.setBackgroundColor(m_overlayBackgroundColor);
+                if (m_showOccludedOverlays)
+                    renderService.setShowOccludedObjects();
+                else
+                    renderService.setHideOccludedObjects();
                 
+                ClassnameLayoutMap& layouts = classnameLayouts(renderService.fontDescriptor());
                 for (const Model::Entity* entity : m_entities) {
                     if (m_showHiddenEntities || m_editorContext.visible(entity)) {
-                        if (entity->group() == nullptr || entity->group() == m_editorContext.currentGroup()) {
-                            if (m_showOccludedOverlays)
-                                renderService.setShowOccludedObjects();
-                            else
-                                renderService.setHideOccludedObjects();
-                            renderService.renderString(entityString(entity), EntityClassnameAnchor(entity));
-                        }
+                        if (entity->group() == nullptr || entity->group() == m_editorContext.currentGroup())
+                            renderService.renderString(classnameLayout(renderService, layouts, entity), EntityClassnameAnchor(entity));
                     }
                 }
             }
@@ -379,6 +423,24 @@ namespace TrenchBroom {
             m_boundsValid = true;
         }
 
+        EntityRenderer::ClassnameLayoutMap& EntityRenderer::classnameLayouts(const FontDescriptor& fontDescriptor) {
+            auto it = m_classnameLayouts.find(fontDescriptor);
+            if (it == std::end(m_classnameLayouts)) {
+                // the font has changed, so the layouts for the previous font will not be needed again
+                m_classnameLayouts.clear();
+                it = m_classnameLayouts.insert(std::make_pair(fontDescriptor, ClassnameLayoutMap())).first;
+            }
+            return it->second;
+        }
+
+        const TextLayout& EntityRenderer::classnameLayout(RenderService& renderService, ClassnameLayoutMap& layouts, const Model::Entity* entity) {
+            const Model::AttributeValue& classname = entity->classname();
+            auto it = layouts.find(classname);
+            if (it == std::end(layouts))
+                it = layouts.insert(std::make_pair(classname, renderService.layoutString(entityString(entity)))).first;
+            return it->second;
+        }
+
         AttrString EntityRenderer::entityString(const Model::Entity* entity) const {
             const Model::AttributeValue& classname = entity->classname();
             // const Model::AttributeValue& targetname = entity->attribute(Model::AttributeNames::Targetname);
@@ -27,10 +27,12 @@
 #include "Renderer/EntityModelRenderer.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/TextRenderer.h"
 #include "Renderer/TriangleRenderer.h"
 #include "Renderer/Vbo.h"
 
 #include <map>
+#include <unordered_map>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -44,14 +46,25 @@ namespace TrenchBroom {
     namespace Renderer {
         class RenderBatch;
         class RenderContext;
+        class RenderService;
         
         class EntityRenderer {
         private:
             class EntityClassnameAnchor;
+            
+            /**
+             * The classname overlays are laid out once per classname and font and reused in every frame. Since the
+             * key is the classname, changing an entity's attributes picks up the matching layout without any
+             * explicit invalidation.
+             */
+            typedef std::unordered_map<String, TextLayout> ClassnameLayoutMap;
+            typedef std::map<FontDescriptor, ClassnameLayoutMap> FontClassnameLayoutMap;
 
             Assets::EntityModelManager& m_entityModelManager;
             const Model::EditorContext& m_editorContext;
             Model::EntityList m_entities;
+            // the index of each entity in m_entities, so that entities can be added and removed without scanning
+            std::unordered_map<Model::Entity*, size_t> m_entityIndices;
 
             DirectEdgeRenderer m_pointEntityWireframeBoundsRenderer;
             DirectEdgeRenderer m_brushEntityWireframeBoundsRenderer;
@@ -59,6 +72,7 @@ namespace TrenchBroom {
             TriangleRenderer m_solidBoundsRenderer;
             EntityModelRenderer m_modelRenderer;
             bool m_boundsValid;
+            FontClassnameLayoutMap m_classnameLayouts;
             
             bool m_showOverlays;
             Color m_overlayTextColor;
@@ -77,6 +91,14 @@ namespace TrenchBroom {
             EntityRenderer(Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext);
 
             void setEntities(const Model::EntityList& entities);
+            /**
+             * Entities that are already in this renderer are skipped.
+             */
+            void addEntities(const Model::EntityList& entities);
+            /**
+             * Entities that are not in this renderer are ignored.
+             */
+            void removeEntities(const Model::EntityList& entities);
             void invalidate();
             void clear();
             void reloadModels();
@@ -118,6 +140,8 @@ namespace TrenchBroom {
             void invalidateBounds();
             void validateBounds();
             
+            ClassnameLayoutMap& classnameLayouts(const FontDescriptor& fontDescriptor);
+            const TextLayout& classnameLayout(RenderService& renderService, ClassnameLayoutMap& layouts, const Model::Entity* entity);
             AttrString entityString(const Model::Entity* entity) const;
             const Color& boundsColor(const Model::Entity* entity) const;
         };
@@ -23,6 +23,7 @@
 #include "Preferences.h"
 #include "PreferenceManager.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureArray.h"
 #include "Renderer/Camera.h"
 #include "Renderer/BrushRendererArrays.h"
 #include "Renderer/RenderContext.h"
@@ -65,9 +66,10 @@ namespace TrenchBroom {
         m_tint(false),
         m_alpha(1.0f) {}
         
-        FaceRenderer::FaceRenderer(BrushVertexArrayPtr vertexArray, TextureToBrushIndicesMapPtr indexArrayMap, const Color& faceColor) :
+        FaceRenderer::FaceRenderer(BrushVertexArrayPtr vertexArray, TextureToBrushIndicesMapPtr indexArrayMap, TextureArrayToBrushIndicesMapPtr arrayIndexArrayMap, const Color& faceColor) :
         m_vertexArray(vertexArray),
         m_indexArrayMap(indexArrayMap),
+        m_arrayIndexArrayMap(arrayIndexArrayMap),
         m_faceColor(faceColor),
         m_grayscale(false),
         m_tint(false),
@@ -76,6 +78,7 @@ namespace TrenchBroom {
         FaceRenderer::FaceRenderer(const FaceRenderer& other) :
         m_vertexArray(other.m_vertexArray),
         m_indexArrayMap(other.m_indexArrayMap),
+        m_arrayIndexArrayMap(other.m_arrayIndexArrayMap),
         m_faceColor(other.m_faceColor),
         m_grayscale(other.m_grayscale),
         m_tint(other.m_tint),
@@ -92,6 +95,7 @@ namespace TrenchBroom {
             using std::swap;
             swap(left.m_vertexArray, right.m_vertexArray);
             swap(left.m_indexArrayMap, right.m_indexArrayMap);
+            swap(left.m_arrayIndexArrayMap, right.m_arrayIndexArrayMap);
             swap(left.m_faceColor, right.m_faceColor);
             swap(left.m_grayscale, right.m_grayscale);
             swap(left.m_tint, right.m_tint);
@@ -126,55 +130,90 @@ namespace TrenchBroom {
                 const auto& brushIndexHolderPtr = pair.second;
                 brushIndexHolderPtr->prepare(indexVbo);
             }
+            for (const auto& pair : *m_arrayIndexArrayMap) {
+                const auto& brushIndexHolderPtr = pair.second;
+                brushIndexHolderPtr->prepare(indexVbo);
+            }
         }
         
         void FaceRenderer::doRender(RenderContext& context) {
-            if (m_indexArrayMap->empty())
+            if (m_indexArrayMap->empty() && m_arrayIndexArrayMap->empty())
                 return;
 
             if (m_vertexArray->setupVertices()) {
-                ShaderManager& shaderManager = context.shaderManager();
-                ActiveShader shader(shaderManager, Shaders::FaceShader);
-                PreferenceManager& prefs = PreferenceManager::instance();
-                
-                const bool applyTexture = context.showTextures();
-                const bool shadeFaces = context.shadeFaces();
-                const bool showFog = context.showFog();
-                
-                glAssert(glEnable(GL_TEXTURE_2D));
                 glAssert(glActiveTexture(GL_TEXTURE0));
-                shader.set("Brightness", prefs.get(Preferences::Brightness));
-                shader.set("RenderGrid", context.showGrid());
-                shader.set("GridSize", static_cast<float>(context.gridSize()));
-                shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
-                shader.set("ApplyTexture", applyTexture);
-                shader.set("Texture", 0);
-                shader.set("ApplyTinting", m_tint);
-                if (m_tint)
-                    shader.set("TintColor", m_tintColor);
-                shader.set("GrayScale", m_grayscale);
-                shader.set("CameraPosition", context.camera().position());
-                shader.set("ShadeFaces", shadeFaces);
-                shader.set("ShowFog", showFog);
-                shader.set("Alpha", m_alpha);
-                
-                RenderFunc func(shader, applyTexture, m_faceColor);
                 if (m_alpha < 1.0f) {
                     glAssert(glDepthMask(GL_FALSE));
                 }
-                for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap) {
-                    if (brushIndexHolderPtr->empty()) {
-                        continue;
-                    }
-                    func.before(texture);
-                    brushIndexHolderPtr->render(GL_TRIANGLES);
-                    func.after(texture);
-                }
+
+                if (!m_arrayIndexArrayMap->empty())
+                    renderTextureArrays(context);
+                if (!m_indexArrayMap->empty())
+                    renderTextures(context);
+
                 if (m_alpha < 1.0f) {
                     glAssert(glDepthMask(GL_TRUE));
                 }
                 m_vertexArray->cleanupVertices();
             }
         }
+
+        void FaceRenderer::renderTextures(RenderContext& context) {
+            ShaderManager& shaderManager = context.shaderManager();
+            ActiveShader shader(shaderManager, Shaders::FaceShader);
+
+            const bool applyTexture = context.showTextures();
+            setupShader(shader, context, applyTexture);
+
+            glAssert(glEnable(GL_TEXTURE_2D));
+            RenderFunc func(shader, applyTexture, m_faceColor);
+            for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap) {
+                if (brushIndexHolderPtr->empty()) {
+                    continue;
+                }
+                func.before(texture);
+                brushIndexHolderPtr->render(GL_TRIANGLES);
+                func.after(texture);
+            }
+        }
+
+        void FaceRenderer::renderTextureArrays(RenderContext& context) {
+            ShaderManager& shaderManager = context.shaderManager();
+            ActiveShader shader(shaderManager, Shaders::FaceArrayShader);
+
+            // The faces of an array batch use different textures, so there is no single average color to show when
+            // textures are hidden; fall back to the default face color in that case.
+            const bool applyTexture = context.showTextures();
+            setupShader(shader, context, applyTexture);
+            shader.set("Color", m_faceColor);
+
+            for (const auto& [textureArray, brushIndexHolderPtr] : *m_arrayIndexArrayMap) {
+                if (brushIndexHolderPtr->empty()) {
+                    continue;
+                }
+                textureArray->activate();
+                brushIndexHolderPtr->render(GL_TRIANGLES);
+                textureArray->deactivate();
+            }
+        }
+
+        void FaceRenderer::setupShader(ActiveShader& shader, RenderContext& context, const bool applyTexture) const {
+            PreferenceManager& prefs = PreferenceManager::instance();
+
+            shader.set("Brightness", prefs.get(Preferences::Brightness));
+            shader.set("RenderGrid", context.showGrid());
+            shader.set("GridSize", static_cast<float>(context.gridSize()));
+            shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
+            shader.set("ApplyTexture", applyTexture);
+            shader.set("Texture", 0);
+            shader.set("ApplyTinting", m_tint);
+            if (m_tint)
+                shader.set("TintColor", m_tintColor);
+            shader.set("GrayScale", m_grayscale);
+            shader.set("CameraPosition", context.camera().position());
+            shader.set("ShadeFaces", context.shadeFaces());
+            shader.set("ShowFog", context.showFog());
+            shader.set("Alpha", m_alpha);
+        }
     }
 }
@@ -42,6 +42,8 @@ namespace TrenchBroom {
         using BrushVertexArrayPtr = std::shared_ptr<BrushVertexArray>;
         using TextureToBrushIndicesMap = std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
         using TextureToBrushIndicesMapPtr = std::shared_ptr<const TextureToBrushIndicesMap>;
+        using TextureArrayToBrushIndicesMap = std::unordered_map<const Assets::TextureArray*, std::shared_ptr<BrushIndexArray>>;
+        using TextureArrayToBrushIndicesMapPtr = std::shared_ptr<const TextureArrayToBrushIndicesMap>;
 
         class FaceRenderer : public IndexedRenderable {
         private:
@@ -49,6 +51,7 @@ namespace TrenchBroom {
 
             BrushVertexArrayPtr m_vertexArray;
             TextureToBrushIndicesMapPtr m_indexArrayMap;
+            TextureArrayToBrushIndicesMapPtr m_arrayIndexArrayMap;
             Color m_faceColor;
             bool m_grayscale;
             bool m_tint;
@@ -56,7 +59,7 @@ namespace TrenchBroom {
             float m_alpha;
         public:
             FaceRenderer();
-            FaceRenderer(BrushVertexArrayPtr vertexArray, TextureToBrushIndicesMapPtr indexArrayMap, const Color& faceColor);
+            FaceRenderer(BrushVertexArrayPtr vertexArray, TextureToBrushIndicesMapPtr indexArrayMap, TextureArrayToBrushIndicesMapPtr arrayIndexArrayMap, const Color& faceColor);
             
             FaceRenderer(const FaceRenderer& other);
             FaceRenderer& operator=(FaceRenderer other);
@@ -71,6 +74,9 @@ namespace TrenchBroom {
         private:
             void prepareVerticesAndIndices(Vbo& vertexVbo, Vbo& indexVbo) override;
             void doRender(RenderContext& context) override;
+            void renderTextures(RenderContext& context);
+            void renderTextureArrays(RenderContext& context);
+            void setupShader(ActiveShader& shader, RenderContext& context, bool applyTexture) const;
         };
 
         void swap(FaceRenderer& left, FaceRenderer& right);
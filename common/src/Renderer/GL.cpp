@@ -19,6 +19,8 @@
 
 #include "GL.h"
 
+#include <cstdlib>
+
 namespace TrenchBroom {
     void glCheckError(const String& msg) {
         const GLenum error = glGetError();
@@ -52,6 +54,60 @@ namespace TrenchBroom {
         }
     }
 
+    static bool glHasExtension(const String& extensions, const String& name) {
+        size_t pos = extensions.find(name);
+        while (pos != String::npos) {
+            const size_t end = pos + name.size();
+            if ((pos == 0 || extensions[pos - 1] == ' ') && (end == extensions.size() || extensions[end] == ' '))
+                return true;
+            pos = extensions.find(name, end);
+        }
+        return false;
+    }
+
+    static bool glGetVersion(int& major, int& minor) {
+        const GLubyte* version = glGetString(GL_VERSION);
+        if (version == nullptr)
+            return false;
+
+        // the version string starts with "<major>.<minor>", optionally followed by vendor specific information
+        char* end = nullptr;
+        major = static_cast<int>(std::strtol(reinterpret_cast<const char*>(version), &end, 10));
+        minor = (end != nullptr && *end == '.') ? static_cast<int>(std::strtol(end + 1, nullptr, 10)) : 0;
+        return true;
+    }
+
+    static bool glHasExtension(const String& name) {
+        const GLubyte* extensions = glGetString(GL_EXTENSIONS);
+        if (extensions == nullptr)
+            return false;
+        return glHasExtension(String(reinterpret_cast<const char*>(extensions)), name);
+    }
+
+    bool glSupportsTextureArrays() {
+        int major, minor;
+        if (!glGetVersion(major, minor))
+            return false;
+
+        // array textures and glGenerateMipmap are core since OpenGL 3.0
+        if (major >= 3)
+            return true;
+
+        return glHasExtension("GL_EXT_texture_array") && glHasExtension("GL_ARB_framebuffer_object");
+    }
+
+    bool glSupportsTimerQueries() {
+        int major, minor;
+        if (!glGetVersion(major, minor))
+            return false;
+
+        // GL_TIME_ELAPSED queries are core since OpenGL 3.3
+        if (major > 3 || (major == 3 && minor >= 3))
+            return true;
+
+        return glHasExtension("GL_ARB_timer_query") || glHasExtension("GL_EXT_timer_query");
+    }
+
     Func0<void> glewInitialize;
     
     Func0<GLenum> glGetError;
@@ -95,6 +151,8 @@ namespace TrenchBroom {
     Func3<void, GLenum, GLenum, GLfloat> glTexParameterf;
     Func3<void, GLenum, GLenum, GLint> glTexParameteri;
     Func9<void, GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*> glTexImage2D;
+    Func10<void, GLenum, GLint, GLint, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*> glTexImage3D;
+    Func1<void, GLenum> glGenerateMipmap;
     Func1<void, GLenum> glActiveTexture;
     
     Func2<void, GLsizei, GLuint*> glGenBuffers;
@@ -105,6 +163,13 @@ namespace TrenchBroom {
     Func2<GLvoid*, GLenum, GLenum> glMapBuffer;
     Func1<GLboolean, GLenum> glUnmapBuffer;
     
+    Func2<void, GLsizei, GLuint*> glGenQueries;
+    Func2<void, GLsizei, const GLuint*> glDeleteQueries;
+    Func2<void, GLenum, GLuint> glBeginQuery;
+    Func1<void, GLenum> glEndQuery;
+    Func3<void, GLuint, GLenum, GLint*> glGetQueryObjectiv;
+    Func3<void, GLuint, GLenum, GLuint*> glGetQueryObjectuiv;
+    
     Func1<void, GLuint> glEnableVertexAttribArray;
     Func1<void, GLuint> glDisableVertexAttribArray;
     Func1<void, GLenum> glEnableClientState;
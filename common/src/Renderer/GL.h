@@ -118,6 +118,9 @@ namespace TrenchBroom {
 #define GL_LINE 0x1B01
 #define GL_FILL 0x1B02
 
+#define GL_VERSION 0x1F02
+#define GL_EXTENSIONS 0x1F03
+
 #define GL_NEAREST 0x2600
 #define GL_LINEAR 0x2601
 #define GL_NEAREST_MIPMAP_NEAREST 0x2700
@@ -154,6 +157,8 @@ namespace TrenchBroom {
 #define GL_ARRAY_BUFFER 0x8892
 #define GL_ELEMENT_ARRAY_BUFFER 0x8893
 
+#define GL_QUERY_RESULT 0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
 #define GL_READ_ONLY 0x88B8
 #define GL_WRITE_ONLY 0x88B9
 #define GL_READ_WRITE 0x88BA
@@ -166,6 +171,8 @@ namespace TrenchBroom {
 #define GL_DYNAMIC_DRAW 0x88E8
 #define GL_DYNAMIC_READ 0x88E9
 #define GL_DYNAMIC_COPY 0x88EA
+#define GL_TIME_ELAPSED 0x88BF
+#define GL_MAX_ARRAY_TEXTURE_LAYERS 0x88FF
 
 #define GL_FRAGMENT_SHADER 0x8B30
 #define GL_VERTEX_SHADER 0x8B31
@@ -174,6 +181,8 @@ namespace TrenchBroom {
 #define GL_INFO_LOG_LENGTH 0x8B84
 #define GL_CURRENT_PROGRAM 0x8B8D
 
+#define GL_TEXTURE_2D_ARRAY 0x8C1A
+
     typedef unsigned int GLenum;
     typedef unsigned int GLbitfield;
     typedef int GLsizei;
@@ -207,6 +216,18 @@ namespace TrenchBroom {
     void glCheckError(const String& msg);
     String glGetErrorMessage(GLenum code);
 
+    /**
+     * Checks whether the current context supports 2D array textures and mipmap generation for them. Requires a
+     * current context; returns false if the context cannot be queried.
+     */
+    bool glSupportsTextureArrays();
+
+    /**
+     * Checks whether the current context supports GL_TIME_ELAPSED queries. Requires a current context; returns false
+     * if the context cannot be queried.
+     */
+    bool glSupportsTimerQueries();
+
 // #define GL_DEBUG 1
 // #define GL_LOG 1
     
@@ -285,6 +306,8 @@ namespace TrenchBroom {
     extern Func3<void, GLenum, GLenum, GLfloat> glTexParameterf;
     extern Func3<void, GLenum, GLenum, GLint> glTexParameteri;
     extern Func9<void, GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*> glTexImage2D;
+    extern Func10<void, GLenum, GLint, GLint, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*> glTexImage3D;
+    extern Func1<void, GLenum> glGenerateMipmap;
     extern Func1<void, GLenum> glActiveTexture;
     
     extern Func2<void, GLsizei, GLuint*> glGenBuffers;
@@ -295,6 +318,13 @@ namespace TrenchBroom {
     extern Func2<GLvoid*, GLenum, GLenum> glMapBuffer;
     extern Func1<GLboolean, GLenum> glUnmapBuffer;
     
+    extern Func2<void, GLsizei, GLuint*> glGenQueries;
+    extern Func2<void, GLsizei, const GLuint*> glDeleteQueries;
+    extern Func2<void, GLenum, GLuint> glBeginQuery;
+    extern Func1<void, GLenum> glEndQuery;
+    extern Func3<void, GLuint, GLenum, GLint*> glGetQueryObjectiv;
+    extern Func3<void, GLuint, GLenum, GLuint*> glGetQueryObjectuiv;
+    
     extern Func1<void, GLuint> glEnableVertexAttribArray;
     extern Func1<void, GLuint> glDisableVertexAttribArray;
     extern Func1<void, GLenum> glEnableClientState;
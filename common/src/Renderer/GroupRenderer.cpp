@@ -60,6 +60,41 @@ namespace TrenchBroom {
         
         void GroupRenderer::setGroups(const Model::GroupList& groups) {
             m_groups = groups;
+            m_groupIndices.clear();
+            for (size_t i = 0; i < m_groups.size(); ++i)
+                m_groupIndices[m_groups[i]] = i;
+            invalidate();
+        }
+
+        void GroupRenderer::addGroups(const Model::GroupList& groups) {
+            if (groups.empty())
+                return;
+
+            for (Model::Group* group : groups) {
+                if (m_groupIndices.insert(std::make_pair(group, m_groups.size())).second)
+                    m_groups.push_back(group);
+            }
+            invalidate();
+        }
+
+        void GroupRenderer::removeGroups(const Model::GroupList& groups) {
+            if (groups.empty())
+                return;
+
+            for (Model::Group* group : groups) {
+                const auto it = m_groupIndices.find(group);
+                if (it == std::end(m_groupIndices))
+                    continue;
+
+                // move the last group into the slot of the removed group
+                const size_t index = it->second;
+                m_groupIndices.erase(it);
+                if (index + 1 < m_groups.size()) {
+                    m_groups[index] = m_groups.back();
+                    m_groupIndices[m_groups[index]] = index;
+                }
+                m_groups.pop_back();
+            }
             invalidate();
         }
 
@@ -69,6 +104,7 @@ namespace TrenchBroom {
         
         void GroupRenderer::clear() {
             m_groups.clear();
+            m_groupIndices.clear();
             m_boundsRenderer = DirectEdgeRenderer();
         }
         
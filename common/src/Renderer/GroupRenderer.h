@@ -25,6 +25,8 @@
 #include "Model/ModelTypes.h"
 #include "Renderer/EdgeRenderer.h"
 
+#include <unordered_map>
+
 namespace TrenchBroom {
     namespace Model {
         class EditorContext;
@@ -40,6 +42,8 @@ namespace TrenchBroom {
             
             const Model::EditorContext& m_editorContext;
             Model::GroupList m_groups;
+            // the index of each group in m_groups, so that groups can be added and removed without scanning
+            std::unordered_map<Model::Group*, size_t> m_groupIndices;
             
             DirectEdgeRenderer m_boundsRenderer;
             bool m_boundsValid;
@@ -59,28 +63,14 @@ namespace TrenchBroom {
             void invalidate();
             void clear();
 
-            template <typename Iter>
-            void addGroups(Iter cur, const Iter end) {
-                while (cur != end) {
-                    addGroup(*cur);
-                    ++cur;
-                }
-            }
-            template <typename Iter>
-            void updateGroups(Iter cur, const Iter end) {
-                while (cur != end) {
-                    updateGroup(*cur);
-                    ++cur;
-                }
-            }
-            
-            template <typename Iter>
-            void removeGroups(Iter cur, const Iter end) {
-                while (cur != end) {
-                    removeGroup(*cur);
-                    ++cur;
-                }
-            }
+            /**
+             * Groups that are already in this renderer are skipped.
+             */
+            void addGroups(const Model::GroupList& groups);
+            /**
+             * Groups that are not in this renderer are ignored.
+             */
+            void removeGroups(const Model::GroupList& groups);
             
             void setShowOverlays(bool showOverlays);
             void setOverlayTextColor(const Color& overlayTextColor);
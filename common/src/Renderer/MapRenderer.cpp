@@ -26,6 +26,7 @@
 #include "Assets/EntityDefinitionManager.h"
 #include "Model/Brush.h"
 #include "Model/CollectMatchingNodesVisitor.h"
+#include "Model/CollectNodesVisitor.h"
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
 #include "Model/Group.h"
@@ -38,8 +39,10 @@
 #include "Renderer/Camera.h"
 #include "Renderer/EntityLinkRenderer.h"
 #include "Renderer/ObjectRenderer.h"
+#include "Renderer/PortalFileRenderer.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/RenderService.h"
 #include "Renderer/RenderUtils.h"
 #include "View/Selection.h"
@@ -117,7 +120,8 @@ namespace TrenchBroom {
         m_defaultRenderer(createDefaultRenderer(m_document)),
         m_selectionRenderer(createSelectionRenderer(m_document)),
         m_lockedRenderer(createLockRenderer(m_document)),
-        m_entityLinkRenderer(new EntityLinkRenderer(m_document)) {
+        m_entityLinkRenderer(new EntityLinkRenderer(m_document)),
+        m_portalFileRenderer(new PortalFileRenderer(m_document)) {
             bindObservers();
             setupRenderers();
         }
@@ -125,6 +129,7 @@ namespace TrenchBroom {
         MapRenderer::~MapRenderer() {
             unbindObservers();
             clear();
+            delete m_portalFileRenderer;
             delete m_entityLinkRenderer;
             delete m_lockedRenderer;
             delete m_selectionRenderer;
@@ -172,20 +177,35 @@ namespace TrenchBroom {
         }
         
         void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
-            commitPendingChanges();
+            RenderProfiler* profiler = renderContext.profiler();
+            {
+                ProfileScope scope(profiler, "Commit pending changes");
+                commitPendingChanges();
+            }
             setupGL(renderBatch);
-            renderDefaultOpaque(renderContext, renderBatch);
-            renderLockedOpaque(renderContext, renderBatch);
-            renderSelectionOpaque(renderContext, renderBatch);
-            
-            renderDefaultTransparent(renderContext, renderBatch);
-            renderLockedTransparent(renderContext, renderBatch);
-            renderSelectionTransparent(renderContext, renderBatch);
-            
-            renderEntityLinks(renderContext, renderBatch);
+            {
+                ProfileScope scope(profiler, "Opaque");
+                renderDefaultOpaque(renderContext, renderBatch);
+                renderLockedOpaque(renderContext, renderBatch);
+                renderSelectionOpaque(renderContext, renderBatch);
+            }
+            {
+                ProfileScope scope(profiler, "Transparent");
+                renderDefaultTransparent(renderContext, renderBatch);
+                renderLockedTransparent(renderContext, renderBatch);
+                renderSelectionTransparent(renderContext, renderBatch);
+            }
+            {
+                ProfileScope scope(profiler, "Entity links");
+                renderEntityLinks(renderContext, renderBatch);
+            }
             renderTutorialMessages(renderContext, renderBatch);
         }
         
+        void MapRenderer::renderPortalFile(RenderContext& renderContext, RenderBatch& renderBatch) {
+            m_portalFileRenderer->render(renderContext, renderBatch);
+        }
+        
         void MapRenderer::commitPendingChanges() {
             View::MapDocumentSPtr document = lock(m_document);
             document->commitPendingAssets();
@@ -295,6 +315,7 @@ namespace TrenchBroom {
             setupSelectionRenderer(m_selectionRenderer);
             setupLockedRenderer(m_lockedRenderer);
             setupEntityLinkRenderer();
+            setupPortalFileRenderer();
         }
         
         void MapRenderer::setupDefaultRenderer(ObjectRenderer* renderer) {
@@ -356,6 +377,11 @@ namespace TrenchBroom {
         void MapRenderer::setupEntityLinkRenderer() {
         }
         
+        void MapRenderer::setupPortalFileRenderer() {
+            m_portalFileRenderer->setFillColor(pref(Preferences::PortalFileFillColor));
+            m_portalFileRenderer->setOutlineColor(pref(Preferences::PortalFileBorderColor));
+        }
+        
         class MapRenderer::CollectRenderableNodes : public Model::NodeVisitor {
         private:
             Renderer m_renderers;
@@ -437,6 +463,33 @@ namespace TrenchBroom {
             invalidateEntityLinkRenderer();
         }
         
+        void MapRenderer::updateRenderers(const Model::NodeCollection& nodes) {
+            if (nodes.empty())
+                return;
+
+            removeFromRenderers(nodes);
+
+            CollectRenderableNodes collect(Renderer_All);
+            Model::Node::accept(std::begin(nodes), std::end(nodes), collect);
+
+            m_defaultRenderer->addObjects(collect.defaultNodes().groups(),
+                                          collect.defaultNodes().entities(),
+                                          collect.defaultNodes().brushes());
+            m_selectionRenderer->addObjects(collect.selectedNodes().groups(),
+                                            collect.selectedNodes().entities(),
+                                            collect.selectedNodes().brushes());
+            m_lockedRenderer->addObjects(collect.lockedNodes().groups(),
+                                         collect.lockedNodes().entities(),
+                                         collect.lockedNodes().brushes());
+            m_entityLinkRenderer->invalidateNodes(nodes.nodes());
+        }
+
+        void MapRenderer::removeFromRenderers(const Model::NodeCollection& nodes) {
+            m_defaultRenderer->removeObjects(nodes.groups(), nodes.entities(), nodes.brushes());
+            m_selectionRenderer->removeObjects(nodes.groups(), nodes.entities(), nodes.brushes());
+            m_lockedRenderer->removeObjects(nodes.groups(), nodes.entities(), nodes.brushes());
+        }
+
         void MapRenderer::invalidateRenderers(Renderer renderers) {
             if ((renderers & Renderer_Default) != 0)
                 m_defaultRenderer->invalidate();
@@ -486,6 +539,8 @@ namespace TrenchBroom {
             document->textureCollectionsDidChangeNotifier.addObserver(this, &MapRenderer::textureCollectionsDidChange);
             document->entityDefinitionsDidChangeNotifier.addObserver(this, &MapRenderer::entityDefinitionsDidChange);
             document->modsDidChangeNotifier.addObserver(this, &MapRenderer::modsDidChange);
+            document->portalFileWasLoadedNotifier.addObserver(this, &MapRenderer::portalFileDidChange);
+            document->portalFileWasUnloadedNotifier.addObserver(this, &MapRenderer::portalFileDidChange);
             document->editorContextDidChangeNotifier.addObserver(this, &MapRenderer::editorContextDidChange);
             document->mapViewConfigDidChangeNotifier.addObserver(this, &MapRenderer::mapViewConfigDidChange);
             
@@ -511,6 +566,8 @@ namespace TrenchBroom {
                 document->textureCollectionsDidChangeNotifier.removeObserver(this, &MapRenderer::textureCollectionsDidChange);
                 document->entityDefinitionsDidChangeNotifier.removeObserver(this, &MapRenderer::entityDefinitionsDidChange);
                 document->modsDidChangeNotifier.removeObserver(this, &MapRenderer::modsDidChange);
+                document->portalFileWasLoadedNotifier.removeObserver(this, &MapRenderer::portalFileDidChange);
+                document->portalFileWasUnloadedNotifier.removeObserver(this, &MapRenderer::portalFileDidChange);
                 document->editorContextDidChangeNotifier.removeObserver(this, &MapRenderer::editorContextDidChange);
                 document->mapViewConfigDidChangeNotifier.removeObserver(this, &MapRenderer::mapViewConfigDidChange);
             }
@@ -529,20 +586,32 @@ namespace TrenchBroom {
         }
         
         void MapRenderer::nodesWereAdded(const Model::NodeList& nodes) {
-            updateRenderers(Renderer_Default);
+            Model::CollectNodesVisitor collect;
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collect);
+
+            Model::NodeCollection added;
+            added.addNodes(collect.nodes());
+            updateRenderers(added);
         }
         
         void MapRenderer::nodesWereRemoved(const Model::NodeList& nodes) {
-            updateRenderers(Renderer_Default);
+            Model::CollectNodesVisitor collect;
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collect);
+
+            Model::NodeCollection removed;
+            removed.addNodes(collect.nodes());
+            removeFromRenderers(removed);
+            m_entityLinkRenderer->invalidateNodes(removed.nodes());
         }
         
         void MapRenderer::nodesDidChange(const Model::NodeList& nodes) {
             invalidateRenderers(Renderer_Selection);
-            invalidateEntityLinkRenderer();
+            m_entityLinkRenderer->invalidateNodes(nodes);
         }
         
         void MapRenderer::nodeVisibilityDidChange(const Model::NodeList& nodes) {
             invalidateRenderers(Renderer_All);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::nodeLockingDidChange(const Model::NodeList& nodes) {
@@ -562,7 +631,16 @@ namespace TrenchBroom {
         }
         
         void MapRenderer::selectionDidChange(const View::Selection& selection) {
-            updateRenderers(Renderer_All); // need to update locked objects also because a selected object may have been reparented into a locked layer before deselection
+            // only the nodes whose selection state changed can move between the renderers; this includes the locked
+            // renderer because a selected object may have been reparented into a locked layer before deselection
+            Model::NodeCollection changed;
+            changed.addNodes(selection.selectedNodes());
+            changed.addNodes(selection.deselectedNodes());
+            changed.addNodes(selection.partiallySelectedNodes());
+            changed.addNodes(selection.partiallyDeselectedNodes());
+            changed.addNodes(selection.recursivelySelectedNodes());
+            changed.addNodes(selection.recursivelyDeselectedNodes());
+            updateRenderers(changed);
 
             // selecting faces needs to invalidate the brushes
             if (!selection.selectedBrushFaces().empty()
@@ -609,6 +687,10 @@ namespace TrenchBroom {
             invalidateEntityLinkRenderer();
         }
         
+        void MapRenderer::portalFileDidChange() {
+            m_portalFileRenderer->invalidate();
+        }
+        
         void MapRenderer::editorContextDidChange() {
             invalidateRenderers(Renderer_All);
             invalidateEntityLinkRenderer();
@@ -627,6 +709,8 @@ namespace TrenchBroom {
                 reloadEntityModels();
                 invalidateRenderers(Renderer_All);
                 invalidateEntityLinkRenderer();
+            } else if (path == Preferences::TextureArrays.path()) {
+                invalidateRenderers(Renderer_All);
             }
         }
     }
@@ -22,6 +22,7 @@
 
 #include "Color.h"
 #include "Model/ModelTypes.h"
+#include "Model/NodeCollection.h"
 #include "View/ViewTypes.h"
 
 #include <map>
@@ -39,6 +40,7 @@ namespace TrenchBroom {
         class EntityLinkRenderer;
         class FontManager;
         class ObjectRenderer;
+        class PortalFileRenderer;
         class RenderBatch;
         class RenderContext;
         
@@ -56,6 +58,7 @@ namespace TrenchBroom {
             ObjectRenderer* m_selectionRenderer;
             ObjectRenderer* m_lockedRenderer;
             EntityLinkRenderer* m_entityLinkRenderer;
+            PortalFileRenderer* m_portalFileRenderer;
         public:
             MapRenderer(View::MapDocumentWPtr document);
             ~MapRenderer();
@@ -69,6 +72,7 @@ namespace TrenchBroom {
             void restoreSelectionColors();
         public: // rendering
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
+            void renderPortalFile(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
             void commitPendingChanges();
             void setupGL(RenderBatch& renderBatch);
@@ -90,6 +94,7 @@ namespace TrenchBroom {
             void setupSelectionRenderer(ObjectRenderer* renderer);
             void setupLockedRenderer(ObjectRenderer* renderer);
             void setupEntityLinkRenderer();
+            void setupPortalFileRenderer();
 
             typedef enum {
                 Renderer_Default            = 1,
@@ -109,6 +114,12 @@ namespace TrenchBroom {
              * If brushes are modified, you need to call invalidateRenderers() or invalidateObjectsInRenderers()
              */
             void updateRenderers(Renderer renderers);
+            /**
+             * Moves only the given nodes between the renderers, without visiting any other nodes. The given brushes
+             * are invalidated in the renderers they end up in.
+             */
+            void updateRenderers(const Model::NodeCollection& nodes);
+            void removeFromRenderers(const Model::NodeCollection& nodes);
             void invalidateRenderers(Renderer renderers);
             void invalidateBrushesInRenderers(Renderer renderers, const Model::BrushList& brushes);
             void invalidateEntityLinkRenderer();
@@ -139,6 +150,8 @@ namespace TrenchBroom {
             void entityDefinitionsDidChange();
             void modsDidChange();
             
+            void portalFileDidChange();
+            
             void editorContextDidChange();
             void mapViewConfigDidChange();
             
@@ -22,6 +22,8 @@
 #include "Model/Group.h"
 #include "Model/Node.h"
 #include "Model/NodeVisitor.h"
+#include "Renderer/RenderContext.h"
+#include "Renderer/RenderProfiler.h"
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -31,6 +33,18 @@ namespace TrenchBroom {
             m_brushRenderer.setBrushes(brushes);
         }
 
+        void ObjectRenderer::addObjects(const Model::GroupList& groups, const Model::EntityList& entities, const Model::BrushList& brushes) {
+            m_groupRenderer.addGroups(groups);
+            m_entityRenderer.addEntities(entities);
+            m_brushRenderer.addBrushes(brushes);
+        }
+
+        void ObjectRenderer::removeObjects(const Model::GroupList& groups, const Model::EntityList& entities, const Model::BrushList& brushes) {
+            m_groupRenderer.removeGroups(groups);
+            m_entityRenderer.removeEntities(entities);
+            m_brushRenderer.removeBrushes(brushes);
+        }
+
         void ObjectRenderer::invalidate() {
             m_groupRenderer.invalidate();
             m_entityRenderer.invalidate();
@@ -139,9 +153,19 @@ namespace TrenchBroom {
         }
 
         void ObjectRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
-            m_brushRenderer.renderOpaque(renderContext, renderBatch);
-            m_entityRenderer.render(renderContext, renderBatch);
-            m_groupRenderer.render(renderContext, renderBatch);
+            RenderProfiler* profiler = renderContext.profiler();
+            {
+                ProfileScope scope(profiler, "Brushes");
+                m_brushRenderer.renderOpaque(renderContext, renderBatch);
+            }
+            {
+                ProfileScope scope(profiler, "Entities");
+                m_entityRenderer.render(renderContext, renderBatch);
+            }
+            {
+                ProfileScope scope(profiler, "Groups");
+                m_groupRenderer.render(renderContext, renderBatch);
+            }
         }
         
         void ObjectRenderer::renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
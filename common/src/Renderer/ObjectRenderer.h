@@ -48,6 +48,8 @@ namespace TrenchBroom {
             m_brushRenderer(brushFilter) {}
         public: // object management
             void setObjects(const Model::GroupList& groups, const Model::EntityList& entities, const Model::BrushList& brushes);
+            void addObjects(const Model::GroupList& groups, const Model::EntityList& entities, const Model::BrushList& brushes);
+            void removeObjects(const Model::GroupList& groups, const Model::EntityList& entities, const Model::BrushList& brushes);
             void invalidate();
             void invalidateBrushes(const Model::BrushList& brushes);
             void clear();
@@ -0,0 +1,176 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PortalFileRenderer.h"
+
+#include "Model/PortalFile.h"
+#include "Renderer/Camera.h"
+#include "Renderer/RenderBatch.h"
+#include "Renderer/RenderContext.h"
+#include "Renderer/ShaderManager.h"
+#include "Renderer/Shaders.h"
+#include "View/MapDocument.h"
+
+#include <cassert>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        PortalFileRenderer::PortalFileRenderer(View::MapDocumentWPtr document) :
+        m_document(document),
+        m_fillColor(1.0f, 0.4f, 0.4f, 0.2f),
+        m_outlineColor(1.0f, 1.0f, 1.0f, 0.5f),
+        m_valid(false) {}
+
+        void PortalFileRenderer::setFillColor(const Color& color) {
+            m_fillColor = color;
+        }
+
+        void PortalFileRenderer::setOutlineColor(const Color& color) {
+            m_outlineColor = color;
+        }
+
+        void PortalFileRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
+            View::MapDocumentSPtr document = lock(m_document);
+            if (document->portalFile() != nullptr)
+                renderBatch.add(this);
+        }
+
+        void PortalFileRenderer::invalidate() {
+            m_valid = false;
+        }
+
+        void PortalFileRenderer::doPrepareVertices(Vbo& vertexVbo) {
+            if (!m_valid) {
+                validate();
+                m_fills.prepare(vertexVbo);
+                m_outlines.prepare(vertexVbo);
+            }
+        }
+
+        void PortalFileRenderer::doRender(RenderContext& renderContext) {
+            assert(m_valid);
+            collectVisibleRanges(renderContext);
+            if (m_fillIndices.empty())
+                return;
+
+            renderFills(renderContext);
+            renderOutlines(renderContext);
+        }
+
+        void PortalFileRenderer::renderFills(RenderContext& renderContext) {
+            ActiveShader shader(renderContext.shaderManager(), Shaders::VaryingPUniformCShader);
+            shader.set("Color", m_fillColor);
+
+            glAssert(glPushAttrib(GL_POLYGON_BIT));
+            glAssert(glDisable(GL_CULL_FACE));
+            glAssert(glPolygonMode(GL_FRONT_AND_BACK, GL_FILL));
+            glAssert(glDepthMask(GL_FALSE));
+
+            m_fills.render(GL_TRIANGLES, m_fillIndices, m_fillCounts, static_cast<GLint>(m_fillIndices.size()));
+
+            glAssert(glDepthMask(GL_TRUE));
+            glAssert(glPopAttrib());
+        }
+
+        void PortalFileRenderer::renderOutlines(RenderContext& renderContext) {
+            ActiveShader shader(renderContext.shaderManager(), Shaders::VaryingPUniformCShader);
+            shader.set("Color", m_outlineColor);
+
+            glAssert(glLineWidth(4.0f));
+            m_outlines.render(GL_LINES, m_outlineIndices, m_outlineCounts, static_cast<GLint>(m_outlineIndices.size()));
+            glAssert(glLineWidth(1.0f));
+        }
+
+        void PortalFileRenderer::collectVisibleRanges(RenderContext& renderContext) {
+            m_fillIndices.clear();
+            m_fillCounts.clear();
+            m_outlineIndices.clear();
+            m_outlineCounts.clear();
+
+            const Camera& camera = renderContext.camera();
+            for (const Chunk& chunk : m_chunks) {
+                if (camera.intersectsFrustum(chunk.bounds)) {
+                    addRange(m_fillIndices, m_fillCounts, chunk.firstFillVertex, chunk.fillVertexCount);
+                    addRange(m_outlineIndices, m_outlineCounts, chunk.firstOutlineVertex, chunk.outlineVertexCount);
+                }
+            }
+        }
+
+        void PortalFileRenderer::addRange(GLIndices& indices, GLCounts& counts, const GLint first, const GLsizei count) {
+            // adjacent chunks are merged into one range
+            if (!indices.empty() && indices.back() + counts.back() == first) {
+                counts.back() += count;
+            } else {
+                indices.push_back(first);
+                counts.push_back(count);
+            }
+        }
+
+        void PortalFileRenderer::validate() {
+            Vertex::List fills;
+            Vertex::List outlines;
+            m_chunks.clear();
+
+            View::MapDocumentSPtr document = lock(m_document);
+            const Model::PortalFile* portalFile = document->portalFile();
+            if (portalFile != nullptr) {
+                // every portal with n vertices has n - 2 triangles and n edges
+                fills.reserve(3 * (portalFile->vertexCount() - 2 * portalFile->portalCount()));
+                outlines.reserve(2 * portalFile->vertexCount());
+
+                for (const Model::PortalFile::Chunk& portalChunk : portalFile->chunks()) {
+                    Chunk chunk;
+                    chunk.bounds = portalChunk.bounds;
+                    chunk.firstFillVertex = static_cast<GLint>(fills.size());
+                    chunk.firstOutlineVertex = static_cast<GLint>(outlines.size());
+
+                    addChunk(*portalFile, portalChunk.firstPortal, portalChunk.portalCount, fills, outlines);
+
+                    chunk.fillVertexCount = static_cast<GLsizei>(fills.size()) - chunk.firstFillVertex;
+                    chunk.outlineVertexCount = static_cast<GLsizei>(outlines.size()) - chunk.firstOutlineVertex;
+                    m_chunks.push_back(chunk);
+                }
+            }
+
+            m_fills = VertexArray::swap(fills);
+            m_outlines = VertexArray::swap(outlines);
+            m_valid = true;
+        }
+
+        void PortalFileRenderer::addChunk(const Model::PortalFile& portalFile, const size_t firstPortal, const size_t portalCount, Vertex::List& fills, Vertex::List& outlines) {
+            const Vec3f::List& vertices = portalFile.vertices();
+            for (size_t i = firstPortal; i < firstPortal + portalCount; ++i) {
+                const size_t first = portalFile.firstVertex(i);
+                const size_t count = portalFile.vertexCount(i);
+
+                for (size_t j = 1; j < count - 1; ++j) {
+                    fills.push_back(Vertex(vertices[first]));
+                    fills.push_back(Vertex(vertices[first + j]));
+                    fills.push_back(Vertex(vertices[first + j + 1]));
+                }
+
+                for (size_t j = 0; j < count; ++j) {
+                    outlines.push_back(Vertex(vertices[first + j]));
+                    outlines.push_back(Vertex(vertices[first + (j + 1) % count]));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_PortalFileRenderer
+#define TrenchBroom_PortalFileRenderer
+
+#include "Color.h"
+#include "VecMath.h"
+#include "Renderer/GL.h"
+#include "Renderer/Renderable.h"
+#include "Renderer/VertexArray.h"
+#include "Renderer/VertexSpec.h"
+#include "View/ViewTypes.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class PortalFile;
+    }
+    
+    namespace Renderer {
+        class RenderBatch;
+        class RenderContext;
+        
+        /**
+         * Renders the portals of the document's portal file. The fills and the outlines of all portals are uploaded
+         * once, and for every frame, only the chunks of the portal file that intersect the view frustum are drawn,
+         * with one draw call for the fills and one for the outlines.
+         */
+        class PortalFileRenderer : public DirectRenderable {
+        private:
+            typedef VertexSpecs::P3::Vertex Vertex;
+
+            struct Chunk {
+                BBox3f bounds;
+                GLint firstFillVertex;
+                GLsizei fillVertexCount;
+                GLint firstOutlineVertex;
+                GLsizei outlineVertexCount;
+            };
+            typedef std::vector<Chunk> ChunkList;
+
+            View::MapDocumentWPtr m_document;
+
+            Color m_fillColor;
+            Color m_outlineColor;
+
+            VertexArray m_fills;
+            VertexArray m_outlines;
+            ChunkList m_chunks;
+            bool m_valid;
+
+            GLIndices m_fillIndices;
+            GLCounts m_fillCounts;
+            GLIndices m_outlineIndices;
+            GLCounts m_outlineCounts;
+        public:
+            PortalFileRenderer(View::MapDocumentWPtr document);
+
+            void setFillColor(const Color& color);
+            void setOutlineColor(const Color& color);
+
+            void render(RenderContext& renderContext, RenderBatch& renderBatch);
+            void invalidate();
+        private:
+            void doPrepareVertices(Vbo& vertexVbo) override;
+            void doRender(RenderContext& renderContext) override;
+            void renderFills(RenderContext& renderContext);
+            void renderOutlines(RenderContext& renderContext);
+            void collectVisibleRanges(RenderContext& renderContext);
+        private:
+            void validate();
+            static void addChunk(const Model::PortalFile& portalFile, size_t firstPortal, size_t portalCount, Vertex::List& fills, Vertex::List& outlines);
+            static void addRange(GLIndices& indices, GLCounts& counts, GLint first, GLsizei count);
+
+            PortalFileRenderer(const PortalFileRenderer& other);
+            PortalFileRenderer& operator=(const PortalFileRenderer& other);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_PortalFileRenderer) */
@@ -19,6 +19,7 @@
 
 #include "PrimitiveRenderer.h"
 
+#include "BatchMath.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/RenderUtils.h"
 #include "Renderer/ShaderManager.h"
@@ -226,7 +227,8 @@ namespace TrenchBroom {
             const Mat4x4f transform   = translation * rotation;
             
             const VertsAndNormals cylinder = cylinder3D(radius, len, segments);
-            const Vec3f::List vertices = transform * cylinder.vertices;
+            Vec3f::List vertices(cylinder.vertices.size());
+            BatchMath::transformPoints(transform, cylinder.vertices.data(), vertices.size(), vertices.data());
             
             m_triangleMeshes[TriangleRenderAttributes(color, occlusionPolicy, cullingPolicy)].addTriangleStrip(Vertex::fromLists(vertices, vertices.size()));
         }
@@ -21,6 +21,8 @@
 
 #include "CollectionUtils.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderContext.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/Vbo.h"
 
 namespace TrenchBroom {
@@ -92,8 +94,19 @@ namespace TrenchBroom {
         void RenderBatch::render(RenderContext& renderContext) {
             ActivateVbo activate(m_vertexVbo);
 
-            prepareRenderables();
-            renderRenderables(renderContext);
+            RenderProfiler* profiler = renderContext.profiler();
+            {
+                ProfileScope scope(profiler, "Upload vertices");
+                prepareRenderables();
+            }
+            {
+                ProfileScope scope(profiler, "Submit");
+                if (profiler != nullptr)
+                    profiler->beginGpuTimer();
+                renderRenderables(renderContext);
+                if (profiler != nullptr)
+                    profiler->endGpuTimer();
+            }
         }
 
         void RenderBatch::doAdd(Renderable* renderable) {
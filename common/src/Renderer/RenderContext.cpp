@@ -44,7 +44,8 @@ namespace TrenchBroom {
         m_gridSize(4),
         m_hideSelection(false),
         m_tintSelection(true),
-        m_showSelectionGuide(ShowSelectionGuide_Hide) {}
+        m_showSelectionGuide(ShowSelectionGuide_Hide),
+        m_profiler(nullptr) {}
         
         bool RenderContext::render2D() const {
             return m_renderMode == RenderMode_2D;
@@ -210,6 +211,14 @@ namespace TrenchBroom {
             setShowSelectionGuide(ShowSelectionGuide_ForceHide);
         }
         
+        RenderProfiler* RenderContext::profiler() const {
+            return m_profiler;
+        }
+
+        void RenderContext::setProfiler(RenderProfiler* profiler) {
+            m_profiler = profiler;
+        }
+
         void RenderContext::setShowSelectionGuide(const ShowSelectionGuide showSelectionGuide) {
             switch (showSelectionGuide) {
                 case ShowSelectionGuide_Show:
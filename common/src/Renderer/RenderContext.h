@@ -32,6 +32,7 @@ namespace TrenchBroom {
         class Camera;
         class FontManager;
         class Renderable;
+        class RenderProfiler;
         class ShaderManager;
         
         class RenderContext {
@@ -78,6 +79,8 @@ namespace TrenchBroom {
             bool m_tintSelection;
             
             ShowSelectionGuide m_showSelectionGuide;
+
+            RenderProfiler* m_profiler;
         public:
             RenderContext(RenderMode renderMode, const Camera& camera, FontManager& fontManager, ShaderManager& shaderManager);
 
@@ -139,6 +142,12 @@ namespace TrenchBroom {
             void setHideSelectionGuide();
             void setForceShowSelectionGuide();
             void setForceHideSelectionGuide();
+
+            /**
+             * Returns the profiler that records the timings of the current frame, or null if profiling is disabled.
+             */
+            RenderProfiler* profiler() const;
+            void setProfiler(RenderProfiler* profiler);
         private:
             void setShowSelectionGuide(ShowSelectionGuide showSelectionGuide);
         private:
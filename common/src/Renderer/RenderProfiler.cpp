@@ -0,0 +1,249 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RenderProfiler.h"
+
+#include "StringUtils.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static double millisecondsBetween(const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end) {
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        }
+
+        RenderProfiler::Section::Section(const char* i_name, const size_t i_depth) :
+        name(i_name),
+        depth(i_depth),
+        time(0.0) {}
+
+        RenderProfiler::Frame::Frame() :
+        time(0.0),
+        gpuTime(-1.0) {}
+
+        bool RenderProfiler::Frame::hasGpuTime() const {
+            return gpuTime >= 0.0;
+        }
+
+        RenderProfiler::OpenSection::OpenSection(const size_t i_index, const Clock::time_point i_start) :
+        index(i_index),
+        start(i_start) {}
+
+        RenderProfiler::PendingQuery::PendingQuery(const GLuint i_query, const size_t i_frameNo) :
+        query(i_query),
+        frameNo(i_frameNo) {}
+
+        RenderProfiler::RenderProfiler(const size_t capacity) :
+        m_capacity(capacity),
+        m_frames(capacity),
+        m_frameNo(0),
+        m_frameOpen(false),
+        m_gpuTimerSupport(GpuTimer_Unknown),
+        m_activeQuery(0) {
+            assert(m_capacity > 0);
+        }
+
+        size_t RenderProfiler::frameCount() const {
+            return std::min(m_frameNo, m_capacity);
+        }
+
+        const RenderProfiler::Frame& RenderProfiler::frame(const size_t index) const {
+            assert(index < frameCount());
+            return m_frames[(m_frameNo - 1 - index) % m_capacity];
+        }
+
+        void RenderProfiler::clear() {
+            std::vector<GLuint> queries = m_freeQueries;
+            for (const PendingQuery& pending : m_pendingQueries)
+                queries.push_back(pending.query);
+            if (m_activeQuery != 0) {
+                glAssert(glEndQuery(GL_TIME_ELAPSED));
+                queries.push_back(m_activeQuery);
+            }
+            if (!queries.empty())
+                glAssert(glDeleteQueries(static_cast<GLsizei>(queries.size()), &queries.front()));
+
+            m_freeQueries.clear();
+            m_pendingQueries.clear();
+            m_activeQuery = 0;
+            m_gpuTimerSupport = GpuTimer_Unknown;
+
+            m_frames = std::vector<Frame>(m_capacity);
+            m_frameNo = 0;
+            m_frameOpen = false;
+            m_currentFrame = Frame();
+            m_openSections.clear();
+        }
+
+        void RenderProfiler::beginFrame() {
+            if (m_frameOpen)
+                endFrame();
+
+            collectGpuTimes();
+
+            m_currentFrame = Frame();
+            m_openSections.clear();
+            m_frameOpen = true;
+            m_frameStart = Clock::now();
+        }
+
+        void RenderProfiler::endFrame() {
+            if (!m_frameOpen)
+                return;
+
+            while (!m_openSections.empty())
+                endSection();
+            if (m_activeQuery != 0)
+                endGpuTimer();
+
+            m_currentFrame.time = millisecondsBetween(m_frameStart, Clock::now());
+
+            using std::swap;
+            swap(m_frames[m_frameNo % m_capacity], m_currentFrame);
+            ++m_frameNo;
+            m_frameOpen = false;
+        }
+
+        void RenderProfiler::beginSection(const char* name) {
+            if (!m_frameOpen)
+                return;
+
+            m_currentFrame.sections.push_back(Section(name, m_openSections.size()));
+            m_openSections.push_back(OpenSection(m_currentFrame.sections.size() - 1, Clock::now()));
+        }
+
+        void RenderProfiler::endSection() {
+            if (!m_frameOpen || m_openSections.empty())
+                return;
+
+            const OpenSection& open = m_openSections.back();
+            m_currentFrame.sections[open.index].time = millisecondsBetween(open.start, Clock::now());
+            m_openSections.pop_back();
+        }
+
+        void RenderProfiler::beginGpuTimer() {
+            if (!m_frameOpen || m_activeQuery != 0)
+                return;
+
+            if (m_gpuTimerSupport == GpuTimer_Unknown)
+                m_gpuTimerSupport = glSupportsTimerQueries() ? GpuTimer_Supported : GpuTimer_Unsupported;
+            if (m_gpuTimerSupport != GpuTimer_Supported)
+                return;
+
+            m_activeQuery = acquireQuery();
+            glAssert(glBeginQuery(GL_TIME_ELAPSED, m_activeQuery));
+        }
+
+        void RenderProfiler::endGpuTimer() {
+            if (m_activeQuery == 0)
+                return;
+
+            glAssert(glEndQuery(GL_TIME_ELAPSED));
+            m_pendingQueries.push_back(PendingQuery(m_activeQuery, m_frameNo));
+            m_activeQuery = 0;
+        }
+
+        AttrString RenderProfiler::report() const {
+            AttrString result;
+            if (frameCount() == 0)
+                return result;
+
+            const Frame& last = frame(0);
+
+            double totalTime = 0.0;
+            double maxTime = 0.0;
+            double totalGpuTime = 0.0;
+            size_t gpuFrameCount = 0;
+            for (size_t i = 0; i < frameCount(); ++i) {
+                const Frame& current = frame(i);
+                totalTime += current.time;
+                maxTime = std::max(maxTime, current.time);
+                if (current.hasGpuTime()) {
+                    totalGpuTime += current.gpuTime;
+                    ++gpuFrameCount;
+                }
+            }
+
+            StringStream str;
+            str << std::fixed << std::setprecision(2);
+            str << "Frame: " << totalTime / static_cast<double>(frameCount()) << " ms avg, " << maxTime << " ms max (" << frameCount() << " frames)";
+            result.appendLeftJustified(str.str());
+
+            if (gpuFrameCount > 0) {
+                str.str("");
+                str << "GPU: " << totalGpuTime / static_cast<double>(gpuFrameCount) << " ms avg";
+                result.appendLeftJustified(str.str());
+            }
+
+            for (const Section& section : last.sections) {
+                str.str("");
+                str << String(2 * section.depth, ' ') << section.name << ": " << section.time << " ms";
+                result.appendLeftJustified(str.str());
+            }
+
+            return result;
+        }
+
+        void RenderProfiler::collectGpuTimes() {
+            // queries complete in the order in which they were issued
+            while (!m_pendingQueries.empty()) {
+                const PendingQuery& pending = m_pendingQueries.front();
+
+                GLint available = 0;
+                glAssert(glGetQueryObjectiv(pending.query, GL_QUERY_RESULT_AVAILABLE, &available));
+                if (available == 0)
+                    break;
+
+                GLuint nanoseconds = 0;
+                glAssert(glGetQueryObjectuiv(pending.query, GL_QUERY_RESULT, &nanoseconds));
+                if (m_frameNo - pending.frameNo <= m_capacity)
+                    m_frames[pending.frameNo % m_capacity].gpuTime = static_cast<double>(nanoseconds) / 1000000.0;
+
+                m_freeQueries.push_back(pending.query);
+                m_pendingQueries.pop_front();
+            }
+        }
+
+        GLuint RenderProfiler::acquireQuery() {
+            if (m_freeQueries.empty()) {
+                GLuint query = 0;
+                glAssert(glGenQueries(1, &query));
+                return query;
+            }
+
+            const GLuint query = m_freeQueries.back();
+            m_freeQueries.pop_back();
+            return query;
+        }
+
+        ProfileScope::ProfileScope(RenderProfiler* profiler, const char* name) :
+        m_profiler(profiler) {
+            if (m_profiler != nullptr)
+                m_profiler->beginSection(name);
+        }
+
+        ProfileScope::~ProfileScope() {
+            if (m_profiler != nullptr)
+                m_profiler->endSection();
+        }
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_RenderProfiler
+#define TrenchBroom_RenderProfiler
+
+#include "AttrString.h"
+#include "Renderer/GL.h"
+
+#include <chrono>
+#include <list>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        /**
+         * Records hierarchical CPU timings of the sections of a frame and, where the driver supports timer queries,
+         * the GPU time spent executing the GL commands of a frame. The most recent frames are kept in a ring buffer.
+         *
+         * The profiler is passed to the renderers via the render context, which holds a null pointer if profiling
+         * is disabled. Use ProfileScope to time a section; it does nothing if the given profiler is null.
+         */
+        class RenderProfiler {
+        public:
+            struct Section {
+                const char* name;
+                size_t depth;
+                double time;
+
+                Section(const char* i_name, size_t i_depth);
+            };
+
+            typedef std::vector<Section> SectionList;
+
+            struct Frame {
+                SectionList sections;
+                double time;
+                double gpuTime;
+
+                Frame();
+                bool hasGpuTime() const;
+            };
+
+            static const size_t DefaultCapacity = 120;
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            struct OpenSection {
+                size_t index;
+                Clock::time_point start;
+
+                OpenSection(size_t i_index, Clock::time_point i_start);
+            };
+
+            struct PendingQuery {
+                GLuint query;
+                size_t frameNo;
+
+                PendingQuery(GLuint i_query, size_t i_frameNo);
+            };
+
+            typedef enum {
+                GpuTimer_Unknown,
+                GpuTimer_Supported,
+                GpuTimer_Unsupported
+            } GpuTimerSupport;
+
+            size_t m_capacity;
+            std::vector<Frame> m_frames;
+            size_t m_frameNo;
+
+            bool m_frameOpen;
+            Frame m_currentFrame;
+            Clock::time_point m_frameStart;
+            std::vector<OpenSection> m_openSections;
+
+            GpuTimerSupport m_gpuTimerSupport;
+            std::vector<GLuint> m_freeQueries;
+            std::list<PendingQuery> m_pendingQueries;
+            GLuint m_activeQuery;
+        public:
+            explicit RenderProfiler(size_t capacity = DefaultCapacity);
+
+            /**
+             * Returns the number of recorded frames, which is at most the capacity of the ring buffer.
+             */
+            size_t frameCount() const;
+
+            /**
+             * Returns a recorded frame. Index 0 is the most recently completed frame.
+             */
+            const Frame& frame(size_t index) const;
+
+            /**
+             * Discards all recorded frames and releases the timer queries. Must be called with the GL context that
+             * was current while the frames were recorded.
+             */
+            void clear();
+
+            void beginFrame();
+            void endFrame();
+
+            void beginSection(const char* name);
+            void endSection();
+
+            /**
+             * Starts measuring the GPU time of the GL commands issued until endGpuTimer is called. Only one GPU
+             * timer can be active per frame; the result becomes available in a later frame.
+             */
+            void beginGpuTimer();
+            void endGpuTimer();
+
+            /**
+             * Formats the most recent frame and the average and maximum frame times of all recorded frames.
+             */
+            AttrString report() const;
+        private:
+            void collectGpuTimes();
+            GLuint acquireQuery();
+
+            RenderProfiler(const RenderProfiler& other);
+            RenderProfiler& operator=(const RenderProfiler& other);
+        };
+
+        class ProfileScope {
+        private:
+            RenderProfiler* m_profiler;
+        public:
+            ProfileScope(RenderProfiler* profiler, const char* name);
+            ~ProfileScope();
+        private:
+            ProfileScope(const ProfileScope& other);
+            ProfileScope& operator=(const ProfileScope& other);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_RenderProfiler) */
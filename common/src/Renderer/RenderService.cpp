@@ -55,6 +55,23 @@ namespace TrenchBroom {
             }
         };
         
+        class RenderService::OverlayTextAnchor : public TextAnchor {
+        private:
+            Vec3f offset(const Camera& camera, const Vec2f& size) const override {
+                Vec3f off = getOffset(camera);
+                return Vec3f(off.x(), off.y() - size.y(), off.z());
+            }
+            
+            Vec3f position(const Camera& camera) const override {
+                return camera.unproject(getOffset(camera));
+            }
+            
+            Vec3f getOffset(const Camera& camera) const {
+                const float h(camera.unzoomedViewport().height);
+                return Vec3f(10.0f, h - 10.0f, 0.0f);
+            }
+        };
+        
         RenderService::RenderService(RenderContext& renderContext, RenderBatch& renderBatch) :
         m_renderContext(renderContext),
         m_renderBatch(renderBatch),
@@ -114,10 +131,29 @@ namespace TrenchBroom {
                 m_textRenderer->renderString(m_renderContext, m_foregroundColor, m_backgroundColor, string, position);
         }
 
+        const FontDescriptor& RenderService::fontDescriptor() const {
+            return m_textRenderer->fontDescriptor();
+        }
+
+        TextLayout RenderService::layoutString(const AttrString& string) const {
+            return m_textRenderer->layout(m_renderContext, string);
+        }
+
+        void RenderService::renderString(const TextLayout& layout, const TextAnchor& position) {
+            if (m_occlusionPolicy != PrimitiveRenderer::OP_Hide)
+                m_textRenderer->renderStringOnTop(m_renderContext, m_foregroundColor, m_backgroundColor, layout, position);
+            else
+                m_textRenderer->renderString(m_renderContext, m_foregroundColor, m_backgroundColor, layout, position);
+        }
+
         void RenderService::renderHeadsUp(const AttrString& string) {
             m_textRenderer->renderStringOnTop(m_renderContext, m_foregroundColor, m_backgroundColor, string, HeadsUpTextAnchor());
         }
 
+        void RenderService::renderOverlay(const AttrString& string) {
+            m_textRenderer->renderStringOnTop(m_renderContext, m_foregroundColor, m_backgroundColor, string, OverlayTextAnchor());
+        }
+
         void RenderService::renderHandles(const Vec3f::List& positions) {
             for (const Vec3f& position : positions)
                 renderHandle(position);
@@ -37,6 +37,7 @@ namespace TrenchBroom {
         class RenderContext;
         class TextAnchor;
         class TextRenderer;
+        struct TextLayout;
         class Vbo;
         
         class RenderService {
@@ -44,6 +45,7 @@ namespace TrenchBroom {
             typedef PrimitiveRenderer::OcclusionPolicy OcclusionPolicy;
             typedef PrimitiveRenderer::CullingPolicy CullingPolicy;
             class HeadsUpTextAnchor;
+            class OverlayTextAnchor;
             
             RenderContext& m_renderContext;
             RenderBatch& m_renderBatch;
@@ -73,7 +75,16 @@ namespace TrenchBroom {
             
             void renderString(const AttrString& string, const Vec3f& position);
             void renderString(const AttrString& string, const TextAnchor& position);
+            
+            const FontDescriptor& fontDescriptor() const;
+            /**
+             * Lays out the given string in the font used by this render service. The returned layout can be cached
+             * and passed to renderString in later frames as long as the font does not change.
+             */
+            TextLayout layoutString(const AttrString& string) const;
+            void renderString(const TextLayout& layout, const TextAnchor& position);
             void renderHeadsUp(const AttrString& string);
+            void renderOverlay(const AttrString& string);
             
             void renderHandles(const Vec3f::List& positions);
             void renderHandle(const Vec3f& position);
@@ -29,7 +29,8 @@ namespace TrenchBroom {
             const ShaderConfig VaryingPUniformCShader     = ShaderConfig("Varying Position / Uniform Color", "VaryingPUniformC.vertsh",     "VaryingPC.fragsh");
             const ShaderConfig MiniMapEdgeShader          = ShaderConfig("MiniMap Edges",                    "MiniMapEdge.vertsh",          "MiniMapEdge.fragsh");
             const ShaderConfig EntityModelShader          = ShaderConfig("Entity Model",                     "EntityModel.vertsh",          "EntityModel.fragsh");
-            const ShaderConfig FaceShader                 = ShaderConfig("Face",                             "Face.vertsh",                 VectorUtils::create<String>("Grid.fragsh", "Face.fragsh"));
+            const ShaderConfig FaceShader                 = ShaderConfig("Face",                             "Face.vertsh",                 VectorUtils::create<String>("Grid.fragsh", "FaceTexture.fragsh", "Face.fragsh"));
+            const ShaderConfig FaceArrayShader            = ShaderConfig("Face Array",                       "Face.vertsh",                 VectorUtils::create<String>("Grid.fragsh", "FaceTextureArray.fragsh", "Face.fragsh"));
             const ShaderConfig ColoredTextShader          = ShaderConfig("Colored Text",                     "ColoredText.vertsh",          "Text.fragsh");
             const ShaderConfig TextShader                 = ShaderConfig("Text",                             "Text.vertsh",                 "Text.fragsh");
             const ShaderConfig TextBackgroundShader       = ShaderConfig("Text Background",                  "TextBackground.vertsh",       "TextBackground.fragsh");
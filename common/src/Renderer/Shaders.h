@@ -31,6 +31,7 @@ namespace TrenchBroom {
             extern const ShaderConfig MiniMapEdgeShader;
             extern const ShaderConfig EntityModelShader;
             extern const ShaderConfig FaceShader;
+            extern const ShaderConfig FaceArrayShader;
             extern const ShaderConfig ColoredTextShader;
             extern const ShaderConfig TextBackgroundShader;
             extern const ShaderConfig TextureBrowserShader;
@@ -24,6 +24,7 @@
 #include "Renderer/Camera.h"
 #include "Renderer/FontManager.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/RenderUtils.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Shaders.h"
@@ -65,22 +66,60 @@ namespace TrenchBroom {
             renderString(renderContext, textColor, backgroundColor, string, position, true);
         }
 
+        const FontDescriptor& TextRenderer::fontDescriptor() const {
+            return m_fontDescriptor;
+        }
+
+        TextLayout TextRenderer::layout(RenderContext& renderContext, const AttrString& string) const {
+            FontManager& fontManager = renderContext.fontManager();
+            TextureFont& font = fontManager.font(m_fontDescriptor);
+
+            TextLayout result;
+            result.vertices = font.quads(string, true);
+            result.size = font.measure(string);
+            return result;
+        }
+
+        void TextRenderer::renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position) {
+            renderString(renderContext, textColor, backgroundColor, layout, position, false);
+        }
+
+        void TextRenderer::renderStringOnTop(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position) {
+            renderString(renderContext, textColor, backgroundColor, layout, position, true);
+        }
+
         void TextRenderer::renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position, const bool onTop) {
             
             const Camera& camera = renderContext.camera();
             const float distance = camera.perpendicularDistanceTo(position.position(camera));
-            if (distance <= 0.0f)
+            if (!isInRange(renderContext, distance, onTop))
                 return;
             
-            if (!isVisible(renderContext, string, position, distance, onTop))
+            // measure first so that the glyph quads are only built for strings that are actually visible
+            if (!isVisible(renderContext, stringSize(renderContext, string), position))
                 return;
             
-            FontManager& fontManager = renderContext.fontManager();
-            TextureFont& font = fontManager.font(m_fontDescriptor);
+            TextLayout stringLayout = layout(renderContext, string);
+            addEntry(renderContext, textColor, backgroundColor, stringLayout.vertices, stringLayout.size, position, distance, onTop);
+        }
 
-            Vec2f::List vertices = font.quads(string, true);
+        void TextRenderer::renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position, const bool onTop) {
+            
+            const Camera& camera = renderContext.camera();
+            const float distance = camera.perpendicularDistanceTo(position.position(camera));
+            if (!isInRange(renderContext, distance, onTop))
+                return;
+            
+            if (!isVisible(renderContext, layout.size.rounded(), position))
+                return;
+            
+            Vec2f::List vertices = layout.vertices;
+            addEntry(renderContext, textColor, backgroundColor, vertices, layout.size, position, distance, onTop);
+        }
+
+        void TextRenderer::addEntry(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, Vec2f::List& vertices, const Vec2f& size, const TextAnchor& position, const float distance, const bool onTop) {
+            const Camera& camera = renderContext.camera();
             const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-            const Vec2f size = font.measure(string);
             const Vec3f offset = position.offset(camera, size);
             
             if (onTop)
@@ -93,18 +132,23 @@ namespace TrenchBroom {
                                           Color(backgroundColor, alphaFactor * backgroundColor.a())));
         }
 
-        bool TextRenderer::isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, const float distance, const bool onTop) const {
+        bool TextRenderer::isInRange(RenderContext& renderContext, const float distance, const bool onTop) const {
+            if (distance <= 0.0f)
+                return false;
+            
             if (!onTop) {
                 if (renderContext.render3D() && distance > m_maxViewDistance)
                     return false;
                 if (renderContext.render2D() && renderContext.camera().zoom() < m_minZoomFactor)
                     return false;
             }
-            
+            return true;
+        }
+
+        bool TextRenderer::isVisible(RenderContext& renderContext, const Vec2f& size, const TextAnchor& position) const {
             const Camera& camera = renderContext.camera();
             const Camera::Viewport& viewport = camera.unzoomedViewport();
             
-            const Vec2f size = stringSize(renderContext, string);
             const Vec2f offset = Vec2f(position.offset(camera, size)) - m_inset;
             const Vec2f actualSize = size + 2.0f * m_inset;
             
@@ -186,6 +230,8 @@ namespace TrenchBroom {
         }
 
         void TextRenderer::doRender(RenderContext& renderContext) {
+            ProfileScope scope(renderContext.profiler(), "Text");
+
             const Camera::Viewport& viewport = renderContext.camera().unzoomedViewport();
             const Mat4x4f projection = orthoMatrix(0.0f, 1.0f,
                                                    static_cast<float>(viewport.x),
@@ -36,6 +36,16 @@ namespace TrenchBroom {
     namespace Renderer {
         class RenderContext;
         class TextAnchor;
+
+        /**
+         * The glyph quads and the size of a string, laid out at the origin. A layout does not depend on the camera,
+         * so it can be computed once and rendered at different anchors in many frames, as long as the font stays
+         * the same.
+         */
+        struct TextLayout {
+            Vec2f::List vertices;
+            Vec2f size;
+        };
         
         class TextRenderer : public DirectRenderable {
         private:
@@ -83,10 +93,18 @@ namespace TrenchBroom {
             
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position);
             void renderStringOnTop(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position);
+
+            const FontDescriptor& fontDescriptor() const;
+            TextLayout layout(RenderContext& renderContext, const AttrString& string) const;
+            void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position);
+            void renderStringOnTop(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position);
         private:
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position, bool onTop);
-            
-            bool isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, float distance, bool onTop) const;
+            void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const TextLayout& layout, const TextAnchor& position, bool onTop);
+            void addEntry(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, Vec2f::List& vertices, const Vec2f& size, const TextAnchor& position, float distance, bool onTop);
+
+            bool isInRange(RenderContext& renderContext, float distance, bool onTop) const;
+            bool isVisible(RenderContext& renderContext, const Vec2f& size, const TextAnchor& position) const;
             float computeAlphaFactor(const RenderContext& renderContext, float distance, bool onTop) const;
             void addEntry(EntryCollection& collection, const Entry& entry);
             
@@ -0,0 +1,291 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskScheduler.h"
+
+#include <cassert>
+#include <chrono>
+#include <limits>
+
+namespace TrenchBroom {
+    static const size_t NoWorker = std::numeric_limits<size_t>::max();
+
+    // the scheduler and index of the worker that runs on the current thread, if any
+    static thread_local const TaskScheduler* t_scheduler = nullptr;
+    static thread_local size_t t_workerIndex = NoWorker;
+
+    TaskScheduler& TaskScheduler::instance() {
+        static TaskScheduler instance(std::max(2u, std::thread::hardware_concurrency()) - 1);
+        return instance;
+    }
+
+    TaskScheduler::TaskScheduler(const size_t workerCount) :
+    m_queuedTaskCount(0),
+    m_stopped(false) {
+        const size_t count = std::max(static_cast<size_t>(1), workerCount);
+        for (size_t i = 0; i < count; ++i)
+            m_workers.push_back(std::make_unique<Worker>());
+
+        m_threads.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            m_threads.push_back(std::thread([this, i]() { work(i); }));
+    }
+
+    TaskScheduler::~TaskScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_wakeUp.notify_all();
+
+        for (std::thread& thread : m_threads)
+            thread.join();
+    }
+
+    size_t TaskScheduler::workerCount() const {
+        return m_workers.size();
+    }
+
+    void TaskScheduler::submit(Task task) {
+        if (t_scheduler == this) {
+            Worker& worker = *m_workers[t_workerIndex];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        } else {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_submittedTasks.push_back(std::move(task));
+        }
+        ++m_queuedTaskCount;
+
+        // lock the mutex so that the notification cannot get lost between a worker's check for queued tasks and its
+        // call to wait
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wakeUp.notify_one();
+    }
+
+    bool TaskScheduler::runQueuedTask() {
+        const size_t workerIndex = t_scheduler == this ? t_workerIndex : NoWorker;
+
+        Task task;
+        if (!takeTask(workerIndex, task))
+            return false;
+
+        task();
+        return true;
+    }
+
+    void TaskScheduler::setMainThreadNotifier(MainThreadNotifier notifier) {
+        std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+        m_mainThreadNotifier = std::move(notifier);
+    }
+
+    void TaskScheduler::postToMainThread(Task task) {
+        MainThreadNotifier notifier;
+        {
+            std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+            if (m_mainThreadTasks.empty())
+                notifier = m_mainThreadNotifier;
+            m_mainThreadTasks.push_back(std::move(task));
+        }
+
+        if (notifier)
+            notifier();
+    }
+
+    size_t TaskScheduler::processMainThreadTasks() {
+        std::vector<Task> tasks;
+        {
+            std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+            using std::swap;
+            swap(tasks, m_mainThreadTasks);
+        }
+
+        for (Task& task : tasks)
+            task();
+        return tasks.size();
+    }
+
+    size_t TaskScheduler::chunkCount(const size_t count, const size_t grainSize) const {
+        // a few chunks per thread so that threads which finish early can steal the remaining ones
+        const size_t maxChunks = 4 * (workerCount() + 1);
+        const size_t chunks = (count + std::max(static_cast<size_t>(1), grainSize) - 1) / std::max(static_cast<size_t>(1), grainSize);
+        return std::max(static_cast<size_t>(1), std::min(chunks, maxChunks));
+    }
+
+    bool TaskScheduler::takeTask(const size_t workerIndex, Task& task) {
+        if (m_queuedTaskCount == 0)
+            return false;
+
+        if (takeOwnTask(workerIndex, task) || takeSubmittedTask(task) || stealTask(workerIndex, task)) {
+            --m_queuedTaskCount;
+            return true;
+        }
+        return false;
+    }
+
+    bool TaskScheduler::takeOwnTask(const size_t workerIndex, Task& task) {
+        if (workerIndex == NoWorker)
+            return false;
+
+        Worker& worker = *m_workers[workerIndex];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.tasks.empty())
+            return false;
+
+        // the most recently submitted task is the most likely to find its data in the cache
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+        return true;
+    }
+
+    bool TaskScheduler::takeSubmittedTask(Task& task) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_submittedTasks.empty())
+            return false;
+
+        task = std::move(m_submittedTasks.front());
+        m_submittedTasks.pop_front();
+        return true;
+    }
+
+    bool TaskScheduler::stealTask(const size_t workerIndex, Task& task) {
+        const size_t count = m_workers.size();
+        const size_t first = workerIndex == NoWorker ? 0 : workerIndex + 1;
+
+        for (size_t i = 0; i < count; ++i) {
+            const size_t victimIndex = (first + i) % count;
+            if (victimIndex == workerIndex)
+                continue;
+
+            // steal the oldest task, which is usually the biggest one if tasks split their work recursively
+            Worker& victim = *m_workers[victimIndex];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void TaskScheduler::work(const size_t workerIndex) {
+        t_scheduler = this;
+        t_workerIndex = workerIndex;
+
+        while (true) {
+            Task task;
+            if (takeTask(workerIndex, task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_stopped && m_queuedTaskCount == 0)
+                return;
+            m_wakeUp.wait(lock, [this]() { return m_stopped || m_queuedTaskCount > 0; });
+        }
+    }
+
+    TaskGroup::TaskGroup(TaskScheduler& scheduler) :
+    m_scheduler(scheduler),
+    m_taskCount(0) {}
+
+    TaskGroup::~TaskGroup() {
+        waitForTasks();
+    }
+
+    void TaskGroup::run(TaskScheduler::Task task) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_taskCount;
+        }
+
+        m_scheduler.submit([this, task]() {
+            try {
+                task();
+                taskFinished(nullptr);
+            } catch (...) {
+                taskFinished(std::current_exception());
+            }
+        });
+    }
+
+    void TaskGroup::then(TaskScheduler::Task continuation) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_taskCount > 0) {
+                m_continuations.push_back(std::move(continuation));
+                return;
+            }
+        }
+        m_scheduler.submit(std::move(continuation));
+    }
+
+    void TaskGroup::wait() {
+        waitForTasks();
+
+        std::exception_ptr exception;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            using std::swap;
+            swap(exception, m_exception);
+        }
+
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    bool TaskGroup::finished() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_taskCount == 0;
+    }
+
+    void TaskGroup::taskFinished(std::exception_ptr exception) {
+        // everything that touches this group happens while the mutex is locked because the group may be destroyed
+        // as soon as a waiting thread sees that the last task has finished
+        TaskScheduler& scheduler = m_scheduler;
+        std::vector<TaskScheduler::Task> continuations;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (exception && !m_exception)
+                m_exception = exception;
+
+            assert(m_taskCount > 0);
+            if (--m_taskCount == 0) {
+                using std::swap;
+                swap(continuations, m_continuations);
+                m_finished.notify_all();
+            }
+        }
+
+        for (TaskScheduler::Task& continuation : continuations)
+            scheduler.submit(std::move(continuation));
+    }
+
+    void TaskGroup::waitForTasks() {
+        while (!finished()) {
+            if (!m_scheduler.runQueuedTask()) {
+                // nothing to help with, the remaining tasks are running on other threads
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_finished.wait_for(lock, std::chrono::milliseconds(1), [this]() { return m_taskCount == 0; });
+            }
+        }
+    }
+}
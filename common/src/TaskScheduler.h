@@ -0,0 +1,235 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_TaskScheduler
+#define TrenchBroom_TaskScheduler
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    /**
+     * A pool of worker threads that execute tasks. Every worker owns a queue of tasks. Tasks that are submitted by a
+     * worker go to the back of its own queue, and the worker takes its next task from there, too. A worker whose queue
+     * is empty takes tasks that were submitted by other threads, and then steals tasks from the front of the queues
+     * of the other workers.
+     *
+     * Threads that wait for tasks, e.g. in TaskGroup::wait, help with the work instead of blocking, so tasks may
+     * submit further tasks and wait for them without running out of threads.
+     *
+     * Tasks that must run on the main thread, such as anything that touches the UI, can be posted to the main thread
+     * queue. The application drains that queue from its event loop when it is notified of new tasks.
+     */
+    class TaskScheduler {
+    public:
+        typedef std::function<void()> Task;
+        typedef std::function<void()> MainThreadNotifier;
+    private:
+        struct Worker {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wakeUp;
+        std::deque<Task> m_submittedTasks;
+        std::atomic<size_t> m_queuedTaskCount;
+        bool m_stopped;
+
+        std::mutex m_mainThreadMutex;
+        std::vector<Task> m_mainThreadTasks;
+        MainThreadNotifier m_mainThreadNotifier;
+    public:
+        /**
+         * Returns the scheduler that is shared by the entire application. It has one worker thread less than there
+         * are hardware threads because the main thread helps while it waits for tasks.
+         */
+        static TaskScheduler& instance();
+
+        /**
+         * Creates a scheduler with the given number of worker threads. At least one worker is created.
+         */
+        explicit TaskScheduler(size_t workerCount);
+        ~TaskScheduler();
+
+        size_t workerCount() const;
+
+        /**
+         * Queues the given task for execution on a worker thread. The task must not throw; use a TaskGroup to run
+         * tasks that may throw.
+         */
+        void submit(Task task);
+
+        /**
+         * Executes one queued task on the calling thread if there is one.
+         *
+         * @return true if a task was executed and false otherwise
+         */
+        bool runQueuedTask();
+
+        /**
+         * Sets the function that is called when a task is posted to the empty main thread queue. The function may be
+         * called on any thread and should arrange for processMainThreadTasks to be called on the main thread.
+         */
+        void setMainThreadNotifier(MainThreadNotifier notifier);
+
+        /**
+         * Queues the given task for execution on the main thread.
+         */
+        void postToMainThread(Task task);
+
+        /**
+         * Executes the tasks in the main thread queue in the order in which they were posted. Must be called on the
+         * main thread.
+         *
+         * @return the number of executed tasks
+         */
+        size_t processMainThreadTasks();
+
+        /**
+         * Calls the given function for every index in [begin, end) and returns when all calls have finished. The
+         * range is split into chunks of at least the given grain size which are processed concurrently, so the
+         * function must only write to state that belongs to its index. If a call throws, the first exception is
+         * rethrown on the calling thread after the other chunks have finished.
+         */
+        template <typename F>
+        void parallelFor(size_t begin, size_t end, F&& function, size_t grainSize = 1);
+
+        /**
+         * Maps every index in [begin, end) to a value and combines the values, starting with the given identity. The
+         * combine function must be associative. The values are combined in index order within chunks and the chunk
+         * results are combined in chunk order, so the result does not depend on the scheduling.
+         */
+        template <typename T, typename M, typename C>
+        T parallelReduce(size_t begin, size_t end, T identity, M&& map, C&& combine, size_t grainSize = 1);
+    private:
+        size_t chunkCount(size_t count, size_t grainSize) const;
+
+        bool takeTask(size_t workerIndex, Task& task);
+        bool takeOwnTask(size_t workerIndex, Task& task);
+        bool takeSubmittedTask(Task& task);
+        bool stealTask(size_t workerIndex, Task& task);
+        void work(size_t workerIndex);
+
+        TaskScheduler(const TaskScheduler& other);
+        TaskScheduler& operator=(const TaskScheduler& other);
+    };
+
+    /**
+     * A set of tasks that can be waited for as a whole. Exceptions thrown by the tasks are caught, and the first one
+     * is rethrown by wait. Continuations are submitted to the scheduler once all tasks have finished. The destructor
+     * waits for the remaining tasks, but it does not rethrow exceptions.
+     */
+    class TaskGroup {
+    private:
+        TaskScheduler& m_scheduler;
+        std::mutex m_mutex;
+        std::condition_variable m_finished;
+        size_t m_taskCount;
+        std::exception_ptr m_exception;
+        std::vector<TaskScheduler::Task> m_continuations;
+    public:
+        explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::instance());
+        ~TaskGroup();
+
+        void run(TaskScheduler::Task task);
+
+        /**
+         * Submits the given task once all tasks of this group have finished. If the group has no running tasks, the
+         * continuation is submitted immediately.
+         */
+        void then(TaskScheduler::Task continuation);
+
+        /**
+         * Executes queued tasks on the calling thread until all tasks of this group have finished, and rethrows the
+         * first exception thrown by any of them.
+         */
+        void wait();
+    private:
+        bool finished();
+        void taskFinished(std::exception_ptr exception);
+        void waitForTasks();
+
+        TaskGroup(const TaskGroup& other);
+        TaskGroup& operator=(const TaskGroup& other);
+    };
+
+    template <typename F>
+    void TaskScheduler::parallelFor(const size_t begin, const size_t end, F&& function, const size_t grainSize) {
+        if (begin >= end)
+            return;
+
+        const size_t count = end - begin;
+        const size_t chunks = chunkCount(count, grainSize);
+        if (chunks == 1) {
+            for (size_t i = begin; i < end; ++i)
+                function(i);
+            return;
+        }
+
+        TaskGroup group(*this);
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            const size_t chunkBegin = begin + count * chunk / chunks;
+            const size_t chunkEnd = begin + count * (chunk + 1) / chunks;
+            group.run([&function, chunkBegin, chunkEnd]() {
+                for (size_t i = chunkBegin; i < chunkEnd; ++i)
+                    function(i);
+            });
+        }
+        group.wait();
+    }
+
+    template <typename T, typename M, typename C>
+    T TaskScheduler::parallelReduce(const size_t begin, const size_t end, T identity, M&& map, C&& combine, const size_t grainSize) {
+        if (begin >= end)
+            return identity;
+
+        const size_t count = end - begin;
+        const size_t chunks = chunkCount(count, grainSize);
+
+        // not a vector because the chunks write their results concurrently, which is not safe for std::vector<bool>
+        std::deque<T> results(chunks, identity);
+        parallelFor(0, chunks, [&](const size_t chunk) {
+            const size_t chunkBegin = begin + count * chunk / chunks;
+            const size_t chunkEnd = begin + count * (chunk + 1) / chunks;
+            T result = identity;
+            for (size_t i = chunkBegin; i < chunkEnd; ++i)
+                result = combine(result, map(i));
+            results[chunk] = result;
+        });
+
+        T result = identity;
+        for (const T& chunkResult : results)
+            result = combine(result, chunkResult);
+        return result;
+    }
+}
+
+#endif /* defined(TrenchBroom_TaskScheduler) */
@@ -25,6 +25,7 @@
 #include "GLInit.h"
 #include "Macros.h"
 #include "RecoverableExceptions.h"
+#include "TaskScheduler.h"
 #include "TrenchBroomAppTraits.h"
 #include "TrenchBroomStackWalker.h"
 #include "IO/Path.h"
@@ -65,6 +66,13 @@ namespace TrenchBroom {
         LONG WINAPI TrenchBroomUnhandledExceptionFilter(PEXCEPTION_POINTERS pExceptionPtrs);
 #endif
 
+        class ProcessMainThreadTasks : public ExecutableEvent::Executable {
+        private:
+            void execute() override {
+                TaskScheduler::instance().processMainThreadTasks();
+            }
+        };
+
         TrenchBroomApp::TrenchBroomApp() :
         wxApp(),
         m_frameManager(nullptr),
@@ -140,10 +148,16 @@ namespace TrenchBroom {
 
             Bind(EXECUTABLE_EVENT, &TrenchBroomApp::OnExecutableEvent, this);
 
+            // tasks may be posted to the main thread from any thread, so the notification is sent through the event queue
+            TaskScheduler::instance().setMainThreadNotifier([this]() {
+                QueueEvent(new ExecutableEvent(new ProcessMainThreadTasks()));
+            });
+
             m_recentDocuments->didChangeNotifier.addObserver(recentDocumentsDidChangeNotifier);
         }
 
         TrenchBroomApp::~TrenchBroomApp() {
+            TaskScheduler::instance().setMainThreadNotifier(TaskScheduler::MainThreadNotifier());
             wxImage::CleanUpHandlers();
             
             delete m_frameManager;
@@ -242,6 +256,10 @@ namespace TrenchBroom {
 
                 frame->openDocument(game, mapFormat, path);
                 return true;
+            } catch (const OperationCancelledException& e) {
+                if (frame != nullptr)
+                    frame->Close();
+                return false;
             } catch (const FileNotFoundException& e) {
                 m_recentDocuments->removePath(IO::Path(path));
                 if (frame != nullptr)
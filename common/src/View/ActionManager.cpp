@@ -210,6 +210,7 @@ namespace TrenchBroom {
             editMenu->addModifiableActionItem(CommandIds::Menu::EditSelectInside, "Select Inside", KeyboardShortcut('E', WXK_CONTROL));
             editMenu->addModifiableActionItem(CommandIds::Menu::EditSelectTall, "Select Tall", KeyboardShortcut('E', WXK_CONTROL, WXK_SHIFT));
             editMenu->addModifiableActionItem(CommandIds::Menu::EditSelectByFilePosition, "Select by Line Number");
+            editMenu->addModifiableActionItem(CommandIds::Menu::EditSelectByTexture, "Select by Texture");
             editMenu->addModifiableActionItem(CommandIds::Menu::EditSelectNone, "Select None", KeyboardShortcut('A', WXK_CONTROL, WXK_SHIFT));
             editMenu->addSeparator();
             
@@ -281,6 +282,7 @@ namespace TrenchBroom {
             viewMenu->addModifiableCheckItem(CommandIds::Menu::ViewToggleInspector, "Toggle Inspector", KeyboardShortcut('5', WXK_CONTROL));
             viewMenu->addSeparator();
             viewMenu->addModifiableCheckItem(CommandIds::Menu::ViewToggleMaximizeCurrentView, "Maximize Current View", KeyboardShortcut(WXK_SPACE, WXK_CONTROL));
+            viewMenu->addModifiableCheckItem(CommandIds::Menu::ViewToggleFrameTimings, "Show Frame Timings");
             
             Menu* runMenu = m_menuBar->addMenu("Run");
             runMenu->addModifiableActionItem(CommandIds::Menu::RunCompile, "Compile...");
@@ -74,12 +74,14 @@ namespace TrenchBroom {
                 const int ViewToggleMaximizeCurrentView      = Lowest +  89;
                 const int ViewToggleInfoPanel                = Lowest +  90;
                 const int ViewToggleInspector                = Lowest +  91;
+                const int ViewToggleFrameTimings             = Lowest +  92;
                 
                 const int FileOpenRecent                     = Lowest +  96;
                 const int FileExportObj                      = Lowest +  97;
                 const int EditPrintFilePositions             = Lowest + 101;
                 const int EditSelectInside                   = Lowest + 103;
                 const int EditSelectTall                     = Lowest + 104;
+                const int EditSelectByTexture                = Lowest + 105;
                 const int EditRepeat                         = Lowest + 107;
                 const int EditClearRepeat                    = Lowest + 108;
                 const int ViewMoveCameraToPosition           = Lowest + 109;
@@ -93,6 +93,7 @@ namespace TrenchBroom {
             document->nodesWereRemovedNotifier.addObserver(this, &IssueBrowser::nodesWereRemoved);
             document->nodesDidChangeNotifier.addObserver(this, &IssueBrowser::nodesDidChange);
             document->brushFacesDidChangeNotifier.addObserver(this, &IssueBrowser::brushFacesDidChange);
+            m_view->issuesWereUpdatedNotifier.addObserver(this, &IssueBrowser::issuesWereUpdated);
         }
         
         void IssueBrowser::unbindObservers() {
@@ -106,6 +107,7 @@ namespace TrenchBroom {
                 document->nodesDidChangeNotifier.removeObserver(this, &IssueBrowser::nodesDidChange);
                 document->brushFacesDidChangeNotifier.removeObserver(this, &IssueBrowser::brushFacesDidChange);
             }
+            m_view->issuesWereUpdatedNotifier.removeObserver(this, &IssueBrowser::issuesWereUpdated);
         }
 
         void IssueBrowser::documentWasNewedOrLoaded(MapDocument* document) {
@@ -141,26 +143,42 @@ namespace TrenchBroom {
         void IssueBrowser::issueIgnoreChanged(Model::Issue* issue) {
             m_view->Refresh();
         }
+
+        void IssueBrowser::issuesWereUpdated() {
+            // the labels show the generator statistics, which change whenever issues are generated
+            setFilterFlags();
+            m_filterEditor->setFlagValue(~m_view->hiddenGenerators());
+        }
         
         void IssueBrowser::updateFilterFlags() {
+            setFilterFlags();
+            m_view->setHiddenGenerators(0);
+            m_filterEditor->setFlagValue(~0);
+        }
+
+        void IssueBrowser::setFilterFlags() {
             MapDocumentSPtr document = lock(m_document);
             const Model::World* world = document->world();
+            if (world == nullptr)
+                return;
+            
             const Model::IssueGeneratorList& generators = world->registeredIssueGenerators();
+            const Model::IssueGeneratorRegistry::StatsList& stats = world->issueGeneratorStats();
+            assert(generators.size() == stats.size());
             
             wxArrayInt flags;
             wxArrayString labels;
             
-            for (const Model::IssueGenerator* generator : generators) {
+            for (size_t i = 0; i < generators.size(); ++i) {
+                const Model::IssueGenerator* generator = generators[i];
                 const Model::IssueType flag = generator->type();
                 const String& description = generator->description();
                 
                 flags.push_back(flag);
-                labels.push_back(description);
+                labels.push_back(wxString::Format("%s (%lu issues, %.1f ms)", description, static_cast<unsigned long>(stats[i].issueCount), stats[i].milliseconds));
             }
 
             m_filterEditor->setFlags(flags, labels);
-            m_view->setHiddenGenerators(0);
-            m_filterEditor->setFlagValue(~0);
         }
     }
 }
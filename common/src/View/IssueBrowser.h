@@ -70,8 +70,10 @@ namespace TrenchBroom {
             void nodesDidChange(const Model::NodeList& nodes);
             void brushFacesDidChange(const Model::BrushFaceList& faces);
             void issueIgnoreChanged(Model::Issue* issue);
+            void issuesWereUpdated();
 
             void updateFilterFlags();
+            void setFilterFlags();
         };
     }
 }
@@ -168,6 +168,8 @@ namespace TrenchBroom {
             MapDocumentSPtr document = lock(m_document);
             Model::World* world = document->world();
             if (world != nullptr) {
+                world->validateAllIssues();
+                
                 const Model::IssueGeneratorList& issueGenerators = world->registeredIssueGenerators();
                 Model::CollectMatchingIssuesVisitor<IssueVisible> visitor(issueGenerators, IssueVisible(m_hiddenGenerators, m_showHiddenIssues));
                 world->acceptAndRecurse(visitor);
@@ -289,6 +291,7 @@ namespace TrenchBroom {
                 
                 updateIssues();
                 SetItemCount(static_cast<long>(m_issues.size()));
+                issuesWereUpdatedNotifier();
             }
         }
     }
@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_IssueBrowserView
 #define TrenchBroom_IssueBrowserView
 
+#include "Notifier.h"
 #include "View/ViewTypes.h"
 
 #include "Model/Issue.h"
@@ -48,6 +49,8 @@ namespace TrenchBroom {
             bool m_showHiddenIssues;
             
             bool m_valid;
+        public:
+            Notifier0 issuesWereUpdatedNotifier;
         public:
             IssueBrowserView(wxWindow* parent, MapDocumentWPtr document);
             
@@ -36,33 +36,51 @@ namespace TrenchBroom {
             m_cur = point;
         }
 
-        bool Lasso::selects(const Vec3& point, const Plane3& plane, const BBox2& box) const {
-            const Ray3 ray(m_camera.pickRay(point));
-            const FloatType hitDistance = plane.intersectWithRay(ray);
-            if (Math::isnan(hitDistance))
-                return false;
-            
-            const Vec3 hitPoint = ray.pointAtDistance(hitDistance);
-            const Vec3 projected = m_transform * hitPoint;
-            return box.contains(projected);
+        Model::SelectionRegion Lasso::region() const {
+            const BBox2 box = this->box();
+            const Vec2 size = box.size();
+            if (Math::zero(size.x()) || Math::zero(size.y()))
+                return Model::SelectionRegion();
+
+            const Mat4x4 inverted = invertedMatrix(m_transform);
+            const Vec3 center = inverted * Vec3(box.center(), 0.0);
+
+            Vec3::List corners(4);
+            corners[0] = inverted * Vec3(box.min.x(), box.min.y(), 0.0);
+            corners[1] = inverted * Vec3(box.min.x(), box.max.y(), 0.0);
+            corners[2] = inverted * Vec3(box.max.x(), box.max.y(), 0.0);
+            corners[3] = inverted * Vec3(box.max.x(), box.min.y(), 0.0);
+
+            // Each side of the lasso spans a plane with the pick ray through one of its corners, so this works for
+            // both perspective and orthographic cameras.
+            Plane3::List planes(4);
+            for (size_t i = 0; i < 4; ++i) {
+                const Vec3& p0 = corners[i];
+                const Vec3& p1 = corners[(i + 1) % 4];
+                const Vec3 direction(m_camera.pickRay(p0).direction);
+                if (!setPlanePoints(planes[i], p0, p1, p0 + direction))
+                    return Model::SelectionRegion();
+                if (planes[i].pointDistance(center) > 0.0)
+                    planes[i] = planes[i].flipped();
+            }
+
+            // The side planes of a perspective camera already exclude everything behind it, but the additional plane
+            // allows the region to reject boxes behind the camera that touch all side planes.
+            if (m_camera.perspectiveProjection())
+                planes.push_back(Plane3(Vec3(m_camera.position()), -Vec3(m_camera.direction())));
+            return Model::SelectionRegion(planes);
         }
-        
-        bool Lasso::selects(const Edge3& edge, const Plane3& plane, const BBox2& box) const {
-            return selects(edge.center(), plane, box);
+
+        bool Lasso::selects(const Vec3& point, const Model::SelectionRegion& region) const {
+            return region.contains(point);
         }
         
-        bool Lasso::selects(const Polygon3& polygon, const Plane3& plane, const BBox2& box) const {
-            return selects(polygon.center(), plane, box);
+        bool Lasso::selects(const Edge3& edge, const Model::SelectionRegion& region) const {
+            return selects(edge.center(), region);
         }
         
-        Vec3 Lasso::project(const Vec3& point, const Plane3& plane) const {
-            const Ray3 ray(m_camera.pickRay(point));
-            const FloatType hitDistance = plane.intersectWithRay(ray);
-            if (Math::isnan(hitDistance))
-                return Vec3::NaN;
-            
-            const Vec3 hitPoint = ray.pointAtDistance(hitDistance);
-            return m_transform * hitPoint;
+        bool Lasso::selects(const Polygon3& polygon, const Model::SelectionRegion& region) const {
+            return selects(polygon.center(), region);
         }
 
         void Lasso::render(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const {
@@ -84,10 +102,6 @@ namespace TrenchBroom {
             renderService.renderFilledPolygon(polygon);
         }
 
-        Plane3 Lasso::plane() const {
-            return Plane3(m_camera.defaultPoint(static_cast<float>(m_distance)), m_camera.direction());
-        }
-        
         BBox2 Lasso::box() const {
             const Vec3 start = m_transform * m_start;
             const Vec3 cur   = m_transform * m_cur;
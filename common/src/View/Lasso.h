@@ -22,6 +22,7 @@
 
 #include "TrenchBroom.h"
 #include "VecMath.h"
+#include "Model/SelectionRegion.h"
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -45,10 +46,9 @@ namespace TrenchBroom {
             
             template <typename I, typename O>
             void selected(I cur, I end, O out) const {
-                const Plane3 plane = this->plane();
-                const BBox2 box = this->box();
+                const Model::SelectionRegion region = this->region();
                 while (cur != end) {
-                    if (selects(*cur, plane, box))
+                    if (selects(*cur, region))
                         out = *cur;
                     ++cur;
                 }
@@ -56,17 +56,21 @@ namespace TrenchBroom {
             
             template <typename H>
             bool selects(const H& h) const {
-                return selects(h, plane(), box());
+                return selects(h, region());
             }
-        private:
-            bool selects(const Vec3& point, const Plane3& plane, const BBox2& box) const;
-            bool selects(const Edge3& edge, const Plane3& plane, const BBox2& box) const;
-            bool selects(const Polygon3& polygon, const Plane3& plane, const BBox2& box) const;
-            Vec3 project(const Vec3& point, const Plane3& plane) const;
+
+            /**
+             * Returns the region of space that this lasso covers, i.e., the part of the view frustum that lies behind
+             * the lasso's rectangle on the screen. The region is empty if the rectangle has no area.
+             */
+            Model::SelectionRegion region() const;
+
+            bool selects(const Vec3& point, const Model::SelectionRegion& region) const;
+            bool selects(const Edge3& edge, const Model::SelectionRegion& region) const;
+            bool selects(const Polygon3& polygon, const Model::SelectionRegion& region) const;
         public:
             void render(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const;
         private:
-            Plane3 plane() const;
             BBox2 box() const;
         };
     }
@@ -137,6 +137,7 @@ namespace TrenchBroom {
         m_lastSelectionBounds(0.0, 32.0),
         m_selectionBoundsValid(true),
         m_viewEffectsService(nullptr) {
+            m_textureManager->setUseTextureArrays(pref(Preferences::TextureArrays));
             bindObservers();
         }
         
@@ -250,11 +251,11 @@ namespace TrenchBroom {
             documentWasNewedNotifier(this);
         }
         
-        void MapDocument::loadDocument(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path) {
+        void MapDocument::loadDocument(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path, IO::ParserStatus& status) {
             info("Loading document from " + path.asString());
             
             clearDocument();
-            loadWorld(mapFormat, worldBounds, game, path);
+            loadWorld(mapFormat, worldBounds, game, path, status);
             
             loadAssets();
             registerIssueGenerators();
@@ -276,12 +277,22 @@ namespace TrenchBroom {
             m_game->writeMap(m_world, path);
         }
         
+        void MapDocument::saveMapCache(const IO::Path& path) {
+            try {
+                m_game->writeMapCache(m_world, path);
+            } catch (const Exception& e) {
+                warn("Could not write map cache: %s", e.what());
+            }
+        }
+
         void MapDocument::exportDocumentAs(const Model::ExportFormat format, const IO::Path& path) {
             m_game->exportMap(m_world, format, path);
         }
 
         void MapDocument::doSaveDocument(const IO::Path& path) {
             saveDocumentTo(path);
+            if (pref(Preferences::WriteMapCache))
+                saveMapCache(path);
             setLastSaveModificationCount();
             setPath(path);
             documentWasSavedNotifier(this);
@@ -362,11 +373,17 @@ namespace TrenchBroom {
                 unloadPointFile();
             }
 
-            m_pointFilePath = path;
-            m_pointFile = std::make_unique<Model::PointFile>(path);
+            try {
+                m_pointFilePath = path;
+                m_pointFile = std::make_unique<Model::PointFile>(path);
+            } catch (const std::exception &exception) {
+                info("Couldn't load point file " + path.asString() + ": " + exception.what());
+            }
 
-            info("Loaded point file " + path.asString());
-            pointFileWasLoadedNotifier();
+            if (isPointFileLoaded()) {
+                info("Loaded point file " + path.asString());
+                pointFileWasLoadedNotifier();
+            }
         }
         
         bool MapDocument::isPointFileLoaded() const {
@@ -548,6 +565,22 @@ namespace TrenchBroom {
             select(visitor.nodes());
         }
         
+        void MapDocument::selectFacesWithTexture(const Assets::Texture* texture) {
+            ensure(texture != nullptr, "texture is null");
+            
+            Model::BrushFaceList faces;
+            for (Model::BrushFace* face : texture->faces()) {
+                // skip the faces of brushes that are not in the map
+                const Model::Brush* brush = face->brush();
+                if (brush != nullptr && brush->parent() != nullptr && m_editorContext->selectable(face))
+                    faces.push_back(face);
+            }
+            
+            Transaction transaction(this, "Select by Texture");
+            deselectAll();
+            select(faces);
+        }
+        
         void MapDocument::select(const Model::NodeList& nodes) {
             submitAndStore(SelectionCommand::select(nodes));
         }
@@ -1086,8 +1119,20 @@ namespace TrenchBroom {
             Model::NodeList toRemove;
             toRemove.push_back(subtrahend);
             
+            // only minuends that touch the subtrahend are affected; keep them in selection order
+            const Model::NodeList intersecting = m_world->findNodesIntersecting(subtrahend->bounds());
+            const Model::NodeSet candidates(std::begin(intersecting), std::end(intersecting));
+
+            Model::BrushList affected;
             for (Model::Brush* minuend : minuends) {
-                const Model::BrushList result = minuend->subtract(*m_world, m_worldBounds, currentTextureName(), subtrahend);
+                if (candidates.count(minuend) > 0)
+                    affected.push_back(minuend);
+            }
+
+            const std::vector<Model::BrushList> results = Model::Brush::subtract(*m_world, m_worldBounds, currentTextureName(), affected, subtrahend);
+            for (size_t i = 0; i < affected.size(); ++i) {
+                Model::Brush* minuend = affected[i];
+                const Model::BrushList& result = results[i];
                 if (!result.empty()) {
                     VectorUtils::append(toAdd[minuend->parent()], result);
                     toRemove.push_back(minuend);
@@ -1447,6 +1492,11 @@ namespace TrenchBroom {
                 m_world->pick(pickRay, pickResult);
         }
         
+        void MapDocument::pickNearest(const Ray3& pickRay, Model::PickResult& pickResult, const std::function<const Model::Hit&(const Model::PickResult&)>& query) const {
+            if (m_world != nullptr)
+                m_world->pickNearest(pickRay, pickResult, query);
+        }
+        
         Model::NodeList MapDocument::findNodesContaining(const Vec3& point) const {
             Model::NodeList result;
             if (m_world != nullptr)
@@ -1464,10 +1514,10 @@ namespace TrenchBroom {
             setPath(IO::Path(DefaultDocumentName));
         }
         
-        void MapDocument::loadWorld(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path) {
+        void MapDocument::loadWorld(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path, IO::ParserStatus& status) {
             m_worldBounds = worldBounds;
             m_game = game;
-            m_world = m_game->loadMap(mapFormat, m_worldBounds, path, this);
+            m_world = m_game->loadMap(mapFormat, m_worldBounds, path, status);
             setCurrentLayer(m_world->defaultLayer());
             
             updateGameSearchPaths();
@@ -1816,9 +1866,10 @@ namespace TrenchBroom {
             if (isGamePathPreference(path)) {
                 const Model::GameFactory& gameFactory = Model::GameFactory::instance();
                 const IO::Path newGamePath = gameFactory.gamePath(m_game->gameName());
-                m_game->setGamePath(newGamePath, this);
-                
+
+                // running model loads read from the game file system, so they must finish before it is rebuilt
                 clearEntityModels();
+                m_game->setGamePath(newGamePath, this);
                 
                 unsetTextures();
                 loadTextures();
@@ -1829,6 +1880,11 @@ namespace TrenchBroom {
                        path == Preferences::TextureMagFilter.path()) {
                 m_entityModelManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
                 m_textureManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+            } else if (path == Preferences::TextureArrays.path()) {
+                // texture collections that are already prepared must be reloaded to create their array textures
+                m_textureManager->setUseTextureArrays(pref(Preferences::TextureArrays));
+                if (m_world != nullptr)
+                    reloadTextureCollections();
             }
         }
 
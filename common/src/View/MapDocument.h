@@ -36,6 +36,7 @@
 #include "View/UndoableCommand.h"
 #include "View/ViewTypes.h"
 
+#include <functional>
 #include <memory>
 
 class Color;
@@ -46,11 +47,16 @@ namespace TrenchBroom {
         class TextureManager;
     }
     
+    namespace IO {
+        class ParserStatus;
+    }
+    
     namespace Model {
         class BrushFaceAttributes;
         class ChangeBrushFaceAttributesRequest;
         class EditorContext;
         class Group;
+        class Hit;
         class PickResult;
         class PointFile;
         class PortalFile;
@@ -178,13 +184,14 @@ namespace TrenchBroom {
             void setViewEffectsService(ViewEffectsService* viewEffectsService);
         public: // new, load, save document
             void newDocument(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game);
-            void loadDocument(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path);
+            void loadDocument(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path, IO::ParserStatus& status);
             void saveDocument();
             void saveDocumentAs(const IO::Path& path);
             void saveDocumentTo(const IO::Path& path);
             void exportDocumentAs(Model::ExportFormat format, const IO::Path& path);
         private:
             void doSaveDocument(const IO::Path& path);
+            void saveMapCache(const IO::Path& path);
             void clearDocument();
         public: // copy and paste
             String serializeSelectedNodes();
@@ -225,6 +232,7 @@ namespace TrenchBroom {
             void selectTouching(bool del) override;
             void selectInside(bool del) override;
             void selectNodesWithFilePosition(const std::vector<size_t>& positions) override;
+            void selectFacesWithTexture(const Assets::Texture* texture) override;
             void select(const Model::NodeList& nodes) override;
             void select(Model::Node* node) override;
             void select(const Model::BrushFaceList& faces) override;
@@ -382,10 +390,14 @@ namespace TrenchBroom {
             void commitPendingAssets();
         public: // picking
             void pick(const Ray3& pickRay, Model::PickResult& pickResult) const;
+            /**
+             * Picks only until the hit returned by the given query cannot change anymore, see World::pickNearest.
+             */
+            void pickNearest(const Ray3& pickRay, Model::PickResult& pickResult, const std::function<const Model::Hit&(const Model::PickResult&)>& query) const;
             Model::NodeList findNodesContaining(const Vec3& point) const;
         private: // world management
             void createWorld(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game);
-            void loadWorld(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path);
+            void loadWorld(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path, IO::ParserStatus& status);
             void clearWorld();
             void initializeWorld(const BBox3& worldBounds);
         public: // asset management
@@ -22,6 +22,7 @@
 #include "TrenchBroomApp.h"
 #include "Preferences.h"
 #include "PreferenceManager.h"
+#include "Assets/TextureManager.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/ResourceUtils.h"
 #include "Model/AttributableNode.h"
@@ -54,6 +55,7 @@
 #include "View/MapFrameDropTarget.h"
 #include "View/Menu.h"
 #include "View/OpenClipboard.h"
+#include "View/ProgressDialogParserStatus.h"
 #include "View/RenderView.h"
 #include "View/ReplaceTextureDialog.h"
 #include "View/SplitterWindow2.h"
@@ -246,7 +248,8 @@ namespace TrenchBroom {
         bool MapFrame::openDocument(Model::GameSPtr game, const Model::MapFormat::Type mapFormat, const IO::Path& path) {
             if (!confirmOrDiscardChanges())
                 return false;
-            m_document->loadDocument(mapFormat, MapDocument::DefaultWorldBounds, game, path);
+            ProgressDialogParserStatus status(m_document.get(), this, "Loading " + path.lastComponent().asString(), "Reading " + path.asString());
+            m_document->loadDocument(mapFormat, MapDocument::DefaultWorldBounds, game, path, status);
             return true;
         }
 
@@ -710,6 +713,7 @@ namespace TrenchBroom {
             Bind(wxEVT_MENU, &MapFrame::OnEditSelectInside, this, CommandIds::Menu::EditSelectInside);
             Bind(wxEVT_MENU, &MapFrame::OnEditSelectTall, this, CommandIds::Menu::EditSelectTall);
             Bind(wxEVT_MENU, &MapFrame::OnEditSelectByLineNumber, this, CommandIds::Menu::EditSelectByFilePosition);
+            Bind(wxEVT_MENU, &MapFrame::OnEditSelectByTexture, this, CommandIds::Menu::EditSelectByTexture);
             Bind(wxEVT_MENU, &MapFrame::OnEditSelectNone, this, CommandIds::Menu::EditSelectNone);
 
             Bind(wxEVT_MENU, &MapFrame::OnEditGroupSelectedObjects, this, CommandIds::Menu::EditGroupSelection);
@@ -756,6 +760,7 @@ namespace TrenchBroom {
 
             Bind(wxEVT_MENU, &MapFrame::OnViewToggleMaximizeCurrentView, this, CommandIds::Menu::ViewToggleMaximizeCurrentView);
             Bind(wxEVT_MENU, &MapFrame::OnViewToggleInfoPanel, this, CommandIds::Menu::ViewToggleInfoPanel);
+            Bind(wxEVT_MENU, &MapFrame::OnViewToggleFrameTimings, this, CommandIds::Menu::ViewToggleFrameTimings);
             Bind(wxEVT_MENU, &MapFrame::OnViewToggleInspector, this, CommandIds::Menu::ViewToggleInspector);
 
             Bind(wxEVT_MENU, &MapFrame::OnRunCompile, this, CommandIds::Menu::RunCompile);
@@ -1060,6 +1065,15 @@ namespace TrenchBroom {
             }
         }
 
+        void MapFrame::OnEditSelectByTexture(wxCommandEvent& event) {
+            if (IsBeingDeleted()) return;
+
+            if (canSelectByTexture()) { // on gtk, menu shortcuts remain enabled even if the menu item is disabled
+                const Assets::Texture* texture = m_document->textureManager().texture(m_document->currentTextureName());
+                m_document->selectFacesWithTexture(texture);
+            }
+        }
+
         void MapFrame::OnEditSelectNone(wxCommandEvent& event) {
             if (IsBeingDeleted()) return;
 
@@ -1354,6 +1368,13 @@ namespace TrenchBroom {
                 m_hSplitter->maximize(m_vSplitter);
         }
 
+        void MapFrame::OnViewToggleFrameTimings(wxCommandEvent& event) {
+            if (IsBeingDeleted()) return;
+
+            PreferenceManager::instance().set(Preferences::ShowFrameTimings, !pref(Preferences::ShowFrameTimings));
+            PreferenceManager::instance().saveChanges();
+        }
+
         void MapFrame::OnRunCompile(wxCommandEvent& event) {
             if (IsBeingDeleted()) return;
             
@@ -1585,6 +1606,9 @@ namespace TrenchBroom {
                 case CommandIds::Menu::EditSelectByFilePosition:
                     event.Enable(canSelect());
                     break;
+                case CommandIds::Menu::EditSelectByTexture:
+                    event.Enable(canSelectByTexture());
+                    break;
                 case CommandIds::Menu::EditSelectNone:
                     event.Enable(canDeselect());
                     break;
@@ -1753,6 +1777,10 @@ namespace TrenchBroom {
                     event.Enable(true);
                     event.Check(!m_hSplitter->isMaximized(m_vSplitter));
                     break;
+                case CommandIds::Menu::ViewToggleFrameTimings:
+                    event.Enable(true);
+                    event.Check(pref(Preferences::ShowFrameTimings));
+                    break;
                 case CommandIds::Menu::RunCompile:
                     event.Enable(canCompile());
                     break;
@@ -1890,6 +1918,10 @@ namespace TrenchBroom {
             return canChangeSelection();
         }
 
+        bool MapFrame::canSelectByTexture() const {
+            return canChangeSelection() && m_document->textureManager().texture(m_document->currentTextureName()) != nullptr;
+        }
+
         bool MapFrame::canDeselect() const {
             return canChangeSelection() && m_document->hasSelectedNodes();
         }
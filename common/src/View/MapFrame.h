@@ -170,6 +170,7 @@ namespace TrenchBroom {
             void OnEditSelectInside(wxCommandEvent& event);
             void OnEditSelectTall(wxCommandEvent& event);
             void OnEditSelectByLineNumber(wxCommandEvent& event);
+            void OnEditSelectByTexture(wxCommandEvent& event);
             void OnEditSelectNone(wxCommandEvent& event);
 
             void OnEditGroupSelectedObjects(wxCommandEvent& event);
@@ -222,6 +223,7 @@ namespace TrenchBroom {
             
             void OnViewToggleMaximizeCurrentView(wxCommandEvent& event);
             void OnViewToggleInfoPanel(wxCommandEvent& event);
+            void OnViewToggleFrameTimings(wxCommandEvent& event);
             void OnViewToggleInspector(wxCommandEvent& event);
 
             void OnRunCompile(wxCommandEvent& event);
@@ -264,6 +266,7 @@ namespace TrenchBroom {
             bool canSelectByBrush() const;
             bool canSelectTall() const;
             bool canSelect() const;
+            bool canSelectByTexture() const;
             bool canDeselect() const;
             bool canChangeSelection() const;
             bool canGroup() const;
@@ -329,8 +329,11 @@ namespace TrenchBroom {
                 const Model::EditorContext& editorContext = document->editorContext();
                 Model::PickResult pickResult = Model::PickResult::byDistance(editorContext);
 
-                document->pick(Ray3(pickRay), pickResult);
-                const Model::Hit& hit = pickResult.query().pickable().type(Model::Brush::BrushHit).first();
+                const auto query = [](const Model::PickResult& result) -> const Model::Hit& {
+                    return result.query().pickable().type(Model::Brush::BrushHit).first();
+                };
+                document->pickNearest(Ray3(pickRay), pickResult, query);
+                const Model::Hit& hit = query(pickResult);
                 
                 if (hit.isMatch()) {
                     const Model::BrushFace* face = Model::hitToFace(hit);
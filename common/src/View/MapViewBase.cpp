@@ -23,6 +23,7 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Assets/EntityDefinitionManager.h"
+#include "Assets/EntityModelManager.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
@@ -38,7 +39,6 @@
 #include "Model/HitQuery.h"
 #include "Model/Layer.h"
 #include "Model/PointFile.h"
-#include "Model/PortalFile.h"
 #include "Model/PushSelection.h"
 #include "Model/World.h"
 #include "Renderer/Camera.h"
@@ -110,6 +110,10 @@ namespace TrenchBroom {
             unbindObservers();
             m_animationManager->Delete();
             delete m_compass;
+
+            // the timer queries of the profiler live in the shared context
+            if (makeContextCurrent())
+                m_profiler.clear();
         }
 
         void MapViewBase::bindObservers() {
@@ -138,6 +142,9 @@ namespace TrenchBroom {
             Grid& grid = document->grid();
             grid.gridDidChangeNotifier.addObserver(this, &MapViewBase::gridDidChange);
 
+            Assets::EntityModelManager& entityModelManager = document->entityModelManager();
+            entityModelManager.modelsDidLoadNotifier.addObserver(this, &MapViewBase::entityModelsDidLoad);
+
             m_toolBox.toolActivatedNotifier.addObserver(this, &MapViewBase::toolChanged);
             m_toolBox.toolDeactivatedNotifier.addObserver(this, &MapViewBase::toolChanged);
 
@@ -171,6 +178,9 @@ namespace TrenchBroom {
 
                 Grid& grid = document->grid();
                 grid.gridDidChangeNotifier.removeObserver(this, &MapViewBase::gridDidChange);
+
+                Assets::EntityModelManager& entityModelManager = document->entityModelManager();
+                entityModelManager.modelsDidLoadNotifier.removeObserver(this, &MapViewBase::entityModelsDidLoad);
             }
 
             m_toolBox.toolActivatedNotifier.removeObserver(this, &MapViewBase::toolChanged);
@@ -217,6 +227,10 @@ namespace TrenchBroom {
             Refresh();
         }
 
+        void MapViewBase::entityModelsDidLoad() {
+            Refresh();
+        }
+
         void MapViewBase::editorContextDidChange() {
             Refresh();
         }
@@ -872,21 +886,36 @@ namespace TrenchBroom {
             renderContext.setShowGrid(grid.visible());
             renderContext.setGridSize(grid.actualSize());
 
+            // the profiler's timer queries belong to this view's context, so they are released here
+            if (pref(Preferences::ShowFrameTimings)) {
+                m_profiler.beginFrame();
+                renderContext.setProfiler(&m_profiler);
+            } else if (m_profiler.frameCount() > 0) {
+                m_profiler.clear();
+            }
+
             setupGL(renderContext);
             setRenderOptions(renderContext);
 
             Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo());
 
-            doRenderGrid(renderContext, renderBatch);
-            doRenderMap(m_renderer, renderContext, renderBatch);
-            doRenderTools(m_toolBox, renderContext, renderBatch);
-            doRenderExtras(renderContext, renderBatch);
-            renderCoordinateSystem(renderContext, renderBatch);
-            renderPointFile(renderContext, renderBatch);
-            renderPortalFile(renderContext, renderBatch);
-            renderCompass(renderBatch);
+            {
+                Renderer::ProfileScope scope(renderContext.profiler(), "Collect");
+                doRenderGrid(renderContext, renderBatch);
+                doRenderMap(m_renderer, renderContext, renderBatch);
+                doRenderTools(m_toolBox, renderContext, renderBatch);
+                doRenderExtras(renderContext, renderBatch);
+                renderCoordinateSystem(renderContext, renderBatch);
+                renderPointFile(renderContext, renderBatch);
+                renderPortalFile(renderContext, renderBatch);
+                renderCompass(renderBatch);
+            }
+            renderFrameTimings(renderContext, renderBatch);
             
             renderBatch.render(renderContext);
+
+            if (renderContext.profiler() != nullptr)
+                m_profiler.endFrame();
         }
 
         void MapViewBase::setupGL(Renderer::RenderContext& context) {
@@ -920,29 +949,7 @@ namespace TrenchBroom {
         }
         
         void MapViewBase::renderPortalFile(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
-            MapDocumentSPtr document = lock(m_document);
-            Model::PortalFile* portalFile = document->portalFile();
-            if (portalFile != nullptr) {
-                Renderer::RenderService renderService(renderContext, renderBatch);
-                
-                // render fills
-                
-                renderService.setShowBackfaces();
-                renderService.setHideOccludedObjects();
-                renderService.setForegroundColor(pref(Preferences::PortalFileFillColor));
-                
-                for (const auto& poly : portalFile->portals()) {
-                    renderService.renderFilledPolygon(poly.vertices());
-                }
-                
-                // render strokes
-                
-                renderService.setLineWidth(4.0f);
-                renderService.setForegroundColor(pref(Preferences::PortalFileBorderColor));
-                for (const auto& poly : portalFile->portals()) {
-                    renderService.renderPolygonOutline(poly.vertices());
-                }
-            }
+            m_renderer.renderPortalFile(renderContext, renderBatch);
         }
 
         void MapViewBase::renderCompass(Renderer::RenderBatch& renderBatch) {
@@ -950,6 +957,15 @@ namespace TrenchBroom {
                 m_compass->render(renderBatch);
         }
         
+        void MapViewBase::renderFrameTimings(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
+            if (renderContext.profiler() != nullptr && m_profiler.frameCount() > 0) {
+                Renderer::RenderService renderService(renderContext, renderBatch);
+                renderService.setForegroundColor(pref(Preferences::InfoOverlayTextColor));
+                renderService.setBackgroundColor(pref(Preferences::InfoOverlayBackgroundColor));
+                renderService.renderOverlay(m_profiler.report());
+            }
+        }
+
         static bool isEntity(const Model::Node* node) {
             class IsEntity : public Model::ConstNodeVisitor, public Model::NodeQuery<bool> {
             private:
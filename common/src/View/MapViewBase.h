@@ -24,6 +24,7 @@
 #include "Model/ModelTypes.h"
 #include "Model/NodeCollection.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderProfiler.h"
 #include "View/ActionContext.h"
 #include "View/CameraLinkHelper.h"
 #include "View/GLAttribs.h"
@@ -76,6 +77,7 @@ namespace TrenchBroom {
         private:
             Renderer::MapRenderer& m_renderer;
             Renderer::Compass* m_compass;
+            Renderer::RenderProfiler m_profiler;
         protected:
             MapViewBase(wxWindow* parent, Logger* logger, MapDocumentWPtr document, MapViewToolBox& toolBox, Renderer::MapRenderer& renderer, GLContextManager& contextManager);
             
@@ -94,6 +96,7 @@ namespace TrenchBroom {
             void textureCollectionsDidChange();
             void entityDefinitionsDidChange();
             void modsDidChange();
+            void entityModelsDidLoad();
             void editorContextDidChange();
             void mapViewConfigDidChange();
             void gridDidChange();
@@ -217,6 +220,7 @@ namespace TrenchBroom {
             void renderPointFile(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
             void renderPortalFile(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
             void renderCompass(Renderer::RenderBatch& renderBatch);
+            void renderFrameTimings(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
         private: // implement ToolBoxConnector
             void doShowPopupMenu() override;
             wxMenu* makeEntityGroupsMenu(Assets::EntityDefinition::Type type, int id);
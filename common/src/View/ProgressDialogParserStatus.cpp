@@ -0,0 +1,59 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ProgressDialogParserStatus.h"
+
+#include <wx/progdlg.h>
+
+namespace TrenchBroom {
+    namespace View {
+        static const std::chrono::milliseconds ProgressDialogDelay(500);
+        
+        ProgressDialogParserStatus::ProgressDialogParserStatus(Logger* logger, wxWindow* parent, const String& title, const String& message) :
+        ParserStatus(logger),
+        m_parent(parent),
+        m_title(title),
+        m_message(message),
+        m_start(Clock::now()),
+        m_percent(-1),
+        m_cancelled(false) {}
+
+        ProgressDialogParserStatus::~ProgressDialogParserStatus() {}
+
+        void ProgressDialogParserStatus::doProgress(const double progress) {
+            const int percent = static_cast<int>(progress * 100.0);
+            if (percent == m_percent)
+                return;
+            m_percent = percent;
+
+            if (m_dialog == nullptr) {
+                if (Clock::now() - m_start < ProgressDialogDelay)
+                    return;
+                m_dialog.reset(new wxProgressDialog(m_title, m_message, 100, m_parent, wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME));
+            }
+
+            if (!m_dialog->Update(percent))
+                m_cancelled = true;
+        }
+
+        bool ProgressDialogParserStatus::doCancelled() const {
+            return m_cancelled;
+        }
+    }
+}
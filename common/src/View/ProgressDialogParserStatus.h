@@ -0,0 +1,62 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ProgressDialogParserStatus
+#define TrenchBroom_ProgressDialogParserStatus
+
+#include "StringUtils.h"
+#include "IO/ParserStatus.h"
+
+#include <chrono>
+#include <memory>
+
+class wxProgressDialog;
+class wxWindow;
+
+namespace TrenchBroom {
+    class Logger;
+    
+    namespace View {
+        /**
+         * Reports the progress of a parser in a modal progress dialog with a cancel button. The dialog only appears
+         * if parsing takes longer than a moment, and it is only updated when the progress has advanced by a full
+         * percent because every update yields to the event loop.
+         */
+        class ProgressDialogParserStatus : public IO::ParserStatus {
+        private:
+            typedef std::chrono::steady_clock Clock;
+            
+            wxWindow* m_parent;
+            String m_title;
+            String m_message;
+            Clock::time_point m_start;
+            std::unique_ptr<wxProgressDialog> m_dialog;
+            int m_percent;
+            bool m_cancelled;
+        public:
+            ProgressDialogParserStatus(Logger* logger, wxWindow* parent, const String& title, const String& message);
+            ~ProgressDialogParserStatus() override;
+        private:
+            void doProgress(double progress) override;
+            bool doCancelled() const override;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_ProgressDialogParserStatus) */
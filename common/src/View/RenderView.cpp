@@ -102,6 +102,10 @@ namespace TrenchBroom {
             return m_glContext->shaderManager();
         }
 
+        bool RenderView::makeContextCurrent() {
+            return m_glContext->SetCurrent(this);
+        }
+
         int RenderView::depthBits() const {
             return GLAttribs::depth();
         }
@@ -61,6 +61,11 @@ namespace TrenchBroom {
             
             int depthBits() const;
             bool multisample() const;
+
+            /**
+             * Makes the GL context of this view current so that GL resources can be released outside of rendering.
+             */
+            bool makeContextCurrent();
         private:
             void bindEvents();
 
@@ -20,9 +20,8 @@
 #include "ReplaceTextureDialog.h"
 
 #include "Assets/Texture.h"
+#include "Model/Brush.h"
 #include "Model/BrushFace.h"
-#include "Model/CollectMatchingBrushFacesVisitor.h"
-#include "Model/World.h"
 #include "View/BorderLine.h"
 #include "View/MapDocument.h"
 #include "View/TextureBrowser.h"
@@ -75,18 +74,18 @@ namespace TrenchBroom {
         
         Model::BrushFaceList ReplaceTextureDialog::getApplicableFaces() const {
             MapDocumentSPtr document = lock(m_document);
-            Model::BrushFaceList faces = document->allSelectedBrushFaces();
-            if (faces.empty()) {
-                Model::CollectBrushFacesVisitor collect;
-                document->world()->acceptAndRecurse(collect);
-                faces = collect.faces();
-            }
-            
             const Assets::Texture* subject = m_subjectBrowser->selectedTexture();
             ensure(subject != nullptr, "subject is null");
             
             Model::BrushFaceList result;
-            std::copy_if(std::begin(faces), std::end(faces), std::back_inserter(result), [&subject](const Model::BrushFace* face) { return face->texture() == subject; });
+            const Model::BrushFaceList faces = document->allSelectedBrushFaces();
+            if (faces.empty()) {
+                // the texture knows its faces, but some of them may belong to brushes that are not in the map
+                const Model::BrushFaceList& textureFaces = subject->faces();
+                std::copy_if(std::begin(textureFaces), std::end(textureFaces), std::back_inserter(result), [](const Model::BrushFace* face) { return face->brush() != nullptr && face->brush()->parent() != nullptr; });
+            } else {
+                std::copy_if(std::begin(faces), std::end(faces), std::back_inserter(result), [&subject](const Model::BrushFace* face) { return face->texture() == subject; });
+            }
             return result;
         }
         
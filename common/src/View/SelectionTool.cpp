@@ -33,17 +33,28 @@
 #include "Model/Node.h"
 #include "Model/NodeVisitor.h"
 #include "Model/PickResult.h"
+#include "Model/World.h"
+#include "Renderer/Camera.h"
 #include "Renderer/RenderContext.h"
 #include "View/InputState.h"
 #include "View/Grid.h"
+#include "View/Lasso.h"
 #include "View/MapDocument.h"
 
 namespace TrenchBroom {
     namespace View {
+        static const float LassoDistance = 64.0f;
+
         SelectionTool::SelectionTool(MapDocumentWPtr document) :
         ToolControllerBase(),
         Tool(true),
-        m_document(document) {}
+        m_document(document),
+        m_lasso(nullptr),
+        m_lassoSelectsFaces(false) {}
+
+        SelectionTool::~SelectionTool() {
+            delete m_lasso;
+        }
         
         Tool* SelectionTool::doGetTool() {
             return this;
@@ -288,7 +299,10 @@ namespace TrenchBroom {
             if (isFaceClick(inputState)) {
                 const auto& hit = firstHit(inputState, Model::Brush::BrushHit);
                 if (!hit.isMatch()) {
-                    return false;
+                    // dragging from empty space selects the faces in a rectangle
+                    m_lasso = new Lasso(inputState.camera(), LassoDistance, lassoPoint(inputState));
+                    m_lassoSelectsFaces = true;
+                    return true;
                 }
 
                 auto* face = Model::hitToFace(hit);
@@ -306,7 +320,10 @@ namespace TrenchBroom {
             } else {
                 const auto& hit = firstHit(inputState, Model::Group::GroupHit | Model::Entity::EntityHit | Model::Brush::BrushHit);
                 if (!hit.isMatch()) {
-                    return false;
+                    // dragging from empty space selects the objects in a rectangle
+                    m_lasso = new Lasso(inputState.camera(), LassoDistance, lassoPoint(inputState));
+                    m_lassoSelectsFaces = false;
+                    return true;
                 }
 
                 auto* node = Model::hitToNode(hit);
@@ -326,6 +343,11 @@ namespace TrenchBroom {
         }
         
         bool SelectionTool::doMouseDrag(const InputState& inputState) {
+            if (m_lasso != nullptr) {
+                m_lasso->update(lassoPoint(inputState));
+                return true;
+            }
+
             auto document = lock(m_document);
             const auto& editorContext = document->editorContext();
             if (document->hasSelectedBrushFaces()) {
@@ -350,14 +372,69 @@ namespace TrenchBroom {
         }
         
         void SelectionTool::doEndMouseDrag(const InputState& inputState) {
+            if (m_lasso != nullptr) {
+                m_lasso->update(lassoPoint(inputState));
+                selectInLasso();
+                delete m_lasso;
+                m_lasso = nullptr;
+                return;
+            }
+
             auto document = lock(m_document);
             document->commitTransaction();
         }
         
         void SelectionTool::doCancelMouseDrag() {
+            if (m_lasso != nullptr) {
+                delete m_lasso;
+                m_lasso = nullptr;
+                return;
+            }
+
             auto document = lock(m_document);
             document->cancelTransaction();
         }
+
+        Vec3 SelectionTool::lassoPoint(const InputState& inputState) const {
+            const auto& camera = inputState.camera();
+            const auto plane = orthogonalDragPlane(Vec3(camera.defaultPoint(LassoDistance)), Vec3(camera.direction()));
+            const auto& pickRay = inputState.pickRay();
+            return pickRay.pointAtDistance(plane.intersectWithRay(pickRay));
+        }
+
+        void SelectionTool::selectInLasso() {
+            auto document = lock(m_document);
+            const auto& editorContext = document->editorContext();
+            const auto region = m_lasso->region();
+
+            if (m_lassoSelectsFaces) {
+                Model::BrushFaceList faces;
+                for (auto* face : document->world()->findBrushFacesContainedIn(region)) {
+                    if (!face->selected() && editorContext.selectable(face)) {
+                        faces.push_back(face);
+                    }
+                }
+
+                Transaction transaction(document, "Select Brush Faces");
+                if (document->hasSelection() && !document->hasSelectedBrushFaces()) {
+                    document->deselectAll();
+                }
+                document->select(faces);
+            } else {
+                Model::NodeList nodes;
+                for (auto* node : document->world()->findNodesContainedIn(region)) {
+                    if (!node->selected() && editorContext.selectable(node)) {
+                        nodes.push_back(node);
+                    }
+                }
+
+                Transaction transaction(document, "Select Objects");
+                if (document->hasSelection() && !document->hasSelectedNodes()) {
+                    document->deselectAll();
+                }
+                document->select(nodes);
+            }
+        }
         
         void SelectionTool::doSetRenderOptions(const InputState& inputState, Renderer::RenderContext& renderContext) const {
             auto document = lock(m_document);
@@ -367,6 +444,12 @@ namespace TrenchBroom {
             }
         }
         
+        void SelectionTool::doRender(const InputState& inputState, Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
+            if (m_lasso != nullptr) {
+                m_lasso->render(renderContext, renderBatch);
+            }
+        }
+        
         bool SelectionTool::doCancel() {
             // closing the current group is handled in MapViewBase
             return false;
@@ -20,6 +20,8 @@
 #ifndef TrenchBroom_SelectionTool
 #define TrenchBroom_SelectionTool
 
+#include "TrenchBroom.h"
+#include "VecMath.h"
 #include "Model/Hit.h"
 #include "Model/ModelTypes.h"
 #include "View/Tool.h"
@@ -28,17 +30,22 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        class RenderBatch;
         class RenderContext;
     }
     
     namespace View {
         class InputState;
+        class Lasso;
         
         class SelectionTool : public ToolControllerBase<NoPickingPolicy, NoKeyPolicy, MousePolicy, MouseDragPolicy, RenderPolicy, NoDropPolicy>, public Tool {
         private:
             MapDocumentWPtr m_document;
+            Lasso* m_lasso;
+            bool m_lassoSelectsFaces;
         public:
             SelectionTool(MapDocumentWPtr document);
+            ~SelectionTool() override;
         private:
             Tool* doGetTool() override;
             
@@ -62,7 +69,11 @@ namespace TrenchBroom {
             void doEndMouseDrag(const InputState& inputState) override;
             void doCancelMouseDrag() override;
 
+            Vec3 lassoPoint(const InputState& inputState) const;
+            void selectInLasso();
+
             void doSetRenderOptions(const InputState& inputState, Renderer::RenderContext& renderContext) const override;
+            void doRender(const InputState& inputState, Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) override;
             
             bool doCancel() override;
         };
@@ -61,6 +61,12 @@ namespace TrenchBroom {
             return brush->hasVertex(handle);
         }
 
+        void VertexHandleManager::appendHandles(const Model::Brush* brush, HandleList& handles) const {
+            for (const Model::BrushVertex* vertex : brush->vertices()) {
+                handles.push_back(vertex->position());
+            }
+        }
+
         const Model::Hit::HitType EdgeHandleManager::HandleHit = Model::Hit::freeHitType();
 
         void EdgeHandleManager::pickGridHandle(const Ray3& pickRay, const Renderer::Camera& camera, const Grid& grid, Model::PickResult& pickResult) const {
@@ -111,6 +117,12 @@ namespace TrenchBroom {
             return brush->hasEdge(handle);
         }
 
+        void EdgeHandleManager::appendHandles(const Model::Brush* brush, HandleList& handles) const {
+            for (const Model::BrushEdge* edge : brush->edges()) {
+                handles.push_back(Edge3(edge->firstVertex()->position(), edge->secondVertex()->position()));
+            }
+        }
+
         const Model::Hit::HitType FaceHandleManager::HandleHit = Model::Hit::freeHitType();
 
         void FaceHandleManager::pickGridHandle(const Ray3& pickRay, const Renderer::Camera& camera, const Grid& grid, Model::PickResult& pickResult) const {
@@ -166,5 +178,11 @@ namespace TrenchBroom {
         bool FaceHandleManager::isIncident(const Handle& handle, const Model::Brush* brush) const {
             return brush->hasFace(handle);
         }
+
+        void FaceHandleManager::appendHandles(const Model::Brush* brush, HandleList& handles) const {
+            for (const Model::BrushFace* face : brush->faces()) {
+                handles.push_back(face->polygon());
+            }
+        }
     }
 }
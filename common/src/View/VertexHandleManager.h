@@ -518,6 +518,14 @@ namespace TrenchBroom {
              * @return true if and only if the given brush is incident to the given handle
              */
             virtual bool isIncident(const Handle& handle, const Model::Brush* brush) const = 0;
+        public:
+            /**
+             * Appends the handles that this manager adds for the given brush to the given list.
+             *
+             * @param brush the brush
+             * @param handles the list to append to
+             */
+            virtual void appendHandles(const Model::Brush* brush, HandleList& handles) const = 0;
         };
 
         /**
@@ -544,6 +552,7 @@ namespace TrenchBroom {
             void removeHandles(const Model::Brush* brush) override;
             
             Model::Hit::HitType hitType() const override;
+            void appendHandles(const Model::Brush* brush, HandleList& handles) const override;
         private:
             bool isIncident(const Handle& handle, const Model::Brush* brush) const override;
         };
@@ -589,6 +598,7 @@ namespace TrenchBroom {
             void removeHandles(const Model::Brush* brush) override;
             
             Model::Hit::HitType hitType() const override;
+            void appendHandles(const Model::Brush* brush, HandleList& handles) const override;
         private:
             bool isIncident(const Handle& handle, const Model::Brush* brush) const override;
         };
@@ -635,6 +645,7 @@ namespace TrenchBroom {
             void removeHandles(const Model::Brush* brush) override;
 
             Model::Hit::HitType hitType() const override;
+            void appendHandles(const Model::Brush* brush, HandleList& handles) const override;
         private:
             bool isIncident(const Handle& handle, const Model::Brush* brush) const override;
         };
@@ -27,6 +27,7 @@
 #include "Preferences.h"
 #include "Model/Hit.h"
 #include "Model/ModelTypes.h"
+#include "Model/World.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderService.h"
 #include "View/Lasso.h"
@@ -47,6 +48,7 @@
 #include <algorithm>
 #include <cassert>
 #include <numeric>
+#include <set>
 
 namespace TrenchBroom {
     namespace Model {
@@ -157,11 +159,29 @@ namespace TrenchBroom {
             
             void select(const Lasso& lasso, const bool modifySelection) {
                 typedef std::vector<H> HandleList;
-                
-                const HandleList allHandles = handleManager().allHandles();
-                HandleList selectedHandles;
-                
-                lasso.selected(std::begin(allHandles), std::end(allHandles), std::back_inserter(selectedHandles));
+
+                Model::NodeList brushes(std::begin(selectedBrushes()), std::end(selectedBrushes()));
+                std::sort(std::begin(brushes), std::end(brushes));
+
+                // Only the selected brushes in the lasso's region can contribute handles, and the handles of a brush
+                // whose bounds are contained in the region need not be tested individually.
+                const Model::SelectionRegion region = lasso.region();
+                std::set<H> selectedHandles;
+                HandleList brushHandles;
+
+                MapDocumentSPtr document = lock(m_document);
+                document->world()->findNodesInRegion(region, [&](const Model::Node* node, const bool contained) {
+                    if (!std::binary_search(std::begin(brushes), std::end(brushes), node))
+                        return;
+
+                    brushHandles.clear();
+                    handleManager().appendHandles(static_cast<const Model::Brush*>(node), brushHandles);
+                    for (const H& handle : brushHandles) {
+                        if ((contained || lasso.selects(handle, region)) && handleManager().contains(handle))
+                            selectedHandles.insert(handle);
+                    }
+                });
+
                 if (!modifySelection)
                     handleManager().deselectAll();
                 handleManager().toggle(std::begin(selectedHandles), std::end(selectedHandles));
@@ -125,6 +125,15 @@ namespace TrenchBroom {
             prefs.set(Preferences::TextureMagFilter, magFilter);
         }
 
+        void ViewPreferencePane::OnTextureArraysChanged(wxCommandEvent& event) {
+            if (IsBeingDeleted()) return;
+
+            const bool value = event.IsChecked();
+
+            PreferenceManager& prefs = PreferenceManager::instance();
+            prefs.set(Preferences::TextureArrays, value);
+        }
+
         void ViewPreferencePane::OnBackgroundColorChanged(wxColourPickerEvent& event) {
             if (IsBeingDeleted()) return;
             
@@ -224,6 +233,9 @@ namespace TrenchBroom {
             wxStaticText* textureModeLabel = new wxStaticText(viewBox, wxID_ANY, "Texture Mode");
             m_textureModeChoice = new wxChoice(viewBox, wxID_ANY, wxDefaultPosition, wxDefaultSize, NumTextureModes, textureModeNames);
 
+            m_textureArraysCheckBox = new wxCheckBox(viewBox, wxID_ANY, "Batch textures of equal size");
+            m_textureArraysCheckBox->SetToolTip("Uploads textures of equal size into array textures so that brush faces can be rendered with fewer draw calls. Falls back to regular textures if the graphics driver does not support array textures.");
+
             
             
             wxStaticText* colorPrefsHeader = new wxStaticText(viewBox, wxID_ANY, "Colors");
@@ -284,6 +296,9 @@ namespace TrenchBroom {
             sizer->Add(textureModeLabel,                    wxGBPosition( r, 0), wxDefaultSpan, LabelFlags, HMargin);
             sizer->Add(m_textureModeChoice,                 wxGBPosition( r, 1), wxDefaultSpan, ChoiceFlags, HMargin);
             ++r;
+
+            sizer->Add(m_textureArraysCheckBox,             wxGBPosition( r, 1), wxDefaultSpan, CheckBoxFlags, HMargin);
+            ++r;
             
             sizer->Add(0, LayoutConstants::ChoiceSizeDelta, wxGBPosition( r, 0), wxGBSpan(1,2));
             ++r;
@@ -341,6 +356,7 @@ namespace TrenchBroom {
             m_edgeColorPicker->Bind(wxEVT_COLOURPICKER_CHANGED, &ViewPreferencePane::OnEdgeColorChanged, this);
 
             m_textureModeChoice->Bind(wxEVT_CHOICE, &ViewPreferencePane::OnTextureModeChanged, this);
+            m_textureArraysCheckBox->Bind(wxEVT_CHECKBOX, &ViewPreferencePane::OnTextureArraysChanged, this);
             m_textureBrowserIconSizeChoice->Bind(wxEVT_CHOICE, &ViewPreferencePane::OnTextureBrowserIconSizeChanged, this);
         }
 
@@ -355,6 +371,7 @@ namespace TrenchBroom {
             prefs.resetToDefault(Preferences::ShowAxes);
             prefs.resetToDefault(Preferences::TextureMinFilter);
             prefs.resetToDefault(Preferences::TextureMagFilter);
+            prefs.resetToDefault(Preferences::TextureArrays);
             prefs.resetToDefault(Preferences::BackgroundColor);
             prefs.resetToDefault(Preferences::GridColor2D);
             prefs.resetToDefault(Preferences::EdgeColor);
@@ -370,6 +387,7 @@ namespace TrenchBroom {
             const size_t textureModeIndex = findTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
             assert(textureModeIndex < NumTextureModes);
             m_textureModeChoice->SetSelection(static_cast<int>(textureModeIndex));
+            m_textureArraysCheckBox->SetValue(pref(Preferences::TextureArrays));
             
             m_showAxes->SetValue(pref(Preferences::ShowAxes));
 
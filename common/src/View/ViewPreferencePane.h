@@ -37,6 +37,7 @@ namespace TrenchBroom {
             wxSlider* m_gridAlphaSlider;
             wxCheckBox* m_showAxes;
             wxChoice* m_textureModeChoice;
+            wxCheckBox* m_textureArraysCheckBox;
             wxColourPickerCtrl* m_backgroundColorPicker;
             wxColourPickerCtrl* m_gridColorPicker;
             wxColourPickerCtrl* m_edgeColorPicker;
@@ -49,6 +50,7 @@ namespace TrenchBroom {
             void OnGridAlphaChanged(wxScrollEvent& event);
             void OnShowAxesChanged(wxCommandEvent& event);
             void OnTextureModeChanged(wxCommandEvent& event);
+            void OnTextureArraysChanged(wxCommandEvent& event);
             void OnBackgroundColorChanged(wxColourPickerEvent& event);
             void OnGridColorChanged(wxColourPickerEvent& event);
             void OnEdgeColorChanged(wxColourPickerEvent& event);
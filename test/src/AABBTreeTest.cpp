@@ -23,6 +23,8 @@
 #include "Ray.h"
 #include "AABBTree.h"
 
+#include <map>
+
 using AABB = AABBTree<double, 3, size_t>;
 using BOX = AABB::Box;
 using RAY = Ray<AABB::FloatType, AABB::Components>;
@@ -30,6 +32,7 @@ using VEC = Vec<AABB::FloatType, AABB::Components>;
 
 void assertTree(const std::string& exp, const AABB& actual);
 void assertIntersectors(const AABB& tree, const Ray<AABB::FloatType, AABB::Components>& ray, std::initializer_list<AABB::DataType> items);
+void assertIntersectors(const AABB& tree, const BOX& bounds, std::initializer_list<AABB::DataType> items);
 
 TEST(AABBTreeTest, createEmptyTree) {
     AABB tree;
@@ -424,6 +427,30 @@ BOX makeBounds(const K min, const K max) {
     return BOX(VEC(static_cast<double>(min), -1.0, -1.0), VEC(static_cast<double>(max), 1.0, 1.0));
 }
 
+TEST(AABBTreeTest, clearAndBuild) {
+    const auto getBounds = [](const AABB::DataType item) {
+        const AABB::FloatType x = 2.0 * static_cast<AABB::FloatType>(item - 1u);
+        return BOX(VEC(x, 0.0, 0.0), VEC(x + 1.0, 1.0, 1.0));
+    };
+
+    AABB tree;
+    tree.insert(BOX(VEC(-8.0, -8.0, -8.0), VEC(-7.0, -7.0, -7.0)), 9u);
+    tree.clearAndBuild(AABB::Array({ 3u, 1u, 4u, 2u }), getBounds);
+
+    assertTree(R"(
+O [ (0 0 0) (7 1 1) ]
+  O [ (0 0 0) (3 1 1) ]
+    L [ (0 0 0) (1 1 1) ]: 1
+    L [ (2 0 0) (3 1 1) ]: 2
+  O [ (4 0 0) (7 1 1) ]
+    L [ (4 0 0) (5 1 1) ]: 3
+    L [ (6 0 0) (7 1 1) ]: 4
+)" , tree);
+
+    tree.clearAndBuild(AABB::Array(), getBounds);
+    ASSERT_TRUE(tree.empty());
+}
+
 TEST(AABBTreeTest, findIntersectorsOfEmptyTree) {
     AABB tree;
     assertIntersectors(tree, RAY(VEC::Null, VEC::PosX), {});
@@ -468,6 +495,125 @@ TEST(AABBTreeTest, findIntersectorsFromInsideRootBBox) {
     assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::PosX), { 2u });
 }
 
+TEST(AABBTreeTest, findIntersectorsOfBox) {
+    AABB tree;
+    assertIntersectors(tree, BOX(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0)), {});
+
+    tree.insert(BOX(VEC(-4.0, -1.0, -1.0), VEC(-2.0, +1.0, +1.0)), 1u);
+    tree.insert(BOX(VEC(+2.0, -1.0, -1.0), VEC(+4.0, +1.0, +1.0)), 2u);
+    tree.insert(BOX(VEC(+2.0, +2.0, -1.0), VEC(+4.0, +4.0, +1.0)), 3u);
+
+    assertIntersectors(tree, BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), {});
+    assertIntersectors(tree, BOX(VEC(-3.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), { 1u });
+    assertIntersectors(tree, BOX(VEC(-3.0, -1.0, -1.0), VEC(+3.0, +1.0, +1.0)), { 1u, 2u });
+    assertIntersectors(tree, BOX(VEC(+1.0, +1.0, -1.0), VEC(+2.0, +2.0, +1.0)), { 2u, 3u });
+    assertIntersectors(tree, BOX(VEC(-8.0, -8.0, -8.0), VEC(+8.0, +8.0, +8.0)), { 1u, 2u, 3u });
+}
+
+TEST(AABBTreeTest, findIntersectorsInOrder) {
+    AABB tree;
+    tree.insert(BOX(VEC(+6.0, -1.0, -1.0), VEC(+7.0, +1.0, +1.0)), 3u);
+    tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), 1u);
+    tree.insert(BOX(VEC(+2.0, +2.0, -1.0), VEC(+3.0, +3.0, +1.0)), 4u);
+    tree.insert(BOX(VEC(+3.0, -1.0, -1.0), VEC(+4.0, +1.0, +1.0)), 2u);
+
+    std::vector<AABB::DataType> items;
+    std::vector<AABB::FloatType> distances;
+    const auto collect = [&](const AABB::DataType item, const AABB::FloatType distance) {
+        items.push_back(item);
+        distances.push_back(distance);
+        return true;
+    };
+
+    tree.findIntersectorsInOrder(RAY(VEC(0.0, 0.0, 0.0), VEC::PosX), collect);
+    ASSERT_EQ(std::vector<AABB::DataType>({ 1u, 2u, 3u }), items);
+    ASSERT_EQ(std::vector<AABB::FloatType>({ 0.0, 3.0, 6.0 }), distances);
+
+    items.clear();
+    distances.clear();
+    tree.findIntersectorsInOrder(RAY(VEC(10.0, 0.0, 0.0), VEC::NegX), collect);
+    ASSERT_EQ(std::vector<AABB::DataType>({ 3u, 2u, 1u }), items);
+
+    items.clear();
+    tree.findIntersectorsInOrder(RAY(VEC(-10.0, 0.0, 0.0), VEC::PosX), [&](const AABB::DataType item, const AABB::FloatType distance) {
+        items.push_back(item);
+        return distance < 10.0;
+    });
+    ASSERT_EQ(std::vector<AABB::DataType>({ 1u, 2u }), items);
+}
+
+TEST(AABBTreeTest, findIntersectorsOfBoxAndCollapse) {
+    const AABB::Array items({ 1u, 2u, 3u, 4u });
+    const auto getBounds = [](const size_t i) {
+        // two small boxes near the origin and two large boxes further away
+        switch (i) {
+            case 1u: return BOX(VEC(0.0, 0.0, 0.0), VEC(0.25, 0.25, 0.25));
+            case 2u: return BOX(VEC(0.5, 0.0, 0.0), VEC(0.75, 0.25, 0.25));
+            case 3u: return BOX(VEC(8.0, 0.0, 0.0), VEC(12.0, 4.0, 4.0));
+            default: return BOX(VEC(16.0, 0.0, 0.0), VEC(20.0, 4.0, 4.0));
+        }
+    };
+
+    AABB tree;
+    tree.clearAndBuild(items, getBounds);
+
+    std::set<AABB::DataType> found;
+    std::vector<BOX> collapsed;
+    const auto small = [](const BOX& bounds) { return bounds.size().x() < 1.0; };
+    const auto collapse = [&](const BOX& bounds) { collapsed.push_back(bounds); };
+
+    tree.findIntersectors(BOX(VEC(-1.0, -1.0, -1.0), VEC(24.0, 8.0, 8.0)), std::inserter(found, std::end(found)), small, collapse);
+    ASSERT_EQ(std::set<AABB::DataType>({ 3u, 4u }), found);
+    ASSERT_EQ(1u, collapsed.size());
+    ASSERT_EQ(BOX(VEC(0.0, 0.0, 0.0), VEC(0.75, 0.25, 0.25)), collapsed.front());
+
+    found.clear();
+    collapsed.clear();
+    tree.findIntersectors(BOX(VEC(10.0, 1.0, 1.0), VEC(11.0, 2.0, 2.0)), std::inserter(found, std::end(found)), small, collapse);
+    ASSERT_EQ(std::set<AABB::DataType>({ 3u }), found);
+    ASSERT_TRUE(collapsed.empty());
+}
+
+TEST(AABBTreeTest, findInRegion) {
+    // a region that is given by a bounding box and counts how often it is tested
+    struct BoxRegion {
+        BOX box;
+        mutable size_t tests;
+
+        BoxRegion(const BOX& i_box) : box(i_box), tests(0) {}
+
+        bool intersects(const BOX& bounds) const { ++tests; return box.intersects(bounds); }
+        bool contains(const BOX& bounds) const { ++tests; return box.contains(bounds); }
+    };
+
+    const AABB::Array items({ 1u, 2u, 3u, 4u });
+    const auto getBounds = [](const size_t i) {
+        const auto x = static_cast<double>(i) * 4.0;
+        return BOX(VEC(x, 0.0, 0.0), VEC(x + 2.0, 2.0, 2.0));
+    };
+
+    AABB tree;
+    tree.clearAndBuild(items, getBounds);
+
+    std::map<AABB::DataType, bool> found;
+    const auto collect = [&](const AABB::DataType item, const bool contained) { found[item] = contained; };
+
+    // item 2 is contained, item 3 intersects, and items 1 and 4 lie outside
+    tree.findInRegion(BoxRegion(BOX(VEC(7.0, -1.0, -1.0), VEC(13.0, 3.0, 3.0))), collect);
+    ASSERT_EQ((std::map<AABB::DataType, bool>({ { 2u, true }, { 3u, false } })), found);
+
+    // the region contains the whole tree, so only the root is tested
+    found.clear();
+    const BoxRegion all(BOX(VEC(-1.0, -1.0, -1.0), VEC(24.0, 3.0, 3.0)));
+    tree.findInRegion(all, collect);
+    ASSERT_EQ((std::map<AABB::DataType, bool>({ { 1u, true }, { 2u, true }, { 3u, true }, { 4u, true } })), found);
+    ASSERT_EQ(2u, all.tests);
+
+    found.clear();
+    tree.findInRegion(BoxRegion(BOX(VEC(-1.0, 4.0, -1.0), VEC(24.0, 5.0, 3.0))), collect);
+    ASSERT_TRUE(found.empty());
+}
+
 void assertTree(const std::string& exp, const AABB& actual) {
     std::stringstream str;
     actual.print(str);
@@ -482,3 +628,12 @@ void assertIntersectors(const AABB& tree, const Ray<AABB::FloatType, AABB::Compo
 
     ASSERT_EQ(expected, actual);
 }
+
+void assertIntersectors(const AABB& tree, const BOX& bounds, std::initializer_list<AABB::DataType> items) {
+    const std::set<AABB::DataType> expected(items);
+    std::set<AABB::DataType> actual;
+
+    tree.findIntersectors(bounds, std::inserter(actual, std::end(actual)));
+
+    ASSERT_EQ(expected, actual);
+}
@@ -0,0 +1,320 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "TaskScheduler.h"
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelManager.h"
+#include "IO/EntityModelLoader.h"
+#include "IO/Path.h"
+#include "Renderer/Vbo.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class TestEntityModel : public EntityModel {
+        private:
+            Renderer::TexturedIndexRangeRenderer* doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const override {
+                return nullptr;
+            }
+
+            BBox3f doGetBounds(const size_t skinIndex, const size_t frameIndex) const override {
+                return BBox3f(8.0f);
+            }
+
+            BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const override {
+                return BBox3f(8.0f);
+            }
+
+            void doPrepare(const int minFilter, const int magFilter) override {}
+            void doSetTextureMode(const int minFilter, const int magFilter) override {}
+        };
+
+        /**
+         * Records the loaded paths and fails to load models with the extension "bad". If the loader is closed, loads
+         * block until it is opened again.
+         */
+        class TestEntityModelLoader : public IO::EntityModelLoader {
+        private:
+            mutable std::mutex m_mutex;
+            mutable std::condition_variable m_condition;
+            mutable IO::Path::List m_loadedPaths;
+            mutable size_t m_waitingCount;
+            mutable size_t m_activeCount;
+            bool m_open;
+        public:
+            TestEntityModelLoader() :
+            m_waitingCount(0),
+            m_activeCount(0),
+            m_open(true) {}
+
+            size_t activeCount() const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_activeCount;
+            }
+
+            IO::Path::List loadedPaths() const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_loadedPaths;
+            }
+
+            void close() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_open = false;
+            }
+
+            void open() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_open = true;
+                m_condition.notify_all();
+            }
+
+            void waitUntilBlocked() const {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() { return m_waitingCount > 0; });
+            }
+        private:
+            EntityModel* doLoadEntityModel(const IO::Path& path) const override {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                ++m_activeCount;
+                ++m_waitingCount;
+                m_condition.notify_all();
+                m_condition.wait(lock, [this]() { return m_open; });
+                --m_waitingCount;
+
+                // simulate reading the file outside of the lock
+                lock.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                lock.lock();
+                --m_activeCount;
+
+                m_loadedPaths.push_back(path);
+                if (path.extension() == "bad")
+                    throw GameException("Cannot load model");
+                return new TestEntityModel();
+            }
+        };
+
+        class ModelsDidLoadObserver {
+        public:
+            size_t count;
+
+            ModelsDidLoadObserver() :
+            count(0) {}
+
+            void modelsDidLoad() {
+                ++count;
+            }
+        };
+
+        static ModelSpecification spec(const String& path) {
+            return ModelSpecification(IO::Path(path), 0, 0);
+        }
+
+        static bool isLoading(const EntityModelManager& manager, const IO::Path::List& paths) {
+            for (const IO::Path& path : paths) {
+                if (manager.isLoading(path))
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * Calls prepare until none of the given models are being loaded anymore and returns the number of models that
+         * became available in each call that added models.
+         */
+        static std::vector<size_t> prepareUntilLoaded(EntityModelManager& manager, const IO::Path::List& paths) {
+            Renderer::Vbo vbo(0xFFF);
+            std::vector<size_t> counts;
+
+            size_t loading = paths.size();
+            for (size_t i = 0; i < 10000 && loading > 0; ++i) {
+                manager.prepare(vbo);
+
+                size_t stillLoading = 0;
+                for (const IO::Path& path : paths) {
+                    if (manager.isLoading(path))
+                        ++stillLoading;
+                }
+
+                if (stillLoading < loading)
+                    counts.push_back(loading - stillLoading);
+                loading = stillLoading;
+
+                if (loading > 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return counts;
+        }
+
+        TEST(EntityModelManagerTest, loadModelInBackground) {
+            TaskScheduler scheduler(1);
+            TestEntityModelLoader loader;
+            EntityModelManager manager(nullptr, 0, 0, scheduler);
+            manager.setLoader(&loader);
+
+            ModelsDidLoadObserver observer;
+            manager.modelsDidLoadNotifier.addObserver(&observer, &ModelsDidLoadObserver::modelsDidLoad);
+
+            const size_t generation = manager.generation();
+            const IO::Path path("progs/player.mdl");
+            ASSERT_TRUE(manager.renderer(spec(path.asString())) == nullptr);
+            ASSERT_TRUE(manager.isLoading(path));
+
+            prepareUntilLoaded(manager, IO::Path::List(1, path));
+            ASSERT_FALSE(manager.isLoading(path));
+            ASSERT_NE(generation, manager.generation());
+
+            scheduler.processMainThreadTasks();
+            ASSERT_LT(0u, observer.count);
+
+            // the model is available now and is not loaded again
+            ASSERT_TRUE(manager.model(path) != nullptr);
+            ASSERT_EQ(IO::Path::List(1, path), loader.loadedPaths());
+
+            manager.modelsDidLoadNotifier.removeObserver(&observer, &ModelsDidLoadObserver::modelsDidLoad);
+        }
+
+        TEST(EntityModelManagerTest, limitModelsPerPrepare) {
+            TaskScheduler scheduler(2);
+            TestEntityModelLoader loader;
+            EntityModelManager manager(nullptr, 0, 0, scheduler);
+            manager.setLoader(&loader);
+
+            IO::Path::List paths;
+            for (size_t i = 0; i < 20; ++i) {
+                paths.push_back(IO::Path("progs/model" + std::to_string(i) + ".mdl"));
+                manager.renderer(spec(paths.back().asString()));
+            }
+
+            const std::vector<size_t> counts = prepareUntilLoaded(manager, paths);
+            ASSERT_FALSE(isLoading(manager, paths));
+            ASSERT_LE(3u, counts.size());
+            for (const size_t count : counts)
+                ASSERT_GE(EntityModelManager::ModelUploadBudget, count);
+        }
+
+        TEST(EntityModelManagerTest, loadModelsByPriority) {
+            TaskScheduler scheduler(1);
+            TestEntityModelLoader loader;
+            EntityModelManager manager(nullptr, 0, 0, scheduler);
+            manager.setLoader(&loader);
+
+            // block the only worker so that the other requests wait until their priorities are set
+            loader.close();
+            manager.renderer(spec("progs/first.mdl"));
+            loader.waitUntilBlocked();
+
+            manager.renderer(spec("progs/far.mdl"));
+            manager.renderer(spec("progs/near.mdl"));
+            manager.renderer(spec("progs/middle.mdl"));
+            manager.setLoadPriority(IO::Path("progs/far.mdl"), 300.0f);
+            manager.setLoadPriority(IO::Path("progs/near.mdl"), 100.0f);
+            manager.setLoadPriority(IO::Path("progs/middle.mdl"), 500.0f);
+            manager.setLoadPriority(IO::Path("progs/middle.mdl"), 200.0f);
+            loader.open();
+
+            IO::Path::List expected;
+            expected.push_back(IO::Path("progs/first.mdl"));
+            expected.push_back(IO::Path("progs/near.mdl"));
+            expected.push_back(IO::Path("progs/middle.mdl"));
+            expected.push_back(IO::Path("progs/far.mdl"));
+
+            prepareUntilLoaded(manager, expected);
+            ASSERT_EQ(expected, loader.loadedPaths());
+        }
+
+        TEST(EntityModelManagerTest, failToLoadModelInBackground) {
+            TaskScheduler scheduler(1);
+            TestEntityModelLoader loader;
+            EntityModelManager manager(nullptr, 0, 0, scheduler);
+            manager.setLoader(&loader);
+
+            const IO::Path path("progs/broken.bad");
+            ASSERT_FALSE(manager.hasModel(spec(path.asString())));
+            prepareUntilLoaded(manager, IO::Path::List(1, path));
+
+            // the failure is remembered and the model is not requested again
+            ASSERT_FALSE(manager.hasModel(spec(path.asString())));
+            ASSERT_FALSE(manager.isLoading(path));
+            ASSERT_TRUE(manager.safeGetModel(path) == nullptr);
+            ASSERT_EQ(IO::Path::List(1, path), loader.loadedPaths());
+        }
+
+        TEST(EntityModelManagerTest, clearWhileLoading) {
+            TaskScheduler scheduler(1);
+            TestEntityModelLoader loader;
+            EntityModelManager manager(nullptr, 0, 0, scheduler);
+            manager.setLoader(&loader);
+
+            loader.close();
+            manager.renderer(spec("progs/first.mdl"));
+            manager.renderer(spec("progs/second.mdl"));
+            loader.waitUntilBlocked();
+
+            // clearing waits for the running load, so open the loader from another thread
+            std::thread opener([&loader]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                loader.open();
+            });
+            manager.clear();
+            opener.join();
+
+            ASSERT_FALSE(manager.isLoading(IO::Path("progs/first.mdl")));
+            ASSERT_FALSE(manager.isLoading(IO::Path("progs/second.mdl")));
+            ASSERT_EQ(IO::Path::List(1, IO::Path("progs/first.mdl")), loader.loadedPaths());
+        }
+
+        TEST(EntityModelManagerTest, changeGamePathWhileLoading) {
+            TaskScheduler scheduler(1);
+            TestEntityModelLoader loader;
+            EntityModelManager manager(nullptr, 0, 0, scheduler);
+            manager.setLoader(&loader);
+
+            loader.close();
+            manager.renderer(spec("progs/first.mdl"));
+            manager.renderer(spec("progs/second.mdl"));
+            loader.waitUntilBlocked();
+
+            std::thread opener([&loader]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                loader.open();
+            });
+
+            // this is what the document does when the game path changes: the models are cleared before the game
+            // file system that the loader reads from is rebuilt, so no load may be running afterwards
+            manager.clear();
+            ASSERT_EQ(0u, loader.activeCount());
+            opener.join();
+
+            // models requested after the change are loaded again
+            manager.renderer(spec("progs/first.mdl"));
+            prepareUntilLoaded(manager, IO::Path::List(1, IO::Path("progs/first.mdl")));
+            ASSERT_FALSE(manager.isLoading(IO::Path("progs/first.mdl")));
+            ASSERT_EQ(2u, loader.loadedPaths().size());
+        }
+    }
+}
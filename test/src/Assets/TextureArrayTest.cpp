@@ -0,0 +1,164 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "CollectionUtils.h"
+#include "GL/GLMock.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureArray.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        static Texture* createTexture(const String& name, const size_t width, const size_t height, const GLenum format, const TextureType type, const size_t mipCount) {
+            TextureBuffer::List buffers(mipCount);
+            setMipBufferSize(buffers, width, height, format);
+            return new Texture(name, width, height, Color(0.0f, 0.0f, 0.0f, 1.0f), buffers, format, type);
+        }
+
+        static Texture* createTexture(const String& name) {
+            return createTexture(name, 64, 64, GL_RGB, TextureType::Opaque, 1);
+        }
+
+        TEST(TextureArrayTest, groupTexturesBySizeAndFormat) {
+            TextureList textures;
+            textures.push_back(createTexture("a"));
+            textures.push_back(createTexture("narrow", 32, 64, GL_RGB, TextureType::Opaque, 1));
+            textures.push_back(createTexture("rgba", 64, 64, GL_RGBA, TextureType::Opaque, 1));
+            textures.push_back(createTexture("masked", 64, 64, GL_RGB, TextureType::Masked, 1));
+            textures.push_back(createTexture("mips1", 64, 64, GL_RGB, TextureType::Opaque, 4));
+            textures.push_back(createTexture("b"));
+            textures.push_back(createTexture("mips2", 64, 64, GL_RGB, TextureType::Opaque, 4));
+
+            TextureArrayList arrays = TextureArray::createTextureArrays(textures, 16);
+            ASSERT_EQ(2u, arrays.size());
+
+            const TextureArray* plain = textures[0]->array();
+            ASSERT_TRUE(plain != nullptr);
+            ASSERT_EQ(plain, textures[5]->array());
+            ASSERT_EQ(2u, plain->layerCount());
+            ASSERT_EQ(64u, plain->width());
+            ASSERT_EQ(64u, plain->height());
+
+            const TextureArray* mipmapped = textures[4]->array();
+            ASSERT_TRUE(mipmapped != nullptr);
+            ASSERT_NE(plain, mipmapped);
+            ASSERT_EQ(mipmapped, textures[6]->array());
+            ASSERT_EQ(2u, mipmapped->layerCount());
+
+            // every other texture differs in exactly one property and has no partner
+            ASSERT_TRUE(textures[1]->array() == nullptr);
+            ASSERT_TRUE(textures[2]->array() == nullptr);
+            ASSERT_TRUE(textures[3]->array() == nullptr);
+
+            VectorUtils::clearAndDelete(arrays);
+            VectorUtils::clearAndDelete(textures);
+        }
+
+        TEST(TextureArrayTest, assignLayersInOrder) {
+            TextureList textures;
+            for (size_t i = 0; i < 4; ++i)
+                textures.push_back(createTexture("texture"));
+
+            TextureArrayList arrays = TextureArray::createTextureArrays(textures, 16);
+            ASSERT_EQ(1u, arrays.size());
+            ASSERT_EQ(4u, arrays.front()->layerCount());
+
+            for (size_t i = 0; i < textures.size(); ++i) {
+                ASSERT_EQ(arrays.front(), textures[i]->array());
+                ASSERT_EQ(i, textures[i]->arrayLayer());
+            }
+
+            // the textures are detached from the array when it is destroyed
+            VectorUtils::clearAndDelete(arrays);
+            for (const Texture* texture : textures)
+                ASSERT_TRUE(texture->array() == nullptr);
+
+            VectorUtils::clearAndDelete(textures);
+        }
+
+        TEST(TextureArrayTest, splitGroupsAtMaxLayers) {
+            TextureList textures;
+            for (size_t i = 0; i < 7; ++i)
+                textures.push_back(createTexture("texture"));
+
+            TextureArrayList arrays = TextureArray::createTextureArrays(textures, 3);
+            ASSERT_EQ(2u, arrays.size());
+            ASSERT_EQ(3u, arrays[0]->layerCount());
+            ASSERT_EQ(3u, arrays[1]->layerCount());
+
+            for (size_t i = 0; i < 6; ++i) {
+                ASSERT_EQ(arrays[i / 3], textures[i]->array());
+                ASSERT_EQ(i % 3, textures[i]->arrayLayer());
+            }
+
+            // the last chunk only has a single texture, so it does not get an array
+            ASSERT_TRUE(textures[6]->array() == nullptr);
+
+            VectorUtils::clearAndDelete(arrays);
+            VectorUtils::clearAndDelete(textures);
+        }
+
+        TEST(TextureArrayTest, skipSingleTextureGroups) {
+            TextureList textures;
+            textures.push_back(createTexture("small", 16, 16, GL_RGB, TextureType::Opaque, 1));
+            textures.push_back(createTexture("large", 128, 128, GL_RGB, TextureType::Opaque, 1));
+
+            const TextureArrayList arrays = TextureArray::createTextureArrays(textures, 16);
+            ASSERT_TRUE(arrays.empty());
+            ASSERT_TRUE(textures[0]->array() == nullptr);
+            ASSERT_TRUE(textures[1]->array() == nullptr);
+
+            VectorUtils::clearAndDelete(textures);
+        }
+
+        TEST(TextureArrayTest, skipPreparedTexturesAndTexturesWithoutBuffers) {
+            using namespace testing;
+            NiceMock<GLMock> glMock;
+
+            TextureList textures;
+            textures.push_back(createTexture("a"));
+            textures.push_back(new Texture("placeholder", 64, 64));
+            textures.push_back(createTexture("prepared"));
+            textures.push_back(createTexture("b"));
+
+            textures[2]->prepare(13, GL_NEAREST, GL_NEAREST);
+            ASSERT_TRUE(textures[2]->isPrepared());
+
+            TextureArrayList arrays = TextureArray::createTextureArrays(textures, 16);
+            ASSERT_EQ(1u, arrays.size());
+            ASSERT_EQ(2u, arrays.front()->layerCount());
+
+            ASSERT_EQ(arrays.front(), textures[0]->array());
+            ASSERT_EQ(0u, textures[0]->arrayLayer());
+            ASSERT_EQ(arrays.front(), textures[3]->array());
+            ASSERT_EQ(1u, textures[3]->arrayLayer());
+            ASSERT_TRUE(textures[1]->array() == nullptr);
+            ASSERT_TRUE(textures[2]->array() == nullptr);
+
+            // textures that already belong to an array are not added to another one
+            ASSERT_TRUE(TextureArray::createTextureArrays(textures, 16).empty());
+
+            VectorUtils::clearAndDelete(arrays);
+            VectorUtils::clearAndDelete(textures);
+        }
+    }
+}
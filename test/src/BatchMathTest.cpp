@@ -0,0 +1,162 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BatchMath.h"
+#include "VecMath.h"
+
+#include "TestUtils.h"
+
+#include <random>
+#include <vector>
+
+template <typename T>
+static typename Vec<T,3>::List randomPoints(const size_t count) {
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<T> distribution(static_cast<T>(-1024.0), static_cast<T>(1024.0));
+
+    typename Vec<T,3>::List result;
+    for (size_t i = 0; i < count; ++i)
+        result.push_back(Vec<T,3>(distribution(random), distribution(random), distribution(random)));
+    return result;
+}
+
+template <typename T>
+static Mat<T,4,4> affineTransformation() {
+    return translationMatrix(Vec<T,3>(32.0, -16.0, 8.0)) * rotationMatrix(Vec<T,3>(1.0, 2.0, 3.0).normalized(), static_cast<T>(0.3)) * scalingMatrix(Vec<T,3>(2.0, 0.5, 1.5));
+}
+
+template <typename T>
+static Mat<T,4,4> projectiveTransformation() {
+    Mat<T,4,4> result = affineTransformation<T>();
+    result[0][3] = static_cast<T>(0.001);
+    result[2][3] = static_cast<T>(-0.002);
+    result[3][3] = static_cast<T>(4.0);
+    return result;
+}
+
+template <typename T>
+static void assertTransformsPoints(const Mat<T,4,4>& transformation) {
+    // odd count to cover the points that don't fill a whole register
+    const typename Vec<T,3>::List points = randomPoints<T>(101);
+
+    typename Vec<T,3>::List result(points.size());
+    BatchMath::transformPoints(transformation, points.data(), points.size(), result.data());
+    for (size_t i = 0; i < points.size(); ++i)
+        ASSERT_EQ(transformation * points[i], result[i]);
+
+    typename Vec<T,3>::List inPlace = points;
+    BatchMath::transformPoints(transformation, inPlace.data(), inPlace.size(), inPlace.data());
+    ASSERT_EQ(result, inPlace);
+}
+
+TEST(BatchMathTest, transformPoints) {
+    assertTransformsPoints(affineTransformation<float>());
+    assertTransformsPoints(projectiveTransformation<float>());
+    assertTransformsPoints(affineTransformation<double>());
+    assertTransformsPoints(projectiveTransformation<double>());
+}
+
+template <typename T>
+static void assertTransformedBounds(const Mat<T,4,4>& transformation) {
+    const typename Vec<T,3>::List points = randomPoints<T>(101);
+    ASSERT_EQ(BatchMath::Scalar::transformedBounds(transformation, points.data(), points.size()),
+              BatchMath::transformedBounds(transformation, points.data(), points.size()));
+    ASSERT_EQ(BatchMath::Scalar::transformedBounds(transformation, points.data(), 1),
+              BatchMath::transformedBounds(transformation, points.data(), 1));
+}
+
+TEST(BatchMathTest, transformedBounds) {
+    assertTransformedBounds(affineTransformation<float>());
+    assertTransformedBounds(projectiveTransformation<float>());
+    assertTransformedBounds(affineTransformation<double>());
+    assertTransformedBounds(projectiveTransformation<double>());
+}
+
+TEST(BatchMathTest, boundsOfPointsInVertices) {
+    struct Vertex {
+        Vec3f position;
+        Vec2f texCoords;
+    };
+
+    const Vec3f::List points = randomPoints<float>(37);
+    std::vector<Vertex> vertices;
+    for (const Vec3f& point : points)
+        vertices.push_back(Vertex{ point, Vec2f(point.x(), point.y()) });
+
+    const BBox3f expected(points);
+    ASSERT_EQ(expected, BatchMath::boundsOfPoints(&vertices.front().position, vertices.size(), sizeof(Vertex)));
+    ASSERT_EQ(expected, BatchMath::boundsOfPoints(points.data(), points.size()));
+
+    const Mat4x4f transformation = affineTransformation<float>();
+    ASSERT_EQ(BatchMath::Scalar::transformedBounds(transformation, points.data(), points.size()),
+              BatchMath::transformedBounds(transformation, &vertices.front().position, vertices.size(), sizeof(Vertex)));
+}
+
+template <typename T>
+static void assertMergesBounds() {
+    const typename Vec<T,3>::List points = randomPoints<T>(64);
+    std::vector<BBox<T,3>> boxes;
+    for (size_t i = 0; i < points.size(); i += 2)
+        boxes.push_back(BBox<T,3>(points[i], points[i]).mergeWith(points[i + 1]));
+
+    const BBox<T,3> expected(points);
+    ASSERT_EQ(expected, BatchMath::Scalar::mergeBounds(boxes.data(), boxes.size()));
+    ASSERT_EQ(expected, BatchMath::mergeBounds(boxes.data(), boxes.size()));
+    ASSERT_EQ(boxes.front(), BatchMath::mergeBounds(boxes.data(), 1));
+}
+
+TEST(BatchMathTest, mergeBounds) {
+    assertMergesBounds<float>();
+    assertMergesBounds<double>();
+}
+
+TEST(BatchMathTest, classifyPoints) {
+    using namespace BatchMath::PointStatusMask;
+
+    const Plane3d plane(8.0, Vec3d::PosZ);
+    const Vec3d::List points {
+        Vec3d(0.0, 0.0, 16.0),
+        Vec3d(0.0, 0.0, 8.0),
+        Vec3d(0.0, 0.0, 0.0),
+        Vec3d(0.0, 0.0, 8.00001),
+        Vec3d(0.0, 0.0, 7.0)
+    };
+
+    ASSERT_EQ(0u, BatchMath::classifyPoints(plane, points.data(), 0));
+    ASSERT_EQ(PSAbove, BatchMath::classifyPoints(plane, points.data(), 1));
+    ASSERT_EQ(PSAbove | PSInside, BatchMath::classifyPoints(plane, points.data(), 2));
+    ASSERT_EQ(PSAbove | PSInside | PSBelow, BatchMath::classifyPoints(plane, points.data(), 3));
+    ASSERT_EQ(PSInside, BatchMath::classifyPoints(plane, points.data() + 1, 1));
+    ASSERT_EQ(PSInside | PSBelow, BatchMath::classifyPoints(plane, points.data() + 3, 2));
+    ASSERT_EQ(PSBelow, BatchMath::classifyPoints(plane, points.data() + 4, 1));
+}
+
+TEST(BatchMathTest, classifyRandomPoints) {
+    const Vec3d::List points = randomPoints<double>(101);
+    for (size_t i = 0; i < 16; ++i) {
+        const Plane3d plane(static_cast<double>(i) * 64.0 - 512.0, Vec3d(1.0, static_cast<double>(i), 2.0).normalized());
+        for (size_t count = 1; count <= 4; ++count) {
+            for (size_t first = 0; first + count <= points.size(); first += 7)
+                ASSERT_EQ(BatchMath::Scalar::classifyPoints(plane, points.data() + first, count),
+                          BatchMath::classifyPoints(plane, points.data() + first, count));
+        }
+    }
+}
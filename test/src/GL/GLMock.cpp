@@ -63,6 +63,8 @@ namespace TrenchBroom {
         glTexParameterf.bindMemFunc(this, &GLMock::TexParameterf);
         glTexParameteri.bindMemFunc(this, &GLMock::TexParameteri);
         glTexImage2D.bindMemFunc(this, &GLMock::TexImage2D);
+        glTexImage3D.bindMemFunc(this, &GLMock::TexImage3D);
+        glGenerateMipmap.bindMemFunc(this, &GLMock::GenerateMipmap);
         glActiveTexture.bindMemFunc(this, &GLMock::ActiveTexture);
         
         glGenBuffers.bindMemFunc(this, &GLMock::GenBuffers);
@@ -73,6 +75,13 @@ namespace TrenchBroom {
         glMapBuffer.bindMemFunc(this, &GLMock::MapBuffer);
         glUnmapBuffer.bindMemFunc(this, &GLMock::UnmapBuffer);
         
+        glGenQueries.bindMemFunc(this, &GLMock::GenQueries);
+        glDeleteQueries.bindMemFunc(this, &GLMock::DeleteQueries);
+        glBeginQuery.bindMemFunc(this, &GLMock::BeginQuery);
+        glEndQuery.bindMemFunc(this, &GLMock::EndQuery);
+        glGetQueryObjectiv.bindMemFunc(this, &GLMock::GetQueryObjectiv);
+        glGetQueryObjectuiv.bindMemFunc(this, &GLMock::GetQueryObjectuiv);
+        
         glEnableVertexAttribArray.bindMemFunc(this, &GLMock::EnableVertexAttribArray);
         glDisableVertexAttribArray.bindMemFunc(this, &GLMock::DisableVertexAttribArray);
         glEnableClientState.bindMemFunc(this, &GLMock::EnableClientState);
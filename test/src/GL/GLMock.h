@@ -70,6 +70,8 @@ namespace TrenchBroom {
         MOCK_METHOD3(TexParameterf, void(GLenum, GLenum, GLfloat));
         MOCK_METHOD3(TexParameteri, void(GLenum, GLenum, GLint));
         MOCK_METHOD9(TexImage2D, void(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*));
+        MOCK_METHOD10(TexImage3D, void(GLenum, GLint, GLint, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*));
+        MOCK_METHOD1(GenerateMipmap, void(GLenum));
         MOCK_METHOD1(ActiveTexture, void(GLenum));
         
         MOCK_METHOD2(GenBuffers, void(GLsizei, GLuint*));
@@ -80,6 +82,13 @@ namespace TrenchBroom {
         MOCK_METHOD2(MapBuffer, void*(GLenum, GLenum));
         MOCK_METHOD1(UnmapBuffer, GLboolean(GLenum));
         
+        MOCK_METHOD2(GenQueries, void(GLsizei, GLuint*));
+        MOCK_METHOD2(DeleteQueries, void(GLsizei, const GLuint*));
+        MOCK_METHOD2(BeginQuery, void(GLenum, GLuint));
+        MOCK_METHOD1(EndQuery, void(GLenum));
+        MOCK_METHOD3(GetQueryObjectiv, void(GLuint, GLenum, GLint*));
+        MOCK_METHOD3(GetQueryObjectuiv, void(GLuint, GLenum, GLuint*));
+        
         MOCK_METHOD1(EnableVertexAttribArray, void(GLuint));
         MOCK_METHOD1(DisableVertexAttribArray, void(GLuint));
         MOCK_METHOD1(EnableClientState, void(GLenum));
@@ -565,6 +565,92 @@ namespace TrenchBroom {
             VectorUtils::clearAndDelete(definitions);
         }
         
+        TEST(FgdParserTest, parseMergedFlagsDoNotChangeBaseClass) {
+            const String file =
+            "@BaseClass = Appearflags [ spawnflags(Flags) = [ 256 : \"Not on Easy\" : 0 ] ]\n"
+            "@BaseClass = Static [ spawnflags(Flags) = [ 1 : \"Force Static\" : 0 ] ]\n"
+            "@PointClass base(Appearflags, Static) = light []\n"
+            "@PointClass base(Static) = light_static []\n";
+            
+            const Color defaultColor(1.0f, 1.0f, 1.0f, 1.0f);
+            FgdParser parser(file, defaultColor);
+            
+            TestParserStatus status;
+            Assets::EntityDefinitionList definitions = parser.parseDefinitions(status);
+            ASSERT_EQ(2u, definitions.size());
+            
+            const Assets::FlagsAttributeDefinition* lightFlags = static_cast<const Assets::FlagsAttributeDefinition*>(definitions[0]->attributeDefinition("spawnflags"));
+            ASSERT_EQ(2u, lightFlags->options().size());
+            
+            // merging the flags of the light must not add them to the flags of the base class
+            const Assets::FlagsAttributeDefinition* staticFlags = static_cast<const Assets::FlagsAttributeDefinition*>(definitions[1]->attributeDefinition("spawnflags"));
+            ASSERT_EQ(1u, staticFlags->options().size());
+            ASSERT_EQ(1, staticFlags->options()[0].value());
+            
+            VectorUtils::clearAndDelete(definitions);
+        }
+        
+        static String largeFgd(const size_t classCount, const String& lastClass) {
+            StringStream str;
+            str << "// a large file that is parsed in sections\n";
+            for (size_t i = 0; i < classCount; ++i) {
+                str << "@BaseClass = Base" << i << " [ base" << i << "(string) : \"Base " << i << "\" ]\n";
+                str << "@PointClass base(Base" << i << ") color(0 255 0) = class" << i << " : \"Class " << i << "\"\n"
+                    << "[\n"
+                    << "\tdescription(string) : \"A string with an @ and a [\"\n"
+                    << "]\n";
+            }
+            str << lastClass;
+            return str.str();
+        }
+        
+        TEST(FgdParserTest, parseLargeFile) {
+            // the redefined base class must only affect the classes after it
+            const String file = largeFgd(1000,
+                                         "@BaseClass = Base0 [ redefined(string) : \"Redefined\" ]\n"
+                                         "@PointClass base(Base0) unknown(1) = last []\n");
+            
+            const Color defaultColor(1.0f, 1.0f, 1.0f, 1.0f);
+            FgdParser parser(file, defaultColor);
+            
+            TestParserStatus status;
+            Assets::EntityDefinitionList definitions = parser.parseDefinitions(status);
+            ASSERT_EQ(1001u, definitions.size());
+            
+            // one warning about the unknown attribute and one about the redefinition, whatever level they are logged at
+            ASSERT_EQ(2u, status.countStatus(Logger::LogLevel_Debug) + status.countStatus(Logger::LogLevel_Warn));
+            
+            for (size_t i = 0; i < 1000; ++i) {
+                const Assets::EntityDefinition* definition = definitions[i];
+                ASSERT_EQ("class" + std::to_string(i), definition->name());
+                ASSERT_EQ("Class " + std::to_string(i), definition->description());
+                ASSERT_EQ(2u, definition->attributeDefinitions().size());
+                ASSERT_TRUE(definition->attributeDefinition("base" + std::to_string(i)) != nullptr);
+            }
+            
+            ASSERT_EQ(String("last"), definitions.back()->name());
+            ASSERT_TRUE(definitions.back()->attributeDefinition("redefined") != nullptr);
+            ASSERT_TRUE(definitions.back()->attributeDefinition("base0") == nullptr);
+            
+            VectorUtils::clearAndDelete(definitions);
+        }
+        
+        TEST(FgdParserTest, parseLargeFileWithError) {
+            const String file = largeFgd(1000, "@PointClass = broken [ ( ]\n");
+            const size_t lastLine = 1 + 5 * 1000 + 1;
+            
+            const Color defaultColor(1.0f, 1.0f, 1.0f, 1.0f);
+            FgdParser parser(file, defaultColor);
+            
+            TestParserStatus status;
+            try {
+                parser.parseDefinitions(status);
+                FAIL();
+            } catch (const ParserException& e) {
+                ASSERT_TRUE(StringUtils::containsCaseSensitive(e.what(), "[line " + std::to_string(lastLine) + ", column 24]")) << e.what();
+            }
+        }
+        
         static const String ModelDefinitionTemplate =
         "@PointClass\n"
         "    model(${MODEL}) = item_shells : \"Shells\" []\n";
@@ -0,0 +1,186 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "StringUtils.h"
+#include "TestUtils.h"
+#include "IO/MapCache.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/World.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace IO {
+        static String writeCache(const Model::World* world, const String& data) {
+            StringStream str;
+            MapCacheWriter writer(world, data.data(), data.data() + data.size(), str);
+            writer.writeCache();
+            return str.str();
+        }
+
+        static Model::World* readCache(const String& cache, const Model::MapFormat::Type format, const String& data) {
+            MapCacheReader reader(cache.data(), cache.data() + cache.size(), nullptr);
+            return reader.read(format, BBox3(8192.0), data.data(), data.data() + data.size());
+        }
+
+        static Model::World* readMap(const String& data, const Model::MapFormat::Type format) {
+            TestParserStatus status;
+            WorldReader reader(data, nullptr);
+            return reader.read(format, BBox3(8192.0), status);
+        }
+
+        TEST(MapCacheTest, roundTripStandardMap) {
+            const String data("{\n"
+                              "\"classname\" \"worldspawn\"\n"
+                              "\"message\" \"yay\"\n"
+                              "{\n"
+                              "( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1\n"
+                              "( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none 0 0 0 1 1\n"
+                              "( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none 0 0 0 1 1\n"
+                              "( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none 0 0 0 1 1\n"
+                              "( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none 0 0 0 1 1\n"
+                              "( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none 0 0 0 1 1\n"
+                              "}\n"
+                              "}\n"
+                              "{\n"
+                              "\"classname\" \"func_group\"\n"
+                              "\"_tb_type\" \"_tb_layer\"\n"
+                              "\"_tb_name\" \"Custom Layer\"\n"
+                              "\"_tb_id\" \"1\"\n"
+                              "}\n"
+                              "{\n"
+                              "\"classname\" \"func_group\"\n"
+                              "\"_tb_type\" \"_tb_group\"\n"
+                              "\"_tb_name\" \"Group\"\n"
+                              "\"_tb_id\" \"2\"\n"
+                              "\"_tb_layer\" \"1\"\n"
+                              "{\n"
+                              "( 96 -32 -32 ) ( 96 -31 -32 ) ( 96 -32 -31 ) tex1 16 8 45 0.5 2\n"
+                              "( 160 32 32 ) ( 160 32 33 ) ( 160 33 32 ) tex1 0 0 0 1 1\n"
+                              "( 96 -32 -32 ) ( 96 -32 -31 ) ( 97 -32 -32 ) tex2 0 0 0 1 1\n"
+                              "( 160 32 32 ) ( 161 32 32 ) ( 160 32 33 ) tex2 0 0 0 1 1\n"
+                              "( 160 32 32 ) ( 160 33 32 ) ( 161 32 32 ) tex1 0 0 0 1 1\n"
+                              "( 96 -32 -32 ) ( 97 -32 -32 ) ( 96 -31 -32 ) tex1 0 0 0 1 1\n"
+                              "}\n"
+                              "}\n"
+                              "{\n"
+                              "\"classname\" \"light\"\n"
+                              "\"origin\" \"0 0 64\"\n"
+                              "\"_tb_group\" \"2\"\n"
+                              "}\n");
+
+            std::unique_ptr<Model::World> world(readMap(data, Model::MapFormat::Standard));
+            const String cache = writeCache(world.get(), data);
+
+            std::unique_ptr<Model::World> cached(readCache(cache, Model::MapFormat::Standard, data));
+            ASSERT_EQ(cache, writeCache(cached.get(), data));
+
+            ASSERT_EQ("yay", cached->attribute("message"));
+            ASSERT_EQ(world->lineNumber(), cached->lineNumber());
+            ASSERT_EQ(world->lineCount(), cached->lineCount());
+            ASSERT_EQ(1u, cached->defaultLayer()->childCount());
+
+            const Model::LayerList customLayers = cached->customLayers();
+            ASSERT_EQ(1u, customLayers.size());
+            ASSERT_EQ("Custom Layer", customLayers.front()->name());
+            ASSERT_EQ(1u, customLayers.front()->childCount());
+
+            const Model::Group* group = static_cast<Model::Group*>(customLayers.front()->children().front());
+            ASSERT_EQ("Group", group->name());
+            ASSERT_EQ(2u, group->childCount());
+
+            const Model::Brush* brush = static_cast<Model::Brush*>(group->children().front());
+            const Model::BrushFace* face = brush->findFace(Vec3::NegX);
+            ASSERT_TRUE(face != nullptr);
+            ASSERT_EQ("tex1", face->textureName());
+            ASSERT_FLOAT_EQ(16.0f, face->xOffset());
+            ASSERT_FLOAT_EQ(8.0f, face->yOffset());
+            ASSERT_FLOAT_EQ(45.0f, face->rotation());
+            ASSERT_FLOAT_EQ(0.5f, face->xScale());
+            ASSERT_FLOAT_EQ(2.0f, face->yScale());
+
+            const Model::Entity* light = static_cast<Model::Entity*>(group->children().back());
+            ASSERT_EQ("light", light->classname());
+            ASSERT_EQ("0 0 64", light->attribute("origin"));
+        }
+
+        TEST(MapCacheTest, roundTripValveMap) {
+            const String data("{\n"
+                              "\"classname\" \"worldspawn\"\n"
+                              "{\n"
+                              "( -800 288 1024 ) ( -736 288 1024 ) ( -736 224 1024 ) METAL4_5 [ 1 0 0 64 ] [ 0 -1 0 0 ] 0 1 1\n"
+                              "( -800 288 1024 ) ( -800 224 1024 ) ( -800 224 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1\n"
+                              "( -736 224 1024 ) ( -736 288 1024 ) ( -736 288 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1\n"
+                              "( -736 288 1024 ) ( -800 288 1024 ) ( -800 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1\n"
+                              "( -800 224 1024 ) ( -736 224 1024 ) ( -736 224 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1\n"
+                              "( -800 224 576 ) ( -736 224 576 ) ( -736 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 1 0 0 ] 0 1 1\n"
+                              "}\n"
+                              "}\n");
+
+            std::unique_ptr<Model::World> world(readMap(data, Model::MapFormat::Valve));
+            const String cache = writeCache(world.get(), data);
+
+            std::unique_ptr<Model::World> cached(readCache(cache, Model::MapFormat::Valve, data));
+            ASSERT_EQ(cache, writeCache(cached.get(), data));
+
+            const Model::Brush* brush = static_cast<Model::Brush*>(cached->defaultLayer()->children().front());
+            const Model::BrushFace* face = brush->findFace(Vec3::PosZ);
+            ASSERT_TRUE(face != nullptr);
+            ASSERT_VEC_EQ(Vec3::PosX, face->textureXAxis());
+            ASSERT_VEC_EQ(Vec3::NegY, face->textureYAxis());
+        }
+
+        TEST(MapCacheTest, rejectMismatchingCache) {
+            const String data("{\n"
+                              "\"classname\" \"worldspawn\"\n"
+                              "{\n"
+                              "( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1\n"
+                              "( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none 0 0 0 1 1\n"
+                              "( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none 0 0 0 1 1\n"
+                              "( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none 0 0 0 1 1\n"
+                              "( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none 0 0 0 1 1\n"
+                              "( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none 0 0 0 1 1\n"
+                              "}\n"
+                              "}\n");
+
+            std::unique_ptr<Model::World> world(readMap(data, Model::MapFormat::Standard));
+            const String cache = writeCache(world.get(), data);
+
+            ASSERT_THROW(readCache(cache, Model::MapFormat::Standard, data + " "), FileFormatException);
+            ASSERT_THROW(readCache(cache, Model::MapFormat::Valve, data), FileFormatException);
+            ASSERT_THROW(readCache(cache.substr(0, cache.size() - 1), Model::MapFormat::Standard, data), FileFormatException);
+            ASSERT_THROW(readCache("not a map cache", Model::MapFormat::Standard, data), FileFormatException);
+
+            // same size, different contents
+            String changed = data;
+            changed.replace(changed.find("-32 -32 -32"), 3, "-16");
+            ASSERT_EQ(data.size(), changed.size());
+            ASSERT_THROW(readCache(cache, Model::MapFormat::Standard, changed), FileFormatException);
+        }
+    }
+}
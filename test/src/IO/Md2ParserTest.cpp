@@ -0,0 +1,126 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+#include "Assets/Md2Model.h"
+#include "Assets/Palette.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
+#include "IO/Md2Parser.h"
+#include "IO/Path.h"
+#include "Renderer/TexturedIndexRangeRenderer.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace IO {
+        template <typename T>
+        static void append(String& data, const T value) {
+            data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        static void appendVec(String& data, const Vec3f& vec) {
+            for (size_t i = 0; i < 3; ++i)
+                append(data, vec[i]);
+        }
+
+        /**
+         * Creates a model with a single triangle fan. The vertices of frame i are (i, 0, 0), (i + 1, 0, 0) and
+         * (i, 2, 0).
+         */
+        static String createMd2(const int frameCount, const String& skinName) {
+            static const int HeaderSize = 17 * 4;
+            static const int SkinSize = static_cast<int>(Md2Layout::SkinNameLength);
+            static const int FrameSize = 12 + 12 + static_cast<int>(Md2Layout::FrameNameLength) + 3 * 4;
+            static const int CommandCount = 1 + 3 * 3 + 1;
+
+            String data;
+            append<int32_t>(data, Md2Layout::Ident);
+            append<int32_t>(data, Md2Layout::Version);
+            append<int32_t>(data, 4); // skin width
+            append<int32_t>(data, 4); // skin height
+            append<int32_t>(data, FrameSize);
+            append<int32_t>(data, 1); // skins
+            append<int32_t>(data, 3); // vertices
+            append<int32_t>(data, 0); // texture coordinates
+            append<int32_t>(data, 0); // triangles
+            append<int32_t>(data, CommandCount);
+            append<int32_t>(data, frameCount);
+            append<int32_t>(data, HeaderSize); // skin offset
+            append<int32_t>(data, 0); // texture coordinate offset
+            append<int32_t>(data, 0); // triangle offset
+            append<int32_t>(data, HeaderSize + SkinSize); // frame offset
+            append<int32_t>(data, HeaderSize + SkinSize + frameCount * FrameSize); // command offset
+            append<int32_t>(data, HeaderSize + SkinSize + frameCount * FrameSize + CommandCount * 4); // end offset
+
+            String skin = skinName;
+            skin.resize(Md2Layout::SkinNameLength, '\0');
+            data.append(skin);
+
+            for (int i = 0; i < frameCount; ++i) {
+                appendVec(data, Vec3f(1.0f, 1.0f, 1.0f)); // scale
+                appendVec(data, Vec3f::Null); // offset
+                data.append(Md2Layout::FrameNameLength, '\0');
+
+                const unsigned char x = static_cast<unsigned char>(i);
+                const unsigned char vertices[3][4] = { { x, 0, 0, 0 }, { static_cast<unsigned char>(x + 1), 0, 0, 0 }, { x, 2, 0, 0 } };
+                for (size_t j = 0; j < 3; ++j)
+                    data.append(reinterpret_cast<const char*>(vertices[j]), 4);
+            }
+
+            append<int32_t>(data, -3); // triangle fan
+            for (int32_t i = 0; i < 3; ++i) {
+                append<float>(data, 0.0f);
+                append<float>(data, 0.0f);
+                append<int32_t>(data, i);
+            }
+            append<int32_t>(data, 0);
+
+            return data;
+        }
+
+        TEST(Md2ParserTest, buildFramesOnDemand) {
+            DiskFileSystem fs(IO::Disk::getCurrentWorkingDir() + Path("data"));
+            const Assets::Palette palette = Assets::Palette::loadFile(fs, Path("palette.lmp"));
+
+            const String data = createMd2(10, "IO/Md2/skin.pcx");
+            Md2Parser parser("test", data.data(), data.data() + data.size(), palette, fs);
+            std::unique_ptr<Assets::Md2Model> model(static_cast<Assets::Md2Model*>(parser.parseModel()));
+
+            ASSERT_EQ(10u, model->frameCount());
+            ASSERT_EQ(0u, model->builtFrameCount());
+
+            const BBox3f bounds = model->bounds(0, 3);
+            ASSERT_VEC_EQ(Vec3f(3.0f, 0.0f, 0.0f), bounds.min);
+            ASSERT_VEC_EQ(Vec3f(4.0f, 2.0f, 0.0f), bounds.max);
+            ASSERT_EQ(1u, model->builtFrameCount());
+
+            // the built frame is reused
+            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> renderer(model->buildRenderer(0, 3));
+            ASSERT_TRUE(renderer != nullptr);
+            ASSERT_EQ(1u, model->builtFrameCount());
+
+            renderer.reset(model->buildRenderer(0, 7));
+            ASSERT_TRUE(renderer != nullptr);
+            ASSERT_EQ(2u, model->builtFrameCount());
+        }
+    }
+}
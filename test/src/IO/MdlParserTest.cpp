@@ -0,0 +1,126 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+#include "Assets/MdlModel.h"
+#include "Assets/Palette.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
+#include "IO/MdlParser.h"
+#include "IO/Path.h"
+#include "Renderer/TexturedIndexRangeRenderer.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace IO {
+        template <typename T>
+        static void append(String& data, const T value) {
+            data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        static void appendVec(String& data, const Vec3f& vec) {
+            for (size_t i = 0; i < 3; ++i)
+                append(data, vec[i]);
+        }
+
+        /**
+         * Creates a model with a 4x4 skin and a single triangle. The triangle of frame i has the vertices
+         * (i, 0, 0), (i + 1, 0, 0) and (i, 2, 0).
+         */
+        static String createMdl(const int frameCount) {
+            String data;
+            data.append("IDPO");
+            append<int32_t>(data, 6);
+            appendVec(data, Vec3f(1.0f, 1.0f, 1.0f)); // scale
+            appendVec(data, Vec3f::Null); // origin
+            append<float>(data, 16.0f); // radius
+            appendVec(data, Vec3f::Null); // eye position
+            append<int32_t>(data, 1); // skins
+            append<int32_t>(data, 4); // skin width
+            append<int32_t>(data, 4); // skin height
+            append<int32_t>(data, 3); // vertices
+            append<int32_t>(data, 1); // triangles
+            append<int32_t>(data, frameCount);
+            append<int32_t>(data, 0); // sync type
+            append<int32_t>(data, 0); // flags
+            append<float>(data, 1.0f); // size
+
+            append<int32_t>(data, 0); // single skin
+            data.append(16, '\x01');
+
+            const int skinVertices[3][2] = { { 0, 0 }, { 2, 0 }, { 0, 2 } };
+            for (size_t i = 0; i < 3; ++i) {
+                append<int32_t>(data, 0); // on seam
+                append<int32_t>(data, skinVertices[i][0]);
+                append<int32_t>(data, skinVertices[i][1]);
+            }
+
+            append<int32_t>(data, 1); // front facing
+            for (int32_t i = 0; i < 3; ++i)
+                append<int32_t>(data, i);
+
+            for (int i = 0; i < frameCount; ++i) {
+                append<int32_t>(data, 0); // single frame
+                data.append(8, '\0'); // bounds
+                data.append(16, '\0'); // name
+
+                const unsigned char x = static_cast<unsigned char>(i);
+                const unsigned char vertices[3][4] = { { x, 0, 0, 0 }, { static_cast<unsigned char>(x + 1), 0, 0, 0 }, { x, 2, 0, 0 } };
+                for (size_t j = 0; j < 3; ++j)
+                    data.append(reinterpret_cast<const char*>(vertices[j]), 4);
+            }
+
+            return data;
+        }
+
+        TEST(MdlParserTest, buildFramesOnDemand) {
+            DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+            const Assets::Palette palette = Assets::Palette::loadFile(fs, Path("data/palette.lmp"));
+
+            const String data = createMdl(10);
+            MdlParser parser("test", data.data(), data.data() + data.size(), palette);
+            std::unique_ptr<Assets::MdlModel> model(static_cast<Assets::MdlModel*>(parser.parseModel()));
+
+            ASSERT_EQ(10u, model->frameCount());
+            ASSERT_EQ(0u, model->builtFrameCount());
+
+            // the bounds are known without building the frame
+            const BBox3f bounds = model->bounds(0, 3);
+            ASSERT_VEC_EQ(Vec3f(3.0f, 0.0f, 0.0f), bounds.min);
+            ASSERT_VEC_EQ(Vec3f(4.0f, 2.0f, 0.0f), bounds.max);
+            ASSERT_EQ(0u, model->builtFrameCount());
+
+            const BBox3f transformedBounds = model->transformedBounds(0, 3, translationMatrix(Vec3f(1.0f, 0.0f, 0.0f)));
+            ASSERT_VEC_EQ(Vec3f(4.0f, 0.0f, 0.0f), transformedBounds.min);
+            ASSERT_VEC_EQ(Vec3f(5.0f, 2.0f, 0.0f), transformedBounds.max);
+            ASSERT_EQ(1u, model->builtFrameCount());
+
+            std::unique_ptr<Renderer::TexturedIndexRangeRenderer> renderer(model->buildRenderer(0, 3));
+            ASSERT_TRUE(renderer != nullptr);
+            ASSERT_EQ(1u, model->builtFrameCount());
+
+            renderer.reset(model->buildRenderer(0, 7));
+            ASSERT_TRUE(renderer != nullptr);
+            ASSERT_EQ(2u, model->builtFrameCount());
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "IO/TextScanner.h"
+
+#include <cstdlib>
+#include <random>
+#include <sstream>
+
+namespace TrenchBroom {
+    namespace IO {
+        static float readFloat(const String& str) {
+            TextScanner scanner(str.data(), str.data() + str.size());
+            return scanner.readFloat();
+        }
+
+        TEST(TextScannerTest, readWordsAndNumbers) {
+            const String str("  word 12 -3.5\n  ( 1e3");
+            TextScanner scanner(str.data(), str.data() + str.size());
+            ASSERT_EQ("word", scanner.readWord());
+            ASSERT_EQ(12, scanner.readInteger());
+            ASSERT_EQ(-3.5f, scanner.readFloat());
+            scanner.expect('(');
+            ASSERT_EQ(2u, scanner.line());
+            ASSERT_EQ(1000.0f, scanner.readFloat());
+            ASSERT_TRUE(scanner.eof());
+        }
+
+        TEST(TextScannerTest, readInvalidFloat) {
+            ASSERT_THROW(readFloat("1.2.3"), ParserException);
+            ASSERT_THROW(readFloat("abc"), ParserException);
+        }
+
+        TEST(TextScannerTest, readFloatMatchesStrtof) {
+            std::mt19937 random(0);
+            std::uniform_int_distribution<int> digitCount(1, 12);
+            std::uniform_int_distribution<int> digit(0, 9);
+
+            for (size_t i = 0; i < 100000; ++i) {
+                // numbers with up to 12 digits in total, split at a random position by the decimal point
+                const int integerDigits = digitCount(random);
+                const int fractionDigits = digitCount(random) - 1;
+
+                std::stringstream str;
+                if (i % 2 == 0)
+                    str << '-';
+                for (int j = 0; j < integerDigits; ++j)
+                    str << digit(random);
+                if (fractionDigits > 0) {
+                    str << '.';
+                    for (int j = 0; j < fractionDigits; ++j)
+                        str << digit(random);
+                }
+
+                const String number = str.str();
+                ASSERT_EQ(std::strtof(number.c_str(), nullptr), readFloat(number)) << number;
+            }
+        }
+    }
+}
@@ -26,6 +26,8 @@
 #include "Model/Entity.h"
 #include "Model/World.h"
 
+#include <limits>
+
 namespace TrenchBroom {
     namespace IO {
         inline Model::BrushFace* findFaceByPoints(const Model::BrushFaceList& faces, const Vec3& point0, const Vec3& point1, const Vec3& point2) {
@@ -116,6 +118,63 @@ namespace TrenchBroom {
             delete world;
         }
 
+        class CancellingParserStatus : public ParserStatus {
+        private:
+            size_t m_cancelAfter;
+            size_t m_progressCount;
+            double m_lastProgress;
+        public:
+            CancellingParserStatus(const size_t cancelAfter) :
+            ParserStatus(nullptr),
+            m_cancelAfter(cancelAfter),
+            m_progressCount(0),
+            m_lastProgress(0.0) {}
+
+            size_t progressCount() const {
+                return m_progressCount;
+            }
+
+            double lastProgress() const {
+                return m_lastProgress;
+            }
+        private:
+            void doProgress(const double progress) override {
+                ASSERT_LE(m_lastProgress, progress);
+                m_lastProgress = progress;
+                ++m_progressCount;
+            }
+
+            bool doCancelled() const override {
+                return m_progressCount >= m_cancelAfter;
+            }
+        };
+
+        TEST(WorldReaderTest, reportProgressAndCancel) {
+            const String data("{"
+                              "\"classname\" \"worldspawn\""
+                              "}"
+                              "{"
+                              "\"classname\" \"info_player_deathmatch\""
+                              "}"
+                              "{"
+                              "\"classname\" \"light\""
+                              "}");
+            BBox3 worldBounds(8192);
+
+            CancellingParserStatus status(std::numeric_limits<size_t>::max());
+            WorldReader reader(data, nullptr);
+            Model::World* world = reader.read(Model::MapFormat::Standard, worldBounds, status);
+            ASSERT_TRUE(world != nullptr);
+            ASSERT_EQ(3u, status.progressCount());
+            ASSERT_DOUBLE_EQ(1.0, status.lastProgress());
+            delete world;
+
+            CancellingParserStatus cancellingStatus(2);
+            WorldReader cancelledReader(data, nullptr);
+            ASSERT_THROW(cancelledReader.read(Model::MapFormat::Standard, worldBounds, cancellingStatus), OperationCancelledException);
+            ASSERT_EQ(2u, cancellingStatus.progressCount());
+        }
+
         TEST(WorldReaderTest, parseMapWithWorldspawnAndOneMoreEntity) {
             const String data("{"
                               "\"classname\" \"worldspawn\""
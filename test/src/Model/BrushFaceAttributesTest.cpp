@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/ParaxialTexCoordSystem.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(BrushFaceAttributesTest, copyOnWrite) {
+            BrushFaceAttributes original("texture");
+            original.setXOffset(16.0f);
+
+            BrushFaceAttributes copy(original);
+            ASSERT_TRUE(copy.sharesRecordWith(original));
+
+            copy.setXOffset(32.0f);
+            ASSERT_FALSE(copy.sharesRecordWith(original));
+            ASSERT_EQ(16.0f, original.xOffset());
+            ASSERT_EQ(32.0f, copy.xOffset());
+            ASSERT_EQ("texture", copy.textureName());
+
+            const BrushFaceAttributes snapshot = original.takeSnapshot();
+            ASSERT_TRUE(snapshot.sharesRecordWith(original));
+        }
+
+        TEST(BrushFaceAttributesTest, internEqualAttributes) {
+            const size_t internedCount = BrushFaceAttributes::internedCount();
+            {
+                BrushFaceAttributes first("interned_texture");
+                first.setRotation(45.0f);
+                BrushFaceAttributes second("interned_texture");
+                second.setRotation(45.0f);
+                BrushFaceAttributes third("interned_texture");
+                ASSERT_FALSE(first.sharesRecordWith(second));
+
+                first.intern();
+                second.intern();
+                third.intern();
+                ASSERT_TRUE(first.sharesRecordWith(second));
+                ASSERT_FALSE(first.sharesRecordWith(third));
+                ASSERT_EQ(internedCount + 2, BrushFaceAttributes::internedCount());
+
+                // interned attributes are copied when modified, even if they are not shared
+                third.setRotation(45.0f);
+                ASSERT_FALSE(first.sharesRecordWith(third));
+                third.intern();
+                ASSERT_TRUE(first.sharesRecordWith(third));
+                ASSERT_EQ(internedCount + 1, BrushFaceAttributes::internedCount());
+
+                second.setRotation(90.0f);
+                ASSERT_EQ(45.0f, first.rotation());
+                ASSERT_EQ(90.0f, second.rotation());
+            }
+            ASSERT_EQ(internedCount, BrushFaceAttributes::internedCount());
+        }
+
+        TEST(BrushFaceAttributesTest, internAttributesWithNaN) {
+            const size_t internedCount = BrushFaceAttributes::internedCount();
+            {
+                BrushFaceAttributes first("nan_texture");
+                first.setRotation(Math::nan<float>());
+                first.intern();
+
+                BrushFaceAttributes second(first);
+                second.intern();
+                ASSERT_TRUE(first.sharesRecordWith(second));
+
+                // NaN is not equal to itself, so equal attributes with NaN are never shared
+                BrushFaceAttributes third("nan_texture");
+                third.setRotation(Math::nan<float>());
+                third.intern();
+                ASSERT_FALSE(first.sharesRecordWith(third));
+                ASSERT_EQ(internedCount + 2, BrushFaceAttributes::internedCount());
+            }
+            ASSERT_EQ(internedCount, BrushFaceAttributes::internedCount());
+
+            // the released records must not be found anymore
+            BrushFaceAttributes fourth("nan_texture");
+            fourth.setRotation(Math::nan<float>());
+            fourth.intern();
+            ASSERT_EQ(internedCount + 1, BrushFaceAttributes::internedCount());
+        }
+
+        TEST(BrushFaceAttributesTest, facesShareAttributes) {
+            const Vec3 p0(0.0,  0.0, 4.0);
+            const Vec3 p1(1.0,  0.0, 4.0);
+            const Vec3 p2(0.0, -1.0, 4.0);
+
+            BrushFaceAttributes attribs("shared_texture");
+            attribs.setXScale(0.5f);
+
+            BrushFace first(p0, p1, p2, attribs, new ParaxialTexCoordSystem(p0, p1, p2, attribs));
+            BrushFace second(p0, p1, p2, BrushFaceAttributes(attribs), new ParaxialTexCoordSystem(p0, p1, p2, attribs));
+            ASSERT_TRUE(first.attribs().sharesRecordWith(second.attribs()));
+
+            std::unique_ptr<BrushFace> clone(first.clone());
+            ASSERT_TRUE(first.attribs().sharesRecordWith(clone->attribs()));
+
+            clone->setXOffset(8.0f);
+            ASSERT_FALSE(first.attribs().sharesRecordWith(clone->attribs()));
+            ASSERT_EQ(0.0f, first.xOffset());
+            ASSERT_EQ(8.0f, clone->xOffset());
+
+            // edited faces share their attributes again once they are equal
+            second.setXOffset(8.0f);
+            ASSERT_TRUE(second.attribs().sharesRecordWith(clone->attribs()));
+            second.setXOffset(0.0f);
+            ASSERT_TRUE(second.attribs().sharesRecordWith(first.attribs()));
+        }
+    }
+}
@@ -118,6 +118,50 @@ namespace TrenchBroom {
             EXPECT_EQ(0, texture2.usageCount());
         }
         
+        TEST(BrushFaceTest, textureFaces) {
+            const Vec3 p0(0.0,  0.0, 4.0);
+            const Vec3 p1(1.f,  0.0, 4.0);
+            const Vec3 p2(0.0, -1.0, 4.0);
+            Assets::Texture texture("testTexture", 64, 64);
+            Assets::Texture texture2("testTexture2", 64, 64);
+            
+            BrushFaceAttributes attribs("");
+            attribs.setTexture(&texture);
+            ASSERT_TRUE(texture.faces().empty());
+            
+            {
+                BrushFace face(p0, p1, p2, attribs, new ParaxialTexCoordSystem(p0, p1, p2, attribs));
+                ASSERT_EQ(BrushFaceList(1, &face), texture.faces());
+                
+                BrushFace* clone1 = face.clone();
+                BrushFace* clone2 = face.clone();
+                ASSERT_EQ(3u, texture.faces().size());
+                
+                // removing a face from the middle of the list keeps the others
+                delete clone1;
+                ASSERT_EQ(2u, texture.faces().size());
+                ASSERT_TRUE(VectorUtils::contains(texture.faces(), &face));
+                ASSERT_TRUE(VectorUtils::contains(texture.faces(), clone2));
+                
+                clone2->setTexture(&texture2);
+                ASSERT_EQ(BrushFaceList(1, &face), texture.faces());
+                ASSERT_EQ(BrushFaceList(1, clone2), texture2.faces());
+                
+                clone2->setAttribs(attribs);
+                ASSERT_EQ(2u, texture.faces().size());
+                ASSERT_TRUE(texture2.faces().empty());
+                
+                face.unsetTexture();
+                ASSERT_EQ(BrushFaceList(1, clone2), texture.faces());
+                
+                delete clone2;
+                ASSERT_TRUE(texture.faces().empty());
+            }
+            
+            ASSERT_TRUE(texture.faces().empty());
+            ASSERT_TRUE(texture2.faces().empty());
+        }
+        
         static void getFaceVertsAndTexCoords(const BrushFace *face,
                                              std::vector<Vec3> *vertPositions,
                                              std::vector<Vec2> *vertTexCoords) {
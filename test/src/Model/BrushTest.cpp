@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <random>
 
 namespace TrenchBroom {
     namespace Model {
@@ -2637,6 +2638,39 @@ namespace TrenchBroom {
             VectorUtils::deleteAll(result);
         }
         
+        TEST(BrushTest, subtractFromMultipleMinuends) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+
+            BrushBuilder builder(&world, worldBounds);
+            Brush* subtrahend = builder.createCuboid(BBox3(Vec3(-16.0, -16.0, -16.0), Vec3(16.0, 16.0, 16.0)), "subtrahend");
+
+            BrushList minuends;
+            for (size_t i = 0; i < 16; ++i) {
+                const Vec3 origin(static_cast<FloatType>(i) * 8.0 - 64.0, -32.0, -32.0);
+                minuends.push_back(builder.createCuboid(BBox3(origin, origin + Vec3(32.0, 64.0, 64.0)), "minuend"));
+            }
+
+            const std::vector<BrushList> results = Brush::subtract(world, worldBounds, "texture", minuends, subtrahend);
+            ASSERT_EQ(minuends.size(), results.size());
+
+            for (size_t i = 0; i < minuends.size(); ++i) {
+                const BrushList expected = minuends[i]->subtract(world, worldBounds, "texture", subtrahend);
+                ASSERT_EQ(expected.size(), results[i].size());
+                for (size_t j = 0; j < expected.size(); ++j) {
+                    ASSERT_EQ(expected[j]->bounds(), results[i][j]->bounds());
+                    ASSERT_EQ(SetUtils::makeSet(expected[j]->vertexPositions()), SetUtils::makeSet(results[i][j]->vertexPositions()));
+                }
+                VectorUtils::deleteAll(expected);
+            }
+
+            for (const BrushList& result : results) {
+                VectorUtils::deleteAll(result);
+            }
+            VectorUtils::deleteAll(minuends);
+            delete subtrahend;
+        }
+
         TEST(BrushTest, subtractTruncatedCones) {
             // https://github.com/kduske/TrenchBroom/issues/1469
 
@@ -3306,6 +3340,129 @@ namespace TrenchBroom {
             EXPECT_FALSE(brush1->canMoveVertices(worldBounds, allVertexPositions, Vec3(8192, 0, 0)));
         }
 
+        static Brush* createRandomBrush(const BrushBuilder& builder, std::mt19937& random) {
+            std::uniform_int_distribution<int> coord(-8, 8);
+            std::uniform_int_distribution<int> size(1, 8);
+
+            if (random() % 2 == 0) {
+                const Vec3 min(coord(random), coord(random), coord(random));
+                const Vec3 max = min + Vec3(size(random), size(random), size(random));
+                return builder.createCuboid(BBox3(16.0 * min, 16.0 * max), "texture");
+            }
+
+            while (true) {
+                Vec3::List points;
+                for (size_t i = 0; i < 8; ++i)
+                    points.push_back(16.0 * Vec3(coord(random), coord(random), coord(random)));
+
+                const Polyhedron3 polyhedron(points);
+                if (polyhedron.polyhedron())
+                    return builder.createBrush(polyhedron, "texture");
+            }
+        }
+
+        TEST(BrushTest, intersectsMatchesPolyhedronQuery) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            std::mt19937 random(1);
+            for (size_t i = 0; i < 2000; ++i) {
+                Brush* lhs = createRandomBrush(builder, random);
+                Brush* rhs = createRandomBrush(builder, random);
+
+                const Polyhedron3 lhsPolyhedron(lhs->vertexPositions());
+                const Polyhedron3 rhsPolyhedron(rhs->vertexPositions());
+
+                ASSERT_EQ(lhsPolyhedron.intersects(rhsPolyhedron), lhs->intersects(rhs));
+                ASSERT_EQ(rhsPolyhedron.intersects(lhsPolyhedron), rhs->intersects(lhs));
+
+                delete lhs;
+                delete rhs;
+            }
+        }
+
+        TEST(BrushTest, containsMatchesPolyhedronQuery) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            std::mt19937 random(2);
+            size_t containedCount = 0;
+            for (size_t i = 0; i < 2000; ++i) {
+                Brush* lhs = createRandomBrush(builder, random);
+                Brush* rhs = createRandomBrush(builder, random);
+
+                const Polyhedron3 lhsPolyhedron(lhs->vertexPositions());
+                const Polyhedron3 rhsPolyhedron(rhs->vertexPositions());
+
+                const bool contains = lhsPolyhedron.contains(rhsPolyhedron);
+                ASSERT_EQ(contains, lhs->contains(rhs));
+                ASSERT_EQ(rhsPolyhedron.contains(lhsPolyhedron), rhs->contains(lhs));
+                if (contains)
+                    ++containedCount;
+
+                delete lhs;
+                delete rhs;
+            }
+            ASSERT_LT(0u, containedCount);
+        }
+
+        TEST(BrushTest, pickMatchesFaceQuery) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            std::mt19937 random(3);
+            std::uniform_real_distribution<FloatType> coord(-256.0, 256.0);
+            size_t hitCount = 0;
+            for (size_t i = 0; i < 500; ++i) {
+                Brush* brush = createRandomBrush(builder, random);
+                for (size_t j = 0; j < 20; ++j) {
+                    const Vec3 origin(coord(random), coord(random), coord(random));
+                    const Vec3 target = brush->bounds().center() + Vec3(coord(random), coord(random), coord(random)) / 4.0;
+                    const Ray3 ray(origin, (target - origin).normalized());
+
+                    FloatType expected = Math::nan<FloatType>();
+                    for (const BrushFace* face : brush->faces()) {
+                        const FloatType distance = face->intersectWithRay(ray);
+                        if (!Math::isnan(distance)) {
+                            expected = distance;
+                            break;
+                        }
+                    }
+
+                    PickResult pickResult;
+                    brush->pick(ray, pickResult);
+                    if (Math::isnan(expected)) {
+                        ASSERT_TRUE(pickResult.empty());
+                    } else {
+                        ASSERT_EQ(1u, pickResult.size());
+                        const Hit& hit = pickResult.all().front();
+                        ASSERT_NEAR(expected, hit.distance(), 0.001);
+                        ASSERT_LT(hit.target<BrushFace*>()->boundary().normal.dot(ray.direction), 0.0);
+                        ++hitCount;
+                    }
+                }
+                delete brush;
+            }
+            ASSERT_LT(0u, hitCount);
+        }
+
+        TEST(BrushTest, containsItself) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            Brush* brush = builder.createCube(64.0, "texture");
+            Brush* copy = brush->clone(worldBounds);
+            ASSERT_TRUE(brush->contains(copy));
+            ASSERT_TRUE(brush->intersects(copy));
+
+            delete brush;
+            delete copy;
+        }
+
         // https://github.com/kduske/TrenchBroom/issues/1893
         TEST(BrushTest, intersectsIssue1893) {
             const String data("{\n"
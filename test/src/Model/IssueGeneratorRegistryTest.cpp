@@ -0,0 +1,208 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "TaskScheduler.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Issue.h"
+#include "Model/IssueGenerator.h"
+#include "Model/IssueGeneratorRegistry.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/NodeVisitor.h"
+#include "Model/World.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace Model {
+        class MissingAttributeIssue : public Issue {
+        public:
+            static const IssueType Type;
+        public:
+            MissingAttributeIssue(Node* node) :
+            Issue(node) {}
+        private:
+            IssueType doGetType() const override { return Type; }
+            const String doGetDescription() const override { return "missing attribute"; }
+        };
+
+        const IssueType MissingAttributeIssue::Type = Issue::freeType();
+
+        class MissingAttributeIssueGenerator : public IssueGenerator {
+        private:
+            AttributeName m_name;
+        public:
+            MissingAttributeIssueGenerator(const AttributeName& name) :
+            IssueGenerator(MissingAttributeIssue::Type, "Missing attribute " + name),
+            m_name(name) {}
+        private:
+            void doGenerate(Entity* node, IssueList& issues) const override {
+                if (!node->hasAttribute(m_name))
+                    issues.push_back(new MissingAttributeIssue(node));
+            }
+        };
+
+        class BrushOutOfBoundsIssue : public Issue {
+        public:
+            static const IssueType Type;
+        public:
+            BrushOutOfBoundsIssue(Node* node) :
+            Issue(node) {}
+        private:
+            IssueType doGetType() const override { return Type; }
+            const String doGetDescription() const override { return "brush out of bounds"; }
+        };
+
+        const IssueType BrushOutOfBoundsIssue::Type = Issue::freeType();
+
+        class BrushOutOfBoundsIssueGenerator : public IssueGenerator {
+        private:
+            BBox3 m_bounds;
+        public:
+            BrushOutOfBoundsIssueGenerator(const BBox3& bounds) :
+            IssueGenerator(BrushOutOfBoundsIssue::Type, "Brush out of bounds"),
+            m_bounds(bounds) {}
+        private:
+            void doGenerate(Brush* brush, IssueList& issues) const override {
+                if (!m_bounds.contains(brush->bounds()))
+                    issues.push_back(new BrushOutOfBoundsIssue(brush));
+            }
+        };
+
+        static const BBox3 WorldBounds(4096.0);
+
+        static void registerGenerators(IssueGeneratorRegistry& registry) {
+            registry.registerGenerator(new MissingAttributeIssueGenerator("classname"));
+            registry.registerGenerator(new MissingAttributeIssueGenerator("target"));
+            registry.registerGenerator(new BrushOutOfBoundsIssueGenerator(BBox3(1024.0)));
+        }
+
+        static std::unique_ptr<World> createWorld() {
+            std::unique_ptr<World> world(new World(MapFormat::Standard, nullptr, WorldBounds));
+            world->registerIssueGenerator(new MissingAttributeIssueGenerator("classname"));
+            world->registerIssueGenerator(new MissingAttributeIssueGenerator("target"));
+            world->registerIssueGenerator(new BrushOutOfBoundsIssueGenerator(BBox3(1024.0)));
+
+            BrushBuilder builder(world.get(), WorldBounds);
+            for (size_t i = 0; i < 500; ++i) {
+                Entity* entity = world->createEntity();
+                if (i % 3 != 0)
+                    entity->addOrUpdateAttribute("classname", "info_null");
+                if (i % 5 != 0)
+                    entity->addOrUpdateAttribute("target", "t1");
+                world->defaultLayer()->addChild(entity);
+
+                Brush* brush = builder.createCube(32.0, "texture");
+                brush->transform(translationMatrix(Vec3(0.0, static_cast<double>(i) * 4.0, 0.0)), false, WorldBounds);
+                world->defaultLayer()->addChild(brush);
+            }
+            return world;
+        }
+
+        class CollectNodes : public NodeVisitor {
+        public:
+            NodeList nodes;
+        private:
+            void doVisit(World* world) override   { nodes.push_back(world);  }
+            void doVisit(Layer* layer) override   { nodes.push_back(layer);  }
+            void doVisit(Group* group) override   { nodes.push_back(group);  }
+            void doVisit(Entity* entity) override { nodes.push_back(entity); }
+            void doVisit(Brush* brush) override   { nodes.push_back(brush);  }
+        };
+
+        static NodeList collectNodes(World* world) {
+            CollectNodes visitor;
+            world->acceptAndRecurse(visitor);
+            return visitor.nodes;
+        }
+
+        TEST(IssueGeneratorRegistryTest, generateIssuesConcurrently) {
+            // the issues of one world are validated node by node, those of the other world are generated concurrently
+            auto serialWorld = createWorld();
+            auto concurrentWorld = createWorld();
+
+            const NodeList serialNodes = collectNodes(serialWorld.get());
+            const NodeList concurrentNodes = collectNodes(concurrentWorld.get());
+            ASSERT_EQ(serialNodes.size(), concurrentNodes.size());
+
+            IssueGeneratorRegistry registry;
+            registerGenerators(registry);
+
+            TaskScheduler scheduler(4);
+            registry.generateIssues(concurrentNodes, scheduler);
+
+            size_t lastSeqId = 0;
+            size_t issueCount = 0;
+            for (size_t i = 0; i < serialNodes.size(); ++i) {
+                ASSERT_TRUE(concurrentNodes[i]->issuesValid());
+
+                const IssueList& expected = serialNodes[i]->issues(serialWorld->registeredIssueGenerators());
+                const IssueList& actual = concurrentNodes[i]->issues(registry.registeredGenerators());
+                ASSERT_EQ(expected.size(), actual.size());
+
+                for (size_t j = 0; j < expected.size(); ++j) {
+                    ASSERT_EQ(expected[j]->type(), actual[j]->type());
+                    ASSERT_EQ(expected[j]->description(), actual[j]->description());
+
+                    // the sequence ids follow the order of the nodes
+                    if (issueCount > 0)
+                        ASSERT_LT(lastSeqId, actual[j]->seqId());
+                    lastSeqId = actual[j]->seqId();
+                    ++issueCount;
+                }
+            }
+            ASSERT_LT(0u, issueCount);
+
+            const IssueGeneratorRegistry::StatsList& stats = registry.stats();
+            ASSERT_EQ(3u, stats.size());
+
+            size_t statsIssueCount = 0;
+            for (const IssueGeneratorRegistry::Stats& generatorStats : stats) {
+                ASSERT_EQ(concurrentNodes.size(), generatorStats.nodeCount);
+                ASSERT_LE(0.0, generatorStats.milliseconds);
+                statsIssueCount += generatorStats.issueCount;
+            }
+            ASSERT_EQ(issueCount, statsIssueCount);
+
+            ASSERT_EQ(167u, stats[0].issueCount);
+            ASSERT_EQ(100u, stats[1].issueCount);
+            ASSERT_EQ(247u, stats[2].issueCount);
+        }
+
+        TEST(IssueGeneratorRegistryTest, validateAllIssues) {
+            auto world = createWorld();
+            world->validateAllIssues();
+
+            const IssueGeneratorRegistry::StatsList& stats = world->issueGeneratorStats();
+            ASSERT_EQ(3u, stats.size());
+            for (const IssueGeneratorRegistry::Stats& generatorStats : stats)
+                ASSERT_EQ(collectNodes(world.get()).size(), generatorStats.nodeCount);
+
+            // nodes with valid issues are not checked again
+            world->validateAllIssues();
+            for (const IssueGeneratorRegistry::Stats& generatorStats : world->issueGeneratorStats())
+                ASSERT_EQ(collectNodes(world.get()).size(), generatorStats.nodeCount);
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/Entity.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/NodeCollection.h"
+#include "Model/World.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(NodeCollectionTest, addNodes) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            Layer* layer = world.defaultLayer();
+            Entity* entity = world.createEntity();
+            Brush* brush1 = builder.createCube(64.0, "");
+            Brush* brush2 = builder.createCube(64.0, "");
+            layer->addChild(entity);
+            entity->addChild(brush1);
+            entity->addChild(brush2);
+
+            NodeCollection collection;
+            collection.addNodes(NodeList{ brush1, layer, entity, brush2 });
+
+            // adding a node twice has no effect, and the world is never added
+            collection.addNode(brush1);
+            collection.addNode(&world);
+
+            ASSERT_EQ((NodeList{ brush1, layer, entity, brush2 }), collection.nodes());
+            ASSERT_EQ(LayerList(1, layer), collection.layers());
+            ASSERT_EQ(EntityList(1, entity), collection.entities());
+            ASSERT_EQ((BrushList{ brush1, brush2 }), collection.brushes());
+            ASSERT_EQ(4u, collection.nodeCount());
+            ASSERT_TRUE(collection.contains(brush2));
+            ASSERT_FALSE(collection.contains(&world));
+        }
+
+        TEST(NodeCollectionTest, removeNodesKeepsOrder) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            NodeList brushes;
+            for (size_t i = 0; i < 6; ++i) {
+                Brush* brush = builder.createCube(64.0, "");
+                world.defaultLayer()->addChild(brush);
+                brushes.push_back(brush);
+            }
+
+            NodeCollection collection;
+            collection.addNodes(brushes);
+            collection.removeNodes(NodeList{ brushes[4], brushes[1] });
+            collection.removeNode(brushes[1]);
+
+            ASSERT_EQ(4u, collection.nodeCount());
+            ASSERT_FALSE(collection.contains(brushes[1]));
+            ASSERT_TRUE(collection.contains(brushes[2]));
+            ASSERT_EQ((NodeList{ brushes[0], brushes[2], brushes[3], brushes[5] }), collection.nodes());
+            ASSERT_EQ(4u, collection.brushCount());
+
+            // a removed node is appended when it is added again
+            collection.removeNode(brushes[0]);
+            collection.addNode(brushes[1]);
+            collection.addNode(brushes[0]);
+            ASSERT_EQ((NodeList{ brushes[2], brushes[3], brushes[5], brushes[1], brushes[0] }), collection.nodes());
+            ASSERT_EQ(5u, collection.brushes().size());
+
+            collection.removeNodes(brushes);
+            ASSERT_TRUE(collection.empty());
+            ASSERT_TRUE(collection.nodes().empty());
+            ASSERT_FALSE(collection.hasBrushes());
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "Model/PointFile.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+#include "IO/PointFileParser.h"
+#include "TestUtils.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(PointFileTest, parsePoints) {
+            const String data("1 2 3\n"
+                              "-4.5 5e1 .5\n"
+                              "\n"
+                              "7 8 9");
+            Vec3f::List points;
+            IO::PointFileParser parser(data.data(), data.data() + data.size());
+            parser.parse(points);
+
+            ASSERT_EQ(3u, points.size());
+            ASSERT_VEC_EQ(Vec3f(1.0f, 2.0f, 3.0f), points[0]);
+            ASSERT_VEC_EQ(Vec3f(-4.5f, 50.0f, 0.5f), points[1]);
+            ASSERT_VEC_EQ(Vec3f(7.0f, 8.0f, 9.0f), points[2]);
+        }
+
+        TEST(PointFileTest, parseInvalidPoints) {
+            const String data("1 2 3\n"
+                              "4 ( 6\n");
+            Vec3f::List points;
+            IO::PointFileParser parser(data.data(), data.data() + data.size());
+            ASSERT_THROW(parser.parse(points), ParserException);
+        }
+
+        TEST(PointFileTest, loadPointFile) {
+            const auto path = IO::Disk::getCurrentWorkingDir() + IO::Path("data/Model/PointFile/pointtest.pts");
+            const PointFile pointFile(path);
+
+            // the collinear points are removed and the remaining segments are subdivided every 64 units
+            const Vec3f::List& points = pointFile.points();
+            ASSERT_EQ(7u, points.size());
+            ASSERT_VEC_EQ(Vec3f(0.0f, 0.0f, 0.0f), points[0]);
+            ASSERT_VEC_EQ(Vec3f(64.0f, 0.0f, 0.0f), points[1]);
+            ASSERT_VEC_EQ(Vec3f(128.0f, 0.0f, 0.0f), points[2]);
+            ASSERT_VEC_EQ(Vec3f(192.0f, 0.0f, 0.0f), points[3]);
+            ASSERT_VEC_EQ(Vec3f(256.0f, 0.0f, 0.0f), points[4]);
+            ASSERT_VEC_EQ(Vec3f(256.0f, 64.0f, 0.0f), points[5]);
+            ASSERT_VEC_EQ(Vec3f(256.0f, 128.0f, 0.0f), points[6]);
+        }
+    }
+}
@@ -22,16 +22,18 @@
 #include <memory>
 
 #include "CollectionUtils.h"
+#include "Exceptions.h"
 #include "Model/ModelTypes.h"
 #include "Model/PortalFile.h"
 #include "IO/DiskIO.h"
 #include "IO/Path.h"
+#include "IO/PortalFileParser.h"
 #include "TestUtils.h"
 
 namespace TrenchBroom {
     namespace Model {
         TEST(PortalFileTest, parseInvalidPRT1) {
-            const auto path = IO::Path("data/Model/PortalFile/portaltest_prt1_invalid.prt");
+            const auto path = IO::Disk::getCurrentWorkingDir() + IO::Path("data/Model/PortalFile/portaltest_prt1_invalid.prt");
 
             EXPECT_ANY_THROW(const Model::PortalFile p = Model::PortalFile(path));
         }
@@ -45,21 +47,89 @@ namespace TrenchBroom {
         };
 
         TEST(PortalFileTest, parsePRT1) {
-            const auto path = IO::Path("data/Model/PortalFile/portaltest_prt1.prt");
+            const auto path = IO::Disk::getCurrentWorkingDir() + IO::Path("data/Model/PortalFile/portaltest_prt1.prt");
             const Model::PortalFile portalFile(path);
             ASSERT_EQ(ExpectedPortals, portalFile.portals());
         }
 
         TEST(PortalFileTest, parsePRT1AM) {
-            const auto path = IO::Path("data/Model/PortalFile/portaltest_prt1am.prt");
+            const auto path = IO::Disk::getCurrentWorkingDir() + IO::Path("data/Model/PortalFile/portaltest_prt1am.prt");
             const Model::PortalFile portalFile(path);
             ASSERT_EQ(ExpectedPortals, portalFile.portals());
         }
 
         TEST(PortalFileTest, parsePRT2) {
-            const auto path = IO::Path("data/Model/PortalFile/portaltest_prt2.prt");
+            const auto path = IO::Disk::getCurrentWorkingDir() + IO::Path("data/Model/PortalFile/portaltest_prt2.prt");
             const Model::PortalFile portalFile(path);
             ASSERT_EQ(ExpectedPortals, portalFile.portals());
         }
+
+        TEST(PortalFileTest, parseFromMemory) {
+            const String data("PRT1\n"
+                              "2\n"
+                              "1\n"
+                              "3 0 1 (0 0 0 ) (1.5 0 0 ) (0 -2.5e1 0 ) \n");
+            Vec3f::List vertices;
+            std::vector<size_t> offsets;
+            IO::PortalFileParser parser(data.data(), data.data() + data.size());
+            parser.parse(vertices, offsets);
+
+            const Model::PortalFile portalFile(vertices, offsets);
+            ASSERT_EQ(1u, portalFile.portalCount());
+            ASSERT_EQ(Polygon3f({{0, 0, 0}, {1.5f, 0, 0}, {0, -25, 0}}), portalFile.portal(0));
+        }
+
+        TEST(PortalFileTest, rejectDegeneratePortal) {
+            const String data("PRT1\n"
+                              "2\n"
+                              "1\n"
+                              "2 0 1 (0 0 0 ) (1 0 0 ) \n");
+            Vec3f::List vertices;
+            std::vector<size_t> offsets;
+            IO::PortalFileParser parser(data.data(), data.data() + data.size());
+            ASSERT_THROW(parser.parse(vertices, offsets), ParserException);
+        }
+
+        TEST(PortalFileTest, chunkLargePortalFile) {
+            // a row of unit quads along the X axis
+            const size_t portalCount = 5 * PortalFile::MaxChunkSize + 7;
+            Vec3f::List vertices;
+            std::vector<size_t> offsets;
+            for (size_t i = 0; i < portalCount; ++i) {
+                const float x = static_cast<float>((i * 7919) % portalCount);
+                offsets.push_back(vertices.size());
+                vertices.push_back(Vec3f(x, 0, 0));
+                vertices.push_back(Vec3f(x, 1, 0));
+                vertices.push_back(Vec3f(x, 1, 1));
+                vertices.push_back(Vec3f(x, 0, 1));
+            }
+            offsets.push_back(vertices.size());
+
+            const Model::PortalFile portalFile(vertices, offsets);
+            ASSERT_EQ(portalCount, portalFile.portalCount());
+            ASSERT_EQ(4 * portalCount, portalFile.vertexCount());
+
+            const PortalFile::ChunkList& chunks = portalFile.chunks();
+            ASSERT_LT(1u, chunks.size());
+
+            // the chunks cover all portals without gaps, and every portal lies within the bounds of its chunk
+            size_t nextPortal = 0;
+            for (const PortalFile::Chunk& chunk : chunks) {
+                ASSERT_EQ(nextPortal, chunk.firstPortal);
+                ASSERT_GE(PortalFile::MaxChunkSize, chunk.portalCount);
+                for (size_t i = chunk.firstPortal; i < chunk.firstPortal + chunk.portalCount; ++i) {
+                    const Polygon3f portal = portalFile.portal(i);
+                    ASSERT_EQ(4u, portal.vertices().size());
+                    for (const Vec3f& vertex : portal.vertices())
+                        ASSERT_TRUE(chunk.bounds.contains(vertex));
+                }
+                nextPortal += chunk.portalCount;
+            }
+            ASSERT_EQ(portalCount, nextPortal);
+
+            // the chunks are spatially disjoint because the portals were split along the X axis
+            for (size_t i = 1; i < chunks.size(); ++i)
+                ASSERT_FALSE(chunks[i - 1].bounds.max.x() > chunks[i].bounds.min.x() && chunks[i].bounds.max.x() > chunks[i - 1].bounds.min.x());
+        }
     }
 }
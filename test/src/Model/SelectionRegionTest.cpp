@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/Entity.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/SelectionRegion.h"
+#include "Model/World.h"
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    namespace Model {
+        static SelectionRegion boxRegion(const BBox3& box) {
+            Plane3::List planes;
+            planes.push_back(Plane3(box.max, Vec3::PosX));
+            planes.push_back(Plane3(box.max, Vec3::PosY));
+            planes.push_back(Plane3(box.max, Vec3::PosZ));
+            planes.push_back(Plane3(box.min, Vec3::NegX));
+            planes.push_back(Plane3(box.min, Vec3::NegY));
+            planes.push_back(Plane3(box.min, Vec3::NegZ));
+            return SelectionRegion(planes);
+        }
+
+        static Brush* createCube(const BrushBuilder& builder, const Vec3& center, const FloatType size) {
+            const BBox3 bounds(size / 2.0);
+            return builder.createCuboid(bounds.translated(center), "texture");
+        }
+
+        TEST(SelectionRegionTest, containsAndIntersects) {
+            const SelectionRegion region = boxRegion(BBox3(Vec3(0.0, 0.0, 0.0), Vec3(8.0, 8.0, 8.0)));
+            ASSERT_FALSE(region.empty());
+
+            ASSERT_TRUE(region.contains(Vec3(4.0, 4.0, 4.0)));
+            ASSERT_TRUE(region.contains(Vec3(8.0, 8.0, 8.0)));
+            ASSERT_FALSE(region.contains(Vec3(9.0, 4.0, 4.0)));
+
+            ASSERT_TRUE(region.contains(BBox3(Vec3(1.0, 1.0, 1.0), Vec3(7.0, 7.0, 7.0))));
+            ASSERT_FALSE(region.contains(BBox3(Vec3(1.0, 1.0, 1.0), Vec3(9.0, 7.0, 7.0))));
+
+            ASSERT_TRUE(region.intersects(BBox3(Vec3(1.0, 1.0, 1.0), Vec3(9.0, 7.0, 7.0))));
+            ASSERT_TRUE(region.intersects(BBox3(Vec3(-4.0, -4.0, -4.0), Vec3(12.0, 12.0, 12.0))));
+            ASSERT_FALSE(region.intersects(BBox3(Vec3(9.0, 1.0, 1.0), Vec3(10.0, 7.0, 7.0))));
+        }
+
+        TEST(SelectionRegionTest, emptyRegion) {
+            const SelectionRegion region;
+            ASSERT_TRUE(region.empty());
+            ASSERT_FALSE(region.contains(Vec3::Null));
+            ASSERT_FALSE(region.contains(BBox3(1.0)));
+            ASSERT_FALSE(region.intersects(BBox3(1.0)));
+        }
+
+        TEST(SelectionRegionTest, containsBrush) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            // a region shaped like a wedge that cuts off one corner of the brush's bounds
+            Plane3::List planes;
+            planes.push_back(Plane3(Vec3(16.0, 0.0, 0.0), Vec3(1.0, 1.0, 0.0).normalized()));
+            planes.push_back(Plane3(Vec3(-64.0, 0.0, 0.0), Vec3::NegX));
+            planes.push_back(Plane3(Vec3(0.0, -64.0, 0.0), Vec3::NegY));
+            const SelectionRegion region(planes);
+
+            Brush* inside = createCube(builder, Vec3(-8.0, -8.0, 0.0), 16.0);
+            Brush* outside = createCube(builder, Vec3(8.0, 8.0, 0.0), 16.0);
+            ASSERT_TRUE(region.contains(inside));
+            ASSERT_FALSE(region.contains(outside));
+
+            // only the faces whose vertices lie below the diagonal plane are contained
+            size_t containedFaces = 0;
+            for (const BrushFace* face : outside->faces()) {
+                if (region.contains(face))
+                    ++containedFaces;
+            }
+            ASSERT_EQ(2u, containedFaces);
+
+            delete inside;
+            delete outside;
+        }
+
+        TEST(SelectionRegionTest, findNodesContainedIn) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            Brush* brush1 = createCube(builder, Vec3(0.0, 0.0, 0.0), 16.0);
+            Brush* brush2 = createCube(builder, Vec3(32.0, 0.0, 0.0), 16.0);
+            Brush* brush3 = createCube(builder, Vec3(64.0, 0.0, 0.0), 16.0);
+            Entity* entity = new Entity();
+            world.defaultLayer()->addChild(brush1);
+            world.defaultLayer()->addChild(brush2);
+            world.defaultLayer()->addChild(brush3);
+            world.defaultLayer()->addChild(entity);
+
+            // brush 3 only intersects the region
+            const SelectionRegion region = boxRegion(BBox3(Vec3(-32.0, -32.0, -32.0), Vec3(64.0, 32.0, 32.0)));
+
+            NodeList nodes = world.findNodesContainedIn(region);
+            std::sort(std::begin(nodes), std::end(nodes));
+
+            NodeList expected;
+            expected.push_back(brush1);
+            expected.push_back(brush2);
+            expected.push_back(entity);
+            std::sort(std::begin(expected), std::end(expected));
+            ASSERT_EQ(expected, nodes);
+
+            // brush 3 contributes the face on its left side
+            const BrushFaceList faces = world.findBrushFacesContainedIn(region);
+            ASSERT_EQ(13u, faces.size());
+            for (const BrushFace* face : faces)
+                ASSERT_TRUE(face->brush() != brush3 || face->boundary().normal == Vec3::NegX);
+
+            ASSERT_TRUE(world.findNodesContainedIn(SelectionRegion()).empty());
+        }
+    }
+}
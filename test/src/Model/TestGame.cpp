@@ -59,11 +59,12 @@ namespace TrenchBroom {
             return new World(format, brushContentTypeBuilder(), worldBounds);
         }
         
-        World* TestGame::doLoadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const {
+        World* TestGame::doLoadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status) const {
             return new World(format, brushContentTypeBuilder(), worldBounds);
         }
         
         void TestGame::doWriteMap(World* world, const IO::Path& path) const {}
+        void TestGame::doWriteMapCache(World* world, const IO::Path& path) const {}
         void TestGame::doExportMap(World* world, Model::ExportFormat format, const IO::Path& path) const {}
         
         NodeList TestGame::doParseNodes(const String& str, World* world, const BBox3& worldBounds, Logger* logger) const {
@@ -56,5 +56,30 @@ namespace TrenchBroom {
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
+
+        static void assertProjectsLikeGetTexCoords(const TexCoordSystem& coordSystem, const BrushFaceAttributes& attribs) {
+            const TexCoordProjection projection = coordSystem.getTexCoordProjection(attribs);
+            for (size_t i = 0; i < 32; ++i) {
+                const Vec3 point(static_cast<double>(i) * 17.3 - 128.0, static_cast<double>(i * i) * 0.71, 64.0 - static_cast<double>(i) * 3.9);
+                ASSERT_EQ(coordSystem.getTexCoords(point, attribs), projection.project(point));
+            }
+        }
+
+        TEST(TexCoordSystemTest, projectionMatchesGetTexCoords) {
+            Assets::Texture texture("texture", 64, 32);
+            BrushFaceAttributes attribs("texture");
+            attribs.setTexture(&texture);
+            attribs.setOffset(Vec2f(12.0f, -7.5f));
+            attribs.setScale(Vec2f(0.5f, 2.0f));
+
+            assertProjectsLikeGetTexCoords(ParaxialTexCoordSystem(Vec3(1.0, 2.0, 3.0).normalized(), attribs), attribs);
+            assertProjectsLikeGetTexCoords(ParallelTexCoordSystem(Vec3(1.0, 0.3, 0.0).normalized(), Vec3(0.0, 1.0, 0.2).normalized()), attribs);
+
+            // a zero scale is treated like a scale of one
+            attribs.setScale(Vec2f(0.0f, 1.0f));
+            assertProjectsLikeGetTexCoords(ParaxialTexCoordSystem(Vec3::PosX, attribs), attribs);
+
+            attribs.unsetTexture();
+        }
     }
 }
@@ -21,6 +21,7 @@
 #include <gmock/gmock.h>
 
 #include "Renderer/Camera.h"
+#include "Renderer/OrthographicCamera.h"
 #include "Renderer/PerspectiveCamera.h"
 
 namespace TrenchBroom {
@@ -33,5 +34,27 @@ namespace TrenchBroom {
             ASSERT_FALSE(c.right().nan());
             ASSERT_FALSE(c.up().nan());
         }
+
+        TEST(CameraTest, perspectiveIntersectsFrustum) {
+            PerspectiveCamera c(90.0f, 1.0f, 8000.0f, Camera::Viewport(0, 0, 100, 100), Vec3f::Null, Vec3f::PosX, Vec3f::PosZ);
+
+            ASSERT_TRUE(c.intersectsFrustum(BBox3f(Vec3f(100, -10, -10), Vec3f(120, 10, 10))));
+            ASSERT_TRUE(c.intersectsFrustum(BBox3f(Vec3f(100, 60, -10), Vec3f(120, 80, 10))));
+            ASSERT_FALSE(c.intersectsFrustum(BBox3f(Vec3f(100, 200, -10), Vec3f(120, 220, 10))));
+            ASSERT_FALSE(c.intersectsFrustum(BBox3f(Vec3f(100, -10, -220), Vec3f(120, 10, -200))));
+            ASSERT_FALSE(c.intersectsFrustum(BBox3f(Vec3f(-120, -10, -10), Vec3f(-100, 10, 10))));
+        }
+
+        TEST(CameraTest, orthographicIntersectsFrustum) {
+            OrthographicCamera c;
+            c.setViewport(Camera::Viewport(0, 0, 200, 100));
+            c.moveTo(Vec3f(0, 0, 1000));
+            c.setDirection(Vec3f::NegZ, Vec3f::PosY);
+
+            ASSERT_TRUE(c.intersectsFrustum(BBox3f(Vec3f(-10, -10, -10), Vec3f(10, 10, 10))));
+            ASSERT_TRUE(c.intersectsFrustum(BBox3f(Vec3f(90, 40, -10), Vec3f(110, 60, 10))));
+            ASSERT_FALSE(c.intersectsFrustum(BBox3f(Vec3f(110, -10, -10), Vec3f(130, 10, 10))));
+            ASSERT_FALSE(c.intersectsFrustum(BBox3f(Vec3f(-10, 60, -10), Vec3f(10, 80, 10))));
+        }
     }
 }
@@ -0,0 +1,96 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Renderer/RenderProfiler.h"
+
+#include <cstring>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        TEST(RenderProfilerTest, recordsNestedSections) {
+            RenderProfiler profiler;
+            ASSERT_EQ(0u, profiler.frameCount());
+
+            profiler.beginFrame();
+            {
+                ProfileScope outer(&profiler, "outer");
+                {
+                    ProfileScope inner(&profiler, "inner");
+                }
+                ProfileScope sibling(&profiler, "sibling");
+            }
+            profiler.endFrame();
+
+            ASSERT_EQ(1u, profiler.frameCount());
+            const RenderProfiler::Frame& frame = profiler.frame(0);
+            ASSERT_EQ(3u, frame.sections.size());
+            ASSERT_EQ(0, std::strcmp("outer", frame.sections[0].name));
+            ASSERT_EQ(0u, frame.sections[0].depth);
+            ASSERT_EQ(0, std::strcmp("inner", frame.sections[1].name));
+            ASSERT_EQ(1u, frame.sections[1].depth);
+            ASSERT_EQ(0, std::strcmp("sibling", frame.sections[2].name));
+            ASSERT_EQ(1u, frame.sections[2].depth);
+            ASSERT_FALSE(frame.hasGpuTime());
+            ASSERT_LE(frame.sections[1].time, frame.sections[0].time);
+            ASSERT_LE(frame.sections[0].time, frame.time);
+        }
+
+        TEST(RenderProfilerTest, ignoresSectionsOutsideOfFrame) {
+            RenderProfiler profiler;
+            {
+                ProfileScope scope(&profiler, "outside");
+            }
+
+            profiler.beginFrame();
+            profiler.endFrame();
+
+            ASSERT_EQ(1u, profiler.frameCount());
+            ASSERT_TRUE(profiler.frame(0).sections.empty());
+        }
+
+        TEST(RenderProfilerTest, nullProfilerScope) {
+            ProfileScope scope(nullptr, "nothing");
+        }
+
+        TEST(RenderProfilerTest, ringBufferKeepsMostRecentFrames) {
+            RenderProfiler profiler(2);
+
+            profiler.beginFrame();
+            profiler.beginSection("first");
+            profiler.endFrame();
+
+            profiler.beginFrame();
+            profiler.beginSection("second");
+            profiler.endFrame();
+
+            profiler.beginFrame();
+            profiler.beginSection("third");
+            profiler.endFrame();
+
+            ASSERT_EQ(2u, profiler.frameCount());
+            ASSERT_EQ(0, std::strcmp("third", profiler.frame(0).sections[0].name));
+            ASSERT_EQ(0, std::strcmp("second", profiler.frame(1).sections[0].name));
+
+            profiler.clear();
+            ASSERT_EQ(0u, profiler.frameCount());
+        }
+    }
+}
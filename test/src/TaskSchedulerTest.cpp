@@ -0,0 +1,164 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "StringUtils.h"
+#include "TaskScheduler.h"
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace TrenchBroom {
+    TEST(TaskSchedulerTest, parallelForVisitsEveryIndexOnce) {
+        TaskScheduler scheduler(4);
+
+        std::vector<int> visits(10000, 0);
+        scheduler.parallelFor(0, visits.size(), [&](const size_t i) { ++visits[i]; });
+        ASSERT_EQ(std::vector<int>(10000, 1), visits);
+
+        std::vector<int> partial(100, 0);
+        scheduler.parallelFor(10, 20, [&](const size_t i) { ++partial[i]; }, 3);
+        for (size_t i = 0; i < partial.size(); ++i)
+            ASSERT_EQ(i >= 10 && i < 20 ? 1 : 0, partial[i]);
+
+        scheduler.parallelFor(5, 5, [](const size_t) { FAIL(); });
+    }
+
+    TEST(TaskSchedulerTest, parallelReduce) {
+        TaskScheduler scheduler(4);
+
+        const size_t sum = scheduler.parallelReduce(0, 100001, size_t(0),
+                                                    [](const size_t i) { return i; },
+                                                    [](const size_t lhs, const size_t rhs) { return lhs + rhs; });
+        ASSERT_EQ(5000050000u, sum);
+
+        // not commutative, so this checks that the values are combined in index order
+        const String str = scheduler.parallelReduce(0, 26, String(),
+                                                    [](const size_t i) { return String(1, static_cast<char>('a' + i)); },
+                                                    [](const String& lhs, const String& rhs) { return lhs + rhs; });
+        ASSERT_EQ("abcdefghijklmnopqrstuvwxyz", str);
+
+        ASSERT_EQ(7, scheduler.parallelReduce(3, 3, 7, [](const size_t) { return 1; }, [](int lhs, int rhs) { return lhs + rhs; }));
+    }
+
+    TEST(TaskSchedulerTest, waitRethrowsFirstException) {
+        TaskScheduler scheduler(2);
+
+        std::atomic<size_t> count(0);
+        TaskGroup group(scheduler);
+        for (size_t i = 0; i < 100; ++i) {
+            group.run([&count, i]() {
+                ++count;
+                if (i % 10 == 0)
+                    throw ParserException("task failed");
+            });
+        }
+        ASSERT_THROW(group.wait(), ParserException);
+        ASSERT_EQ(100u, count);
+
+        // the exception is only rethrown once
+        ASSERT_NO_THROW(group.wait());
+
+        ASSERT_THROW(scheduler.parallelFor(0, 1000, [](const size_t i) {
+            if (i == 500)
+                throw ParserException("index failed");
+        }), ParserException);
+    }
+
+    TEST(TaskSchedulerTest, continuationRunsAfterTasks) {
+        TaskScheduler scheduler(4);
+
+        std::atomic<size_t> count(0);
+        std::atomic<size_t> countSeenByContinuation(0);
+
+        TaskGroup group(scheduler);
+        for (size_t i = 0; i < 1000; ++i)
+            group.run([&count]() { ++count; });
+        group.then([&]() { countSeenByContinuation = count.load(); });
+        group.wait();
+
+        // the continuation is submitted when the last task finishes, but it may not have run yet
+        while (countSeenByContinuation == 0)
+            scheduler.runQueuedTask();
+        ASSERT_EQ(1000u, countSeenByContinuation);
+
+        // a group without running tasks submits its continuation immediately
+        std::atomic<bool> ran(false);
+        TaskGroup empty(scheduler);
+        empty.then([&ran]() { ran = true; });
+        while (!ran)
+            scheduler.runQueuedTask();
+    }
+
+    TEST(TaskSchedulerTest, nestedGroupsStress) {
+        TaskScheduler scheduler(4);
+
+        // every task spawns and waits for further tasks, so the waiting threads must help or the scheduler would run
+        // out of workers
+        std::atomic<size_t> leaves(0);
+        std::function<void(size_t)> spawn = [&](const size_t depth) {
+            if (depth == 0) {
+                ++leaves;
+                return;
+            }
+
+            TaskGroup group(scheduler);
+            for (size_t i = 0; i < 8; ++i)
+                group.run([&spawn, depth]() { spawn(depth - 1); });
+            group.wait();
+        };
+
+        for (size_t i = 0; i < 10; ++i)
+            spawn(4);
+        ASSERT_EQ(10u * 8u * 8u * 8u * 8u, leaves);
+    }
+
+    TEST(TaskSchedulerTest, mainThreadTasks) {
+        TaskScheduler scheduler(2);
+
+        std::atomic<size_t> notifications(0);
+        scheduler.setMainThreadNotifier([&notifications]() { ++notifications; });
+
+        std::vector<size_t> order;
+        scheduler.postToMainThread([&order]() { order.push_back(1); });
+        scheduler.postToMainThread([&order]() { order.push_back(2); });
+
+        // only the first task posted to an empty queue notifies
+        ASSERT_EQ(1u, notifications);
+        ASSERT_TRUE(order.empty());
+
+        ASSERT_EQ(2u, scheduler.processMainThreadTasks());
+        ASSERT_EQ(std::vector<size_t>({ 1, 2 }), order);
+        ASSERT_EQ(0u, scheduler.processMainThreadTasks());
+
+        // tasks posted from workers are run on the thread that processes the queue
+        {
+            TaskGroup group(scheduler);
+            for (size_t i = 0; i < 100; ++i)
+                group.run([&scheduler, &order, i]() { scheduler.postToMainThread([&order, i]() { order.push_back(i); }); });
+            group.wait();
+        }
+        ASSERT_EQ(100u, scheduler.processMainThreadTasks());
+        ASSERT_EQ(102u, order.size());
+        ASSERT_EQ(2u, notifications);
+    }
+}
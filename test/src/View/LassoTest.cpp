@@ -0,0 +1,84 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Model/SelectionRegion.h"
+#include "Renderer/OrthographicCamera.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/Lasso.h"
+
+namespace TrenchBroom {
+    namespace View {
+        TEST(LassoTest, orthographicRegion) {
+            Renderer::OrthographicCamera camera;
+            camera.setViewport(Renderer::Camera::Viewport(0, 0, 200, 100));
+            camera.moveTo(Vec3f(0, 0, 100));
+            camera.setDirection(Vec3f::NegZ, Vec3f::PosY);
+
+            // the lasso plane lies 64 units in front of the camera
+            Lasso lasso(camera, 64.0, Vec3(-10.0, -20.0, 36.0));
+            lasso.update(Vec3(10.0, 20.0, 36.0));
+
+            const Model::SelectionRegion region = lasso.region();
+            ASSERT_TRUE(region.contains(Vec3(0.0, 0.0, -500.0)));
+            ASSERT_TRUE(region.contains(Vec3(9.0, 19.0, 500.0)));
+            ASSERT_FALSE(region.contains(Vec3(11.0, 0.0, 0.0)));
+            ASSERT_FALSE(region.contains(Vec3(0.0, -21.0, 0.0)));
+
+            ASSERT_TRUE(region.contains(BBox3(Vec3(-5.0, -5.0, -1000.0), Vec3(5.0, 5.0, 1000.0))));
+            ASSERT_FALSE(region.contains(BBox3(Vec3(5.0, -5.0, -1.0), Vec3(15.0, 5.0, 1.0))));
+            ASSERT_TRUE(region.intersects(BBox3(Vec3(5.0, -5.0, -1.0), Vec3(15.0, 5.0, 1.0))));
+            ASSERT_FALSE(region.intersects(BBox3(Vec3(15.0, -5.0, -1.0), Vec3(25.0, 5.0, 1.0))));
+
+            ASSERT_TRUE(lasso.selects(Vec3(0.0, 0.0, 0.0)));
+            ASSERT_TRUE(lasso.selects(Edge3(Vec3(-20.0, 0.0, 0.0), Vec3(20.0, 0.0, 0.0))));
+            ASSERT_FALSE(lasso.selects(Edge3(Vec3(0.0, 0.0, 0.0), Vec3(40.0, 0.0, 0.0))));
+        }
+
+        TEST(LassoTest, perspectiveRegion) {
+            Renderer::PerspectiveCamera camera(90.0f, 1.0f, 8000.0f, Renderer::Camera::Viewport(0, 0, 100, 100), Vec3f::Null, Vec3f::PosX, Vec3f::PosZ);
+
+            Lasso lasso(camera, 64.0, Vec3(64.0, -8.0, -8.0));
+            lasso.update(Vec3(64.0, 8.0, 8.0));
+
+            // the region widens with the distance from the camera and does not extend behind it
+            const Model::SelectionRegion region = lasso.region();
+            ASSERT_TRUE(region.contains(Vec3(32.0, 3.0, 3.0)));
+            ASSERT_TRUE(region.contains(Vec3(640.0, 70.0, -70.0)));
+            ASSERT_FALSE(region.contains(Vec3(640.0, 90.0, 0.0)));
+            ASSERT_FALSE(region.contains(Vec3(32.0, 5.0, 0.0)));
+            ASSERT_FALSE(region.contains(Vec3(-64.0, 0.0, 0.0)));
+
+            ASSERT_TRUE(region.contains(BBox3(Vec3(600.0, -60.0, -60.0), Vec3(640.0, 60.0, 60.0))));
+            ASSERT_FALSE(region.intersects(BBox3(Vec3(-128.0, -8.0, -8.0), Vec3(-64.0, 8.0, 8.0))));
+        }
+
+        TEST(LassoTest, regionOfEmptyLasso) {
+            Renderer::PerspectiveCamera camera(90.0f, 1.0f, 8000.0f, Renderer::Camera::Viewport(0, 0, 100, 100), Vec3f::Null, Vec3f::PosX, Vec3f::PosZ);
+
+            Lasso lasso(camera, 64.0, Vec3(64.0, 0.0, 0.0));
+            lasso.update(Vec3(64.0, 8.0, 0.0));
+
+            ASSERT_TRUE(lasso.region().empty());
+            ASSERT_FALSE(lasso.selects(Vec3(64.0, 4.0, 0.0)));
+        }
+    }
+}